@@ -0,0 +1,108 @@
+#include "../Sources/Core/scheduler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Times full runs (timeline built and returned) against metrics-only runs on
+// the same workload. Usage: metrics_only_bench [process_count] [repeats]
+
+static double now_seconds(void) {
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void build_workload(process_t *processes, int count) {
+    unsigned int state = 12345U;
+    int arrival = 0;
+    for (int i = 0; i < count; i++) {
+        state = state * 1103515245U + 12345U;
+        arrival += (int)((state >> 16) % 4U);
+        state = state * 1103515245U + 12345U;
+
+        (void)memset(&processes[i], 0, sizeof(processes[i]));
+        processes[i].process_id = i + 1;
+        (void)snprintf(processes[i].name, sizeof(processes[i].name), "P%d", i + 1);
+        processes[i].arrival_time = arrival;
+        processes[i].burst_time = 1 + (int)((state >> 16) % 12U);
+        processes[i].priority = 1 + i % 10;
+    }
+}
+
+static int bench(const char *label, algorithm_type_t algorithm, const process_t *workload, int count, int repeats) {
+    process_t *processes = (process_t *)malloc((size_t)count * sizeof(process_t));
+    if (!processes) {
+        return 1;
+    }
+
+    schedule_config_t config;
+    (void)memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = 2;
+    config.switch_cost = 1;
+
+    double full_time = 0.0;
+    double fast_time = 0.0;
+    int segments = 0;
+    metrics_t full_metrics = {0};
+    metrics_t fast_metrics = {0};
+    for (int r = 0; r < repeats; r++) {
+        timeline_event_t *timeline = NULL;
+        (void)memcpy(processes, workload, (size_t)count * sizeof(process_t));
+        double start = now_seconds();
+        if (schedule_processes_with_config(processes, count, &config, &timeline, &segments, &full_metrics) != 0) {
+            free(processes);
+            return 1;
+        }
+        full_time += now_seconds() - start;
+        free(timeline);
+
+        (void)memcpy(processes, workload, (size_t)count * sizeof(process_t));
+        start = now_seconds();
+        if (schedule_processes_metrics_only(processes, count, &config, &fast_metrics) != 0) {
+            free(processes);
+            return 1;
+        }
+        fast_time += now_seconds() - start;
+    }
+    free(processes);
+
+    if (fast_metrics.context_switches != full_metrics.context_switches ||
+        fast_metrics.total_time != full_metrics.total_time) {
+        fprintf(stderr, "%s: metrics-only run disagrees with the full run\n", label);
+        return 1;
+    }
+
+    printf("%-5s %8d processes %9d segments  full %8.2f ms  metrics-only %8.2f ms  %5.2fx\n",
+           label,
+           count,
+           segments,
+           full_time * 1000.0 / repeats,
+           fast_time * 1000.0 / repeats,
+           (fast_time > 0.0) ? full_time / fast_time : 0.0);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int count = (argc > 1) ? atoi(argv[1]) : 5000;
+    int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+    if (count <= 0 || repeats <= 0) {
+        fprintf(stderr, "usage: %s [process_count] [repeats]\n", argv[0]);
+        return 1;
+    }
+
+    process_t *workload = (process_t *)malloc((size_t)count * sizeof(process_t));
+    if (!workload) {
+        return 1;
+    }
+    build_workload(workload, count);
+
+    int failed = bench("RR", ALGO_RR, workload, count, repeats);
+    if (!failed) {
+        failed = bench("SRTF", ALGO_SRTF, workload, count, repeats);
+    }
+    free(workload);
+    return failed;
+}
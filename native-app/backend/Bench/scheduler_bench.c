@@ -0,0 +1,522 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../Sources/Core/scheduler.h"
+
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Times every policy over several workload shapes and sizes. Each case runs
+// in a forked child so peak RSS is per case and a runaway case can be cut off
+// by the time budget; larger sizes of a policy/shape that ran out of budget
+// are skipped. Results go to stdout and, with --json, to a file with one case
+// per line, policies spelled as sched_algorithm_name returns them. --baseline
+// compares against such a file and exits non-zero when a case got slower (or
+// allocates more) than the tolerance allows.
+//
+// usage: scheduler_bench [--scales 10,1000,100000,1000000] [--budget SECONDS]
+//                        [--json OUT] [--baseline FILE] [--tolerance FRACTION]
+
+#define MAX_SCALES 8
+#define MIN_CASE_SECONDS 0.2
+#define MAX_REPEATS 1000
+
+// Allocation counting interposes the allocator, which only glibc supports
+// without platform-specific hooks; elsewhere the counts are reported as -1.
+#if defined(__GLIBC__)
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void __libc_free(void *pointer);
+
+static long long allocation_count;
+static long long allocated_bytes;
+
+void *malloc(size_t size) {
+    allocation_count++;
+    allocated_bytes += (long long)size;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    allocation_count++;
+    allocated_bytes += (long long)(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    allocation_count++;
+    allocated_bytes += (long long)size;
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) {
+    __libc_free(pointer);
+}
+#define ALLOCATIONS_COUNTED 1
+#else
+static long long allocation_count = -1;
+static long long allocated_bytes = -1;
+#define ALLOCATIONS_COUNTED 0
+#endif
+
+typedef enum {
+    SHAPE_STEADY = 0,
+    SHAPE_BURSTY,
+    SHAPE_HEAVY_TAIL,
+    SHAPE_COUNT
+} workload_shape_t;
+
+static const char *const kShapeNames[SHAPE_COUNT] = {"steady", "bursty", "heavy_tail"};
+
+typedef enum {
+    CASE_OK = 0,
+    CASE_TIMEOUT,
+    CASE_SKIPPED,
+    CASE_FAILED
+} case_status_t;
+
+static const char *const kStatusNames[] = {"ok", "timeout", "skipped", "failed"};
+
+typedef struct {
+    int policy;
+    int shape;
+    int processes;
+    case_status_t status;
+    int repeats;
+    int segments;
+    double median_ns_per_process;
+    double min_ns_per_process;
+    long long peak_rss_kb;
+    long long allocations;  // per run
+    long long allocated_bytes;
+} bench_case_t;
+
+static uint64_t next_random(uint64_t *state) {
+    // xorshift64*
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+static double random_unit(uint64_t *state) {
+    return (double)(next_random(state) >> 11) / 9007199254740992.0;
+}
+
+// Arrival order is shuffled slightly so policies also pay for sorting.
+static void build_workload(process_t *processes, int count, workload_shape_t shape) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)shape << 32) ^ (uint64_t)count;
+    int arrival = 0;
+    for (int i = 0; i < count; i++) {
+        process_t *proc = &processes[i];
+        (void)memset(proc, 0, sizeof(*proc));
+        proc->process_id = i + 1;
+        (void)snprintf(proc->name, sizeof(proc->name), "P%d", i + 1);
+        proc->priority = 1 + (int)(next_random(&state) % 10U);
+
+        switch (shape) {
+            case SHAPE_STEADY:
+                arrival += (int)(next_random(&state) % 8U);
+                proc->burst_time = 1 + (int)(next_random(&state) % 12U);
+                break;
+            case SHAPE_BURSTY:
+                // Groups of 64 arriving together, then a gap roughly as long as the group's work.
+                if (i % 64 == 0 && i > 0) {
+                    arrival += 64 * 6;
+                }
+                proc->burst_time = 1 + (int)(next_random(&state) % 12U);
+                break;
+            case SHAPE_HEAVY_TAIL: {
+                arrival += (int)(next_random(&state) % 10U);
+                // Pareto, alpha 1.5: most jobs short, a few very long.
+                double pareto = pow(1.0 - random_unit(&state), -1.0 / 1.5);
+                proc->burst_time = (pareto > 1000.0) ? 1000 : (int)pareto;
+                break;
+            }
+            case SHAPE_COUNT:
+                break;
+        }
+        proc->arrival_time = arrival;
+    }
+
+    for (int i = 0; i + 1 < count; i += 7) {
+        int j = i + (int)(next_random(&state) % 7U);
+        if (j < count) {
+            process_t swap = processes[i];
+            processes[i] = processes[j];
+            processes[j] = swap;
+        }
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *lhs, const void *rhs) {
+    double a = *(const double *)lhs;
+    double b = *(const double *)rhs;
+    return (a > b) - (a < b);
+}
+
+static long long peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return (long long)usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return (long long)usage.ru_maxrss;
+#endif
+}
+
+static int run_once(process_t *scratch, const process_t *workload, int count, const schedule_config_t *config, int *segments) {
+    timeline_event_t *timeline = NULL;
+    metrics_t metrics;
+    (void)memcpy(scratch, workload, (size_t)count * sizeof(process_t));
+    int status = schedule_processes_with_config(scratch, count, config, &timeline, segments, &metrics);
+    free(timeline);
+    return status;
+}
+
+// Runs in the child: fills result's measurements.
+static void measure_case(bench_case_t *result) {
+    int count = result->processes;
+    process_t *workload = (process_t *)malloc((size_t)count * sizeof(process_t));
+    process_t *scratch = (process_t *)malloc((size_t)count * sizeof(process_t));
+    double *samples = (double *)malloc(MAX_REPEATS * sizeof(double));
+    if (!workload || !scratch || !samples) {
+        result->status = CASE_FAILED;
+        return;
+    }
+    build_workload(workload, count, (workload_shape_t)result->shape);
+
+    schedule_config_t config;
+    (void)memset(&config, 0, sizeof(config));
+    config.algorithm = (algorithm_type_t)result->policy;
+    config.time_quantum = 4;
+    config.switch_cost = 1;
+
+    long long allocations_before = allocation_count;
+    long long bytes_before = allocated_bytes;
+    double start = now_seconds();
+    if (run_once(scratch, workload, count, &config, &result->segments) != 0) {
+        result->status = CASE_FAILED;
+        return;
+    }
+    samples[0] = now_seconds() - start;
+    if (ALLOCATIONS_COUNTED) {
+        result->allocations = allocation_count - allocations_before;
+        result->allocated_bytes = allocated_bytes - bytes_before;
+    } else {
+        result->allocations = -1;
+        result->allocated_bytes = -1;
+    }
+
+    int repeats = 1;
+    double total = samples[0];
+    while (repeats < MAX_REPEATS && total < MIN_CASE_SECONDS) {
+        start = now_seconds();
+        if (run_once(scratch, workload, count, &config, &result->segments) != 0) {
+            result->status = CASE_FAILED;
+            return;
+        }
+        samples[repeats] = now_seconds() - start;
+        total += samples[repeats];
+        repeats++;
+    }
+
+    qsort(samples, (size_t)repeats, sizeof(double), compare_doubles);
+    result->repeats = repeats;
+    result->median_ns_per_process = samples[repeats / 2] * 1e9 / count;
+    result->min_ns_per_process = samples[0] * 1e9 / count;
+    result->peak_rss_kb = peak_rss_kb();
+    result->status = CASE_OK;
+
+    free(samples);
+    free(scratch);
+    free(workload);
+}
+
+static void run_case(bench_case_t *result, unsigned int budget_seconds) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        result->status = CASE_FAILED;
+        return;
+    }
+
+    pid_t child = fork();
+    if (child < 0) {
+        (void)close(fds[0]);
+        (void)close(fds[1]);
+        result->status = CASE_FAILED;
+        return;
+    }
+    if (child == 0) {
+        (void)close(fds[0]);
+        (void)alarm(budget_seconds);
+        measure_case(result);
+        ssize_t written = write(fds[1], result, sizeof(*result));
+        _exit(written == (ssize_t)sizeof(*result) ? 0 : 1);
+    }
+
+    (void)close(fds[1]);
+    bench_case_t measured;
+    size_t received = 0;
+    while (received < sizeof(measured)) {
+        ssize_t got = read(fds[0], (char *)&measured + received, sizeof(measured) - received);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+        received += (size_t)got;
+    }
+    (void)close(fds[0]);
+
+    int wait_status = 0;
+    while (waitpid(child, &wait_status, 0) < 0 && errno == EINTR) {
+    }
+
+    if (received == sizeof(measured)) {
+        *result = measured;
+    } else if (WIFSIGNALED(wait_status) && WTERMSIG(wait_status) == SIGALRM) {
+        result->status = CASE_TIMEOUT;
+    } else {
+        result->status = CASE_FAILED;
+    }
+}
+
+static void write_case_json(FILE *out, const bench_case_t *c) {
+    fprintf(out,
+            "{\"policy\": \"%s\", \"shape\": \"%s\", \"processes\": %d, \"status\": \"%s\", "
+            "\"repeats\": %d, \"segments\": %d, \"ns_per_process\": %.3f, \"min_ns_per_process\": %.3f, "
+            "\"peak_rss_kb\": %lld, \"allocations\": %lld, \"allocated_bytes\": %lld}",
+            sched_algorithm_name((algorithm_type_t)c->policy),
+            kShapeNames[c->shape],
+            c->processes,
+            kStatusNames[c->status],
+            c->repeats,
+            c->segments,
+            c->median_ns_per_process,
+            c->min_ns_per_process,
+            c->peak_rss_kb,
+            c->allocations,
+            c->allocated_bytes);
+}
+
+static int write_json(const char *path, const bench_case_t *cases, int case_count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(out, "{\"schema\": 1, \"cases\": [\n");
+    for (int i = 0; i < case_count; i++) {
+        fprintf(out, "  ");
+        write_case_json(out, &cases[i]);
+        fprintf(out, "%s\n", (i + 1 < case_count) ? "," : "");
+    }
+    fprintf(out, "]}\n");
+    return fclose(out) == 0 ? 0 : 1;
+}
+
+// Baselines are files written by --json: one case object per line.
+static bool json_string_field(const char *line, const char *field, char *value, size_t capacity) {
+    char key[64];
+    (void)snprintf(key, sizeof(key), "\"%s\": \"", field);
+    const char *at = strstr(line, key);
+    if (!at) {
+        return false;
+    }
+    at += strlen(key);
+    size_t length = 0;
+    while (at[length] != '\0' && at[length] != '"' && length + 1 < capacity) {
+        value[length] = at[length];
+        length++;
+    }
+    value[length] = '\0';
+    return true;
+}
+
+static bool json_number_field(const char *line, const char *field, double *value) {
+    char key[64];
+    (void)snprintf(key, sizeof(key), "\"%s\": ", field);
+    const char *at = strstr(line, key);
+    if (!at) {
+        return false;
+    }
+    char *end = NULL;
+    *value = strtod(at + strlen(key), &end);
+    return end != at + strlen(key);
+}
+
+static int compare_with_baseline(const char *path, const bench_case_t *cases, int case_count, double tolerance) {
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "cannot read baseline %s\n", path);
+        return 1;
+    }
+
+    int regressions = 0;
+    int compared = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), in)) {
+        char policy[32];
+        char shape[32];
+        char status[32];
+        double processes = 0.0;
+        double baseline_ns = 0.0;
+        double baseline_allocations = 0.0;
+        if (!json_string_field(line, "policy", policy, sizeof(policy)) ||
+            !json_string_field(line, "shape", shape, sizeof(shape)) ||
+            !json_string_field(line, "status", status, sizeof(status)) ||
+            !json_number_field(line, "processes", &processes) ||
+            !json_number_field(line, "ns_per_process", &baseline_ns) ||
+            !json_number_field(line, "allocations", &baseline_allocations) || strcmp(status, "ok") != 0) {
+            continue;
+        }
+
+        for (int i = 0; i < case_count; i++) {
+            const bench_case_t *c = &cases[i];
+            if (c->processes != (int)processes ||
+                strcmp(sched_algorithm_name((algorithm_type_t)c->policy), policy) != 0 ||
+                strcmp(kShapeNames[c->shape], shape) != 0) {
+                continue;
+            }
+            compared++;
+            if (c->status != CASE_OK) {
+                printf("REGRESSION %s/%s n=%d: %s (baseline ok)\n", policy, shape, c->processes, kStatusNames[c->status]);
+                regressions++;
+            } else if (c->median_ns_per_process > baseline_ns * (1.0 + tolerance)) {
+                printf("REGRESSION %s/%s n=%d: %.1f ns/process vs %.1f baseline\n",
+                       policy, shape, c->processes, c->median_ns_per_process, baseline_ns);
+                regressions++;
+            } else if (baseline_allocations >= 0.0 && c->allocations >= 0 &&
+                       (double)c->allocations > baseline_allocations * (1.0 + tolerance)) {
+                printf("REGRESSION %s/%s n=%d: %lld allocations vs %.0f baseline\n",
+                       policy, shape, c->processes, c->allocations, baseline_allocations);
+                regressions++;
+            }
+        }
+    }
+    (void)fclose(in);
+
+    printf("compared %d cases against %s: %d regression(s)\n", compared, path, regressions);
+    return regressions > 0 ? 1 : 0;
+}
+
+static int parse_scales(const char *text, int *scales) {
+    int count = 0;
+    while (*text && count < MAX_SCALES) {
+        char *end = NULL;
+        double value = strtod(text, &end);
+        if (end == text || value < 1.0 || value > 1e8) {
+            return 0;
+        }
+        scales[count++] = (int)value;
+        text = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0') {
+            return 0;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char **argv) {
+    int scales[MAX_SCALES] = {10, 1000, 100000, 1000000};
+    int scale_count = 4;
+    unsigned int budget_seconds = 10;
+    double tolerance = 0.15;
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--scales") == 0 && has_value) {
+            scale_count = parse_scales(argv[++i], scales);
+        } else if (strcmp(argv[i], "--budget") == 0 && has_value) {
+            budget_seconds = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && has_value) {
+            tolerance = atof(argv[++i]);
+        } else {
+            scale_count = 0;
+            break;
+        }
+    }
+    if (scale_count <= 0 || budget_seconds == 0 || tolerance < 0.0) {
+        fprintf(stderr,
+                "usage: %s [--scales 10,1000,100000,1000000] [--budget SECONDS] [--json OUT] "
+                "[--baseline FILE] [--tolerance FRACTION]\n",
+                argv[0]);
+        return 2;
+    }
+
+    int policy_count = ALGO_PRIORITY_P + 1;
+    int case_capacity = SHAPE_COUNT * policy_count * scale_count;
+    bench_case_t *cases = (bench_case_t *)calloc((size_t)case_capacity, sizeof(bench_case_t));
+    if (!cases) {
+        return 1;
+    }
+
+    printf("%-12s %-11s %9s %8s %12s %12s %11s %12s\n",
+           "policy", "shape", "n", "status", "ns/process", "segments", "rss KiB", "allocs/run");
+    int case_count = 0;
+    for (int shape = 0; shape < SHAPE_COUNT; shape++) {
+        for (int policy = 0; policy < policy_count; policy++) {
+            bool out_of_budget = false;
+            for (int s = 0; s < scale_count; s++) {
+                bench_case_t *c = &cases[case_count++];
+                c->policy = policy;
+                c->shape = shape;
+                c->processes = scales[s];
+                if (out_of_budget) {
+                    c->status = CASE_SKIPPED;
+                } else {
+                    run_case(c, budget_seconds);
+                    out_of_budget = (c->status != CASE_OK);
+                }
+
+                printf("%-12s %-11s %9d %8s %12.1f %12d %11lld %12lld\n",
+                       sched_algorithm_name((algorithm_type_t)policy),
+                       kShapeNames[shape],
+                       c->processes,
+                       kStatusNames[c->status],
+                       c->median_ns_per_process,
+                       c->segments,
+                       c->peak_rss_kb,
+                       c->allocations);
+                (void)fflush(stdout);
+            }
+        }
+    }
+
+    int failed = 0;
+    if (json_path) {
+        failed |= write_json(json_path, cases, case_count);
+    }
+    if (baseline_path) {
+        failed |= compare_with_baseline(baseline_path, cases, case_count, tolerance);
+    }
+    free(cases);
+    return failed;
+}
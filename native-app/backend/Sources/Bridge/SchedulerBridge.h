@@ -34,6 +34,10 @@ typedef NS_ENUM(NSInteger, SchedulingAlgorithmType) {
 @property (nonatomic, assign) double throughput;
 @property (nonatomic, assign) int totalTime;
 @property (nonatomic, assign) int contextSwitches;
+@property (nonatomic, assign) int overheadTime;
+@property (nonatomic, assign) double p99WaitingTime;
+@property (nonatomic, assign) double p99ResponseTime;
+@property (nonatomic, assign) double maxWaitingTime;
 @property (nonatomic, strong) NSArray<NSDictionary *> *processMetrics;
 @end
 
@@ -53,6 +57,13 @@ typedef NS_ENUM(NSInteger, SchedulingAlgorithmType) {
 - (NSDictionary<NSString *, BridgeSchedulingResult *> *)compareAllAlgorithms:(NSArray<BridgeProcess *> *)processes
                                                                   timeQuantum:(int)timeQuantum;
 
+// The whole result as one schedule_flat_result_t block (flat_result.h),
+// wrapped without copying. Read it in place, e.g. from Swift through
+// withUnsafeBytes; no per-segment or per-process objects are created.
+- (nullable NSData *)scheduleProcessesFlat:(NSArray<BridgeProcess *> *)processes
+                             withAlgorithm:(SchedulingAlgorithmType)algorithm
+                               timeQuantum:(int)timeQuantum;
+
 @end
 
 NS_ASSUME_NONNULL_END
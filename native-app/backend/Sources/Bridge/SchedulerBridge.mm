@@ -1,7 +1,9 @@
 #import "SchedulerBridge.h"
 
+#import "../Core/flat_result.h"
 #import "../Core/metrics.h"
 #import "../Core/process_types.h"
+#import "../Core/result_cache.h"
 #import "../Core/scheduler.h"
 
 #import <vector>
@@ -49,24 +51,7 @@ static NSString *BridgeStringFromCString(const char *value) {
     return stringValue ?: @"";
 }
 
-@implementation SchedulerBridge
-
-+ (instancetype)shared {
-    static SchedulerBridge *instance = nil;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        instance = [[self alloc] init];
-    });
-    return instance;
-}
-
-- (nullable BridgeSchedulingResult *)scheduleProcesses:(NSArray<BridgeProcess *> *)processes
-                                         withAlgorithm:(SchedulingAlgorithmType)algorithm
-                                           timeQuantum:(int)timeQuantum {
-    if (processes.count == 0) {
-        return nil;
-    }
-
+static std::vector<process_t> BridgeMakeCProcesses(NSArray<BridgeProcess *> *processes) {
     std::vector<process_t> cProcesses;
     cProcesses.reserve(processes.count);
 
@@ -90,20 +75,98 @@ static NSString *BridgeStringFromCString(const char *value) {
 
         cProcesses.push_back(cProc);
     }
+    return cProcesses;
+}
+
+// View refreshes re-request identical schedules; keep recent results around.
+static const size_t kSchedulerResultCacheBudget = 32 * 1024 * 1024;
+
+@implementation SchedulerBridge {
+    schedule_cache_t *_resultCache;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        if (schedule_cache_create(kSchedulerResultCacheBudget, &_resultCache) != 0) {
+            _resultCache = NULL;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    schedule_cache_destroy(_resultCache);
+}
+
++ (instancetype)shared {
+    static SchedulerBridge *instance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (nullable BridgeSchedulingResult *)scheduleProcesses:(NSArray<BridgeProcess *> *)processes
+                                         withAlgorithm:(SchedulingAlgorithmType)algorithm
+                                           timeQuantum:(int)timeQuantum {
+    if (processes.count == 0) {
+        return nil;
+    }
+
+    std::vector<process_t> cProcesses = BridgeMakeCProcesses(processes);
 
     timeline_event_t *timeline = NULL;
     int timelineCount = 0;
     metrics_t metrics = {};
 
-    int scheduleResult = schedule_processes(
-        cProcesses.data(),
-        (int)cProcesses.size(),
-        (algorithm_type_t)algorithm,
-        timeQuantum,
-        &timeline,
-        &timelineCount,
-        &metrics
-    );
+    schedule_config_t config = {};
+    config.algorithm = (algorithm_type_t)algorithm;
+    config.time_quantum = timeQuantum;
+
+    // The cache is shared across callers; only its lookup and insert are
+    // locked, so concurrent misses schedule in parallel.
+    int scheduleResult = 0;
+    bool cacheHit = false;
+    if (_resultCache) {
+        @synchronized(self) {
+            scheduleResult = schedule_cache_lookup(
+                _resultCache,
+                cProcesses.data(),
+                (int)cProcesses.size(),
+                &config,
+                &timeline,
+                &timelineCount,
+                &metrics,
+                &cacheHit
+            );
+        }
+    }
+
+    if (scheduleResult == 0 && !cacheHit) {
+        scheduleResult = schedule_processes_with_config(
+            cProcesses.data(),
+            (int)cProcesses.size(),
+            &config,
+            &timeline,
+            &timelineCount,
+            &metrics
+        );
+        if (scheduleResult == 0 && _resultCache) {
+            @synchronized(self) {
+                (void)schedule_cache_insert(
+                    _resultCache,
+                    cProcesses.data(),
+                    (int)cProcesses.size(),
+                    &config,
+                    timeline,
+                    timelineCount,
+                    &metrics
+                );
+            }
+        }
+    }
 
     if (scheduleResult != 0) {
         if (timeline != NULL) {
@@ -134,6 +197,10 @@ static NSString *BridgeStringFromCString(const char *value) {
     bridgeMetrics.throughput = metrics.throughput;
     bridgeMetrics.totalTime = metrics.total_time;
     bridgeMetrics.contextSwitches = metrics.context_switches;
+    bridgeMetrics.overheadTime = metrics.overhead_time;
+    bridgeMetrics.p99WaitingTime = metrics.waiting_stats.p99;
+    bridgeMetrics.p99ResponseTime = metrics.response_stats.p99;
+    bridgeMetrics.maxWaitingTime = metrics.waiting_stats.max;
 
     NSMutableArray<NSDictionary *> *perProcessMetrics =
         [NSMutableArray arrayWithCapacity:(NSUInteger)cProcesses.size()];
@@ -189,4 +256,31 @@ static NSString *BridgeStringFromCString(const char *value) {
     return results;
 }
 
+- (nullable NSData *)scheduleProcessesFlat:(NSArray<BridgeProcess *> *)processes
+                             withAlgorithm:(SchedulingAlgorithmType)algorithm
+                               timeQuantum:(int)timeQuantum {
+    if (processes.count == 0) {
+        return nil;
+    }
+
+    std::vector<process_t> cProcesses = BridgeMakeCProcesses(processes);
+
+    schedule_config_t config = {};
+    config.algorithm = (algorithm_type_t)algorithm;
+    config.time_quantum = timeQuantum;
+
+    schedule_flat_result_t *result = NULL;
+    if (schedule_workload_flat(cProcesses.data(), (int)cProcesses.size(), &config, &result) != 0) {
+        return nil;
+    }
+
+    // NSData takes ownership of the block and frees it with the C allocator.
+    return [NSData dataWithBytesNoCopy:result
+                                length:result->size
+                           deallocator:^(void *bytes, NSUInteger length) {
+                               (void)length;
+                               schedule_flat_result_free((schedule_flat_result_t *)bytes);
+                           }];
+}
+
 @end
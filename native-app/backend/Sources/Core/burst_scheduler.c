@@ -0,0 +1,483 @@
+#include "burst_scheduler.h"
+
+#include "metrics.h"
+#include "ready_queue.h"
+#include "sched_internal.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Events that wake a process up. Events at the same time are handled in this
+// order, so arrivals and I/O completions join the ready queue before a
+// process whose slice ends at that instant.
+enum {
+    EVENT_IO_DONE = 0,
+    EVENT_ARRIVAL = 1
+};
+
+typedef struct {
+    int time;
+    int kind;
+    int index;
+} burst_event_t;
+
+typedef struct {
+    burst_event_t *items;
+    int size;
+} event_heap_t;
+
+typedef struct {
+    int_queue_t waiting;
+    int busy;
+} io_device_t;
+
+// Per-process state; the caller's processes are only read.
+typedef struct {
+    int arrival;        // clamped like initialize_process_runtime_fields
+    int priority;
+    int cpu_demand;     // total of the CPU bursts
+    int cursor;         // index into workload->bursts of the current burst
+    int burst_left;     // remaining time of the current burst
+    int ready_since;
+    int last_run_end;   // -1 until it first leaves the CPU
+    process_result_t outcome;
+} burst_job_t;
+
+typedef struct {
+    const burst_workload_t *workload;
+    const schedule_config_t *config;
+    burst_job_t *jobs;
+    int count;
+    algorithm_type_t algorithm;
+    int quantum;
+
+    ready_queue_t ready;  // one heap ordered like the batch policies
+    int next_seq;         // FIFO order among ready processes
+
+    event_heap_t events;
+    io_device_t *devices;
+
+    int now;
+    int running;
+    int last_index;       // process that last held the CPU, -1 before the first dispatch
+    int dispatch_time;    // when the running process got the CPU, after any switch cost
+    int cpu_event_time;
+    int finished_count;
+
+    timeline_builder_t builder;
+    metrics_accumulator_t metrics;
+} burst_sim_t;
+
+static bool event_before(const burst_event_t *a, const burst_event_t *b) {
+    if (a->time != b->time) {
+        return a->time < b->time;
+    }
+    if (a->kind != b->kind) {
+        return a->kind < b->kind;
+    }
+    return a->index < b->index;
+}
+
+static void event_heap_push(event_heap_t *heap, burst_event_t event) {
+    int pos = heap->size++;
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!event_before(&event, &heap->items[parent])) {
+            break;
+        }
+        heap->items[pos] = heap->items[parent];
+        pos = parent;
+    }
+    heap->items[pos] = event;
+}
+
+static burst_event_t event_heap_pop(event_heap_t *heap) {
+    burst_event_t top = heap->items[0];
+    burst_event_t last = heap->items[--heap->size];
+    int pos = 0;
+    for (;;) {
+        int child = pos * 2 + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && event_before(&heap->items[child + 1], &heap->items[child])) {
+            child++;
+        }
+        if (!event_before(&heap->items[child], &last)) {
+            break;
+        }
+        heap->items[pos] = heap->items[child];
+        pos = child;
+    }
+    if (heap->size > 0) {
+        heap->items[pos] = last;
+    }
+    return top;
+}
+
+static int validate_workload(const burst_workload_t *workload) {
+    if (!workload || !workload->processes || workload->process_count <= 0 ||
+        !workload->burst_offsets || workload->device_count < 0) {
+        return SCHED_ERR_ARGS;
+    }
+
+    const int *offsets = workload->burst_offsets;
+    if (offsets[0] != 0) {
+        return SCHED_ERR_ARGS;
+    }
+
+    for (int i = 0; i < workload->process_count; i++) {
+        if (offsets[i + 1] < offsets[i]) {
+            return SCHED_ERR_ARGS;
+        }
+        for (int b = offsets[i]; b < offsets[i + 1]; b++) {
+            const burst_t *burst = &workload->bursts[b];
+            if (burst->duration < 0) {
+                return SCHED_ERR_ARGS;
+            }
+            if (burst->device != BURST_DEVICE_CPU &&
+                (burst->device < 0 || burst->device >= workload->device_count)) {
+                return SCHED_ERR_ARGS;
+            }
+        }
+    }
+
+    if (offsets[workload->process_count] > 0 && !workload->bursts) {
+        return SCHED_ERR_ARGS;
+    }
+    return SCHED_OK;
+}
+
+static void burst_sim_free(burst_sim_t *sim) {
+    if (sim->devices) {
+        for (int d = 0; d < sim->workload->device_count; d++) {
+            int_queue_free(&sim->devices[d].waiting);
+        }
+    }
+    free(sim->devices);
+    free(sim->events.items);
+    free(sim->jobs);
+    ready_queue_free(&sim->ready);
+    timeline_builder_free(&sim->builder);
+    metrics_accumulator_free(&sim->metrics);
+}
+
+static int burst_sim_init(burst_sim_t *sim, const burst_workload_t *workload, const schedule_config_t *config) {
+    (void)memset(sim, 0, sizeof(*sim));
+    sim->workload = workload;
+    sim->config = config;
+    sim->count = workload->process_count;
+    sim->algorithm = config->algorithm;
+    sim->quantum = (config->time_quantum <= 0) ? 1 : config->time_quantum;
+    sim->running = -1;
+    sim->last_index = -1;
+    sim->cpu_event_time = INT_MAX;
+    (void)ready_queue_init(&sim->ready, 1);
+
+    size_t n = (size_t)sim->count;
+    sim->jobs = (burst_job_t *)calloc(n, sizeof(burst_job_t));
+    // Each process has at most one pending arrival or I/O completion.
+    sim->events.items = (burst_event_t *)malloc(n * sizeof(burst_event_t));
+    if (workload->device_count > 0) {
+        sim->devices = (io_device_t *)calloc((size_t)workload->device_count, sizeof(io_device_t));
+    }
+
+    if (!sim->jobs || !sim->events.items || (workload->device_count > 0 && !sim->devices)) {
+        burst_sim_free(sim);
+        return SCHED_ERR_ALLOC;
+    }
+
+    for (int d = 0; d < workload->device_count; d++) {
+        if (int_queue_init(&sim->devices[d].waiting, 16) != SCHED_OK) {
+            burst_sim_free(sim);
+            return SCHED_ERR_ALLOC;
+        }
+    }
+
+    if (timeline_builder_init(&sim->builder) != SCHED_OK) {
+        burst_sim_free(sim);
+        return SCHED_ERR_ALLOC;
+    }
+    metrics_accumulator_init(&sim->metrics);
+
+    for (int i = 0; i < sim->count; i++) {
+        const process_t *proc = &workload->processes[i];
+        burst_job_t *job = &sim->jobs[i];
+        job->arrival = (proc->arrival_time < 0) ? 0 : proc->arrival_time;
+        job->priority = (proc->priority <= 0) ? 1 : proc->priority;
+        for (int b = workload->burst_offsets[i]; b < workload->burst_offsets[i + 1]; b++) {
+            if (workload->bursts[b].device == BURST_DEVICE_CPU) {
+                job->cpu_demand += workload->bursts[b].duration;
+            }
+        }
+        job->cursor = workload->burst_offsets[i];
+        job->last_run_end = -1;
+        job->outcome.response_time = -1;
+        job->outcome.first_run_time = -1;
+    }
+    return SCHED_OK;
+}
+
+// The batch policies' order: FCFS and RR by readiness, SJF/SRTF by the
+// current burst, the priority policies by priority with the remaining burst
+// as the preemptive tie-break; readiness breaks every remaining tie.
+static ready_entry_t ready_entry(algorithm_type_t algorithm, const burst_job_t *job, int burst_left) {
+    ready_entry_t entry;
+    (void)memset(&entry, 0, sizeof(entry));
+    switch (algorithm) {
+        case ALGO_SJF:
+        case ALGO_SRTF:
+            entry.key = burst_left;
+            break;
+        case ALGO_PRIORITY_NP:
+            entry.key = job->priority;
+            break;
+        case ALGO_PRIORITY_P:
+            entry.key = job->priority;
+            entry.tie1 = burst_left;
+            break;
+        default:
+            break;
+    }
+    return entry;
+}
+
+static int make_ready(burst_sim_t *sim, int index) {
+    burst_job_t *job = &sim->jobs[index];
+    job->ready_since = sim->now;
+    ready_entry_t entry = ready_entry(sim->algorithm, job, job->burst_left);
+    entry.seq = sim->next_seq++;
+    entry.index = index;
+    return ready_queue_push(&sim->ready, 0, entry);
+}
+
+static void complete_process(burst_sim_t *sim, int index) {
+    burst_job_t *job = &sim->jobs[index];
+    job->outcome.completion_time = sim->now;
+    job->outcome.turnaround_time = sim->now - job->arrival;
+    if (job->outcome.response_time < 0) {
+        job->outcome.first_run_time = sim->now;
+        job->outcome.response_time = 0;
+    }
+    metrics_accumulator_add_outcome(&sim->metrics, &job->outcome, job->cpu_demand);
+    sim->finished_count++;
+}
+
+static int start_io(burst_sim_t *sim, int index) {
+    int device = sim->workload->bursts[sim->jobs[index].cursor].device;
+    io_device_t *dev = &sim->devices[device];
+    if (dev->busy) {
+        return int_queue_push(&dev->waiting, index);
+    }
+
+    dev->busy = 1;
+    burst_event_t event = { sim->now + sim->jobs[index].burst_left, EVENT_IO_DONE, index };
+    event_heap_push(&sim->events, event);
+    return SCHED_OK;
+}
+
+// Moves a process into its current burst, skipping empty ones.
+static int enter_burst(burst_sim_t *sim, int index) {
+    burst_job_t *job = &sim->jobs[index];
+    const int end = sim->workload->burst_offsets[index + 1];
+    while (job->cursor < end && sim->workload->bursts[job->cursor].duration == 0) {
+        job->cursor++;
+    }
+
+    if (job->cursor >= end) {
+        complete_process(sim, index);
+        return SCHED_OK;
+    }
+
+    const burst_t *burst = &sim->workload->bursts[job->cursor];
+    job->burst_left = burst->duration;
+    if (burst->device == BURST_DEVICE_CPU) {
+        return make_ready(sim, index);
+    }
+    return start_io(sim, index);
+}
+
+static int handle_io_done(burst_sim_t *sim, int index) {
+    int device = sim->workload->bursts[sim->jobs[index].cursor].device;
+    io_device_t *dev = &sim->devices[device];
+    dev->busy = 0;
+
+    if (!int_queue_empty(&dev->waiting)) {
+        int next = -1;
+        (void)int_queue_pop(&dev->waiting, &next);
+        dev->busy = 1;
+        burst_event_t event = { sim->now + sim->jobs[next].burst_left, EVENT_IO_DONE, next };
+        event_heap_push(&sim->events, event);
+    }
+
+    sim->jobs[index].cursor++;
+    return enter_burst(sim, index);
+}
+
+// Takes the running process off the CPU at sim->now and records its segment.
+static int stop_running(burst_sim_t *sim) {
+    int index = sim->running;
+    burst_job_t *job = &sim->jobs[index];
+    const process_t *proc = &sim->workload->processes[index];
+
+    job->burst_left -= sim->now - sim->dispatch_time;
+    job->last_run_end = sim->now;
+    sim->running = -1;
+    sim->cpu_event_time = INT_MAX;
+
+    if (sim->now > sim->dispatch_time) {
+        if (timeline_builder_add(&sim->builder, proc->process_id, proc->name, sim->dispatch_time, sim->now) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        metrics_accumulator_add_segment(&sim->metrics, proc->process_id);
+    }
+
+    if (job->burst_left > 0) {
+        return make_ready(sim, index);
+    }
+
+    job->cursor++;
+    return enter_burst(sim, index);
+}
+
+// A dispatch, switch cost included, runs for at least one tick before it can
+// be preempted, as in the batch policies.
+static bool should_preempt(const burst_sim_t *sim, const ready_entry_t *candidate) {
+    if (sim->now <= sim->dispatch_time ||
+        (sim->algorithm != ALGO_SRTF && sim->algorithm != ALGO_PRIORITY_P)) {
+        return false;
+    }
+    const burst_job_t *job = &sim->jobs[sim->running];
+    ready_entry_t current = ready_entry(sim->algorithm, job, job->burst_left - (sim->now - sim->dispatch_time));
+    current.seq = INT_MAX;  // ties keep the running process
+    return ready_entry_before(candidate, &current);
+}
+
+// Hands the CPU to the best ready process, after the configured switch cost
+// when it changes hands.
+static int dispatch(burst_sim_t *sim) {
+    ready_entry_t entry;
+    (void)ready_queue_pop(&sim->ready, &entry, NULL);
+    int index = entry.index;
+    burst_job_t *job = &sim->jobs[index];
+
+    int start = sim->now;
+    if (sim->last_index >= 0 && sim->last_index != index) {
+        int cost = sched_switch_cost(sim->config, job->last_run_end, sim->now);
+        if (cost > 0) {
+            if (timeline_builder_add(&sim->builder, TIMELINE_OVERHEAD_PROCESS_ID, TIMELINE_OVERHEAD_NAME, start,
+                                     start + cost) != SCHED_OK) {
+                return SCHED_ERR_ALLOC;
+            }
+            metrics_accumulator_add_overhead(&sim->metrics, cost);
+            start += cost;
+        }
+    }
+
+    job->outcome.waiting_time += start - job->ready_since;
+    if (job->outcome.first_run_time < 0) {
+        job->outcome.first_run_time = start;
+        job->outcome.response_time = start - job->arrival;
+    }
+
+    int slice = job->burst_left;
+    if (sim->algorithm == ALGO_RR && slice > sim->quantum) {
+        slice = sim->quantum;
+    }
+
+    sim->running = index;
+    sim->last_index = index;
+    sim->dispatch_time = start;
+    sim->cpu_event_time = start + slice;
+    return SCHED_OK;
+}
+
+static int run_simulation(burst_sim_t *sim) {
+    for (int i = 0; i < sim->count; i++) {
+        burst_event_t event = { sim->jobs[i].arrival, EVENT_ARRIVAL, i };
+        event_heap_push(&sim->events, event);
+    }
+
+    while (sim->finished_count < sim->count) {
+        int next_time = sim->cpu_event_time;
+        if (sim->events.size > 0 && sim->events.items[0].time < next_time) {
+            next_time = sim->events.items[0].time;
+        }
+        if (next_time == INT_MAX) {
+            break;
+        }
+        sim->now = next_time;
+
+        while (sim->events.size > 0 && sim->events.items[0].time == sim->now) {
+            burst_event_t event = event_heap_pop(&sim->events);
+            int result = (event.kind == EVENT_ARRIVAL) ? enter_burst(sim, event.index)
+                                                       : handle_io_done(sim, event.index);
+            if (result != SCHED_OK) {
+                return result;
+            }
+        }
+
+        if (sim->running >= 0 && sim->cpu_event_time == sim->now) {
+            if (stop_running(sim) != SCHED_OK) {
+                return SCHED_ERR_ALLOC;
+            }
+        }
+
+        ready_entry_t best;
+        if (!ready_queue_peek(&sim->ready, &best, NULL)) {
+            continue;
+        }
+        if (sim->running >= 0 && should_preempt(sim, &best)) {
+            if (stop_running(sim) != SCHED_OK) {
+                return SCHED_ERR_ALLOC;
+            }
+        }
+        if (sim->running < 0 && dispatch(sim) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    return SCHED_OK;
+}
+
+int schedule_burst_processes(
+    const burst_workload_t *workload,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    if (!timeline || !timeline_count || !metrics || sched_validate_config(config) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+    *timeline = NULL;
+    *timeline_count = 0;
+    if (config->aging_interval > 0) {
+        return SCHED_ERR_ARGS;  // aging is not modelled across bursts
+    }
+
+    int valid = validate_workload(workload);
+    if (valid != SCHED_OK) {
+        return valid;
+    }
+
+    burst_sim_t sim;
+    if (burst_sim_init(&sim, workload, config) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    int result = run_simulation(&sim);
+    if (result == SCHED_OK) {
+        result = build_and_return_timeline(&sim.builder, timeline, timeline_count);
+    }
+    if (result == SCHED_OK) {
+        metrics_accumulator_finish(&sim.metrics, metrics);
+        for (int i = 0; results && i < sim.count; i++) {
+            results[i] = sim.jobs[i].outcome;
+        }
+    }
+    burst_sim_free(&sim);
+    return result;
+}
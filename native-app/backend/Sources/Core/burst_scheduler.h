@@ -0,0 +1,27 @@
+#ifndef BURST_SCHEDULER_H
+#define BURST_SCHEDULER_H
+
+#include "process_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Event-driven simulation of processes that alternate CPU and I/O bursts,
+// under config's algorithm, quantum and switch costs (aging is rejected).
+// workload->processes is only read. When results is non-NULL it receives one
+// outcome per process, with waiting_time the time spent in the ready queue.
+int schedule_burst_processes(
+    const burst_workload_t *workload,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BURST_SCHEDULER_H
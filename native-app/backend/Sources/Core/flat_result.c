@@ -0,0 +1,141 @@
+#include "flat_result.h"
+
+#include "sched_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static size_t bounded_name_length(const char *name) {
+    size_t length = 0;
+    while (length < MAX_PROCESS_NAME - 1 && name[length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+static int pack(
+    const process_t *processes,
+    const process_result_t *results,
+    int process_count,
+    const flat_segment_builder_t *segments,
+    const metrics_t *metrics,
+    schedule_flat_result_t **result
+) {
+    size_t names_size = 0;
+    for (int i = 0; i < process_count; i++) {
+        names_size += bounded_name_length(processes[i].name) + 1;
+    }
+
+    size_t segments_offset = align_up(sizeof(schedule_flat_result_t), 8);
+    size_t processes_offset = segments_offset + (size_t)segments->count * sizeof(flat_segment_t);
+    size_t names_offset = processes_offset + (size_t)process_count * sizeof(flat_process_t);
+    size_t size = names_offset + names_size;
+    if (size > UINT32_MAX) {
+        return SCHED_ERR_ARGS;
+    }
+
+    uint8_t *block = (uint8_t *)malloc(size);
+    if (!block) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    schedule_flat_result_t *header = (schedule_flat_result_t *)block;
+    (void)memset(header, 0, segments_offset);
+    header->size = (uint32_t)size;
+    header->segment_count = segments->count;
+    header->process_count = process_count;
+    header->segments_offset = (uint32_t)segments_offset;
+    header->processes_offset = (uint32_t)processes_offset;
+    header->names_offset = (uint32_t)names_offset;
+    header->metrics = *metrics;
+
+    if (segments->count > 0) {
+        (void)memcpy(block + segments_offset, segments->items, (size_t)segments->count * sizeof(flat_segment_t));
+    }
+
+    flat_process_t *out = (flat_process_t *)(block + processes_offset);
+    char *names = (char *)(block + names_offset);
+    uint32_t name_offset = 0;
+    for (int i = 0; i < process_count; i++) {
+        const process_t *proc = &processes[i];
+        size_t length = bounded_name_length(proc->name);
+
+        // Inputs as the scheduler clamped them.
+        out[i].process_id = proc->process_id;
+        out[i].arrival_time = (proc->arrival_time < 0) ? 0 : proc->arrival_time;
+        out[i].burst_time = (proc->burst_time < 0) ? 0 : proc->burst_time;
+        out[i].priority = (proc->priority <= 0) ? 1 : proc->priority;
+        out[i].completion_time = results[i].completion_time;
+        out[i].turnaround_time = results[i].turnaround_time;
+        out[i].waiting_time = results[i].waiting_time;
+        out[i].response_time = results[i].response_time;
+        out[i].name_offset = name_offset;
+
+        (void)memcpy(names + name_offset, proc->name, length);
+        names[name_offset + length] = '\0';
+        name_offset += (uint32_t)(length + 1);
+    }
+
+    *result = header;
+    return SCHED_OK;
+}
+
+int schedule_workload_flat(
+    const process_t *workload,
+    int process_count,
+    const schedule_config_t *config,
+    schedule_flat_result_t **result
+) {
+    if (!workload || process_count <= 0 || !config || !result) {
+        return SCHED_ERR_ARGS;
+    }
+    *result = NULL;
+
+    process_result_t *results = (process_result_t *)malloc((size_t)process_count * sizeof(process_result_t));
+    if (!results) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    sched_inputs_t inputs;
+    sched_inputs_from_processes(&inputs, workload);
+    flat_segment_builder_t segments;
+    (void)memset(&segments, 0, sizeof(segments));
+    metrics_t metrics;
+    int status = sched_schedule_inputs(&inputs, process_count, config, results, NULL, NULL, &segments, &metrics);
+    if (status == SCHED_OK) {
+        status = pack(workload, results, process_count, &segments, &metrics, result);
+    }
+
+    flat_segment_builder_free(&segments);
+    free(results);
+    return status;
+}
+
+void schedule_flat_result_free(schedule_flat_result_t *result) {
+    free(result);
+}
+
+const flat_segment_t *schedule_flat_segments(const schedule_flat_result_t *result) {
+    if (!result) {
+        return NULL;
+    }
+    return (const flat_segment_t *)((const uint8_t *)result + result->segments_offset);
+}
+
+const flat_process_t *schedule_flat_processes(const schedule_flat_result_t *result) {
+    if (!result) {
+        return NULL;
+    }
+    return (const flat_process_t *)((const uint8_t *)result + result->processes_offset);
+}
+
+const char *schedule_flat_name(const schedule_flat_result_t *result, const flat_process_t *process) {
+    if (!result || !process) {
+        return NULL;
+    }
+    return (const char *)result + result->names_offset + process->name_offset;
+}
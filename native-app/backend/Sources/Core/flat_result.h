@@ -0,0 +1,64 @@
+#ifndef FLAT_RESULT_H
+#define FLAT_RESULT_H
+
+#include "process_types.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAT_SEGMENT_OVERHEAD (-1)
+
+typedef struct {
+    int32_t process_index;  // into the process array, FLAT_SEGMENT_OVERHEAD for switch overhead
+    int32_t start_time;
+    int32_t end_time;
+} flat_segment_t;
+
+typedef struct {
+    int32_t process_id;
+    int32_t arrival_time;
+    int32_t burst_time;
+    int32_t priority;
+    int32_t completion_time;
+    int32_t turnaround_time;
+    int32_t waiting_time;
+    int32_t response_time;
+    uint32_t name_offset;  // into the name table, NUL-terminated UTF-8
+} flat_process_t;
+
+// A whole scheduling result in one malloc'd block: this header, then the
+// segment array, the process array (workload order) and the name table.
+// Sections are located by byte offsets from the start of the block, never by
+// pointers, so the block can be handed on as-is (NSData without copying, an
+// UnsafeRawBufferPointer in Swift, a file or a socket) and read in place.
+typedef struct {
+    uint32_t size;  // bytes in the whole block, header included
+    int32_t segment_count;
+    int32_t process_count;
+    uint32_t segments_offset;
+    uint32_t processes_offset;
+    uint32_t names_offset;
+    metrics_t metrics;
+} schedule_flat_result_t;
+
+// Same schedule as schedule_workload; the workload is only read.
+int schedule_workload_flat(
+    const process_t *workload,
+    int process_count,
+    const schedule_config_t *config,
+    schedule_flat_result_t **result
+);
+void schedule_flat_result_free(schedule_flat_result_t *result);
+
+const flat_segment_t *schedule_flat_segments(const schedule_flat_result_t *result);
+const flat_process_t *schedule_flat_processes(const schedule_flat_result_t *result);
+const char *schedule_flat_name(const schedule_flat_result_t *result, const flat_process_t *process);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLAT_RESULT_H
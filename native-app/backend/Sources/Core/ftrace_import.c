@@ -0,0 +1,697 @@
+#include "ftrace_import.h"
+
+#include "sched_internal.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FTRACE_COMM_LENGTH 16   // the kernel's TASK_COMM_LEN
+#define FTRACE_MAX_LINE 1024
+#define FTRACE_MAX_CPU 4096
+
+typedef enum {
+    RECORD_WAKEUP = 0,
+    RECORD_SWITCH = 1
+} record_kind_t;
+
+typedef struct {
+    int pid;
+    int prio;
+    char comm[FTRACE_COMM_LENGTH];
+} record_task_t;
+
+typedef struct {
+    record_kind_t kind;
+    long long ns;
+    int cpu;
+    record_task_t task;      // wakeup target, or the task switched out
+    bool prev_runnable;      // switch: prev_state was R / R+
+    record_task_t next;      // switch: the task switched in
+} record_t;
+
+typedef struct {
+    int pid;
+    int job;                 // open runnable interval, -1 if none
+    int running_cpu;         // -1 when not on a CPU
+    int since;               // tick it last went on a CPU
+    char comm[FTRACE_COMM_LENGTH];
+} task_state_t;
+
+typedef struct {
+    int pid;
+    int arrival;
+    int first_run;
+    int completion;          // -1 while open
+    int burst;
+    int priority;
+    int last_segment;
+    char comm[FTRACE_COMM_LENGTH];
+} job_t;
+
+typedef struct {
+    int job;
+    int start;
+    int end;
+} segment_t;
+
+struct ftrace_importer {
+    long long unit_ns;
+    bool has_base;
+    long long base_ns;
+    int last_tick;
+
+    task_state_t *tasks;
+    int task_count;
+    int task_capacity;
+    int *slots;              // open-addressing pid -> task index + 1 (0 = empty)
+    int slot_capacity;       // power of two
+
+    job_t *jobs;
+    int job_count;
+    int job_capacity;
+    segment_t *segments;
+    int segment_count;
+    int segment_capacity;
+
+    int *cpu_last_job;       // -2 never seen, -1 seen but nothing run yet
+    int cpu_capacity;
+    int cpu_count;
+    int context_switches;
+    long long records;
+    long long ignored_lines;
+};
+
+static int grow_array(void **items, int *capacity, int needed, size_t item_size) {
+    if (needed <= *capacity) {
+        return SCHED_OK;
+    }
+    int grown_capacity = (*capacity > 0) ? *capacity : 64;
+    while (grown_capacity < needed) {
+        if (grown_capacity > INT_MAX / 2) {
+            return SCHED_ERR_ALLOC;
+        }
+        grown_capacity *= 2;
+    }
+    void *grown = realloc(*items, (size_t)grown_capacity * item_size);
+    if (!grown) {
+        return SCHED_ERR_ALLOC;
+    }
+    *items = grown;
+    *capacity = grown_capacity;
+    return SCHED_OK;
+}
+
+int ftrace_importer_create(const ftrace_import_config_t *config, ftrace_importer_t **importer) {
+    if (!importer || (config && config->time_unit_ns <= 0)) {
+        return SCHED_ERR_ARGS;
+    }
+    *importer = (ftrace_importer_t *)calloc(1, sizeof(ftrace_importer_t));
+    if (!*importer) {
+        return SCHED_ERR_ALLOC;
+    }
+    (*importer)->unit_ns = config ? config->time_unit_ns : FTRACE_DEFAULT_TIME_UNIT_NS;
+    return SCHED_OK;
+}
+
+void ftrace_importer_destroy(ftrace_importer_t *importer) {
+    if (!importer) {
+        return;
+    }
+    free(importer->tasks);
+    free(importer->slots);
+    free(importer->jobs);
+    free(importer->segments);
+    free(importer->cpu_last_job);
+    free(importer);
+}
+
+static unsigned int pid_hash(int pid) {
+    return (unsigned int)pid * 2654435761U;
+}
+
+static int rehash(ftrace_importer_t *importer, int capacity) {
+    int *slots = (int *)calloc((size_t)capacity, sizeof(int));
+    if (!slots) {
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < importer->task_count; i++) {
+        unsigned int slot = pid_hash(importer->tasks[i].pid) & (unsigned int)(capacity - 1);
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & (unsigned int)(capacity - 1);
+        }
+        slots[slot] = i + 1;
+    }
+    free(importer->slots);
+    importer->slots = slots;
+    importer->slot_capacity = capacity;
+    return SCHED_OK;
+}
+
+static task_state_t *task_for(ftrace_importer_t *importer, int pid) {
+    if (importer->slot_capacity > 0) {
+        unsigned int mask = (unsigned int)(importer->slot_capacity - 1);
+        for (unsigned int slot = pid_hash(pid) & mask; importer->slots[slot] != 0; slot = (slot + 1) & mask) {
+            task_state_t *task = &importer->tasks[importer->slots[slot] - 1];
+            if (task->pid == pid) {
+                return task;
+            }
+        }
+    }
+
+    // Keep the table at most half full.
+    if ((importer->task_count + 1) * 2 > importer->slot_capacity &&
+        rehash(importer, importer->slot_capacity > 0 ? importer->slot_capacity * 2 : 256) != SCHED_OK) {
+        return NULL;
+    }
+    if (grow_array((void **)&importer->tasks, &importer->task_capacity, importer->task_count + 1,
+                   sizeof(task_state_t)) != SCHED_OK) {
+        return NULL;
+    }
+    task_state_t *task = &importer->tasks[importer->task_count++];
+    (void)memset(task, 0, sizeof(*task));
+    task->pid = pid;
+    task->job = -1;
+    task->running_cpu = -1;
+
+    unsigned int mask = (unsigned int)(importer->slot_capacity - 1);
+    unsigned int slot = pid_hash(pid) & mask;
+    while (importer->slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    importer->slots[slot] = importer->task_count;
+    return task;
+}
+
+static int map_priority(int prio) {
+    if (prio < 100) {
+        return 1;
+    }
+    int level = 1 + (prio - 100) * 10 / 40;
+    return clamp_int(level, 1, 10);
+}
+
+static int open_job(ftrace_importer_t *importer, task_state_t *task, int tick, int prio) {
+    if (grow_array((void **)&importer->jobs, &importer->job_capacity, importer->job_count + 1, sizeof(job_t)) !=
+        SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    job_t *job = &importer->jobs[importer->job_count];
+    job->pid = task->pid;
+    job->arrival = tick;
+    job->first_run = -1;
+    job->completion = -1;
+    job->burst = 0;
+    job->priority = map_priority(prio);
+    job->last_segment = -1;
+    (void)memcpy(job->comm, task->comm, sizeof(job->comm));
+    task->job = importer->job_count++;
+    return SCHED_OK;
+}
+
+static int add_segment(ftrace_importer_t *importer, int job_index, int start, int end) {
+    if (end <= start) {
+        return SCHED_OK;
+    }
+    job_t *job = &importer->jobs[job_index];
+    job->burst += end - start;
+    if (job->last_segment >= 0 && importer->segments[job->last_segment].end == start) {
+        importer->segments[job->last_segment].end = end;
+        return SCHED_OK;
+    }
+    if (grow_array((void **)&importer->segments, &importer->segment_capacity, importer->segment_count + 1,
+                   sizeof(segment_t)) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    segment_t *segment = &importer->segments[importer->segment_count];
+    segment->job = job_index;
+    segment->start = start;
+    segment->end = end;
+    job->last_segment = importer->segment_count++;
+    return SCHED_OK;
+}
+
+static void set_comm(task_state_t *task, const char *comm) {
+    if (comm[0] != '\0') {
+        (void)memcpy(task->comm, comm, sizeof(task->comm));
+    }
+}
+
+static int apply_wakeup(ftrace_importer_t *importer, const record_t *record, int tick) {
+    if (record->task.pid == 0) {
+        return SCHED_OK;
+    }
+    task_state_t *task = task_for(importer, record->task.pid);
+    if (!task) {
+        return SCHED_ERR_ALLOC;
+    }
+    set_comm(task, record->task.comm);
+    return (task->job < 0) ? open_job(importer, task, tick, record->task.prio) : SCHED_OK;
+}
+
+static int apply_switch(ftrace_importer_t *importer, const record_t *record, int tick) {
+    int cpu = record->cpu;
+    if (cpu >= 0 && cpu < FTRACE_MAX_CPU) {
+        int old_capacity = importer->cpu_capacity;
+        if (grow_array((void **)&importer->cpu_last_job, &importer->cpu_capacity, cpu + 1, sizeof(int)) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        for (int i = old_capacity; i < importer->cpu_capacity; i++) {
+            importer->cpu_last_job[i] = -2;
+        }
+        if (importer->cpu_last_job[cpu] == -2) {
+            importer->cpu_last_job[cpu] = -1;
+            importer->cpu_count++;
+        }
+    } else {
+        cpu = -1;
+    }
+
+    if (record->task.pid != 0) {
+        task_state_t *prev = task_for(importer, record->task.pid);
+        if (!prev) {
+            return SCHED_ERR_ALLOC;
+        }
+        set_comm(prev, record->task.comm);
+        if (prev->running_cpu >= 0 && prev->job >= 0) {
+            int status = add_segment(importer, prev->job, prev->since, tick);
+            if (status != SCHED_OK) {
+                return status;
+            }
+        }
+        prev->running_cpu = -1;
+
+        // Preempted tasks stay in their interval; anything else blocked.
+        if (record->prev_runnable) {
+            if (prev->job < 0) {
+                int status = open_job(importer, prev, tick, record->task.prio);
+                if (status != SCHED_OK) {
+                    return status;
+                }
+            }
+        } else if (prev->job >= 0) {
+            importer->jobs[prev->job].completion = tick;
+            prev->job = -1;
+        }
+    }
+
+    if (record->next.pid != 0) {
+        task_state_t *next = task_for(importer, record->next.pid);
+        if (!next) {
+            return SCHED_ERR_ALLOC;
+        }
+        set_comm(next, record->next.comm);
+        if (next->job < 0) {
+            int status = open_job(importer, next, tick, record->next.prio);
+            if (status != SCHED_OK) {
+                return status;
+            }
+        }
+        job_t *job = &importer->jobs[next->job];
+        if (job->first_run < 0) {
+            job->first_run = tick;
+        }
+        next->running_cpu = (cpu >= 0) ? cpu : 0;
+        next->since = tick;
+
+        if (cpu >= 0) {
+            int last = importer->cpu_last_job[cpu];
+            if (last >= 0 && last != next->job) {
+                importer->context_switches++;
+            }
+            importer->cpu_last_job[cpu] = next->job;
+        }
+    }
+    return SCHED_OK;
+}
+
+static const char *skip_spaces(const char *p) {
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    return p;
+}
+
+static void copy_comm(char *comm, const char *begin, const char *end) {
+    size_t length = (size_t)(end - begin);
+    if (length >= FTRACE_COMM_LENGTH) {
+        length = FTRACE_COMM_LENGTH - 1;
+    }
+    (void)memcpy(comm, begin, length);
+    comm[length] = '\0';
+}
+
+static bool parse_int(const char *p, int *value) {
+    char *end = NULL;
+    long parsed = strtol(p, &end, 10);
+    if (end == p || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    *value = (int)parsed;
+    return true;
+}
+
+// key=value fields as the kernel prints them. comm values may contain
+// spaces, so they run up to the following key.
+static const char *find_key(const char *body, const char *key) {
+    size_t key_length = strlen(key);
+    for (const char *p = strstr(body, key); p; p = strstr(p + 1, key)) {
+        if (p == body || p[-1] == ' ') {
+            return p + key_length;
+        }
+    }
+    return NULL;
+}
+
+static bool parse_kv_task(const char *body, const char *comm_key, const char *pid_key, const char *prio_key,
+                          record_task_t *task) {
+    const char *comm = find_key(body, comm_key);
+    const char *pid = find_key(body, pid_key);
+    const char *prio = find_key(body, prio_key);
+    if (!comm || !pid || !prio || pid < comm) {
+        return false;
+    }
+    const char *comm_end = pid - strlen(pid_key);
+    while (comm_end > comm && comm_end[-1] == ' ') {
+        comm_end--;
+    }
+    copy_comm(task->comm, comm, comm_end);
+    return parse_int(pid, &task->pid) && parse_int(prio, &task->prio);
+}
+
+// trace-cmd's "comm:pid [prio]"; the comm itself may contain ':'.
+static bool parse_compact_task(const char *begin, const char *end, record_task_t *task, const char **after) {
+    begin = skip_spaces(begin);
+    const char *bracket = NULL;
+    for (const char *p = begin; p + 1 < end; p++) {
+        if (p[0] == ' ' && p[1] == '[') {
+            bracket = p;
+            break;
+        }
+    }
+    if (!bracket) {
+        return false;
+    }
+    const char *colon = NULL;
+    for (const char *p = begin; p < bracket; p++) {
+        if (*p == ':') {
+            colon = p;
+        }
+    }
+    if (!colon || !parse_int(colon + 1, &task->pid) || !parse_int(bracket + 2, &task->prio)) {
+        return false;
+    }
+    copy_comm(task->comm, begin, colon);
+    const char *close = strchr(bracket, ']');
+    *after = close ? close + 1 : end;
+    return true;
+}
+
+static bool runnable_state(const char *state) {
+    // "R" and "R+" (preempted); anything else (S, D, T, X, Z, ...) blocks.
+    return state[0] == 'R' && (state[1] == '\0' || state[1] == ' ' || state[1] == '+');
+}
+
+static bool parse_switch_body(const char *body, record_t *record) {
+    if (strstr(body, "prev_pid=")) {
+        const char *state = find_key(body, "prev_state=");
+        if (!state || !parse_kv_task(body, "prev_comm=", "prev_pid=", "prev_prio=", &record->task) ||
+            !parse_kv_task(body, "next_comm=", "next_pid=", "next_prio=", &record->next)) {
+            return false;
+        }
+        record->prev_runnable = runnable_state(state);
+        return true;
+    }
+
+    const char *arrow = strstr(body, " ==> ");
+    const char *after = NULL;
+    if (!arrow || !parse_compact_task(body, arrow, &record->task, &after)) {
+        return false;
+    }
+    record->prev_runnable = runnable_state(skip_spaces(after));
+    const char *next = arrow + 5;
+    return parse_compact_task(next, next + strlen(next), &record->next, &after);
+}
+
+static bool parse_wakeup_body(const char *body, record_t *record) {
+    if (find_key(body, "pid=")) {
+        return parse_kv_task(body, "comm=", "pid=", "prio=", &record->task);
+    }
+    const char *after = NULL;
+    return parse_compact_task(body, body + strlen(body), &record->task, &after);
+}
+
+// "<task>-<pid> [cpu] <flags> <sec>.<frac>: <event>: <body>"; the flags
+// column is missing in older formats.
+static bool parse_record(const char *line, record_t *record) {
+    static const char *const kEvents[3] = {"sched_switch:", "sched_wakeup_new:", "sched_wakeup:"};
+    const char *event = NULL;
+    int which = 0;
+    for (; which < 3 && !event; which++) {
+        event = strstr(line, kEvents[which]);
+    }
+    if (!event || event == line) {
+        return false;
+    }
+    which--;
+    record->kind = (which == 0) ? RECORD_SWITCH : RECORD_WAKEUP;
+
+    const char *p = event - 1;
+    while (p > line && *p == ' ') {
+        p--;
+    }
+    if (*p != ':') {
+        return false;
+    }
+    const char *stamp_end = p;
+    while (p > line && ((p[-1] >= '0' && p[-1] <= '9') || p[-1] == '.')) {
+        p--;
+    }
+    const char *stamp = p;
+    long long seconds = 0;
+    long long fraction = 0;
+    long long scale = 1000000000LL;
+    bool in_fraction = false;
+    for (const char *q = stamp; q < stamp_end; q++) {
+        if (*q == '.') {
+            in_fraction = true;
+        } else if (!in_fraction) {
+            seconds = seconds * 10 + (*q - '0');
+        } else if (scale > 1) {
+            scale /= 10;
+            fraction += (*q - '0') * scale;
+        }
+    }
+    if (stamp == stamp_end || seconds > LLONG_MAX / 1000000000LL - 1) {
+        return false;
+    }
+    record->ns = seconds * 1000000000LL + fraction;
+
+    // The last "[digits]" before the timestamp is the CPU.
+    record->cpu = -1;
+    for (const char *q = stamp; q > line; q--) {
+        if (*q == ']') {
+            const char *open = q;
+            while (open > line && open[-1] >= '0' && open[-1] <= '9') {
+                open--;
+            }
+            if (open > line && open[-1] == '[' && open < q) {
+                (void)parse_int(open, &record->cpu);
+                break;
+            }
+        }
+    }
+
+    const char *body = event + strlen(kEvents[which]);
+    (void)memset(&record->task, 0, sizeof(record->task));
+    (void)memset(&record->next, 0, sizeof(record->next));
+    record->prev_runnable = false;
+    return (record->kind == RECORD_SWITCH) ? parse_switch_body(body, record) : parse_wakeup_body(body, record);
+}
+
+int ftrace_importer_feed(ftrace_importer_t *importer, const char *line, size_t length) {
+    if (!importer || (!line && length > 0)) {
+        return SCHED_ERR_ARGS;
+    }
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        length--;
+    }
+    char copy[FTRACE_MAX_LINE];
+    record_t record;
+    if (length == 0 || length >= sizeof(copy) || line[0] == '#') {
+        importer->ignored_lines++;
+        return SCHED_OK;
+    }
+    (void)memcpy(copy, line, length);
+    copy[length] = '\0';
+    if (!parse_record(copy, &record)) {
+        importer->ignored_lines++;
+        return SCHED_OK;
+    }
+
+    if (!importer->has_base) {
+        importer->has_base = true;
+        importer->base_ns = record.ns;
+    }
+    long long ticks = (record.ns - importer->base_ns) / importer->unit_ns;
+    if (ticks > INT_MAX) {
+        return SCHED_ERR_ARGS;
+    }
+    // Tolerate small reorderings between CPUs' buffers.
+    int tick = (ticks > importer->last_tick) ? (int)ticks : importer->last_tick;
+    importer->last_tick = tick;
+    importer->records++;
+
+    return (record.kind == RECORD_SWITCH) ? apply_switch(importer, &record, tick)
+                                          : apply_wakeup(importer, &record, tick);
+}
+
+static int compare_events(const void *lhs, const void *rhs) {
+    const timeline_event_t *a = (const timeline_event_t *)lhs;
+    const timeline_event_t *b = (const timeline_event_t *)rhs;
+    if (a->start_time != b->start_time) {
+        return (a->start_time > b->start_time) - (a->start_time < b->start_time);
+    }
+    if (a->end_time != b->end_time) {
+        return (a->end_time > b->end_time) - (a->end_time < b->end_time);
+    }
+    return (a->process_id > b->process_id) - (a->process_id < b->process_id);
+}
+
+void ftrace_import_result_free(ftrace_import_result_t *result) {
+    if (!result) {
+        return;
+    }
+    free(result->processes);
+    free(result->timeline);
+    (void)memset(result, 0, sizeof(*result));
+}
+
+int ftrace_importer_finish(ftrace_importer_t *importer, ftrace_import_result_t *result) {
+    if (!importer || !result) {
+        return SCHED_ERR_ARGS;
+    }
+    (void)memset(result, 0, sizeof(*result));
+
+    for (int i = 0; i < importer->task_count; i++) {
+        task_state_t *task = &importer->tasks[i];
+        if (task->job < 0) {
+            continue;
+        }
+        if (task->running_cpu >= 0) {
+            int status = add_segment(importer, task->job, task->since, importer->last_tick);
+            if (status != SCHED_OK) {
+                return status;
+            }
+            task->running_cpu = -1;
+        }
+        job_t *job = &importer->jobs[task->job];
+        if (job->burst > 0) {
+            job->completion = importer->segments[job->last_segment].end;
+            result->truncated++;
+        }
+        task->job = -1;
+    }
+
+    // Intervals that never held a CPU for a whole tick are dropped; the rest
+    // are renumbered 1..n in arrival order.
+    int *new_ids = (int *)malloc(((size_t)importer->job_count + 1U) * sizeof(int));
+    if (!new_ids) {
+        return SCHED_ERR_ALLOC;
+    }
+    int kept = 0;
+    for (int j = 0; j < importer->job_count; j++) {
+        const job_t *job = &importer->jobs[j];
+        new_ids[j] = (job->burst > 0 && job->completion >= 0) ? ++kept : 0;
+    }
+    result->dropped = importer->job_count - kept;
+
+    if (kept > 0) {
+        result->processes = (process_t *)calloc((size_t)kept, sizeof(process_t));
+        result->timeline = (timeline_event_t *)calloc((size_t)importer->segment_count, sizeof(timeline_event_t));
+        if (!result->processes || !result->timeline) {
+            free(new_ids);
+            ftrace_import_result_free(result);
+            return SCHED_ERR_ALLOC;
+        }
+    }
+
+    for (int j = 0; j < importer->job_count; j++) {
+        if (new_ids[j] == 0) {
+            continue;
+        }
+        const job_t *job = &importer->jobs[j];
+        process_t *p = &result->processes[new_ids[j] - 1];
+        p->process_id = new_ids[j];
+        (void)snprintf(p->name, sizeof(p->name), "%s:%d", job->comm, job->pid);
+        p->arrival_time = job->arrival;
+        p->burst_time = job->burst;
+        p->priority = job->priority;
+        p->remaining_time = 0;
+        p->completion_time = job->completion;
+        p->turnaround_time = job->completion - job->arrival;
+        p->waiting_time = p->turnaround_time - job->burst;
+        p->first_run_time = job->first_run;
+        p->response_time = job->first_run - job->arrival;
+    }
+    result->process_count = kept;
+
+    for (int s = 0; s < importer->segment_count; s++) {
+        const segment_t *segment = &importer->segments[s];
+        int id = new_ids[segment->job];
+        if (id == 0) {
+            continue;
+        }
+        timeline_event_t *event = &result->timeline[result->timeline_count++];
+        event->process_id = id;
+        safe_copy_string(event->process_name, sizeof(event->process_name), result->processes[id - 1].name);
+        event->start_time = segment->start;
+        event->end_time = segment->end;
+    }
+    if (result->timeline_count > 1) {
+        qsort(result->timeline, (size_t)result->timeline_count, sizeof(timeline_event_t), compare_events);
+    }
+    free(new_ids);
+
+    result->context_switches = importer->context_switches;
+    result->cpu_count = importer->cpu_count;
+    result->records = importer->records;
+    result->ignored_lines = importer->ignored_lines;
+    return SCHED_OK;
+}
+
+int ftrace_import_file(const char *path, const ftrace_import_config_t *config, ftrace_import_result_t *result) {
+    if (!path || !result) {
+        return SCHED_ERR_ARGS;
+    }
+    FILE *in = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    if (!in) {
+        return SCHED_ERR_ARGS;
+    }
+    ftrace_importer_t *importer = NULL;
+    int status = ftrace_importer_create(config, &importer);
+
+    char line[FTRACE_MAX_LINE];
+    bool continuation = false;  // inside an over-long line, which is ignored
+    while (status == SCHED_OK && fgets(line, sizeof(line), in)) {
+        size_t length = strlen(line);
+        bool complete = length > 0 && line[length - 1] == '\n';
+        if (!continuation && (complete || feof(in))) {
+            status = ftrace_importer_feed(importer, line, length);
+        } else if (!continuation) {
+            importer->ignored_lines++;
+        }
+        continuation = !complete;
+    }
+    if (status == SCHED_OK) {
+        status = ftrace_importer_finish(importer, result);
+    }
+
+    ftrace_importer_destroy(importer);
+    if (in != stdin) {
+        (void)fclose(in);
+    }
+    return status;
+}
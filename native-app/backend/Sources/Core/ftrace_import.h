@@ -0,0 +1,66 @@
+#ifndef FTRACE_IMPORT_H
+#define FTRACE_IMPORT_H
+
+#include "process_types.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Turns a kernel scheduling trace into a workload plus the schedule the
+// kernel actually ran. Input is the text of /sys/kernel/tracing/trace or of
+// `trace-cmd report`, fed one line at a time in the order printed; only
+// sched_wakeup, sched_wakeup_new and sched_switch records are used.
+//
+// Every runnable interval of a task becomes one process: it arrives when
+// the task is woken (or first seen on a CPU), its burst is the CPU time it
+// gets, and it completes when the task switches out without being runnable.
+// Times are rebased to the first record and counted in ticks of
+// time_unit_ns. Kernel priorities map onto 1-10: RT tasks get 1, normal
+// tasks spread nice -20..19 over 1..10.
+#define FTRACE_DEFAULT_TIME_UNIT_NS 1000
+
+typedef struct {
+    long long time_unit_ns;
+} ftrace_import_config_t;
+
+typedef struct {
+    // In arrival order, ids 1..process_count, named "comm:pid". The outcome
+    // fields hold what actually happened, so calculate_metrics on these
+    // processes scores the real schedule; the scheduler resets them.
+    process_t *processes;
+    int process_count;
+    timeline_event_t *timeline;  // observed on-CPU segments, by start time
+    int timeline_count;
+    int context_switches;        // per CPU, between different processes
+    int cpu_count;               // CPUs seen; segments of different CPUs may overlap
+    int truncated;               // still runnable when the trace ended; completed at their last run
+    int dropped;                 // intervals too short to last a tick on the CPU
+    long long records;           // scheduling records used
+    long long ignored_lines;
+} ftrace_import_result_t;
+
+typedef struct ftrace_importer ftrace_importer_t;
+
+int ftrace_importer_create(const ftrace_import_config_t *config, ftrace_importer_t **importer);
+void ftrace_importer_destroy(ftrace_importer_t *importer);
+
+// Lines that are not scheduling records (headers, other events) are counted
+// and ignored. Fails with SCHED_ERR_ARGS if the trace outlasts INT_MAX ticks.
+int ftrace_importer_feed(ftrace_importer_t *importer, const char *line, size_t length);
+
+// Closes the intervals still open and hands over the result; the importer
+// must not be fed afterwards. Free the result with ftrace_import_result_free.
+int ftrace_importer_finish(ftrace_importer_t *importer, ftrace_import_result_t *result);
+void ftrace_import_result_free(ftrace_import_result_t *result);
+
+// Reads a whole trace file ("-" for stdin) line by line.
+int ftrace_import_file(const char *path, const ftrace_import_config_t *config, ftrace_import_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FTRACE_IMPORT_H
@@ -1,7 +1,235 @@
 #include "metrics.h"
 
+#include "sched_internal.h"
+
+#include <math.h>
 #include <string.h>
 
+void distribution_accumulator_init(distribution_accumulator_t *acc) {
+    if (!acc) {
+        return;
+    }
+    acc->count = 0;
+    acc->mean = 0.0;
+    acc->m2 = 0.0;
+    acc->max = 0.0;
+    quantile_sketch_init(&acc->sketch);
+}
+
+void distribution_accumulator_free(distribution_accumulator_t *acc) {
+    if (!acc) {
+        return;
+    }
+    quantile_sketch_free(&acc->sketch);
+}
+
+int distribution_accumulator_copy(distribution_accumulator_t *dst, const distribution_accumulator_t *src) {
+    if (!dst || !src) {
+        return SCHED_ERR_ARGS;
+    }
+    *dst = *src;
+    return quantile_sketch_copy(&dst->sketch, &src->sketch);
+}
+
+void distribution_accumulator_add(distribution_accumulator_t *acc, double value) {
+    if (!acc) {
+        return;
+    }
+
+    acc->count++;
+    double delta = value - acc->mean;
+    acc->mean += delta / (double)acc->count;
+    acc->m2 += delta * (value - acc->mean);
+    if (acc->count == 1 || value > acc->max) {
+        acc->max = value;
+    }
+    quantile_sketch_add(&acc->sketch, value);
+}
+
+void distribution_accumulator_merge(distribution_accumulator_t *dst, const distribution_accumulator_t *src) {
+    if (!dst || !src || src->count == 0) {
+        return;
+    }
+
+    if (dst->count == 0) {
+        dst->count = src->count;
+        dst->mean = src->mean;
+        dst->m2 = src->m2;
+        dst->max = src->max;
+    } else {
+        double total = (double)(dst->count + src->count);
+        double delta = src->mean - dst->mean;
+        dst->mean += delta * ((double)src->count / total);
+        dst->m2 += src->m2 + delta * delta * ((double)dst->count * (double)src->count / total);
+        dst->count += src->count;
+        if (src->max > dst->max) {
+            dst->max = src->max;
+        }
+    }
+    quantile_sketch_merge(&dst->sketch, &src->sketch);
+}
+
+void distribution_accumulator_finish(const distribution_accumulator_t *acc, distribution_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    (void)memset(stats, 0, sizeof(*stats));
+    if (!acc || acc->count == 0) {
+        return;
+    }
+
+    stats->mean = acc->mean;
+    stats->stddev = sqrt(acc->m2 / (double)acc->count);
+    stats->p50 = quantile_sketch_quantile(&acc->sketch, 0.50);
+    stats->p95 = quantile_sketch_quantile(&acc->sketch, 0.95);
+    stats->p99 = quantile_sketch_quantile(&acc->sketch, 0.99);
+    stats->max = acc->max;
+}
+
+double bounded_slowdown(int turnaround_time, int burst_time) {
+    int denominator = (burst_time > METRICS_SLOWDOWN_THRESHOLD) ? burst_time : METRICS_SLOWDOWN_THRESHOLD;
+    double slowdown = (double)turnaround_time / (double)denominator;
+    return (slowdown < 1.0) ? 1.0 : slowdown;
+}
+
+void metrics_accumulator_init(metrics_accumulator_t *acc) {
+    if (!acc) {
+        return;
+    }
+    acc->count = 0;
+    acc->total_turnaround = 0.0;
+    acc->total_waiting = 0.0;
+    acc->total_response = 0.0;
+    acc->total_burst = 0;
+    acc->max_completion = 0;
+    acc->context_switches = 0;
+    acc->overhead_time = 0;
+    acc->last_process_id = 0;
+    acc->has_last_segment = false;
+    distribution_accumulator_init(&acc->waiting);
+    distribution_accumulator_init(&acc->response);
+    distribution_accumulator_init(&acc->turnaround);
+    distribution_accumulator_init(&acc->slowdown);
+}
+
+void metrics_accumulator_free(metrics_accumulator_t *acc) {
+    if (!acc) {
+        return;
+    }
+    distribution_accumulator_free(&acc->waiting);
+    distribution_accumulator_free(&acc->response);
+    distribution_accumulator_free(&acc->turnaround);
+    distribution_accumulator_free(&acc->slowdown);
+}
+
+// Deep copy; on failure dst holds nothing that needs freeing.
+int metrics_accumulator_copy(metrics_accumulator_t *dst, const metrics_accumulator_t *src) {
+    if (!dst || !src) {
+        return SCHED_ERR_ARGS;
+    }
+    *dst = *src;
+    distribution_accumulator_t *parts[] = {&dst->waiting, &dst->response, &dst->turnaround, &dst->slowdown};
+    const distribution_accumulator_t *sources[] = {&src->waiting, &src->response, &src->turnaround, &src->slowdown};
+    for (int i = 0; i < 4; i++) {
+        quantile_sketch_init(&parts[i]->sketch);
+    }
+    for (int i = 0; i < 4; i++) {
+        if (distribution_accumulator_copy(parts[i], sources[i]) != SCHED_OK) {
+            metrics_accumulator_free(dst);
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    return SCHED_OK;
+}
+
+void metrics_accumulator_add_process(metrics_accumulator_t *acc, const process_t *process) {
+    if (!acc || !process) {
+        return;
+    }
+
+    process_result_t outcome;
+    outcome.completion_time = process->completion_time;
+    outcome.turnaround_time = process->turnaround_time;
+    outcome.waiting_time = process->waiting_time;
+    outcome.response_time = process->response_time;
+    outcome.first_run_time = process->first_run_time;
+    metrics_accumulator_add_outcome(acc, &outcome, process->burst_time);
+}
+
+void metrics_accumulator_add_outcome(metrics_accumulator_t *acc, const process_result_t *outcome, int burst_time) {
+    if (!acc || !outcome) {
+        return;
+    }
+
+    int response_time = (outcome->response_time < 0) ? 0 : outcome->response_time;
+
+    acc->count++;
+    acc->total_turnaround += (double)outcome->turnaround_time;
+    acc->total_waiting += (double)outcome->waiting_time;
+    acc->total_response += (double)response_time;
+    acc->total_burst += burst_time;
+
+    if (outcome->completion_time > acc->max_completion) {
+        acc->max_completion = outcome->completion_time;
+    }
+
+    distribution_accumulator_add(&acc->waiting, (double)outcome->waiting_time);
+    distribution_accumulator_add(&acc->response, (double)response_time);
+    distribution_accumulator_add(&acc->turnaround, (double)outcome->turnaround_time);
+    distribution_accumulator_add(&acc->slowdown, bounded_slowdown(outcome->turnaround_time, burst_time));
+}
+
+// Mirrors count_context_switches: overhead segments are ignored and a switch
+// is any change of process between consecutive segments.
+void metrics_accumulator_add_segment(metrics_accumulator_t *acc, int process_id) {
+    if (!acc || process_id == TIMELINE_OVERHEAD_PROCESS_ID) {
+        return;
+    }
+    if (acc->has_last_segment && acc->last_process_id != process_id) {
+        acc->context_switches++;
+    }
+    acc->last_process_id = process_id;
+    acc->has_last_segment = true;
+}
+
+void metrics_accumulator_add_overhead(metrics_accumulator_t *acc, int duration) {
+    if (!acc || duration <= 0) {
+        return;
+    }
+    acc->overhead_time += duration;
+}
+
+void metrics_accumulator_finish(const metrics_accumulator_t *acc, metrics_t *metrics) {
+    if (!metrics) {
+        return;
+    }
+
+    (void)memset(metrics, 0, sizeof(*metrics));
+
+    if (!acc || acc->count <= 0) {
+        return;
+    }
+
+    double count = (double)acc->count;
+    metrics->avg_turnaround_time = acc->total_turnaround / count;
+    metrics->avg_waiting_time = acc->total_waiting / count;
+    metrics->avg_response_time = acc->total_response / count;
+
+    metrics->total_time = acc->max_completion;
+    if (acc->max_completion > 0) {
+        metrics->cpu_utilization = ((double)acc->total_burst / (double)acc->max_completion) * 100.0;
+        metrics->throughput = count / (double)acc->max_completion;
+    }
+
+    metrics->context_switches = (acc->context_switches < 0) ? 0 : acc->context_switches;
+    metrics->overhead_time = acc->overhead_time;
+
+    distribution_accumulator_finish(&acc->waiting, &metrics->waiting_stats);
+    distribution_accumulator_finish(&acc->response, &metrics->response_stats);
+    distribution_accumulator_finish(&acc->turnaround, &metrics->turnaround_stats);
+    distribution_accumulator_finish(&acc->slowdown, &metrics->slowdown_stats);
+}
+
 void calculate_metrics(
     const process_t *processes,
     int count,
@@ -18,32 +246,12 @@ void calculate_metrics(
         return;
     }
 
-    double total_turnaround = 0.0;
-    double total_waiting = 0.0;
-    double total_response = 0.0;
-    int total_burst = 0;
-    int max_completion = 0;
-
+    metrics_accumulator_t acc;
+    metrics_accumulator_init(&acc);
     for (int i = 0; i < count; i++) {
-        total_turnaround += (double)processes[i].turnaround_time;
-        total_waiting += (double)processes[i].waiting_time;
-        total_response += (double)((processes[i].response_time < 0) ? 0 : processes[i].response_time);
-        total_burst += processes[i].burst_time;
-
-        if (processes[i].completion_time > max_completion) {
-            max_completion = processes[i].completion_time;
-        }
+        metrics_accumulator_add_process(&acc, &processes[i]);
     }
-
-    metrics->avg_turnaround_time = total_turnaround / (double)count;
-    metrics->avg_waiting_time = total_waiting / (double)count;
-    metrics->avg_response_time = total_response / (double)count;
-
-    metrics->total_time = max_completion;
-    if (max_completion > 0) {
-        metrics->cpu_utilization = ((double)total_burst / (double)max_completion) * 100.0;
-        metrics->throughput = (double)count / (double)max_completion;
-    }
-
-    metrics->context_switches = (context_switches < 0) ? 0 : context_switches;
+    acc.context_switches = context_switches;
+    metrics_accumulator_finish(&acc, metrics);
+    metrics_accumulator_free(&acc);
 }
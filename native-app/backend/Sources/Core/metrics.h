@@ -2,11 +2,65 @@
 #define METRICS_H
 
 #include "process_types.h"
+#include "quantile_sketch.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Bursts shorter than this are treated as this long when computing bounded
+// slowdown, so very short jobs do not dominate the statistic.
+#define METRICS_SLOWDOWN_THRESHOLD 10
+
+// Streaming summary of one per-process quantity. Accumulators can be fed
+// while a run progresses and merged across independent runs; the quantile
+// sketch allocates on the first sample, so release them with _free.
+typedef struct {
+    long long count;
+    double mean;
+    double m2;
+    double max;
+    quantile_sketch_t sketch;
+} distribution_accumulator_t;
+
+void distribution_accumulator_init(distribution_accumulator_t *acc);
+void distribution_accumulator_free(distribution_accumulator_t *acc);
+int distribution_accumulator_copy(distribution_accumulator_t *dst, const distribution_accumulator_t *src);
+void distribution_accumulator_add(distribution_accumulator_t *acc, double value);
+void distribution_accumulator_merge(distribution_accumulator_t *dst, const distribution_accumulator_t *src);
+void distribution_accumulator_finish(const distribution_accumulator_t *acc, distribution_stats_t *stats);
+
+double bounded_slowdown(int turnaround_time, int burst_time);
+
+// Everything calculate_metrics needs, gathered while a policy runs: processes
+// are added as they complete and segments as they are emitted.
+typedef struct {
+    int count;
+    double total_turnaround;
+    double total_waiting;
+    double total_response;
+    long long total_burst;
+    int max_completion;
+    int context_switches;
+    int overhead_time;
+    int last_process_id;
+    bool has_last_segment;
+
+    distribution_accumulator_t waiting;
+    distribution_accumulator_t response;
+    distribution_accumulator_t turnaround;
+    distribution_accumulator_t slowdown;
+} metrics_accumulator_t;
+
+void metrics_accumulator_init(metrics_accumulator_t *acc);
+void metrics_accumulator_free(metrics_accumulator_t *acc);
+int metrics_accumulator_copy(metrics_accumulator_t *dst, const metrics_accumulator_t *src);
+void metrics_accumulator_add_process(metrics_accumulator_t *acc, const process_t *process);
+void metrics_accumulator_add_outcome(metrics_accumulator_t *acc, const process_result_t *outcome, int burst_time);
+void metrics_accumulator_add_segment(metrics_accumulator_t *acc, int process_id);
+void metrics_accumulator_add_overhead(metrics_accumulator_t *acc, int duration);
+void metrics_accumulator_finish(const metrics_accumulator_t *acc, metrics_t *metrics);
+
 void calculate_metrics(
     const process_t *processes,
     int count,
@@ -0,0 +1,358 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "monte_carlo.h"
+
+#include "sched_internal.h"
+#include "scheduler.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MONTE_CARLO_MAX_THREADS 64
+
+typedef struct {
+    double count;
+    double mean;
+    double m2;  // sum of squared deviations from the mean
+} running_stat_t;
+
+typedef struct {
+    const monte_carlo_config_t *config;
+    int block_count;
+    running_stat_t *stats;  // [block][policy][field]
+    double *wins;           // [block][policy]
+    atomic_int next_block;
+    atomic_int status;
+} monte_carlo_shared_t;
+
+static const size_t kStatsMemberOffsets[6] = {
+    offsetof(distribution_stats_t, mean),
+    offsetof(distribution_stats_t, stddev),
+    offsetof(distribution_stats_t, p50),
+    offsetof(distribution_stats_t, p95),
+    offsetof(distribution_stats_t, p99),
+    offsetof(distribution_stats_t, max),
+};
+
+const char *monte_carlo_field_name(monte_carlo_field_t field) {
+    static const char *const kScalarNames[MONTE_CARLO_WAITING_STATS] = {
+        "avg_turnaround_time", "avg_waiting_time", "avg_response_time",
+        "cpu_utilization", "throughput", "total_time",
+        "context_switches", "overhead_time",
+    };
+    static const char *const kStatsNames[4][6] = {
+        {"waiting_stats.mean", "waiting_stats.stddev", "waiting_stats.p50",
+         "waiting_stats.p95", "waiting_stats.p99", "waiting_stats.max"},
+        {"response_stats.mean", "response_stats.stddev", "response_stats.p50",
+         "response_stats.p95", "response_stats.p99", "response_stats.max"},
+        {"turnaround_stats.mean", "turnaround_stats.stddev", "turnaround_stats.p50",
+         "turnaround_stats.p95", "turnaround_stats.p99", "turnaround_stats.max"},
+        {"slowdown_stats.mean", "slowdown_stats.stddev", "slowdown_stats.p50",
+         "slowdown_stats.p95", "slowdown_stats.p99", "slowdown_stats.max"},
+    };
+    if ((int)field < 0 || field >= MONTE_CARLO_FIELD_COUNT) {
+        return "";
+    }
+    if (field < MONTE_CARLO_WAITING_STATS) {
+        return kScalarNames[field];
+    }
+    int index = field - MONTE_CARLO_WAITING_STATS;
+    return kStatsNames[index / 6][index % 6];
+}
+
+double monte_carlo_field_value(const metrics_t *metrics, monte_carlo_field_t field) {
+    if (!metrics) {
+        return 0.0;
+    }
+    switch (field) {
+        case MONTE_CARLO_AVG_TURNAROUND:
+            return metrics->avg_turnaround_time;
+        case MONTE_CARLO_AVG_WAITING:
+            return metrics->avg_waiting_time;
+        case MONTE_CARLO_AVG_RESPONSE:
+            return metrics->avg_response_time;
+        case MONTE_CARLO_CPU_UTILIZATION:
+            return metrics->cpu_utilization;
+        case MONTE_CARLO_THROUGHPUT:
+            return metrics->throughput;
+        case MONTE_CARLO_TOTAL_TIME:
+            return metrics->total_time;
+        case MONTE_CARLO_CONTEXT_SWITCHES:
+            return metrics->context_switches;
+        case MONTE_CARLO_OVERHEAD_TIME:
+            return metrics->overhead_time;
+        default:
+            break;
+    }
+    if ((int)field < MONTE_CARLO_WAITING_STATS || field >= MONTE_CARLO_FIELD_COUNT) {
+        return 0.0;
+    }
+
+    const distribution_stats_t *blocks[4] = {
+        &metrics->waiting_stats, &metrics->response_stats, &metrics->turnaround_stats, &metrics->slowdown_stats};
+    int index = field - MONTE_CARLO_WAITING_STATS;
+    const char *base = (const char *)blocks[index / 6];
+    double value;
+    (void)memcpy(&value, base + kStatsMemberOffsets[index % 6], sizeof(value));
+    return value;
+}
+
+bool monte_carlo_field_higher_is_better(monte_carlo_field_t field) {
+    return field == MONTE_CARLO_CPU_UTILIZATION || field == MONTE_CARLO_THROUGHPUT;
+}
+
+uint64_t monte_carlo_sample_seed(uint64_t master_seed, int sample) {
+    // splitmix64 finaliser over (seed, sample): neighbouring samples get
+    // unrelated generator streams.
+    uint64_t z = master_seed + 0x9E3779B97F4A7C15ULL * ((uint64_t)sample + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void monte_carlo_config_default(monte_carlo_config_t *config) {
+    if (!config) {
+        return;
+    }
+    (void)memset(config, 0, sizeof(*config));
+    workload_gen_config_default(&config->workload);
+    config->workload_size = 200;
+    config->sample_count = 1000;
+    config->confidence = 0.95;
+    config->objective = MONTE_CARLO_AVG_WAITING;
+}
+
+static void running_stat_add(running_stat_t *stat, double value) {
+    stat->count += 1.0;
+    double delta = value - stat->mean;
+    stat->mean += delta / stat->count;
+    stat->m2 += delta * (value - stat->mean);
+}
+
+// Chan et al. pairwise combination of two partial aggregates.
+static void running_stat_merge(running_stat_t *into, const running_stat_t *from) {
+    if (from->count == 0.0) {
+        return;
+    }
+    double count = into->count + from->count;
+    double delta = from->mean - into->mean;
+    into->mean += delta * from->count / count;
+    into->m2 += from->m2 + delta * delta * into->count * from->count / count;
+    into->count = count;
+}
+
+// Two-sided normal quantile by bisection on erfc; monotone and plenty fast
+// for a once-per-run call.
+static double normal_quantile(double confidence) {
+    double tail = 1.0 - confidence;
+    double low = 0.0;
+    double high = 40.0;
+    for (int i = 0; i < 200; i++) {
+        double mid = 0.5 * (low + high);
+        if (erfc(mid / sqrt(2.0)) > tail) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+static int run_block(const monte_carlo_config_t *config, int block, process_t *workload, process_t *scratch,
+                     running_stat_t *stats, double *wins) {
+    int first = block * MONTE_CARLO_BLOCK_SAMPLES;
+    int last = first + MONTE_CARLO_BLOCK_SAMPLES;
+    if (last > config->sample_count) {
+        last = config->sample_count;
+    }
+    size_t workload_bytes = (size_t)config->workload_size * sizeof(process_t);
+
+    for (int sample = first; sample < last; sample++) {
+        workload_gen_config_t spec = config->workload;
+        spec.seed = monte_carlo_sample_seed(config->workload.seed, sample);
+        workload_gen_t gen;
+        int status = workload_gen_init(&gen, &spec);
+        if (status == SCHED_OK) {
+            status = workload_gen_fill(&gen, workload, config->workload_size);
+        }
+        if (status != SCHED_OK) {
+            return status;
+        }
+
+        double objective[MONTE_CARLO_MAX_POLICIES];
+        for (int p = 0; p < config->policy_count; p++) {
+            metrics_t metrics;
+            (void)memcpy(scratch, workload, workload_bytes);
+            status = schedule_processes_metrics_only(scratch, config->workload_size, &config->policies[p], &metrics);
+            if (status != SCHED_OK) {
+                return status;
+            }
+            for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+                running_stat_add(&stats[p * MONTE_CARLO_FIELD_COUNT + f],
+                                 monte_carlo_field_value(&metrics, (monte_carlo_field_t)f));
+            }
+            objective[p] = monte_carlo_field_value(&metrics, config->objective);
+        }
+
+        // A non-finite objective never wins; a sample without a finite one
+        // has no winner.
+        bool higher = monte_carlo_field_higher_is_better(config->objective);
+        bool found = false;
+        double best = 0.0;
+        for (int p = 0; p < config->policy_count; p++) {
+            if (!isfinite(objective[p])) {
+                continue;
+            }
+            if (!found || (higher ? objective[p] > best : objective[p] < best)) {
+                best = objective[p];
+                found = true;
+            }
+        }
+        if (!found) {
+            continue;
+        }
+        int ties = 0;
+        for (int p = 0; p < config->policy_count; p++) {
+            ties += (objective[p] == best);
+        }
+        for (int p = 0; p < config->policy_count; p++) {
+            if (objective[p] == best) {
+                wins[p] += 1.0 / ties;
+            }
+        }
+    }
+    return SCHED_OK;
+}
+
+static void *monte_carlo_worker(void *arg) {
+    monte_carlo_shared_t *shared = (monte_carlo_shared_t *)arg;
+    const monte_carlo_config_t *config = shared->config;
+    size_t workload_bytes = (size_t)config->workload_size * sizeof(process_t);
+
+    // Scratch is per thread and reused for every sample the thread takes.
+    process_t *workload = (process_t *)calloc(1, workload_bytes);
+    process_t *scratch = (process_t *)malloc(workload_bytes);
+    if (!workload || !scratch) {
+        free(workload);
+        free(scratch);
+        int expected = SCHED_OK;
+        (void)atomic_compare_exchange_strong(&shared->status, &expected, SCHED_ERR_ALLOC);
+        return NULL;
+    }
+
+    while (atomic_load(&shared->status) == SCHED_OK) {
+        int block = atomic_fetch_add(&shared->next_block, 1);
+        if (block >= shared->block_count) {
+            break;
+        }
+        int status = run_block(config, block, workload, scratch,
+                               &shared->stats[(size_t)block * config->policy_count * MONTE_CARLO_FIELD_COUNT],
+                               &shared->wins[(size_t)block * config->policy_count]);
+        if (status != SCHED_OK) {
+            int expected = SCHED_OK;
+            (void)atomic_compare_exchange_strong(&shared->status, &expected, status);
+        }
+    }
+
+    free(scratch);
+    free(workload);
+    return NULL;
+}
+
+static int resolve_thread_count(int requested, int block_count) {
+    int threads = requested;
+    if (threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (int)online : 1;
+    }
+    if (threads > MONTE_CARLO_MAX_THREADS) {
+        threads = MONTE_CARLO_MAX_THREADS;
+    }
+    return (threads > block_count) ? block_count : threads;
+}
+
+int monte_carlo_run(const monte_carlo_config_t *config, monte_carlo_result_t *result) {
+    if (!config || !result || config->workload_size <= 0 || config->sample_count <= 0 ||
+        config->policy_count <= 0 || config->policy_count > MONTE_CARLO_MAX_POLICIES ||
+        !(config->confidence > 0.0 && config->confidence < 1.0) || (int)config->objective < 0 ||
+        config->objective >= MONTE_CARLO_FIELD_COUNT) {
+        return SCHED_ERR_ARGS;
+    }
+    workload_gen_t probe;
+    if (workload_gen_init(&probe, &config->workload) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+
+    monte_carlo_shared_t shared;
+    (void)memset(&shared, 0, sizeof(shared));
+    shared.config = config;
+    shared.block_count = (config->sample_count + MONTE_CARLO_BLOCK_SAMPLES - 1) / MONTE_CARLO_BLOCK_SAMPLES;
+    shared.stats = (running_stat_t *)calloc((size_t)shared.block_count * config->policy_count * MONTE_CARLO_FIELD_COUNT,
+                                            sizeof(running_stat_t));
+    shared.wins = (double *)calloc((size_t)shared.block_count * config->policy_count, sizeof(double));
+    if (!shared.stats || !shared.wins) {
+        free(shared.stats);
+        free(shared.wins);
+        return SCHED_ERR_ALLOC;
+    }
+    atomic_init(&shared.next_block, 0);
+    atomic_init(&shared.status, SCHED_OK);
+
+    int thread_count = resolve_thread_count(config->thread_count, shared.block_count);
+    pthread_t threads[MONTE_CARLO_MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < thread_count; t++) {
+        if (pthread_create(&threads[started], NULL, monte_carlo_worker, &shared) != 0) {
+            break;  // the remaining threads pick up the slack
+        }
+        started++;
+    }
+    (void)monte_carlo_worker(&shared);
+    for (int t = 0; t < started; t++) {
+        (void)pthread_join(threads[t], NULL);
+    }
+
+    int status = atomic_load(&shared.status);
+    if (status != SCHED_OK) {
+        free(shared.stats);
+        free(shared.wins);
+        return status;
+    }
+
+    // Blocks are merged in sample order, never in completion order.
+    (void)memset(result, 0, sizeof(*result));
+    result->sample_count = config->sample_count;
+    result->policy_count = config->policy_count;
+    double z = normal_quantile(config->confidence);
+    for (int p = 0; p < config->policy_count; p++) {
+        monte_carlo_policy_result_t *policy = &result->policies[p];
+        double wins = 0.0;
+        for (int b = 0; b < shared.block_count; b++) {
+            wins += shared.wins[(size_t)b * config->policy_count + p];
+        }
+        policy->win_rate = wins / config->sample_count;
+
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            running_stat_t total = {0.0, 0.0, 0.0};
+            for (int b = 0; b < shared.block_count; b++) {
+                size_t index = ((size_t)b * config->policy_count + p) * MONTE_CARLO_FIELD_COUNT + f;
+                running_stat_merge(&total, &shared.stats[index]);
+            }
+            double stddev = (total.count > 1.0) ? sqrt(total.m2 / (total.count - 1.0)) : 0.0;
+            double half_width = z * stddev / sqrt(total.count);
+            policy->fields[f].mean = total.mean;
+            policy->fields[f].stddev = stddev;
+            policy->fields[f].ci_low = total.mean - half_width;
+            policy->fields[f].ci_high = total.mean + half_width;
+        }
+    }
+
+    free(shared.stats);
+    free(shared.wins);
+    return SCHED_OK;
+}
@@ -0,0 +1,85 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include "process_types.h"
+#include "workload_gen.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Compares policies over a distribution of workloads rather than one: K
+// workloads are sampled from a generator spec, every policy runs on each, and
+// every metrics_t field is reduced to a mean with a confidence interval.
+// Samples are reduced in fixed-size blocks merged in sample order, so the
+// result is bit-for-bit the same for a given seed whatever the thread count.
+#define MONTE_CARLO_MAX_POLICIES 16
+#define MONTE_CARLO_BLOCK_SAMPLES 64
+
+// Every metrics_t field; distribution_stats_t members follow their block's
+// first index in declaration order (mean, stddev, p50, p95, p99, max).
+typedef enum {
+    MONTE_CARLO_AVG_TURNAROUND = 0,
+    MONTE_CARLO_AVG_WAITING,
+    MONTE_CARLO_AVG_RESPONSE,
+    MONTE_CARLO_CPU_UTILIZATION,
+    MONTE_CARLO_THROUGHPUT,
+    MONTE_CARLO_TOTAL_TIME,
+    MONTE_CARLO_CONTEXT_SWITCHES,
+    MONTE_CARLO_OVERHEAD_TIME,
+    MONTE_CARLO_WAITING_STATS,
+    MONTE_CARLO_RESPONSE_STATS = MONTE_CARLO_WAITING_STATS + 6,
+    MONTE_CARLO_TURNAROUND_STATS = MONTE_CARLO_RESPONSE_STATS + 6,
+    MONTE_CARLO_SLOWDOWN_STATS = MONTE_CARLO_TURNAROUND_STATS + 6,
+    MONTE_CARLO_FIELD_COUNT = MONTE_CARLO_SLOWDOWN_STATS + 6
+} monte_carlo_field_t;
+
+typedef struct {
+    workload_gen_config_t workload;  // workload.seed is the master seed
+    int workload_size;               // processes per sampled workload
+    int sample_count;                // K
+    schedule_config_t policies[MONTE_CARLO_MAX_POLICIES];
+    int policy_count;
+    int thread_count;                // 0 = one per online CPU
+    double confidence;               // two-sided level of the intervals, e.g. 0.95
+    monte_carlo_field_t objective;   // the field a sample's winner is chosen by
+} monte_carlo_config_t;
+
+typedef struct {
+    double mean;
+    double stddev;    // sample standard deviation across workloads
+    double ci_low;    // normal-approximation interval for the mean
+    double ci_high;
+} monte_carlo_estimate_t;
+
+typedef struct {
+    monte_carlo_estimate_t fields[MONTE_CARLO_FIELD_COUNT];
+    double win_rate;  // share of samples this policy was best on; ties are split, NaN/inf never wins
+} monte_carlo_policy_result_t;
+
+typedef struct {
+    int sample_count;
+    int policy_count;
+    monte_carlo_policy_result_t policies[MONTE_CARLO_MAX_POLICIES];
+} monte_carlo_result_t;
+
+// 1000 samples of 200 processes, average waiting time as the objective, 95%
+// intervals; the caller fills in the policies.
+void monte_carlo_config_default(monte_carlo_config_t *config);
+
+int monte_carlo_run(const monte_carlo_config_t *config, monte_carlo_result_t *result);
+
+// Generator seed of sample k, to rebuild a single sampled workload.
+uint64_t monte_carlo_sample_seed(uint64_t master_seed, int sample);
+
+const char *monte_carlo_field_name(monte_carlo_field_t field);
+double monte_carlo_field_value(const metrics_t *metrics, monte_carlo_field_t field);
+bool monte_carlo_field_higher_is_better(monte_carlo_field_t field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MONTE_CARLO_H
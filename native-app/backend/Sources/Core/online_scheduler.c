@@ -0,0 +1,701 @@
+#include "online_scheduler.h"
+
+#include "metrics.h"
+#include "ready_queue.h"
+#include "sched_internal.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Processes live in recycled slots; slot_seq keeps the submission order,
+// which stands in for the array index as the final tie-break (-1 once the
+// process has finished).
+struct online_scheduler {
+    schedule_config_t config;
+    sched_run_t run;           // run.inputs views the slot table
+    process_t *slots;
+    int slot_capacity;
+    int slot_count;            // slots handed out at least once
+    int *slot_seq;
+    int *free_slots;
+    int free_count;
+    int released_slot;         // finished slot still named by run.last_index, -1 if none
+    int next_seq;
+    int active_count;
+
+    ready_queue_t pending;     // submitted, not yet arrived; keyed by (arrival, id)
+    ready_queue_t ready;       // every policy but RR
+    int_queue_t rr_queue;
+
+    int clock;                 // decisions before this time are final
+    int now;                   // time of the last processed decision
+    int running;               // slot holding the CPU, -1 when idle
+    long long running_level;   // priority P with aging: level held since dispatch
+    int run_from;              // preemptive: remaining_time is exact as of this time
+    int segment_start;         // preemptive: start of the open segment
+    int slice_end;             // non-preemptive and RR: end of the committed slice
+    int slice;
+
+    process_t *completed;
+    int completed_count;
+    int completed_capacity;
+};
+
+static bool is_preemptive(const online_scheduler_t *sim) {
+    return sim->config.algorithm == ALGO_SRTF || sim->config.algorithm == ALGO_PRIORITY_P;
+}
+
+// Same keys as the batch policies: FCFS (arrival, id), SJF (burst, arrival, id),
+// SRTF (remaining, arrival, id), priority NP (key, arrival, id) and
+// priority P (key, remaining, arrival).
+static ready_entry_t ready_entry_for(const online_scheduler_t *sim, int slot, int ready_since) {
+    const process_t *proc = &sim->slots[slot];
+    ready_entry_t entry;
+    entry.tie2 = 0;
+
+    switch (sim->config.algorithm) {
+        case ALGO_SJF:
+            entry.key = proc->burst_time;
+            entry.tie1 = proc->arrival_time;
+            entry.tie2 = proc->process_id;
+            break;
+        case ALGO_SRTF:
+            entry.key = proc->remaining_time;
+            entry.tie1 = proc->arrival_time;
+            entry.tie2 = proc->process_id;
+            break;
+        case ALGO_PRIORITY_NP:
+            entry.key = sched_priority_key(&sim->run, slot, proc->arrival_time);
+            entry.tie1 = proc->arrival_time;
+            entry.tie2 = proc->process_id;
+            break;
+        case ALGO_PRIORITY_P:
+            entry.key = sched_priority_key(&sim->run, slot, ready_since);
+            entry.tie1 = proc->remaining_time;
+            entry.tie2 = proc->arrival_time;
+            break;
+        default:
+            entry.key = proc->arrival_time;
+            entry.tie1 = proc->process_id;
+            break;
+    }
+    entry.seq = sim->slot_seq[slot];
+    entry.index = slot;
+    return entry;
+}
+
+static int grow_slots(online_scheduler_t *sim) {
+    int new_capacity = sim->slot_capacity * 2;
+    if (new_capacity <= sim->slot_capacity) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    process_t *slots = (process_t *)realloc(sim->slots, (size_t)new_capacity * sizeof(process_t));
+    if (!slots) {
+        return SCHED_ERR_ALLOC;
+    }
+    sim->slots = slots;
+    sched_inputs_from_processes(&sim->run.inputs, slots);
+
+    int *slot_seq = (int *)realloc(sim->slot_seq, (size_t)new_capacity * sizeof(int));
+    if (!slot_seq) {
+        return SCHED_ERR_ALLOC;
+    }
+    sim->slot_seq = slot_seq;
+
+    int *free_slots = (int *)realloc(sim->free_slots, (size_t)new_capacity * sizeof(int));
+    if (!free_slots) {
+        return SCHED_ERR_ALLOC;
+    }
+    sim->free_slots = free_slots;
+
+    if (sim->run.last_run_end) {
+        int *last_run_end = (int *)realloc(sim->run.last_run_end, (size_t)new_capacity * sizeof(int));
+        if (!last_run_end) {
+            return SCHED_ERR_ALLOC;
+        }
+        sim->run.last_run_end = last_run_end;
+    }
+
+    sim->slot_capacity = new_capacity;
+    sim->run.count = new_capacity;
+    return SCHED_OK;
+}
+
+static int acquire_slot(online_scheduler_t *sim, int *slot) {
+    if (sim->free_count > 0) {
+        *slot = sim->free_slots[--sim->free_count];
+        return SCHED_OK;
+    }
+    if (sim->slot_count == sim->slot_capacity && grow_slots(sim) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    *slot = sim->slot_count++;
+    return SCHED_OK;
+}
+
+static void release_slot(online_scheduler_t *sim, int slot) {
+    sim->free_slots[sim->free_count++] = slot;
+}
+
+static int finish_process(online_scheduler_t *sim, int slot, int completion_time) {
+    if (sim->completed_count == sim->completed_capacity) {
+        int new_capacity = (sim->completed_capacity == 0) ? 16 : sim->completed_capacity * 2;
+        process_t *resized = (process_t *)realloc(sim->completed, (size_t)new_capacity * sizeof(process_t));
+        if (!resized) {
+            return SCHED_ERR_ALLOC;
+        }
+        sim->completed = resized;
+        sim->completed_capacity = new_capacity;
+    }
+
+    process_t *proc = &sim->slots[slot];
+    finalize_completed_process(proc, completion_time);
+    metrics_accumulator_add_process(&sim->run.metrics, proc);
+    sim->completed[sim->completed_count++] = *proc;
+    sim->slot_seq[slot] = -1;
+    sim->active_count--;
+
+    // The switch-cost check compares against last_index, so that slot must not
+    // be handed to a new process before the next dispatch.
+    if (slot == sim->run.last_index) {
+        sim->released_slot = slot;
+    } else {
+        release_slot(sim, slot);
+    }
+    return SCHED_OK;
+}
+
+static int admit_arrivals(online_scheduler_t *sim, int time) {
+    ready_entry_t entry;
+    while (ready_queue_peek(&sim->pending, &entry, NULL) && entry.key <= time) {
+        (void)ready_queue_pop(&sim->pending, &entry, NULL);
+        int slot = entry.index;
+        process_t *proc = &sim->slots[slot];
+
+        // FCFS completes empty processes in queue order; the others at arrival.
+        if (proc->burst_time == 0 && sim->config.algorithm != ALGO_FCFS) {
+            proc->first_run_time = proc->arrival_time;
+            proc->response_time = 0;
+            if (finish_process(sim, slot, proc->arrival_time) != SCHED_OK) {
+                return SCHED_ERR_ALLOC;
+            }
+            continue;
+        }
+
+        int result = (sim->config.algorithm == ALGO_RR)
+            ? int_queue_push(&sim->rr_queue, slot)
+            : ready_queue_push(&sim->ready, 0, ready_entry_for(sim, slot, proc->arrival_time));
+        if (result != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    return SCHED_OK;
+}
+
+static bool aged_preemption(const online_scheduler_t *sim) {
+    return sim->config.algorithm == ALGO_PRIORITY_P && sim->config.aging_interval > 0;
+}
+
+static bool has_ready(const online_scheduler_t *sim) {
+    if (sim->config.algorithm == ALGO_RR) {
+        return !int_queue_empty(&sim->rr_queue);
+    }
+    return sim->ready.size > 0;
+}
+
+static int dispatch(online_scheduler_t *sim) {
+    while (has_ready(sim)) {
+        int slot = -1;
+        if (sim->config.algorithm == ALGO_RR) {
+            (void)int_queue_pop(&sim->rr_queue, &slot);
+        } else {
+            ready_entry_t entry;
+            (void)ready_queue_pop(&sim->ready, &entry, NULL);
+            slot = entry.index;
+            if (aged_preemption(sim)) {
+                sim->running_level = sched_aged_level(&sim->run, entry.key, sim->now);
+            }
+        }
+
+        process_t *proc = &sim->slots[slot];
+        if (proc->burst_time == 0) {
+            proc->first_run_time = sim->now;
+            proc->response_time = sim->now - proc->arrival_time;
+            if (finish_process(sim, slot, sim->now) != SCHED_OK) {
+                return SCHED_ERR_ALLOC;
+            }
+            continue;
+        }
+
+        if (sched_run_charge_switch(&sim->run, slot, &sim->now) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        if (sim->released_slot >= 0) {
+            release_slot(sim, sim->released_slot);
+            sim->released_slot = -1;
+        }
+
+        if (proc->first_run_time < 0) {
+            proc->first_run_time = sim->now;
+            proc->response_time = sim->now - proc->arrival_time;
+        }
+        sim->running = slot;
+
+        if (is_preemptive(sim)) {
+            sim->run_from = sim->now;
+            sim->segment_start = sim->now;
+            return SCHED_OK;
+        }
+
+        int quantum = (sim->config.time_quantum <= 0) ? 1 : sim->config.time_quantum;
+        sim->slice = proc->remaining_time;
+        if (sim->config.algorithm == ALGO_RR && sim->slice > quantum) {
+            sim->slice = quantum;
+        }
+        sim->slice_end = sim->now + sim->slice;
+        return sched_run_add_segment(&sim->run, slot, sim->now, sim->slice_end);
+    }
+    return SCHED_OK;
+}
+
+// Time of the next decision, given what has been submitted so far.
+static int next_event_time(const online_scheduler_t *sim) {
+    ready_entry_t entry;
+    int next_arrival = ready_queue_peek(&sim->pending, &entry, NULL) ? (int)entry.key : INT_MAX;
+
+    if (sim->running < 0) {
+        return has_ready(sim) ? sim->now : next_arrival;
+    }
+    if (!is_preemptive(sim)) {
+        return sim->slice_end;
+    }
+
+    // The dispatched tick always runs; after that the running process only
+    // loses the CPU to an arrival or, with aging, to a waiting process that
+    // ages past the level it was dispatched at.
+    const process_t *proc = &sim->slots[sim->running];
+    int earliest = sim->run_from + 1;
+    long long next = (long long)sim->run_from + proc->remaining_time;
+    if (next_arrival != INT_MAX && next_arrival < next) {
+        next = (next_arrival > earliest) ? next_arrival : earliest;
+    }
+
+    if (aged_preemption(sim) && ready_queue_peek(&sim->ready, &entry, NULL)) {
+        long long crossover = entry.key - (sim->running_level - 1) * sim->config.aging_interval;
+        if (crossover < next) {
+            next = (crossover > earliest) ? crossover : earliest;
+        }
+    }
+    return (int)next;
+}
+
+static int process_event(online_scheduler_t *sim, int time) {
+    if (sim->running < 0) {
+        if (time > sim->now) {
+            sim->now = time;
+        }
+        if (admit_arrivals(sim, sim->now) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        return dispatch(sim);
+    }
+
+    int slot = sim->running;
+    process_t *proc = &sim->slots[slot];
+
+    if (!is_preemptive(sim)) {
+        sim->now = time;
+        // Arrivals during the slice queue ahead of a preempted RR process.
+        if (admit_arrivals(sim, sim->now) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        proc->remaining_time -= sim->slice;
+        sim->running = -1;
+        int result = (proc->remaining_time > 0)
+            ? int_queue_push(&sim->rr_queue, slot)
+            : finish_process(sim, slot, sim->now);
+        if (result != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        return dispatch(sim);
+    }
+
+    sim->now = time;
+    proc->remaining_time -= time - sim->run_from;
+    sim->run_from = time;
+    if (admit_arrivals(sim, sim->now) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    if (proc->remaining_time == 0) {
+        if (sched_run_add_segment(&sim->run, slot, sim->segment_start, sim->now) != SCHED_OK ||
+            finish_process(sim, slot, sim->now) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        sim->running = -1;
+        return dispatch(sim);
+    }
+
+    // A preempted process starts aging again from now.
+    ready_entry_t top;
+    ready_entry_t current = ready_entry_for(sim, slot, sim->now);
+    if (!ready_queue_peek(&sim->ready, &top, NULL)) {
+        return SCHED_OK;
+    }
+    bool preempt = aged_preemption(sim)
+        ? sched_aged_level(&sim->run, top.key, sim->now) < sim->running_level
+        : ready_entry_before(&top, &current);
+    if (!preempt) {
+        return SCHED_OK;
+    }
+
+    if (sched_run_add_segment(&sim->run, slot, sim->segment_start, sim->now) != SCHED_OK ||
+        ready_queue_push(&sim->ready, 0, current) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    sim->running = -1;
+    return dispatch(sim);
+}
+
+int online_scheduler_create(const schedule_config_t *config, online_scheduler_t **scheduler) {
+    if (!scheduler || sched_validate_config(config) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+    *scheduler = NULL;
+
+    online_scheduler_t *sim = (online_scheduler_t *)calloc(1, sizeof(online_scheduler_t));
+    if (!sim) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    sim->config = *config;
+    sim->slot_capacity = 16;
+    sim->released_slot = -1;
+    sim->running = -1;
+
+    sim->run.config = &sim->config;
+    sim->run.count = sim->slot_capacity;
+    sim->run.last_index = -1;
+    metrics_accumulator_init(&sim->run.metrics);
+
+    sim->slots = (process_t *)malloc((size_t)sim->slot_capacity * sizeof(process_t));
+    sim->slot_seq = (int *)malloc((size_t)sim->slot_capacity * sizeof(int));
+    sim->free_slots = (int *)malloc((size_t)sim->slot_capacity * sizeof(int));
+    if (config->cache_refill_penalty > 0) {
+        sim->run.last_run_end = (int *)malloc((size_t)sim->slot_capacity * sizeof(int));
+    }
+
+    if (!sim->slots || !sim->slot_seq || !sim->free_slots ||
+        (config->cache_refill_penalty > 0 && !sim->run.last_run_end) ||
+        timeline_builder_init(&sim->run.builder) != SCHED_OK ||
+        int_queue_init(&sim->rr_queue, 16) != SCHED_OK) {
+        online_scheduler_destroy(sim);
+        return SCHED_ERR_ALLOC;
+    }
+    sched_inputs_from_processes(&sim->run.inputs, sim->slots);
+    (void)ready_queue_init(&sim->pending, 1);
+    (void)ready_queue_init(&sim->ready, 1);
+
+    *scheduler = sim;
+    return SCHED_OK;
+}
+
+static void free_buffers(online_scheduler_t *sim) {
+    timeline_builder_free(&sim->run.builder);
+    metrics_accumulator_free(&sim->run.metrics);
+    int_queue_free(&sim->rr_queue);
+    ready_queue_free(&sim->pending);
+    ready_queue_free(&sim->ready);
+    free(sim->slots);
+    free(sim->run.last_run_end);
+    free(sim->slot_seq);
+    free(sim->free_slots);
+    free(sim->completed);
+}
+
+void online_scheduler_destroy(online_scheduler_t *scheduler) {
+    if (!scheduler) {
+        return;
+    }
+    free_buffers(scheduler);
+    free(scheduler);
+}
+
+static int copy_ints(int **dst, const int *src, int capacity, int count) {
+    *dst = (int *)malloc((size_t)capacity * sizeof(int));
+    if (!*dst) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(*dst, src, (size_t)count * sizeof(int));
+    return SCHED_OK;
+}
+
+// Copies only the live parts of each buffer, so a checkpoint costs about
+// as much as the active set.
+int online_scheduler_clone(const online_scheduler_t *scheduler, online_scheduler_t **copy) {
+    if (!scheduler || !copy) {
+        return SCHED_ERR_ARGS;
+    }
+    *copy = NULL;
+
+    online_scheduler_t *sim = (online_scheduler_t *)malloc(sizeof(online_scheduler_t));
+    if (!sim) {
+        return SCHED_ERR_ALLOC;
+    }
+    *sim = *scheduler;
+    sim->run.config = &sim->config;
+    sim->slots = NULL;
+    sim->run.last_run_end = NULL;
+    sim->slot_seq = NULL;
+    sim->free_slots = NULL;
+    sim->completed = NULL;
+    sim->completed_count = 0;
+    sim->completed_capacity = 0;
+    (void)memset(&sim->run.builder, 0, sizeof(sim->run.builder));
+    (void)memset(&sim->rr_queue, 0, sizeof(sim->rr_queue));
+    (void)memset(&sim->pending, 0, sizeof(sim->pending));
+    (void)memset(&sim->ready, 0, sizeof(sim->ready));
+    metrics_accumulator_init(&sim->run.metrics);
+
+    int capacity = scheduler->slot_capacity;
+    sim->slots = (process_t *)malloc((size_t)capacity * sizeof(process_t));
+    if (!sim->slots ||
+        copy_ints(&sim->slot_seq, scheduler->slot_seq, capacity, scheduler->slot_count) != SCHED_OK ||
+        copy_ints(&sim->free_slots, scheduler->free_slots, capacity, scheduler->free_count) != SCHED_OK ||
+        (scheduler->run.last_run_end &&
+         copy_ints(&sim->run.last_run_end, scheduler->run.last_run_end, capacity, scheduler->slot_count) != SCHED_OK) ||
+        timeline_builder_copy(&sim->run.builder, &scheduler->run.builder) != SCHED_OK ||
+        int_queue_copy(&sim->rr_queue, &scheduler->rr_queue) != SCHED_OK ||
+        ready_queue_copy(&sim->pending, &scheduler->pending) != SCHED_OK ||
+        ready_queue_copy(&sim->ready, &scheduler->ready) != SCHED_OK ||
+        metrics_accumulator_copy(&sim->run.metrics, &scheduler->run.metrics) != SCHED_OK) {
+        online_scheduler_destroy(sim);
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(sim->slots, scheduler->slots, (size_t)scheduler->slot_count * sizeof(process_t));
+    sched_inputs_from_processes(&sim->run.inputs, sim->slots);
+
+    if (scheduler->completed_count > 0) {
+        sim->completed = (process_t *)malloc((size_t)scheduler->completed_count * sizeof(process_t));
+        if (!sim->completed) {
+            online_scheduler_destroy(sim);
+            return SCHED_ERR_ALLOC;
+        }
+        (void)memcpy(sim->completed, scheduler->completed, (size_t)scheduler->completed_count * sizeof(process_t));
+        sim->completed_count = scheduler->completed_count;
+        sim->completed_capacity = scheduler->completed_count;
+    }
+
+    *copy = sim;
+    return SCHED_OK;
+}
+
+int online_scheduler_restore(online_scheduler_t *scheduler, const online_scheduler_t *checkpoint) {
+    if (!scheduler || !checkpoint) {
+        return SCHED_ERR_ARGS;
+    }
+
+    online_scheduler_t *copy = NULL;
+    if (online_scheduler_clone(checkpoint, &copy) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    free_buffers(scheduler);
+    *scheduler = *copy;
+    scheduler->run.config = &scheduler->config;
+    free(copy);
+    return SCHED_OK;
+}
+
+int online_scheduler_submit(online_scheduler_t *scheduler, const process_t *process) {
+    if (!scheduler || !process) {
+        return SCHED_ERR_ARGS;
+    }
+
+    process_t copy = *process;
+    initialize_process_runtime_fields(&copy, 1);
+    if (copy.arrival_time < scheduler->clock) {
+        return SCHED_ERR_ARGS;
+    }
+
+    int slot = -1;
+    if (acquire_slot(scheduler, &slot) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    scheduler->slots[slot] = copy;
+    scheduler->slot_seq[slot] = scheduler->next_seq;
+    if (scheduler->run.last_run_end) {
+        scheduler->run.last_run_end[slot] = -1;
+    }
+
+    ready_entry_t entry;
+    entry.key = copy.arrival_time;
+    entry.tie1 = copy.process_id;
+    entry.tie2 = 0;
+    entry.seq = scheduler->next_seq;
+    entry.index = slot;
+    if (ready_queue_push(&scheduler->pending, 0, entry) != SCHED_OK) {
+        release_slot(scheduler, slot);
+        return SCHED_ERR_ALLOC;
+    }
+
+    scheduler->next_seq++;
+    scheduler->active_count++;
+    return SCHED_OK;
+}
+
+int online_scheduler_advance_bounded(online_scheduler_t *scheduler, int time, int max_events, bool *reached) {
+    if (!scheduler || !reached || max_events <= 0 || time < scheduler->clock) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *reached = false;
+    for (int made = 0;; made++) {
+        int event_time = next_event_time(scheduler);
+        if (event_time >= time) {
+            break;
+        }
+        if (made == max_events) {
+            // Every decision before event_time is made, as after advance_to(event_time).
+            if (event_time > scheduler->clock) {
+                scheduler->clock = event_time;
+            }
+            return SCHED_OK;
+        }
+        if (process_event(scheduler, event_time) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+    }
+
+    scheduler->clock = time;
+    *reached = true;
+    return SCHED_OK;
+}
+
+int online_scheduler_advance_to(online_scheduler_t *scheduler, int time) {
+    bool reached = false;
+    return online_scheduler_advance_bounded(scheduler, time, INT_MAX, &reached);
+}
+
+// The builder merges a segment into the previous one when the same process
+// carries on at its end, so the trailing segment stays behind while that can
+// still happen: a decision at its end time is pending, or the open
+// preemptive segment starts there.
+static bool trailing_segment_open(const online_scheduler_t *sim) {
+    const timeline_builder_t *builder = &sim->run.builder;
+    if (builder->count == 0) {
+        return false;
+    }
+    int end_time = builder->events[builder->count - 1].end_time;
+    return end_time >= sim->clock ||
+           (sim->running >= 0 && is_preemptive(sim) && sim->segment_start == end_time);
+}
+
+int online_scheduler_drain_events(online_scheduler_t *scheduler, timeline_event_t **events, int *event_count) {
+    if (!scheduler || !events || !event_count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    timeline_builder_t *builder = &scheduler->run.builder;
+    int ready = builder->count - (trailing_segment_open(scheduler) ? 1 : 0);
+    *events = NULL;
+    *event_count = 0;
+    if (ready <= 0) {
+        return SCHED_OK;
+    }
+
+    timeline_event_t *out = (timeline_event_t *)malloc((size_t)ready * sizeof(timeline_event_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(out, builder->events, (size_t)ready * sizeof(timeline_event_t));
+    (void)memmove(builder->events, &builder->events[ready], (size_t)(builder->count - ready) * sizeof(timeline_event_t));
+    builder->count -= ready;
+
+    *events = out;
+    *event_count = ready;
+    return SCHED_OK;
+}
+
+int online_scheduler_drain_completed(online_scheduler_t *scheduler, process_t **processes, int *process_count) {
+    if (!scheduler || !processes || !process_count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *processes = NULL;
+    *process_count = 0;
+    if (scheduler->completed_count == 0) {
+        return SCHED_OK;
+    }
+
+    process_t *out = (process_t *)malloc((size_t)scheduler->completed_count * sizeof(process_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(out, scheduler->completed, (size_t)scheduler->completed_count * sizeof(process_t));
+    *processes = out;
+    *process_count = scheduler->completed_count;
+    scheduler->completed_count = 0;
+    return SCHED_OK;
+}
+
+int online_scheduler_metrics(const online_scheduler_t *scheduler, metrics_t *metrics) {
+    if (!scheduler || !metrics) {
+        return SCHED_ERR_ARGS;
+    }
+
+    metrics_accumulator_finish(&scheduler->run.metrics, metrics);
+    return SCHED_OK;
+}
+
+int online_scheduler_time(const online_scheduler_t *scheduler) {
+    return scheduler ? scheduler->clock : 0;
+}
+
+int online_scheduler_active_count(const online_scheduler_t *scheduler) {
+    return scheduler ? scheduler->active_count : 0;
+}
+
+int online_scheduler_active_processes(const online_scheduler_t *scheduler, process_t **processes, int *process_count) {
+    if (!scheduler || !processes || !process_count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *processes = NULL;
+    *process_count = 0;
+    if (scheduler->active_count == 0) {
+        return SCHED_OK;
+    }
+
+    process_t *out = (process_t *)malloc((size_t)scheduler->active_count * sizeof(process_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    int count = 0;
+    for (int slot = 0; slot < scheduler->slot_count; slot++) {
+        if (scheduler->slot_seq[slot] < 0) {
+            continue;
+        }
+
+        process_t proc = scheduler->slots[slot];
+        if (slot == scheduler->running) {
+            // Bring the running process' remaining time up to the clock.
+            int since = is_preemptive(scheduler) ? scheduler->run_from : scheduler->slice_end - scheduler->slice;
+            int elapsed = scheduler->clock - since;
+            if (elapsed > 0) {
+                proc.remaining_time -= elapsed;
+            }
+        }
+        out[count++] = proc;
+    }
+
+    *processes = out;
+    *process_count = count;
+    return SCHED_OK;
+}
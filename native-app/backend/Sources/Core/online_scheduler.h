@@ -0,0 +1,54 @@
+#ifndef ONLINE_SCHEDULER_H
+#define ONLINE_SCHEDULER_H
+
+#include "process_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Incremental simulator for a live feed of arrivals. Processes are submitted
+// as they become known and the clock only moves forward; memory follows the
+// active set (submitted, unfinished processes) plus anything not yet drained.
+// Fed the same processes, it produces the same schedule as the batch API.
+typedef struct online_scheduler online_scheduler_t;
+
+int online_scheduler_create(const schedule_config_t *config, online_scheduler_t **scheduler);
+void online_scheduler_destroy(online_scheduler_t *scheduler);
+
+// The process' arrival_time must not be earlier than the current clock.
+int online_scheduler_submit(online_scheduler_t *scheduler, const process_t *process);
+
+// Makes every scheduling decision that falls before `time`. Segments are
+// emitted once committed, so a non-preemptive slice may end after `time`.
+int online_scheduler_advance_to(online_scheduler_t *scheduler, int time);
+
+// advance_to in bounded steps: makes at most max_events of the decisions
+// before `time`. When some remain, *reached is false and the clock stops at
+// the next one, so a later call carries on from there.
+int online_scheduler_advance_bounded(online_scheduler_t *scheduler, int time, int max_events, bool *reached);
+
+// Hand over, and forget, the segments and finished processes produced since
+// the previous drain. Arrays are malloc'd (NULL when empty); free() them.
+// A segment that the same process may still extend is held back until final.
+int online_scheduler_drain_events(online_scheduler_t *scheduler, timeline_event_t **events, int *event_count);
+int online_scheduler_drain_completed(online_scheduler_t *scheduler, process_t **processes, int *process_count);
+
+// Metrics over every process finished so far.
+int online_scheduler_metrics(const online_scheduler_t *scheduler, metrics_t *metrics);
+int online_scheduler_time(const online_scheduler_t *scheduler);
+
+// Submitted, unfinished processes with remaining_time as of the clock.
+int online_scheduler_active_processes(const online_scheduler_t *scheduler, process_t **processes, int *process_count);
+
+// Deep copies of the whole simulator state. restore() overwrites the
+// scheduler with the checkpoint so the run can resume from there.
+int online_scheduler_clone(const online_scheduler_t *scheduler, online_scheduler_t **copy);
+int online_scheduler_restore(online_scheduler_t *scheduler, const online_scheduler_t *checkpoint);
+int online_scheduler_active_count(const online_scheduler_t *scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONLINE_SCHEDULER_H
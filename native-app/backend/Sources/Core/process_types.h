@@ -42,6 +42,32 @@ typedef struct {
     int first_run_time;   // -1 if process has not started yet
 } process_t;
 
+// Per-process outcome of a run over a read-only workload, in workload order.
+typedef struct {
+    int completion_time;
+    int turnaround_time;
+    int waiting_time;
+    int response_time;
+    int first_run_time;
+} process_result_t;
+
+// One phase of a process' execution. Bursts of all processes are stored packed in
+// a single array and addressed through per-process offsets.
+#define BURST_DEVICE_CPU (-1)
+
+typedef struct {
+    int duration;
+    int device;           // BURST_DEVICE_CPU, or the I/O device index [0, device_count)
+} burst_t;
+
+typedef struct {
+    const process_t *processes;
+    int process_count;
+    const burst_t *bursts;
+    const int *burst_offsets;  // process_count + 1 entries; process i owns [offsets[i], offsets[i + 1])
+    int device_count;
+} burst_workload_t;
+
 typedef struct {
     pid_t pid;
     char name[MAX_PROCESS_NAME];
@@ -54,6 +80,10 @@ typedef struct {
     char state[MAX_PROCESS_STATE_NAME];    // "running", "sleeping", ...
 } system_process_t;
 
+// Dispatch overhead appears in timelines as its own segment.
+#define TIMELINE_OVERHEAD_PROCESS_ID (-1)
+#define TIMELINE_OVERHEAD_NAME "Context Switch"
+
 typedef struct {
     int process_id;
     char process_name[MAX_PROCESS_NAME];
@@ -61,6 +91,15 @@ typedef struct {
     int end_time;
 } timeline_event_t;
 
+typedef struct {
+    double mean;
+    double stddev;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+} distribution_stats_t;
+
 typedef struct {
     double avg_turnaround_time;
     double avg_waiting_time;
@@ -69,6 +108,51 @@ typedef struct {
     double throughput;
     int total_time;
     int context_switches;
+    int overhead_time;     // time spent on context switches rather than process work
+
+    distribution_stats_t waiting_stats;
+    distribution_stats_t response_stats;
+    distribution_stats_t turnaround_stats;
+    distribution_stats_t slowdown_stats;  // bounded slowdown, see METRICS_SLOWDOWN_THRESHOLD
 } metrics_t;
 
+// Wall time of one run, split by phase. The sort of the arrival order is
+// reported on its own and is not part of the simulation phase.
+typedef enum {
+    SCHED_PHASE_SETUP = 0,     // validation and run-state allocation
+    SCHED_PHASE_SORT = 1,
+    SCHED_PHASE_SIMULATE = 2,  // the policy loop
+    SCHED_PHASE_TIMELINE = 3,  // copying out the timeline
+    SCHED_PHASE_METRICS = 4,
+    SCHED_PHASE_COUNT = 5
+} sched_phase_t;
+
+// Where one run of the batch scheduler spends its work. Counting is compiled
+// in with SCHED_ENABLE_STATS and only happens for runs that ask for it; when
+// compiled out every field stays zero and enabled is false.
+typedef struct {
+    bool enabled;
+    long long selection_scans;        // SJF/SRTF linear passes over the workload
+    long long selection_visits;       // processes looked at by those passes
+    long long selection_comparisons;  // ready candidates weighed against the best so far
+    long long queue_pushes;           // ready queue (heap or buckets) and round-robin FIFO
+    long long queue_pops;
+    long long segments_added;         // new timeline entries, dispatch overhead included
+    long long segments_merged;        // slices that extended the previous entry instead
+    long long allocations;            // fresh buffers
+    long long reallocations;          // buffers grown while running
+    long long idle_jumps;             // clock moved forward over an idle CPU
+    long long next_arrival_scans;     // linear find-next-arrival passes behind those jumps
+    double phase_seconds[SCHED_PHASE_COUNT];
+} sched_stats_t;
+
+typedef struct {
+    algorithm_type_t algorithm;
+    int time_quantum;
+    int switch_cost;           // fixed cost of every context switch
+    int cache_refill_penalty;  // extra cost when the incoming process' cache is cold
+    int cache_refill_window;   // off-CPU time after which the cache is fully cold (0 = always cold)
+    int aging_interval;        // priority policies: waiting time that gains one priority level (0 = off)
+} schedule_config_t;
+
 #endif // PROCESS_TYPES_H
@@ -0,0 +1,291 @@
+#include "quantile_sketch.h"
+
+#include "sched_internal.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SKETCH_PI 3.14159265358979323846
+#define SKETCH_MERGE_CAPACITY (QUANTILE_SKETCH_MAX_CENTROIDS + QUANTILE_SKETCH_EXACT_CAPACITY)
+
+struct quantile_sketch_storage {
+    double buffer[QUANTILE_SKETCH_EXACT_CAPACITY];
+    sketch_centroid_t centroids[QUANTILE_SKETCH_MAX_CENTROIDS];
+};
+
+static int compare_doubles(const void *lhs, const void *rhs) {
+    double a = *(const double *)lhs;
+    double b = *(const double *)rhs;
+    return (a > b) - (a < b);
+}
+
+static int compare_centroids(const void *lhs, const void *rhs) {
+    double a = ((const sketch_centroid_t *)lhs)->mean;
+    double b = ((const sketch_centroid_t *)rhs)->mean;
+    return (a > b) - (a < b);
+}
+
+// k1 scale function: centroids near q = 0 and q = 1 stay small.
+static double scale_k(double q) {
+    return (QUANTILE_SKETCH_COMPRESSION / (2.0 * SKETCH_PI)) * asin(2.0 * q - 1.0);
+}
+
+static double scale_q(double k) {
+    double limit = QUANTILE_SKETCH_COMPRESSION / 4.0;
+    if (k >= limit) {
+        return 1.0;
+    }
+    return (sin(k * 2.0 * SKETCH_PI / QUANTILE_SKETCH_COMPRESSION) + 1.0) / 2.0;
+}
+
+// Greedily folds sorted points into at most QUANTILE_SKETCH_MAX_CENTROIDS
+// centroids under the scale-function bound; returns how many were written.
+static int compress_points(sketch_centroid_t *points, int point_count, sketch_centroid_t *centroids) {
+    qsort(points, (size_t)point_count, sizeof(sketch_centroid_t), compare_centroids);
+
+    double total = 0.0;
+    for (int i = 0; i < point_count; i++) {
+        total += points[i].weight;
+    }
+
+    int out = 0;
+    double weight_so_far = 0.0;
+    double q_limit = scale_q(scale_k(0.0) + 1.0);
+    sketch_centroid_t current = points[0];
+
+    for (int i = 1; i < point_count; i++) {
+        double proposed = current.weight + points[i].weight;
+        bool fits = (weight_so_far + proposed) / total <= q_limit;
+        if (fits || out == QUANTILE_SKETCH_MAX_CENTROIDS - 1) {
+            current.mean += (points[i].mean - current.mean) * (points[i].weight / proposed);
+            current.weight = proposed;
+            continue;
+        }
+
+        centroids[out++] = current;
+        weight_so_far += current.weight;
+        q_limit = scale_q(scale_k(weight_so_far / total) + 1.0);
+        current = points[i];
+    }
+    centroids[out++] = current;
+    return out;
+}
+
+// Folds the buffered samples into the centroids, writing the result to
+// centroids (which may be the sketch's own).
+static int fold_buffer(const quantile_sketch_t *sketch, sketch_centroid_t *centroids) {
+    sketch_centroid_t points[SKETCH_MERGE_CAPACITY];
+    int point_count = 0;
+    for (int i = 0; i < sketch->centroid_count; i++) {
+        points[point_count++] = sketch->storage->centroids[i];
+    }
+    for (int i = 0; i < sketch->buffered; i++) {
+        points[point_count].mean = sketch->storage->buffer[i];
+        points[point_count].weight = 1.0;
+        point_count++;
+    }
+    return compress_points(points, point_count, centroids);
+}
+
+static void flush_buffer(quantile_sketch_t *sketch) {
+    if (sketch->buffered == 0) {
+        return;
+    }
+    sketch->centroid_count = fold_buffer(sketch, sketch->storage->centroids);
+    sketch->buffered = 0;
+    sketch->digest = true;
+}
+
+static bool ensure_storage(quantile_sketch_t *sketch) {
+    if (!sketch->storage) {
+        sketch->storage = (quantile_sketch_storage_t *)malloc(sizeof(quantile_sketch_storage_t));
+    }
+    return sketch->storage != NULL;
+}
+
+void quantile_sketch_init(quantile_sketch_t *sketch) {
+    if (!sketch) {
+        return;
+    }
+    sketch->storage = NULL;
+    sketch->buffered = 0;
+    sketch->digest = false;
+    sketch->centroid_count = 0;
+    sketch->count = 0;
+    sketch->min = 0.0;
+    sketch->max = 0.0;
+}
+
+void quantile_sketch_free(quantile_sketch_t *sketch) {
+    if (!sketch) {
+        return;
+    }
+    free(sketch->storage);
+    quantile_sketch_init(sketch);
+}
+
+int quantile_sketch_copy(quantile_sketch_t *dst, const quantile_sketch_t *src) {
+    if (!dst || !src) {
+        return SCHED_ERR_ARGS;
+    }
+    *dst = *src;
+    dst->storage = NULL;
+    if (!src->storage) {
+        return SCHED_OK;
+    }
+
+    dst->storage = (quantile_sketch_storage_t *)malloc(sizeof(quantile_sketch_storage_t));
+    if (!dst->storage) {
+        quantile_sketch_init(dst);
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(dst->storage->buffer, src->storage->buffer, (size_t)src->buffered * sizeof(double));
+    (void)memcpy(dst->storage->centroids, src->storage->centroids,
+                 (size_t)src->centroid_count * sizeof(sketch_centroid_t));
+    return SCHED_OK;
+}
+
+void quantile_sketch_add(quantile_sketch_t *sketch, double value) {
+    if (!sketch || isnan(value) || !ensure_storage(sketch)) {
+        return;
+    }
+
+    if (sketch->buffered == QUANTILE_SKETCH_EXACT_CAPACITY) {
+        flush_buffer(sketch);
+    }
+
+    if (sketch->count == 0 || value < sketch->min) {
+        sketch->min = value;
+    }
+    if (sketch->count == 0 || value > sketch->max) {
+        sketch->max = value;
+    }
+    sketch->storage->buffer[sketch->buffered++] = value;
+    sketch->count++;
+}
+
+void quantile_sketch_merge(quantile_sketch_t *dst, const quantile_sketch_t *src) {
+    if (!dst || !src || src->count == 0 || !ensure_storage(dst)) {
+        return;
+    }
+
+    if (dst->count == 0 || src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (dst->count == 0 || src->max > dst->max) {
+        dst->max = src->max;
+    }
+
+    if (!dst->digest && !src->digest && dst->buffered + src->buffered <= QUANTILE_SKETCH_EXACT_CAPACITY) {
+        (void)memcpy(&dst->storage->buffer[dst->buffered], src->storage->buffer,
+                     (size_t)src->buffered * sizeof(double));
+        dst->buffered += src->buffered;
+        dst->count += src->count;
+        return;
+    }
+
+    flush_buffer(dst);
+    if (src->centroid_count > 0) {
+        sketch_centroid_t points[SKETCH_MERGE_CAPACITY];
+        int point_count = 0;
+        for (int i = 0; i < dst->centroid_count; i++) {
+            points[point_count++] = dst->storage->centroids[i];
+        }
+        for (int i = 0; i < src->centroid_count; i++) {
+            points[point_count++] = src->storage->centroids[i];
+        }
+        dst->centroid_count = compress_points(points, point_count, dst->storage->centroids);
+        dst->digest = true;
+    }
+
+    // Replay the source's raw samples; min/max are already merged.
+    double min = dst->min;
+    double max = dst->max;
+    long long count = dst->count + src->count - src->buffered;
+    for (int i = 0; i < src->buffered; i++) {
+        quantile_sketch_add(dst, src->storage->buffer[i]);
+    }
+    dst->count = count + src->buffered;
+    dst->min = min;
+    dst->max = max;
+}
+
+static double exact_quantile(const quantile_sketch_t *sketch, double q) {
+    double sorted[QUANTILE_SKETCH_EXACT_CAPACITY];
+    (void)memcpy(sorted, sketch->storage->buffer, (size_t)sketch->buffered * sizeof(double));
+    qsort(sorted, (size_t)sketch->buffered, sizeof(double), compare_doubles);
+
+    long long rank = (long long)ceil(q * (double)sketch->buffered);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > sketch->buffered) {
+        rank = sketch->buffered;
+    }
+    return sorted[rank - 1];
+}
+
+static double digest_quantile(const quantile_sketch_t *sketch, const sketch_centroid_t *c, int n, double q) {
+    double total = (double)sketch->count;
+    double target = q * total;
+
+    if (n == 1) {
+        return c[0].mean;
+    }
+
+    // Each centroid's mass is treated as centred on its mean; interpolate
+    // between neighbouring centres and towards min/max at the ends.
+    double left_center = c[0].weight / 2.0;
+    if (target < left_center) {
+        return sketch->min + (c[0].mean - sketch->min) * (target / left_center);
+    }
+
+    double cumulative = 0.0;
+    for (int i = 0; i < n - 1; i++) {
+        double center = cumulative + c[i].weight / 2.0;
+        double next_center = cumulative + c[i].weight + c[i + 1].weight / 2.0;
+        if (target <= next_center) {
+            double span = next_center - center;
+            double t = (span > 0.0) ? (target - center) / span : 0.0;
+            return c[i].mean + (c[i + 1].mean - c[i].mean) * t;
+        }
+        cumulative += c[i].weight;
+    }
+
+    double last_center = total - c[n - 1].weight / 2.0;
+    double tail = total - last_center;
+    double t = (tail > 0.0) ? (target - last_center) / tail : 1.0;
+    if (t > 1.0) {
+        t = 1.0;
+    }
+    return c[n - 1].mean + (sketch->max - c[n - 1].mean) * t;
+}
+
+double quantile_sketch_quantile(const quantile_sketch_t *sketch, double q) {
+    if (!sketch || sketch->count == 0) {
+        return 0.0;
+    }
+    if (q <= 0.0) {
+        return sketch->min;
+    }
+    if (q >= 1.0) {
+        return sketch->max;
+    }
+
+    if (!sketch->digest) {
+        return exact_quantile(sketch, q);
+    }
+    if (sketch->buffered == 0) {
+        return digest_quantile(sketch, sketch->storage->centroids, sketch->centroid_count, q);
+    }
+
+    // Fold pending samples into a scratch digest so the sketch is untouched.
+    sketch_centroid_t centroids[QUANTILE_SKETCH_MAX_CENTROIDS];
+    int n = fold_buffer(sketch, centroids);
+    return digest_quantile(sketch, centroids, n, q);
+}
+
+bool quantile_sketch_is_exact(const quantile_sketch_t *sketch) {
+    return sketch && !sketch->digest;
+}
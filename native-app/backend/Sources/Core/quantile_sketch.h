@@ -0,0 +1,53 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bounded, mergeable quantile sketch. Up to QUANTILE_SKETCH_EXACT_CAPACITY
+// samples are kept verbatim and quantiles are exact; beyond that the sketch
+// switches to a merging t-digest whose accuracy is best in the tails. The
+// sample buffer and centroids are allocated on the first insert, so an empty
+// sketch is a few words; quantile_sketch_free releases them and
+// quantile_sketch_copy makes an independent copy.
+#define QUANTILE_SKETCH_EXACT_CAPACITY 512
+#define QUANTILE_SKETCH_MAX_CENTROIDS 256
+#define QUANTILE_SKETCH_COMPRESSION 100.0
+
+typedef struct {
+    double mean;
+    double weight;
+} sketch_centroid_t;
+
+typedef struct quantile_sketch_storage quantile_sketch_storage_t;
+
+typedef struct {
+    quantile_sketch_storage_t *storage;  // NULL until the first sample
+    int buffered;
+    bool digest;  // false while every sample is still held in the buffer
+    int centroid_count;
+    long long count;
+    double min;
+    double max;
+} quantile_sketch_t;
+
+void quantile_sketch_init(quantile_sketch_t *sketch);
+void quantile_sketch_free(quantile_sketch_t *sketch);
+int quantile_sketch_copy(quantile_sketch_t *dst, const quantile_sketch_t *src);
+// A sample the sketch cannot allocate storage for is dropped.
+void quantile_sketch_add(quantile_sketch_t *sketch, double value);
+void quantile_sketch_merge(quantile_sketch_t *dst, const quantile_sketch_t *src);
+
+// q in [0, 1]. Exact mode uses the nearest-rank definition. Returns 0 when
+// empty. Does not modify the sketch.
+double quantile_sketch_quantile(const quantile_sketch_t *sketch, double q);
+bool quantile_sketch_is_exact(const quantile_sketch_t *sketch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUANTILE_SKETCH_H
@@ -0,0 +1,211 @@
+#include "ready_queue.h"
+
+#include "sched_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool ready_entry_before(const ready_entry_t *lhs, const ready_entry_t *rhs) {
+    if (lhs->key != rhs->key) {
+        return lhs->key < rhs->key;
+    }
+    if (lhs->tie1 != rhs->tie1) {
+        return lhs->tie1 < rhs->tie1;
+    }
+    if (lhs->tie2 != rhs->tie2) {
+        return lhs->tie2 < rhs->tie2;
+    }
+    return lhs->seq < rhs->seq;
+}
+
+static int lowest_set_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while ((mask & 1U) == 0U) {
+        mask >>= 1U;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static int level_grow(ready_level_t *level) {
+    int new_capacity = (level->capacity == 0) ? 16 : level->capacity * 2;
+    if (new_capacity < 0) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    ready_entry_t *resized = (ready_entry_t *)realloc(level->items, (size_t)new_capacity * sizeof(ready_entry_t));
+    if (!resized) {
+        return SCHED_ERR_ALLOC;
+    }
+    // A full ring that wrapped continues past the old end.
+    int wrapped = level->head + level->size - level->capacity;
+    if (wrapped > 0) {
+        (void)memcpy(&resized[level->capacity], resized, (size_t)wrapped * sizeof(ready_entry_t));
+    }
+    level->items = resized;
+    level->capacity = new_capacity;
+    return SCHED_OK;
+}
+
+int ready_queue_init(ready_queue_t *queue, int level_count) {
+    if (!queue || level_count <= 0 || level_count > READY_QUEUE_MAX_LEVELS) {
+        return SCHED_ERR_ARGS;
+    }
+    (void)memset(queue, 0, sizeof(*queue));
+    queue->level_count = level_count;
+    return SCHED_OK;
+}
+
+int ready_queue_init_fifo(ready_queue_t *queue, int level_count) {
+    int result = ready_queue_init(queue, level_count);
+    if (result == SCHED_OK) {
+        queue->fifo = true;
+    }
+    return result;
+}
+
+void ready_queue_free(ready_queue_t *queue) {
+    if (!queue) {
+        return;
+    }
+    for (int i = 0; i < queue->level_count; i++) {
+        free(queue->levels[i].items);
+    }
+    (void)memset(queue, 0, sizeof(*queue));
+}
+
+// Initialises dst as an independent copy of src.
+int ready_queue_copy(ready_queue_t *dst, const ready_queue_t *src) {
+    if (!dst || !src) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *dst = *src;
+    for (int i = 0; i < src->level_count; i++) {
+        dst->levels[i].items = NULL;
+        dst->levels[i].head = 0;
+        dst->levels[i].capacity = 0;
+    }
+    for (int i = 0; i < src->level_count; i++) {
+        const ready_level_t *from = &src->levels[i];
+        ready_level_t *level = &dst->levels[i];
+        if (from->size == 0) {
+            continue;
+        }
+
+        level->items = (ready_entry_t *)malloc((size_t)from->size * sizeof(ready_entry_t));
+        if (!level->items) {
+            ready_queue_free(dst);
+            return SCHED_ERR_ALLOC;
+        }
+        // Unrolls a wrapped ring; heaps have head 0 and copy as they are.
+        int first = from->capacity - from->head;
+        if (first > from->size) {
+            first = from->size;
+        }
+        (void)memcpy(level->items, &from->items[from->head], (size_t)first * sizeof(ready_entry_t));
+        (void)memcpy(&level->items[first], from->items, (size_t)(from->size - first) * sizeof(ready_entry_t));
+        level->capacity = from->size;
+    }
+    return SCHED_OK;
+}
+
+int ready_queue_push(ready_queue_t *queue, int level, ready_entry_t entry) {
+    if (!queue || level < 0 || level >= queue->level_count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    ready_level_t *heap = &queue->levels[level];
+    if (heap->size == heap->capacity && level_grow(heap) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    if (queue->fifo) {
+        heap->items[(heap->head + heap->size++) % heap->capacity] = entry;
+        queue->occupied |= (1U << (unsigned)level);
+        queue->size++;
+        return SCHED_OK;
+    }
+
+    // Entries pushed in key order (e.g. arrivals) stop after one comparison.
+    int pos = heap->size++;
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!ready_entry_before(&entry, &heap->items[parent])) {
+            break;
+        }
+        heap->items[pos] = heap->items[parent];
+        pos = parent;
+    }
+    heap->items[pos] = entry;
+
+    queue->occupied |= (1U << (unsigned)level);
+    queue->size++;
+    return SCHED_OK;
+}
+
+bool ready_queue_peek(const ready_queue_t *queue, ready_entry_t *entry, int *level) {
+    if (!queue || queue->occupied == 0U) {
+        return false;
+    }
+
+    int best = lowest_set_bit(queue->occupied);
+    if (entry) {
+        *entry = queue->levels[best].items[queue->levels[best].head];
+    }
+    if (level) {
+        *level = best;
+    }
+    return true;
+}
+
+// Removes a heap's root.
+static void sift_down_root(ready_level_t *heap) {
+    ready_entry_t last = heap->items[--heap->size];
+    int pos = 0;
+    for (;;) {
+        int child = pos * 2 + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && ready_entry_before(&heap->items[child + 1], &heap->items[child])) {
+            child++;
+        }
+        if (!ready_entry_before(&heap->items[child], &last)) {
+            break;
+        }
+        heap->items[pos] = heap->items[child];
+        pos = child;
+    }
+    if (heap->size > 0) {
+        heap->items[pos] = last;
+    }
+}
+
+bool ready_queue_pop(ready_queue_t *queue, ready_entry_t *entry, int *level) {
+    int best = 0;
+    if (!ready_queue_peek(queue, entry, &best)) {
+        return false;
+    }
+
+    ready_level_t *heap = &queue->levels[best];
+    if (queue->fifo) {
+        heap->head = (heap->head + 1) % heap->capacity;
+        heap->size--;
+    } else {
+        sift_down_root(heap);
+    }
+    if (heap->size == 0) {
+        queue->occupied &= ~(1U << (unsigned)best);
+    }
+
+    queue->size--;
+    if (level) {
+        *level = best;
+    }
+    return true;
+}
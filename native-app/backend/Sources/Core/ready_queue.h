@@ -0,0 +1,60 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// process_t.priority is documented as 1-10.
+#define READY_QUEUE_MAX_LEVELS 10
+
+// Entries order by (key, tie1, tie2, seq); lower is dispatched first. index
+// is the caller's handle for the queued process.
+typedef struct {
+    long long key;
+    int tie1;
+    int tie2;
+    int seq;
+    int index;
+} ready_entry_t;
+
+typedef struct {
+    ready_entry_t *items;
+    int head;  // FIFO levels: ring start; always 0 for heaps
+    int size;
+    int capacity;
+} ready_level_t;
+
+// Bucket queue: one ordered level per priority plus an occupancy bitmask, so
+// finding the best non-empty level is a single count-trailing-zeros. With a
+// single level it degenerates to a plain binary heap, which callers use when
+// priorities do not fit the bucket range.
+//
+// Levels are binary heaps by default. ready_queue_init_fifo makes them FIFO
+// rings with O(1) push and pop instead, for callers that already push each
+// level in dispatch order; entry keys are then ignored within a level.
+typedef struct {
+    ready_level_t levels[READY_QUEUE_MAX_LEVELS];
+    int level_count;
+    bool fifo;
+    uint32_t occupied;
+    int size;
+} ready_queue_t;
+
+int ready_queue_init(ready_queue_t *queue, int level_count);
+int ready_queue_init_fifo(ready_queue_t *queue, int level_count);
+void ready_queue_free(ready_queue_t *queue);
+int ready_queue_copy(ready_queue_t *dst, const ready_queue_t *src);
+int ready_queue_push(ready_queue_t *queue, int level, ready_entry_t entry);
+bool ready_queue_peek(const ready_queue_t *queue, ready_entry_t *entry, int *level);
+bool ready_queue_pop(ready_queue_t *queue, ready_entry_t *entry, int *level);
+bool ready_entry_before(const ready_entry_t *lhs, const ready_entry_t *rhs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // READY_QUEUE_H
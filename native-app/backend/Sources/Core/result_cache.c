@@ -0,0 +1,436 @@
+#include "result_cache.h"
+
+#include "sched_internal.h"
+#include "scheduler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// xxHash64 primes and lane mixing.
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME_3 0x165667B19E3779F9ULL
+#define HASH_PRIME_4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME_5 0x27D4EB2F165667C5ULL
+
+typedef struct {
+    int algorithm;
+    int time_quantum;
+    int switch_cost;
+    int cache_refill_penalty;
+    int cache_refill_window;
+    int aging_interval;
+} canonical_config_t;
+
+typedef struct cache_entry {
+    uint64_t hash;
+    canonical_config_t config;
+    process_t *processes;  // results, inputs already clamped by the scheduler
+    int process_count;
+    timeline_event_t *timeline;
+    int timeline_count;
+    metrics_t metrics;
+    size_t bytes;
+    struct cache_entry *lru_prev;
+    struct cache_entry *lru_next;
+    struct cache_entry *bucket_next;
+} cache_entry_t;
+
+struct schedule_cache {
+    cache_entry_t **buckets;
+    int bucket_count;
+    cache_entry_t *lru_head;  // most recently used
+    cache_entry_t *lru_tail;
+    schedule_cache_stats_t stats;
+};
+
+static uint64_t rotate_left(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t hash_word(uint64_t hash, uint64_t word) {
+    uint64_t lane = rotate_left(word * HASH_PRIME_2, 31) * HASH_PRIME_1;
+    return rotate_left(hash ^ lane, 27) * HASH_PRIME_1 + HASH_PRIME_4;
+}
+
+static uint64_t hash_finish(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static uint64_t hash_pair(uint64_t hash, int first, int second) {
+    return hash_word(hash, ((uint64_t)(uint32_t)first << 32) | (uint32_t)second);
+}
+
+static size_t name_length(const char *name) {
+    size_t length = 0;
+    while (length < MAX_PROCESS_NAME - 1 && name[length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+// The clamping initialize_process_runtime_fields applies before every run.
+static void canonical_inputs(const process_t *process, int *arrival, int *burst, int *priority) {
+    *arrival = (process->arrival_time < 0) ? 0 : process->arrival_time;
+    *burst = (process->burst_time < 0) ? 0 : process->burst_time;
+    *priority = (process->priority <= 0) ? 1 : process->priority;
+}
+
+static canonical_config_t canonical_config(const schedule_config_t *config) {
+    canonical_config_t key;
+    (void)memset(&key, 0, sizeof(key));
+    key.algorithm = (int)config->algorithm;
+    key.switch_cost = config->switch_cost;
+    key.cache_refill_penalty = config->cache_refill_penalty;
+    if (config->cache_refill_penalty > 0) {
+        key.cache_refill_window = config->cache_refill_window;
+    }
+    if (config->algorithm == ALGO_RR) {
+        key.time_quantum = (config->time_quantum <= 0) ? 1 : config->time_quantum;
+    }
+    if (config->algorithm == ALGO_PRIORITY_NP || config->algorithm == ALGO_PRIORITY_P) {
+        key.aging_interval = config->aging_interval;
+    }
+    return key;
+}
+
+static uint64_t hash_key(const process_t *processes, int process_count, const canonical_config_t *config) {
+    uint64_t hash = HASH_PRIME_5 + (uint64_t)process_count;
+    hash = hash_pair(hash, config->algorithm, config->time_quantum);
+    hash = hash_pair(hash, config->switch_cost, config->cache_refill_penalty);
+    hash = hash_pair(hash, config->cache_refill_window, config->aging_interval);
+
+    for (int i = 0; i < process_count; i++) {
+        int arrival = 0;
+        int burst = 0;
+        int priority = 0;
+        canonical_inputs(&processes[i], &arrival, &burst, &priority);
+        hash = hash_pair(hash, processes[i].process_id, arrival);
+        hash = hash_pair(hash, burst, priority);
+
+        const char *name = processes[i].name;
+        size_t length = name_length(name);
+        for (size_t offset = 0; offset < length; offset += 8) {
+            uint64_t word = 0;
+            size_t chunk = (length - offset < 8) ? length - offset : 8;
+            (void)memcpy(&word, name + offset, chunk);
+            hash = hash_word(hash, word);
+        }
+        hash = hash_word(hash, (uint64_t)length);
+    }
+    return hash_finish(hash);
+}
+
+uint64_t schedule_workload_hash(const process_t *processes, int process_count, const schedule_config_t *config) {
+    if (!processes || process_count <= 0 || !config) {
+        return 0;
+    }
+    canonical_config_t key = canonical_config(config);
+    return hash_key(processes, process_count, &key);
+}
+
+static bool entry_matches(
+    const cache_entry_t *entry,
+    uint64_t hash,
+    const canonical_config_t *config,
+    const process_t *processes,
+    int process_count
+) {
+    if (entry->hash != hash || entry->process_count != process_count ||
+        memcmp(&entry->config, config, sizeof(*config)) != 0) {
+        return false;
+    }
+    for (int i = 0; i < process_count; i++) {
+        const process_t *cached = &entry->processes[i];
+        int arrival = 0;
+        int burst = 0;
+        int priority = 0;
+        canonical_inputs(&processes[i], &arrival, &burst, &priority);
+        size_t length = name_length(processes[i].name);
+        if (cached->process_id != processes[i].process_id || cached->arrival_time != arrival ||
+            cached->burst_time != burst || cached->priority != priority || name_length(cached->name) != length ||
+            memcmp(cached->name, processes[i].name, length) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void lru_unlink(schedule_cache_t *cache, cache_entry_t *entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void lru_push_front(schedule_cache_t *cache, cache_entry_t *entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+    cache->lru_head = entry;
+}
+
+static cache_entry_t **bucket_for(const schedule_cache_t *cache, uint64_t hash) {
+    return &cache->buckets[hash & (uint64_t)(cache->bucket_count - 1)];
+}
+
+static void entry_free(cache_entry_t *entry) {
+    free(entry->processes);
+    free(entry->timeline);
+    free(entry);
+}
+
+static void evict(schedule_cache_t *cache, cache_entry_t *entry) {
+    cache_entry_t **link = bucket_for(cache, entry->hash);
+    while (*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+    lru_unlink(cache, entry);
+
+    cache->stats.bytes -= entry->bytes;
+    cache->stats.entries--;
+    entry_free(entry);
+}
+
+static int grow_buckets(schedule_cache_t *cache) {
+    int new_count = cache->bucket_count * 2;
+    cache_entry_t **buckets = (cache_entry_t **)calloc((size_t)new_count, sizeof(cache_entry_t *));
+    if (!buckets) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    for (int b = 0; b < cache->bucket_count; b++) {
+        cache_entry_t *entry = cache->buckets[b];
+        while (entry) {
+            cache_entry_t *next = entry->bucket_next;
+            cache_entry_t **bucket = &buckets[entry->hash & (uint64_t)(new_count - 1)];
+            entry->bucket_next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = new_count;
+    return SCHED_OK;
+}
+
+int schedule_cache_create(size_t memory_budget, schedule_cache_t **cache) {
+    if (!cache || memory_budget == 0) {
+        return SCHED_ERR_ARGS;
+    }
+
+    schedule_cache_t *created = (schedule_cache_t *)calloc(1, sizeof(schedule_cache_t));
+    if (!created) {
+        return SCHED_ERR_ALLOC;
+    }
+    created->bucket_count = 64;
+    created->buckets = (cache_entry_t **)calloc((size_t)created->bucket_count, sizeof(cache_entry_t *));
+    if (!created->buckets) {
+        free(created);
+        return SCHED_ERR_ALLOC;
+    }
+    created->stats.budget = memory_budget;
+    *cache = created;
+    return SCHED_OK;
+}
+
+void schedule_cache_clear(schedule_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    while (cache->lru_tail) {
+        evict(cache, cache->lru_tail);
+    }
+}
+
+void schedule_cache_destroy(schedule_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    schedule_cache_clear(cache);
+    free(cache->buckets);
+    free(cache);
+}
+
+int schedule_cache_stats(const schedule_cache_t *cache, schedule_cache_stats_t *stats) {
+    if (!cache || !stats) {
+        return SCHED_ERR_ARGS;
+    }
+    *stats = cache->stats;
+    return SCHED_OK;
+}
+
+static int copy_timeline(const timeline_event_t *source, int count, timeline_event_t **copy) {
+    *copy = NULL;
+    if (count == 0) {
+        return SCHED_OK;
+    }
+    *copy = (timeline_event_t *)malloc((size_t)count * sizeof(timeline_event_t));
+    if (!*copy) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(*copy, source, (size_t)count * sizeof(timeline_event_t));
+    return SCHED_OK;
+}
+
+// Best effort: a result that cannot be stored is simply not cached.
+static void insert(
+    schedule_cache_t *cache,
+    uint64_t hash,
+    const canonical_config_t *config,
+    const process_t *processes,
+    int process_count,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const metrics_t *metrics
+) {
+    size_t bytes = sizeof(cache_entry_t) + (size_t)process_count * sizeof(process_t) +
+                   (size_t)timeline_count * sizeof(timeline_event_t);
+    if (bytes > cache->stats.budget) {
+        return;
+    }
+    if (cache->stats.entries >= cache->bucket_count && grow_buckets(cache) != SCHED_OK) {
+        return;
+    }
+
+    cache_entry_t *entry = (cache_entry_t *)calloc(1, sizeof(cache_entry_t));
+    if (!entry) {
+        return;
+    }
+    entry->processes = (process_t *)malloc((size_t)process_count * sizeof(process_t));
+    if (!entry->processes || copy_timeline(timeline, timeline_count, &entry->timeline) != SCHED_OK) {
+        entry_free(entry);
+        return;
+    }
+    (void)memcpy(entry->processes, processes, (size_t)process_count * sizeof(process_t));
+    entry->hash = hash;
+    entry->config = *config;
+    entry->process_count = process_count;
+    entry->timeline_count = timeline_count;
+    entry->metrics = *metrics;
+    entry->bytes = bytes;
+
+    while (cache->stats.bytes + bytes > cache->stats.budget) {
+        evict(cache, cache->lru_tail);
+        cache->stats.evictions++;
+    }
+
+    cache_entry_t **bucket = bucket_for(cache, hash);
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    lru_push_front(cache, entry);
+    cache->stats.bytes += bytes;
+    cache->stats.entries++;
+}
+
+static cache_entry_t *find(const schedule_cache_t *cache, uint64_t hash, const canonical_config_t *key, const process_t *processes, int process_count) {
+    for (cache_entry_t *entry = *bucket_for(cache, hash); entry; entry = entry->bucket_next) {
+        if (entry_matches(entry, hash, key, processes, process_count)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+int schedule_cache_lookup(
+    schedule_cache_t *cache,
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics,
+    bool *hit
+) {
+    if (!cache || !processes || process_count <= 0 || !timeline || !timeline_count || !metrics || !hit ||
+        sched_validate_config(config) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+    *hit = false;
+
+    canonical_config_t key = canonical_config(config);
+    uint64_t hash = hash_key(processes, process_count, &key);
+    cache_entry_t *entry = find(cache, hash, &key, processes, process_count);
+    if (!entry) {
+        cache->stats.misses++;
+        return SCHED_OK;
+    }
+
+    int status = copy_timeline(entry->timeline, entry->timeline_count, timeline);
+    if (status != SCHED_OK) {
+        return status;
+    }
+    *timeline_count = entry->timeline_count;
+    (void)memcpy(processes, entry->processes, (size_t)process_count * sizeof(process_t));
+    *metrics = entry->metrics;
+
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache->stats.hits++;
+    *hit = true;
+    return SCHED_OK;
+}
+
+int schedule_cache_insert(
+    schedule_cache_t *cache,
+    const process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const metrics_t *metrics
+) {
+    if (!cache || !processes || process_count <= 0 || timeline_count < 0 || (timeline_count > 0 && !timeline) ||
+        !metrics || sched_validate_config(config) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+
+    // Clamping is idempotent, so the scheduled processes hash like their inputs.
+    canonical_config_t key = canonical_config(config);
+    uint64_t hash = hash_key(processes, process_count, &key);
+    if (!find(cache, hash, &key, processes, process_count)) {
+        insert(cache, hash, &key, processes, process_count, timeline, timeline_count, metrics);
+    }
+    return SCHED_OK;
+}
+
+int schedule_cache_run(
+    schedule_cache_t *cache,
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    bool hit = false;
+    int status = schedule_cache_lookup(cache, processes, process_count, config, timeline, timeline_count, metrics, &hit);
+    if (status != SCHED_OK || hit) {
+        return status;
+    }
+
+    status = schedule_processes_with_config(processes, process_count, config, timeline, timeline_count, metrics);
+    if (status == SCHED_OK) {
+        (void)schedule_cache_insert(cache, processes, process_count, config, *timeline, *timeline_count, metrics);
+    }
+    return status;
+}
@@ -0,0 +1,78 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "process_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bounded LRU cache of whole scheduling results, keyed by a hash of the
+// canonicalised workload and configuration: process inputs after the same
+// clamping the scheduler applies, and only the config fields the policy reads.
+// Lookups are O(1); the least recently used results are evicted once the
+// cached processes and timelines exceed the memory budget.
+typedef struct schedule_cache schedule_cache_t;
+
+typedef struct {
+    long long hits;
+    long long misses;
+    long long evictions;
+    size_t bytes;
+    size_t budget;
+    int entries;
+} schedule_cache_stats_t;
+
+int schedule_cache_create(size_t memory_budget, schedule_cache_t **cache);
+void schedule_cache_destroy(schedule_cache_t *cache);
+void schedule_cache_clear(schedule_cache_t *cache);
+int schedule_cache_stats(const schedule_cache_t *cache, schedule_cache_stats_t *stats);
+
+// Drop-in for schedule_processes_with_config. On a hit the processes' result
+// fields, the timeline (a fresh malloc'd copy) and the metrics come from the
+// cache. Results larger than the whole budget are returned but not kept.
+int schedule_cache_run(
+    schedule_cache_t *cache,
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+);
+
+// The two halves of schedule_cache_run, for callers that lock the cache but
+// must not hold the lock while scheduling. A miss leaves every output as it
+// was and sets *hit false. Inserting a result that is already cached (another
+// caller got there first) is a no-op; processes must be the scheduled ones.
+int schedule_cache_lookup(
+    schedule_cache_t *cache,
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics,
+    bool *hit
+);
+int schedule_cache_insert(
+    schedule_cache_t *cache,
+    const process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const metrics_t *metrics
+);
+
+uint64_t schedule_workload_hash(const process_t *processes, int process_count, const schedule_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,498 @@
+#include "sched_internal.h"
+
+#include "utils.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+void sched_inputs_from_processes(sched_inputs_t *inputs, const process_t *processes) {
+    (void)memset(inputs, 0, sizeof(*inputs));
+    inputs->ids = (const char *)&processes->process_id;
+    inputs->arrivals = (const char *)&processes->arrival_time;
+    inputs->bursts = (const char *)&processes->burst_time;
+    inputs->priorities = (const char *)&processes->priority;
+    inputs->stride = sizeof(process_t);
+    inputs->names = processes->name;
+}
+
+int timeline_builder_init(timeline_builder_t *builder) {
+    if (!builder) {
+        return SCHED_ERR_ARGS;
+    }
+    builder->capacity = 64;
+    builder->count = 0;
+    builder->events = (timeline_event_t *)calloc((size_t)builder->capacity, sizeof(timeline_event_t));
+    return builder->events ? SCHED_OK : SCHED_ERR_ALLOC;
+}
+
+void timeline_builder_free(timeline_builder_t *builder) {
+    if (!builder) {
+        return;
+    }
+    free(builder->events);
+    builder->events = NULL;
+    builder->count = 0;
+    builder->capacity = 0;
+}
+
+static int timeline_builder_grow(timeline_builder_t *builder) {
+    int new_capacity = builder->capacity * 2;
+    if (new_capacity < 0) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    timeline_event_t *resized = (timeline_event_t *)realloc(builder->events, (size_t)new_capacity * sizeof(timeline_event_t));
+    if (!resized) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    builder->events = resized;
+    builder->capacity = new_capacity;
+    return SCHED_OK;
+}
+
+int timeline_builder_copy(timeline_builder_t *dst, const timeline_builder_t *src) {
+    if (!src) {
+        return SCHED_ERR_ARGS;
+    }
+    return timeline_builder_copy_prefix(dst, src, src->count);
+}
+
+// Initialises dst with the first count segments of src in one block copy.
+int timeline_builder_copy_prefix(timeline_builder_t *dst, const timeline_builder_t *src, int count) {
+    if (!dst || !src || count < 0 || count > src->count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    dst->capacity = (count < 64) ? 64 : count;
+    dst->count = count;
+    dst->events = (timeline_event_t *)malloc((size_t)dst->capacity * sizeof(timeline_event_t));
+    if (!dst->events) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(dst->events, src->events, (size_t)count * sizeof(timeline_event_t));
+    return SCHED_OK;
+}
+
+int timeline_builder_add(
+    timeline_builder_t *builder,
+    int process_id,
+    const char *process_name,
+    int start_time,
+    int end_time
+) {
+    if (!builder || !builder->events || !process_name || end_time <= start_time) {
+        return SCHED_ERR_ARGS;
+    }
+
+    // Merge adjacent segments for the same process to avoid fake context switches.
+    if (builder->count > 0) {
+        timeline_event_t *last = &builder->events[builder->count - 1];
+        if (last->process_id == process_id && last->end_time == start_time) {
+            last->end_time = end_time;
+            return SCHED_OK;
+        }
+    }
+
+    if (builder->count == builder->capacity) {
+        int grow_result = timeline_builder_grow(builder);
+        if (grow_result != SCHED_OK) {
+            return grow_result;
+        }
+    }
+
+    timeline_event_t *event = &builder->events[builder->count++];
+    event->process_id = process_id;
+    safe_copy_string(event->process_name, sizeof(event->process_name), process_name);
+    event->start_time = start_time;
+    event->end_time = end_time;
+    return SCHED_OK;
+}
+
+void flat_segment_builder_free(flat_segment_builder_t *builder) {
+    if (!builder) {
+        return;
+    }
+    free(builder->items);
+    (void)memset(builder, 0, sizeof(*builder));
+}
+
+// Merges adjacent segments of the same process, like timeline_builder_add.
+int flat_segment_builder_add(flat_segment_builder_t *builder, int process_index, int start_time, int end_time) {
+    if (!builder || end_time <= start_time) {
+        return SCHED_ERR_ARGS;
+    }
+
+    if (builder->count > 0) {
+        flat_segment_t *last = &builder->items[builder->count - 1];
+        if (last->process_index == process_index && last->end_time == start_time) {
+            last->end_time = end_time;
+            return SCHED_OK;
+        }
+    }
+
+    if (builder->count == builder->capacity) {
+        int new_capacity = (builder->capacity == 0) ? 64 : builder->capacity * 2;
+        flat_segment_t *resized = (flat_segment_t *)realloc(builder->items, (size_t)new_capacity * sizeof(flat_segment_t));
+        if (!resized) {
+            return SCHED_ERR_ALLOC;
+        }
+        builder->items = resized;
+        builder->capacity = new_capacity;
+    }
+
+    flat_segment_t *segment = &builder->items[builder->count++];
+    segment->process_index = process_index;
+    segment->start_time = start_time;
+    segment->end_time = end_time;
+    return SCHED_OK;
+}
+
+int int_queue_init(int_queue_t *queue, int initial_capacity) {
+    if (!queue || initial_capacity <= 0) {
+        return SCHED_ERR_ARGS;
+    }
+    queue->items = (int *)malloc((size_t)initial_capacity * sizeof(int));
+    if (!queue->items) {
+        return SCHED_ERR_ALLOC;
+    }
+    queue->head = 0;
+    queue->tail = 0;
+    queue->size = 0;
+    queue->capacity = initial_capacity;
+    return SCHED_OK;
+}
+
+void int_queue_free(int_queue_t *queue) {
+    if (!queue) {
+        return;
+    }
+    free(queue->items);
+    queue->items = NULL;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->size = 0;
+    queue->capacity = 0;
+}
+
+static int int_queue_grow(int_queue_t *queue) {
+    int new_capacity = queue->capacity * 2;
+    int *new_items = (int *)malloc((size_t)new_capacity * sizeof(int));
+    if (!new_items) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    for (int i = 0; i < queue->size; i++) {
+        new_items[i] = queue->items[(queue->head + i) % queue->capacity];
+    }
+
+    free(queue->items);
+    queue->items = new_items;
+    queue->capacity = new_capacity;
+    queue->head = 0;
+    queue->tail = queue->size;
+    return SCHED_OK;
+}
+
+int int_queue_push(int_queue_t *queue, int value) {
+    if (!queue || !queue->items) {
+        return SCHED_ERR_ARGS;
+    }
+    if (queue->size == queue->capacity) {
+        int grow_result = int_queue_grow(queue);
+        if (grow_result != SCHED_OK) {
+            return grow_result;
+        }
+    }
+
+    queue->items[queue->tail] = value;
+    queue->tail = (queue->tail + 1) % queue->capacity;
+    queue->size++;
+    return SCHED_OK;
+}
+
+int int_queue_pop(int_queue_t *queue, int *value) {
+    if (!queue || !value || queue->size == 0) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *value = queue->items[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->size--;
+    return SCHED_OK;
+}
+
+// Copies src's contents, oldest first, into a freshly initialised dst.
+int int_queue_copy(int_queue_t *dst, const int_queue_t *src) {
+    if (!dst || !src) {
+        return SCHED_ERR_ARGS;
+    }
+
+    int capacity = (src->size < 16) ? 16 : src->size;
+    if (int_queue_init(dst, capacity) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < src->size; i++) {
+        dst->items[i] = src->items[(src->head + i) % src->capacity];
+    }
+    dst->size = src->size;
+    dst->tail = src->size % capacity;
+    return SCHED_OK;
+}
+
+int int_queue_empty(const int_queue_t *queue) {
+    return (!queue || queue->size == 0);
+}
+
+void finalize_completed_process(process_t *proc, int completion_time) {
+    proc->remaining_time = 0;
+    proc->completion_time = completion_time;
+    proc->turnaround_time = completion_time - proc->arrival_time;
+    proc->waiting_time = proc->turnaround_time - proc->burst_time;
+    if (proc->waiting_time < 0) {
+        proc->waiting_time = 0;
+    }
+    if (proc->response_time < 0) {
+        proc->response_time = 0;
+    }
+}
+
+int count_context_switches(const timeline_event_t *timeline, int timeline_count) {
+    if (!timeline || timeline_count <= 1) {
+        return 0;
+    }
+
+    int switches = 0;
+    int previous = -1;
+    for (int i = 0; i < timeline_count; i++) {
+        if (timeline[i].process_id == TIMELINE_OVERHEAD_PROCESS_ID) {
+            continue;
+        }
+        if (previous >= 0 && timeline[i].process_id != timeline[previous].process_id) {
+            switches++;
+        }
+        previous = i;
+    }
+    return switches;
+}
+
+int build_and_return_timeline(
+    timeline_builder_t *builder,
+    timeline_event_t **timeline,
+    int *timeline_count
+) {
+    if (!builder || !timeline || !timeline_count) {
+        return SCHED_ERR_ARGS;
+    }
+
+    if (builder->count == 0) {
+        *timeline = NULL;
+        *timeline_count = 0;
+        return SCHED_OK;
+    }
+
+    timeline_event_t *out = (timeline_event_t *)malloc((size_t)builder->count * sizeof(timeline_event_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    (void)memcpy(out, builder->events, (size_t)builder->count * sizeof(timeline_event_t));
+    *timeline = out;
+    *timeline_count = builder->count;
+    return SCHED_OK;
+}
+
+#ifdef SCHED_ENABLE_STATS
+typedef struct {
+    int timeline_capacity;
+    int flat_capacity;
+} run_capacities_t;
+
+static run_capacities_t run_capacities(const sched_run_t *run) {
+    run_capacities_t capacities;
+    capacities.timeline_capacity = run->builder.capacity;
+    capacities.flat_capacity = run->flat ? run->flat->capacity : 0;
+    return capacities;
+}
+
+// The flat builder's first buffer is allocated on its first segment.
+static void count_growth(sched_run_t *run, run_capacities_t before) {
+    if (!run->stats) {
+        return;
+    }
+    run_capacities_t after = run_capacities(run);
+    if (after.timeline_capacity != before.timeline_capacity) {
+        run->stats->reallocations++;
+    }
+    if (after.flat_capacity != before.flat_capacity) {
+        if (before.flat_capacity == 0) {
+            run->stats->allocations++;
+        } else {
+            run->stats->reallocations++;
+        }
+    }
+}
+#endif
+
+// A blob name is copied out only for the timeline, truncated like the rest.
+static const char *input_name(const sched_run_t *run, int index, char *buffer) {
+    const sched_inputs_t *inputs = &run->inputs;
+    if (inputs->names) {
+        return inputs->names + (size_t)index * inputs->stride;
+    }
+    size_t begin = inputs->name_offsets[index];
+    size_t length = inputs->name_offsets[index + 1] - begin;
+    if (length > MAX_PROCESS_NAME - 1) {
+        length = MAX_PROCESS_NAME - 1;
+    }
+    (void)memcpy(buffer, inputs->name_blob + begin, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
+int sched_run_add_segment(sched_run_t *run, int index, int start, int end) {
+    int process_id = sched_process_id(run, index);
+#ifdef SCHED_ENABLE_STATS
+    // Runs without stats skip the snapshot; count_growth then returns at once.
+    run_capacities_t before = {0, 0};
+    if (run->stats) {
+        bool merges = run->last_index == index && run->last_end == start;
+        before = run_capacities(run);
+        run->stats->segments_merged += merges ? 1 : 0;
+        run->stats->segments_added += merges ? 0 : 1;
+    }
+#endif
+    if (!run->metrics_only) {
+        char name[MAX_PROCESS_NAME];
+        if (timeline_builder_add(&run->builder, process_id, input_name(run, index, name), start, end) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    if (run->flat && flat_segment_builder_add(run->flat, index, start, end) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+#ifdef SCHED_ENABLE_STATS
+    count_growth(run, before);
+#endif
+    run->last_index = index;
+    run->last_end = end;
+    if (run->last_run_end) {
+        run->last_run_end[index] = end;
+    }
+    metrics_accumulator_add_segment(&run->metrics, process_id);
+    return SCHED_OK;
+}
+
+// Same bookkeeping as finalize_completed_process, on the run's task.
+void sched_run_finalize(sched_run_t *run, int index, int completion_time) {
+    sched_task_t *task = &run->tasks[index];
+    task->remaining_time = 0;
+    task->completion_time = completion_time;
+    if (task->response_time < 0) {
+        task->response_time = 0;
+    }
+    process_result_t outcome = sched_run_outcome(run, index);
+    metrics_accumulator_add_outcome(&run->metrics, &outcome, sched_burst(run, index));
+}
+
+process_result_t sched_run_outcome(const sched_run_t *run, int index) {
+    const sched_task_t *task = &run->tasks[index];
+    process_result_t outcome;
+    outcome.completion_time = task->completion_time;
+    outcome.turnaround_time = task->completion_time - sched_arrival(run, index);
+    outcome.waiting_time = outcome.turnaround_time - sched_burst(run, index);
+    if (outcome.waiting_time < 0) {
+        outcome.waiting_time = 0;
+    }
+    outcome.response_time = task->response_time;
+    outcome.first_run_time = task->first_run_time;
+    return outcome;
+}
+
+int sched_switch_cost(const schedule_config_t *config, int last_end, int current_time) {
+    int cost = config->switch_cost;
+
+    if (config->cache_refill_penalty > 0) {
+        int off_cpu = (last_end < 0) ? INT_MAX : current_time - last_end;
+        if (config->cache_refill_window <= 0 || off_cpu >= config->cache_refill_window) {
+            cost += config->cache_refill_penalty;
+        } else {
+            cost += (int)(((long long)config->cache_refill_penalty * off_cpu) / config->cache_refill_window);
+        }
+    }
+    return cost;
+}
+
+// Charges the dispatch cost when the CPU changes hands and moves *current_time past it.
+int sched_run_charge_switch(sched_run_t *run, int index, int *current_time) {
+    if (run->last_index < 0 || run->last_index == index) {
+        return SCHED_OK;
+    }
+
+    int last_end = run->last_run_end ? run->last_run_end[index] : -1;
+    int cost = sched_switch_cost(run->config, last_end, *current_time);
+    if (cost <= 0) {
+        return SCHED_OK;
+    }
+
+#ifdef SCHED_ENABLE_STATS
+    run_capacities_t before = {0, 0};
+    if (run->stats) {
+        before = run_capacities(run);
+        run->stats->segments_added++;
+    }
+#endif
+    if (!run->metrics_only &&
+        timeline_builder_add(&run->builder,
+                             TIMELINE_OVERHEAD_PROCESS_ID,
+                             TIMELINE_OVERHEAD_NAME,
+                             *current_time,
+                             *current_time + cost) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    if (run->flat &&
+        flat_segment_builder_add(run->flat, FLAT_SEGMENT_OVERHEAD, *current_time, *current_time + cost) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+#ifdef SCHED_ENABLE_STATS
+    count_growth(run, before);
+#endif
+    *current_time += cost;
+    metrics_accumulator_add_overhead(&run->metrics, cost);
+    return SCHED_OK;
+}
+
+// Lower is better. With aging a waiting process gains one priority level per
+// aging_interval; writing that as priority * interval + ready_since keeps the
+// relative order of waiting processes fixed, so nothing is re-aged per tick.
+long long sched_priority_key(const sched_run_t *run, int index, int ready_since) {
+    int interval = run->config->aging_interval;
+    if (interval <= 0) {
+        return sched_priority(run, index);
+    }
+    return (long long)sched_priority(run, index) * interval + ready_since;
+}
+
+// Effective level at time of an aged key: priority - floor(wait / interval),
+// which is ceil((key - time) / interval).
+long long sched_aged_level(const sched_run_t *run, long long key, int time) {
+    long long interval = run->config->aging_interval;
+    long long span = key - time;
+    long long level = span / interval;
+    if (span % interval > 0) {
+        level++;
+    }
+    return level;
+}
+
+int sched_validate_config(const schedule_config_t *config) {
+    if (!config || config->algorithm < ALGO_FCFS || config->algorithm > ALGO_PRIORITY_P) {
+        return SCHED_ERR_ARGS;
+    }
+    if (config->switch_cost < 0 || config->cache_refill_penalty < 0 || config->cache_refill_window < 0 ||
+        config->aging_interval < 0) {
+        return SCHED_ERR_ARGS;
+    }
+    return SCHED_OK;
+}
@@ -0,0 +1,172 @@
+#ifndef SCHED_INTERNAL_H
+#define SCHED_INTERNAL_H
+
+// Helpers shared by the scheduling engines. Not part of the public API.
+
+#include "flat_result.h"
+#include "metrics.h"
+#include "process_types.h"
+
+#include <stddef.h>
+
+enum {
+    SCHED_OK = 0,
+    SCHED_ERR_ARGS = -1,
+    SCHED_ERR_ALLOC = -2
+};
+
+typedef struct {
+    timeline_event_t *events;
+    int count;
+    int capacity;
+} timeline_builder_t;
+
+typedef struct {
+    flat_segment_t *items;
+    int count;
+    int capacity;
+} flat_segment_builder_t;
+
+typedef struct {
+    int *items;
+    int head;
+    int tail;
+    int size;
+    int capacity;
+} int_queue_t;
+
+// Read-only view of a workload's inputs, read in place: every field sits
+// stride bytes after the previous process', so an array of process_t and
+// plain int32 columns both fit without a copy. Names are either
+// NUL-terminated at the same stride or a blob addressed by offsets.
+typedef struct {
+    const char *ids;
+    const char *arrivals;
+    const char *bursts;
+    const char *priorities;
+    size_t stride;
+    const char *names;             // NULL when the names live in name_blob
+    const uint32_t *name_offsets;  // count + 1 entries, checked by whoever built the view
+    const char *name_blob;
+} sched_inputs_t;
+
+// What a run changes about a process; the inputs stay where they are.
+typedef struct {
+    int remaining_time;
+    int first_run_time;   // -1 until dispatched
+    int response_time;    // -1 until dispatched
+    int completion_time;
+} sched_task_t;
+
+// Per-run state shared by the policy loops.
+typedef struct {
+    sched_inputs_t inputs;
+    sched_task_t *tasks;  // batch runs only; the online scheduler keeps state in its slots
+    int count;
+    const schedule_config_t *config;
+    timeline_builder_t builder;
+    bool metrics_only;  // segments only feed the metrics; the builder stays empty
+    flat_segment_builder_t *flat;  // optional compact segment sink, fed even when metrics_only
+    int *last_run_end;  // per process, only tracked when a cache refill penalty is configured
+    int last_index;     // process that last held the CPU, -1 before the first dispatch
+    metrics_accumulator_t metrics;
+    sched_stats_t *stats;  // NULL unless the caller asked for stats
+    int last_end;          // end of the latest slice; stats use it to tell merges apart
+} sched_run_t;
+
+// Hot-path counters cost one predictable branch when built in and nothing at
+// all without SCHED_ENABLE_STATS.
+#ifdef SCHED_ENABLE_STATS
+#define SCHED_STAT_ADD(run, field, amount) \
+    do {                                     \
+        if ((run)->stats) {                  \
+            (run)->stats->field += (amount); \
+        }                                    \
+    } while (0)
+#else
+#define SCHED_STAT_ADD(run, field, amount) ((void)(run))
+#endif
+
+void sched_inputs_from_processes(sched_inputs_t *inputs, const process_t *processes);
+
+static inline int sched_input_field(const sched_run_t *run, const char *field, int index) {
+    return *(const int *)(const void *)(field + (size_t)index * run->inputs.stride);
+}
+
+// Inputs as the policies see them, clamped like initialize_process_runtime_fields.
+static inline int sched_process_id(const sched_run_t *run, int index) {
+    return sched_input_field(run, run->inputs.ids, index);
+}
+
+static inline int sched_arrival(const sched_run_t *run, int index) {
+    int arrival = sched_input_field(run, run->inputs.arrivals, index);
+    return (arrival < 0) ? 0 : arrival;
+}
+
+static inline int sched_burst(const sched_run_t *run, int index) {
+    int burst = sched_input_field(run, run->inputs.bursts, index);
+    return (burst < 0) ? 0 : burst;
+}
+
+static inline int sched_priority(const sched_run_t *run, int index) {
+    int priority = sched_input_field(run, run->inputs.priorities, index);
+    return (priority <= 0) ? 1 : priority;
+}
+
+int timeline_builder_init(timeline_builder_t *builder);
+void timeline_builder_free(timeline_builder_t *builder);
+int timeline_builder_copy(timeline_builder_t *dst, const timeline_builder_t *src);
+int timeline_builder_copy_prefix(timeline_builder_t *dst, const timeline_builder_t *src, int count);
+int timeline_builder_add(
+    timeline_builder_t *builder,
+    int process_id,
+    const char *process_name,
+    int start_time,
+    int end_time
+);
+
+void flat_segment_builder_free(flat_segment_builder_t *builder);
+int flat_segment_builder_add(flat_segment_builder_t *builder, int process_index, int start_time, int end_time);
+
+int int_queue_init(int_queue_t *queue, int initial_capacity);
+void int_queue_free(int_queue_t *queue);
+int int_queue_push(int_queue_t *queue, int value);
+int int_queue_pop(int_queue_t *queue, int *value);
+int int_queue_empty(const int_queue_t *queue);
+int int_queue_copy(int_queue_t *dst, const int_queue_t *src);
+
+void finalize_completed_process(process_t *proc, int completion_time);
+int count_context_switches(const timeline_event_t *timeline, int timeline_count);
+int build_and_return_timeline(
+    timeline_builder_t *builder,
+    timeline_event_t **timeline,
+    int *timeline_count
+);
+
+int sched_run_add_segment(sched_run_t *run, int index, int start, int end);
+void sched_run_finalize(sched_run_t *run, int index, int completion_time);
+process_result_t sched_run_outcome(const sched_run_t *run, int index);
+int sched_run_charge_switch(sched_run_t *run, int index, int *current_time);
+
+// Cost of handing the CPU to a process that last ran until last_end (-1 if
+// it never ran): the switch cost plus any cache refill penalty.
+int sched_switch_cost(const schedule_config_t *config, int last_end, int current_time);
+long long sched_priority_key(const sched_run_t *run, int index, int ready_since);
+long long sched_aged_level(const sched_run_t *run, long long key, int time);
+int sched_validate_config(const schedule_config_t *config);
+
+// Runs a policy over a read-only workload. results (optional) receives each
+// process' outcome in workload order; flat (optional) is fed every segment.
+// Pass NULL timeline/timeline_count for a metrics-only run.
+int sched_schedule_inputs(
+    const sched_inputs_t *inputs,
+    int count,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    flat_segment_builder_t *flat,
+    metrics_t *metrics
+);
+
+#endif // SCHED_INTERNAL_H
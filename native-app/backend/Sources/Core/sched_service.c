@@ -0,0 +1,968 @@
+#include "sched_service.h"
+
+#include "monte_carlo.h"
+#include "online_scheduler.h"
+#include "sched_internal.h"
+#include "scheduler.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SERVICE_CHANNEL_LENGTH 64
+#define SERVICE_NO_NAME UINT32_MAX
+#define SERVICE_MAX_DEPTH 32
+#define SERVICE_BATCH_PROCESSES 65536  // a batch stops growing past this many processes
+
+// Requests keep processes compactly; names are only stored when given.
+typedef struct {
+    int id;
+    int arrival;
+    int burst;
+    int priority;
+    uint32_t name;  // offset into the request's names, or SERVICE_NO_NAME
+} service_process_t;
+
+typedef struct service_request {
+    struct service_request *next;
+    long long id;
+    bool has_id;
+    char channel[SERVICE_CHANNEL_LENGTH];
+    const void *client;
+    sched_service_reply_fn reply;
+    void *context;
+    schedule_config_t config;
+    bool want_timeline;
+    service_process_t *processes;
+    int process_count;
+    int process_capacity;
+    char *names;
+    size_t names_size;
+    size_t names_capacity;
+    bool cancelled;   // superseded; guarded by the service lock
+    bool forgotten;   // client gone: no reply at all
+    struct service_release *release;  // the forgotten client's context, if it waits on this request
+} service_request_t;
+
+// A forgotten client's context, released by whichever of its running
+// requests finishes last.
+typedef struct service_release {
+    sched_service_release_fn release;
+    void *context;
+    int references;  // guarded by the service lock
+} service_release_t;
+
+typedef struct {
+    sched_service_t *service;
+    pthread_t thread;
+    service_request_t *taken[SCHED_SERVICE_BATCH];  // the batch being run
+    int taken_count;
+} service_worker_t;
+
+struct sched_service {
+    pthread_mutex_t lock;
+    pthread_cond_t work;      // queue non-empty, or stopping
+    pthread_cond_t released;  // a taken request was released (forget_client's fallback)
+    service_request_t *head;
+    service_request_t *tail;
+    bool stopping;
+    service_worker_t workers[SCHED_SERVICE_MAX_WORKERS];
+    int worker_count;
+    sched_service_stats_t stats;
+};
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} text_t;
+
+static void text_append(text_t *text, const char *bytes, size_t length) {
+    if (text->failed) {
+        return;
+    }
+    if (text->length + length + 1U > text->capacity) {
+        size_t grown_capacity = (text->capacity > 0U) ? text->capacity : 256U;
+        while (grown_capacity < text->length + length + 1U) {
+            grown_capacity *= 2U;
+        }
+        char *grown = (char *)realloc(text->data, grown_capacity);
+        if (!grown) {
+            text->failed = true;
+            return;
+        }
+        text->data = grown;
+        text->capacity = grown_capacity;
+    }
+    (void)memcpy(text->data + text->length, bytes, length);
+    text->length += length;
+    text->data[text->length] = '\0';
+}
+
+static void text_printf(text_t *text, const char *format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= sizeof(buffer)) {
+        text->failed = true;
+        return;
+    }
+    text_append(text, buffer, (size_t)written);
+}
+
+static void free_request(service_request_t *request) {
+    if (!request) {
+        return;
+    }
+    free(request->processes);
+    free(request->names);
+    free(request);
+}
+
+static void reply_status(const service_request_t *request, const char *status, const char *error) {
+    text_t text = {NULL, 0U, 0U, false};
+    if (request->has_id) {
+        text_printf(&text, "{\"id\":%lld,\"status\":\"%s\"", request->id, status);
+    } else {
+        text_printf(&text, "{\"id\":null,\"status\":\"%s\"", status);
+    }
+    if (error) {
+        text_printf(&text, ",\"error\":\"%s\"", error);
+    }
+    text_append(&text, "}\n", 2U);
+    if (!text.failed) {
+        request->reply(request->context, text.data, text.length);
+    }
+    free(text.data);
+}
+
+// Minimal JSON reading over a length-bounded buffer; only what requests use.
+typedef struct {
+    const char *p;
+    const char *end;
+} cursor_t;
+
+static void skip_ws(cursor_t *c) {
+    while (c->p < c->end && (*c->p == ' ' || *c->p == '\t' || *c->p == '\r' || *c->p == '\n')) {
+        c->p++;
+    }
+}
+
+static bool consume(cursor_t *c, char expected) {
+    skip_ws(c);
+    if (c->p < c->end && *c->p == expected) {
+        c->p++;
+        return true;
+    }
+    return false;
+}
+
+// Escapes other than the simple ones become '?'; the result is truncated to
+// capacity. A NULL out only skips the string.
+static bool parse_string(cursor_t *c, char *out, size_t capacity, size_t *out_length) {
+    if (!consume(c, '"')) {
+        return false;
+    }
+    size_t length = 0;
+    while (c->p < c->end && *c->p != '"') {
+        char ch = *c->p++;
+        if (ch == '\\') {
+            if (c->p >= c->end) {
+                return false;
+            }
+            char escaped = *c->p++;
+            switch (escaped) {
+                case 'n': ch = '\n'; break;
+                case 't': ch = '\t'; break;
+                case 'r': ch = '\r'; break;
+                case 'b': ch = '\b'; break;
+                case 'f': ch = '\f'; break;
+                case 'u':
+                    if (c->end - c->p < 4) {
+                        return false;
+                    }
+                    c->p += 4;
+                    ch = '?';
+                    break;
+                default: ch = escaped; break;
+            }
+        }
+        if (out && length + 1U < capacity) {
+            out[length] = ch;
+        }
+        length++;
+    }
+    if (c->p >= c->end) {
+        return false;
+    }
+    c->p++;
+    if (out) {
+        size_t stored = (length + 1U < capacity) ? length : capacity - 1U;
+        out[stored] = '\0';
+        if (out_length) {
+            *out_length = stored;
+        }
+    }
+    return true;
+}
+
+static bool parse_number(cursor_t *c, double *value) {
+    skip_ws(c);
+    char buffer[64];
+    size_t length = 0;
+    while (c->p + length < c->end && length + 1U < sizeof(buffer)) {
+        char ch = c->p[length];
+        if (!((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E')) {
+            break;
+        }
+        buffer[length++] = ch;
+    }
+    buffer[length] = '\0';
+    char *parsed_end = NULL;
+    *value = strtod(buffer, &parsed_end);
+    if (length == 0U || parsed_end != buffer + length) {
+        return false;
+    }
+    c->p += length;
+    return true;
+}
+
+static bool parse_int(cursor_t *c, int *value) {
+    double number = 0.0;
+    if (!parse_number(c, &number) || number < (double)INT_MIN || number > (double)INT_MAX) {
+        return false;
+    }
+    *value = (int)(number < 0.0 ? number - 0.5 : number + 0.5);
+    return true;
+}
+
+static bool match_literal(cursor_t *c, const char *literal) {
+    size_t length = strlen(literal);
+    skip_ws(c);
+    if ((size_t)(c->end - c->p) < length || memcmp(c->p, literal, length) != 0) {
+        return false;
+    }
+    c->p += length;
+    return true;
+}
+
+static bool skip_value(cursor_t *c, int depth) {
+    skip_ws(c);
+    if (c->p >= c->end || depth > SERVICE_MAX_DEPTH) {
+        return false;
+    }
+    char open = *c->p;
+    if (open == '"') {
+        return parse_string(c, NULL, 0U, NULL);
+    }
+    if (open == '{' || open == '[') {
+        char close = (open == '{') ? '}' : ']';
+        c->p++;
+        if (consume(c, close)) {
+            return true;
+        }
+        do {
+            if (open == '{' && (!parse_string(c, NULL, 0U, NULL) || !consume(c, ':'))) {
+                return false;
+            }
+            if (!skip_value(c, depth + 1)) {
+                return false;
+            }
+        } while (consume(c, ','));
+        return consume(c, close);
+    }
+    if (match_literal(c, "true") || match_literal(c, "false") || match_literal(c, "null")) {
+        return true;
+    }
+    double ignored = 0.0;
+    return parse_number(c, &ignored);
+}
+
+static bool parse_bool(cursor_t *c, bool *value) {
+    if (match_literal(c, "true")) {
+        *value = true;
+        return true;
+    }
+    if (match_literal(c, "false")) {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+
+static service_process_t *add_process(service_request_t *request) {
+    if (request->process_count == SCHED_SERVICE_MAX_PROCESSES) {
+        return NULL;
+    }
+    if (request->process_count == request->process_capacity) {
+        int grown_capacity = (request->process_capacity > 0) ? request->process_capacity * 2 : 64;
+        service_process_t *grown = (service_process_t *)realloc(
+            request->processes, (size_t)grown_capacity * sizeof(service_process_t));
+        if (!grown) {
+            return NULL;
+        }
+        request->processes = grown;
+        request->process_capacity = grown_capacity;
+    }
+    service_process_t *process = &request->processes[request->process_count];
+    process->id = request->process_count + 1;
+    process->arrival = 0;
+    process->burst = 0;
+    process->priority = 1;
+    process->name = SERVICE_NO_NAME;
+    request->process_count++;
+    return process;
+}
+
+static bool store_name(service_request_t *request, service_process_t *process, const char *name, size_t length) {
+    if (request->names_size + length + 1U > request->names_capacity) {
+        size_t grown_capacity = (request->names_capacity > 0U) ? request->names_capacity * 2U : 1024U;
+        while (grown_capacity < request->names_size + length + 1U) {
+            grown_capacity *= 2U;
+        }
+        if (grown_capacity >= SERVICE_NO_NAME) {
+            return false;
+        }
+        char *grown = (char *)realloc(request->names, grown_capacity);
+        if (!grown) {
+            return false;
+        }
+        request->names = grown;
+        request->names_capacity = grown_capacity;
+    }
+    process->name = (uint32_t)request->names_size;
+    (void)memcpy(request->names + request->names_size, name, length + 1U);
+    request->names_size += length + 1U;
+    return true;
+}
+
+// [id, arrival, burst, priority?] or {"id": .., "arrival": .., ...}.
+static bool parse_process(cursor_t *c, service_request_t *request) {
+    service_process_t *process = add_process(request);
+    if (!process) {
+        return false;
+    }
+    if (consume(c, '[')) {
+        int *fields[4] = {&process->id, &process->arrival, &process->burst, &process->priority};
+        int field = 0;
+        do {
+            if (field == 4 || !parse_int(c, fields[field])) {
+                return false;
+            }
+            field++;
+        } while (consume(c, ','));
+        return field >= 3 && consume(c, ']');
+    }
+
+    if (!consume(c, '{')) {
+        return false;
+    }
+    if (consume(c, '}')) {
+        return true;
+    }
+    do {
+        char key[32];
+        if (!parse_string(c, key, sizeof(key), NULL) || !consume(c, ':')) {
+            return false;
+        }
+        bool ok = true;
+        if (strcmp(key, "id") == 0) {
+            ok = parse_int(c, &process->id);
+        } else if (strcmp(key, "arrival") == 0 || strcmp(key, "arrivalTime") == 0) {
+            ok = parse_int(c, &process->arrival);
+        } else if (strcmp(key, "burst") == 0 || strcmp(key, "burstTime") == 0) {
+            ok = parse_int(c, &process->burst);
+        } else if (strcmp(key, "priority") == 0) {
+            ok = parse_int(c, &process->priority);
+        } else if (strcmp(key, "name") == 0) {
+            char name[MAX_PROCESS_NAME];
+            size_t length = 0;
+            ok = parse_string(c, name, sizeof(name), &length) && store_name(request, process, name, length);
+        } else {
+            ok = skip_value(c, 1);
+        }
+        if (!ok) {
+            return false;
+        }
+    } while (consume(c, ','));
+    return consume(c, '}');
+}
+
+// "priority" is kept as an alias of priority_np.
+static bool parse_algorithm(cursor_t *c, algorithm_type_t *algorithm) {
+    char name[32];
+    if (!parse_string(c, name, sizeof(name), NULL)) {
+        return false;
+    }
+    if (strcmp(name, "priority") == 0) {
+        *algorithm = ALGO_PRIORITY_NP;
+        return true;
+    }
+    return sched_algorithm_from_name(name, algorithm) == SCHED_OK;
+}
+
+// Fills the request from one JSON object; *error names the first problem.
+static bool parse_request(cursor_t *c, service_request_t *request, const char **error) {
+    request->config.algorithm = ALGO_FCFS;
+    request->config.time_quantum = 2;
+    *error = "malformed request";
+    if (!consume(c, '{')) {
+        return false;
+    }
+    if (consume(c, '}')) {
+        return true;
+    }
+    do {
+        char key[32];
+        if (!parse_string(c, key, sizeof(key), NULL) || !consume(c, ':')) {
+            return false;
+        }
+        bool ok = true;
+        if (strcmp(key, "id") == 0) {
+            double id = 0.0;
+            ok = parse_number(c, &id) && id >= -9e15 && id <= 9e15;
+            request->id = (long long)id;
+            request->has_id = ok;
+        } else if (strcmp(key, "channel") == 0) {
+            ok = parse_string(c, request->channel, sizeof(request->channel), NULL);
+        } else if (strcmp(key, "algorithm") == 0) {
+            ok = parse_algorithm(c, &request->config.algorithm);
+            if (!ok) {
+                *error = "unknown algorithm";
+            }
+        } else if (strcmp(key, "quantum") == 0) {
+            ok = parse_int(c, &request->config.time_quantum);
+        } else if (strcmp(key, "switch_cost") == 0) {
+            ok = parse_int(c, &request->config.switch_cost);
+        } else if (strcmp(key, "aging") == 0) {
+            ok = parse_int(c, &request->config.aging_interval);
+        } else if (strcmp(key, "timeline") == 0) {
+            ok = parse_bool(c, &request->want_timeline);
+        } else if (strcmp(key, "processes") == 0) {
+            ok = consume(c, '[');
+            if (ok && !consume(c, ']')) {
+                do {
+                    ok = parse_process(c, request);
+                } while (ok && consume(c, ','));
+                ok = ok && consume(c, ']');
+            }
+            if (!ok) {
+                *error = (request->process_count == SCHED_SERVICE_MAX_PROCESSES) ? "too many processes"
+                                                                                 : "malformed process";
+            }
+        } else {
+            ok = skip_value(c, 1);
+        }
+        if (!ok) {
+            return false;
+        }
+    } while (consume(c, ','));
+    if (!consume(c, '}')) {
+        return false;
+    }
+
+    if (sched_validate_config(&request->config) != SCHED_OK ||
+        (request->config.algorithm == ALGO_RR && request->config.time_quantum <= 0)) {
+        *error = "invalid parameters";
+        return false;
+    }
+    for (int i = 0; i < request->process_count; i++) {
+        if (request->processes[i].arrival < 0 || request->processes[i].burst <= 0) {
+            *error = "invalid process";
+            return false;
+        }
+    }
+    return true;
+}
+
+// The online scheduler takes arrivals in time order.
+static int sort_processes(service_request_t *request) {
+    int count = request->process_count;
+    int *order = NULL;
+    int status = arrival_order(count > 0 ? &request->processes[0].arrival : NULL, sizeof(service_process_t), count,
+                               &order);
+    if (status != SCHED_OK || !order) {
+        return status;
+    }
+    service_process_t *ordered = (service_process_t *)malloc((size_t)count * sizeof(service_process_t));
+    if (!ordered) {
+        free(order);
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < count; i++) {
+        ordered[i] = request->processes[order[i]];
+    }
+    free(order);
+    free(request->processes);
+    request->processes = ordered;
+    request->process_capacity = count;
+    return SCHED_OK;
+}
+
+static bool is_cancelled(sched_service_t *service, const service_request_t *request) {
+    (void)pthread_mutex_lock(&service->lock);
+    bool cancelled = request->cancelled || request->forgotten;
+    (void)pthread_mutex_unlock(&service->lock);
+    return cancelled;
+}
+
+static int drain_run(online_scheduler_t *sim, text_t *processes, text_t *timeline) {
+    process_t *completed = NULL;
+    int completed_count = 0;
+    int status = online_scheduler_drain_completed(sim, &completed, &completed_count);
+    for (int i = 0; i < completed_count; i++) {
+        const process_t *p = &completed[i];
+        text_printf(processes, "%s[%d,%d,%d,%d,%d]", (processes->length > 0U) ? "," : "", p->process_id,
+                    p->completion_time, p->turnaround_time, p->waiting_time, p->response_time);
+    }
+    free(completed);
+
+    timeline_event_t *events = NULL;
+    int event_count = 0;
+    if (status == SCHED_OK) {
+        status = online_scheduler_drain_events(sim, &events, &event_count);
+    }
+    for (int i = 0; timeline && i < event_count; i++) {
+        text_printf(timeline, "%s[%d,%d,%d]", (timeline->length > 0U) ? "," : "", events[i].process_id,
+                    events[i].start_time, events[i].end_time);
+    }
+    free(events);
+    if (status == SCHED_OK && (processes->failed || (timeline && timeline->failed))) {
+        status = SCHED_ERR_ALLOC;
+    }
+    return status;
+}
+
+// advance_to in steps of SCHED_SERVICE_CHUNK decisions, draining and checking
+// for cancellation after each, so even one huge burst of arrivals stops soon
+// after it is superseded.
+static int advance_run(sched_service_t *service, service_request_t *request, online_scheduler_t *sim, int time,
+                       text_t *processes, text_t *timeline, bool *cancelled) {
+    int status = SCHED_OK;
+    bool reached = false;
+    while (status == SCHED_OK && !reached && !*cancelled) {
+        status = online_scheduler_advance_bounded(sim, time, SCHED_SERVICE_CHUNK, &reached);
+        if (status == SCHED_OK) {
+            status = drain_run(sim, processes, timeline);
+        }
+        *cancelled = is_cancelled(service, request);
+    }
+    return status;
+}
+
+// Runs the request chunk by chunk, checking for cancellation in between.
+// Returns 1 when cancelled; otherwise a SCHED_* status with the reply in out.
+static int run_request(sched_service_t *service, service_request_t *request, text_t *out) {
+    int status = sort_processes(request);
+    online_scheduler_t *sim = NULL;
+    if (status == SCHED_OK) {
+        status = online_scheduler_create(&request->config, &sim);
+    }
+    text_t processes = {NULL, 0U, 0U, false};
+    text_t timeline = {NULL, 0U, 0U, false};
+    text_t *timeline_out = request->want_timeline ? &timeline : NULL;
+    bool cancelled = false;
+
+    int count = request->process_count;
+    for (int begin = 0; begin < count && status == SCHED_OK && !cancelled; begin += SCHED_SERVICE_CHUNK) {
+        int end = (count - begin > SCHED_SERVICE_CHUNK) ? begin + SCHED_SERVICE_CHUNK : count;
+        for (int i = begin; i < end && status == SCHED_OK; i++) {
+            const service_process_t *source = &request->processes[i];
+            process_t process;
+            (void)memset(&process, 0, sizeof(process));
+            process.process_id = source->id;
+            process.arrival_time = source->arrival;
+            process.burst_time = source->burst;
+            process.priority = source->priority;
+            if (source->name != SERVICE_NO_NAME) {
+                safe_copy_string(process.name, sizeof(process.name), request->names + source->name);
+            } else {
+                (void)snprintf(process.name, sizeof(process.name), "P%d", source->id);
+            }
+            status = online_scheduler_submit(sim, &process);
+        }
+        if (status == SCHED_OK) {
+            status = advance_run(service, request, sim, request->processes[end - 1].arrival, &processes, timeline_out,
+                                 &cancelled);
+        }
+    }
+    if (status == SCHED_OK && !cancelled) {
+        status = advance_run(service, request, sim, INT_MAX, &processes, timeline_out, &cancelled);
+    }
+
+    metrics_t metrics;
+    if (status == SCHED_OK && !cancelled) {
+        status = online_scheduler_metrics(sim, &metrics);
+    }
+    online_scheduler_destroy(sim);
+    if (status == SCHED_OK && !cancelled) {
+        if (request->has_id) {
+            text_printf(out, "{\"id\":%lld,\"status\":\"ok\",\"metrics\":{", request->id);
+        } else {
+            text_printf(out, "{\"id\":null,\"status\":\"ok\",\"metrics\":{");
+        }
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            text_printf(out, "%s\"%s\":%.10g", (f > 0) ? "," : "", monte_carlo_field_name((monte_carlo_field_t)f),
+                        monte_carlo_field_value(&metrics, (monte_carlo_field_t)f));
+        }
+        text_append(out, "},\"processes\":[", 15U);
+        if (processes.data) {
+            text_append(out, processes.data, processes.length);
+        }
+        text_append(out, "]", 1U);
+        if (request->want_timeline) {
+            text_append(out, ",\"timeline\":[", 13U);
+            if (timeline.data) {
+                text_append(out, timeline.data, timeline.length);
+            }
+            text_append(out, "]", 1U);
+        }
+        text_append(out, "}\n", 2U);
+        if (out->failed) {
+            status = SCHED_ERR_ALLOC;
+        }
+    }
+    free(processes.data);
+    free(timeline.data);
+    return cancelled ? 1 : status;
+}
+
+static bool is_taken(const sched_service_t *service, const void *client) {
+    for (int w = 0; w < service->worker_count; w++) {
+        for (int i = 0; i < service->workers[w].taken_count; i++) {
+            const service_request_t *request = service->workers[w].taken[i];
+            if (request && request->client == client) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void *service_worker(void *arg) {
+    service_worker_t *worker = (service_worker_t *)arg;
+    sched_service_t *service = worker->service;
+
+    (void)pthread_mutex_lock(&service->lock);
+    for (;;) {
+        while (!service->head && !service->stopping) {
+            (void)pthread_cond_wait(&service->work, &service->lock);
+        }
+        if (!service->head) {
+            break;
+        }
+        // Small requests are taken together; a large one goes alone.
+        long long processes = 0;
+        worker->taken_count = 0;
+        while (service->head && worker->taken_count < SCHED_SERVICE_BATCH &&
+               (worker->taken_count == 0 || processes + service->head->process_count <= SERVICE_BATCH_PROCESSES)) {
+            service_request_t *request = service->head;
+            service->head = request->next;
+            if (!service->head) {
+                service->tail = NULL;
+            }
+            request->next = NULL;
+            processes += request->process_count;
+            worker->taken[worker->taken_count++] = request;
+        }
+        service->stats.batches++;
+        (void)pthread_mutex_unlock(&service->lock);
+
+        for (int i = 0; i < worker->taken_count; i++) {
+            service_request_t *request = worker->taken[i];
+            text_t out = {NULL, 0U, 0U, false};
+            int status = is_cancelled(service, request) ? 1 : run_request(service, request, &out);
+
+            (void)pthread_mutex_lock(&service->lock);
+            bool forgotten = request->forgotten;
+            if (status == SCHED_OK) {
+                service->stats.completed++;
+            } else if (status == 1) {
+                service->stats.cancelled++;
+            } else {
+                service->stats.failed++;
+            }
+            (void)pthread_mutex_unlock(&service->lock);
+
+            if (!forgotten) {
+                if (status == SCHED_OK) {
+                    request->reply(request->context, out.data, out.length);
+                } else {
+                    reply_status(request, (status == 1) ? "cancelled" : "error",
+                                 (status == 1) ? NULL : "scheduling failed");
+                }
+            }
+            free(out.data);
+
+            // Only now may the forgotten client's context be released.
+            (void)pthread_mutex_lock(&service->lock);
+            worker->taken[i] = NULL;
+            service_release_t *release = request->release;
+            bool last = release && --release->references == 0;
+            (void)pthread_cond_broadcast(&service->released);
+            (void)pthread_mutex_unlock(&service->lock);
+            free_request(request);
+            if (last) {
+                release->release(release->context);
+                free(release);
+            }
+        }
+        (void)pthread_mutex_lock(&service->lock);
+        worker->taken_count = 0;
+    }
+    (void)pthread_mutex_unlock(&service->lock);
+    return NULL;
+}
+
+int sched_service_create(int worker_count, sched_service_t **service) {
+    if (!service || worker_count <= 0 || worker_count > SCHED_SERVICE_MAX_WORKERS) {
+        return SCHED_ERR_ARGS;
+    }
+    *service = (sched_service_t *)calloc(1, sizeof(sched_service_t));
+    if (!*service) {
+        return SCHED_ERR_ALLOC;
+    }
+    sched_service_t *s = *service;
+    (void)pthread_mutex_init(&s->lock, NULL);
+    (void)pthread_cond_init(&s->work, NULL);
+    (void)pthread_cond_init(&s->released, NULL);
+
+    for (int w = 0; w < worker_count; w++) {
+        s->workers[w].service = s;
+        if (pthread_create(&s->workers[w].thread, NULL, service_worker, &s->workers[w]) != 0) {
+            sched_service_destroy(s);
+            *service = NULL;
+            return SCHED_ERR_ALLOC;
+        }
+        s->worker_count++;
+    }
+    return SCHED_OK;
+}
+
+void sched_service_destroy(sched_service_t *service) {
+    if (!service) {
+        return;
+    }
+    (void)pthread_mutex_lock(&service->lock);
+    service_request_t *queued = service->head;
+    service->head = NULL;
+    service->tail = NULL;
+    service->stopping = true;
+    for (int w = 0; w < service->worker_count; w++) {
+        for (int i = 0; i < service->workers[w].taken_count; i++) {
+            if (service->workers[w].taken[i]) {
+                service->workers[w].taken[i]->cancelled = true;
+            }
+        }
+    }
+    (void)pthread_cond_broadcast(&service->work);
+    (void)pthread_mutex_unlock(&service->lock);
+
+    while (queued) {
+        service_request_t *next = queued->next;
+        reply_status(queued, "cancelled", NULL);
+        free_request(queued);
+        queued = next;
+    }
+    for (int w = 0; w < service->worker_count; w++) {
+        (void)pthread_join(service->workers[w].thread, NULL);
+    }
+    (void)pthread_cond_destroy(&service->released);
+    (void)pthread_cond_destroy(&service->work);
+    (void)pthread_mutex_destroy(&service->lock);
+    free(service);
+}
+
+// Queues one parsed request, unlinking the queued requests it supersedes
+// into *superseded and flagging taken ones.
+static void enqueue(sched_service_t *service, service_request_t *request, service_request_t **superseded) {
+    (void)pthread_mutex_lock(&service->lock);
+    if (request->channel[0] != '\0') {
+        service_request_t *previous = NULL;
+        service_request_t *queued = service->head;
+        while (queued) {
+            service_request_t *next = queued->next;
+            if (queued->client == request->client && strcmp(queued->channel, request->channel) == 0) {
+                if (previous) {
+                    previous->next = next;
+                } else {
+                    service->head = next;
+                }
+                if (service->tail == queued) {
+                    service->tail = previous;
+                }
+                queued->next = *superseded;
+                *superseded = queued;
+                service->stats.cancelled++;
+            } else {
+                previous = queued;
+            }
+            queued = next;
+        }
+        for (int w = 0; w < service->worker_count; w++) {
+            for (int i = 0; i < service->workers[w].taken_count; i++) {
+                service_request_t *taken = service->workers[w].taken[i];
+                if (taken && taken->client == request->client && strcmp(taken->channel, request->channel) == 0) {
+                    taken->cancelled = true;
+                }
+            }
+        }
+    }
+
+    if (service->tail) {
+        service->tail->next = request;
+    } else {
+        service->head = request;
+    }
+    service->tail = request;
+    (void)pthread_cond_signal(&service->work);
+    (void)pthread_mutex_unlock(&service->lock);
+}
+
+int sched_service_submit(
+    sched_service_t *service,
+    const char *line,
+    size_t length,
+    const void *client,
+    sched_service_reply_fn reply,
+    void *context
+) {
+    if (!service || (!line && length > 0U) || !reply) {
+        return SCHED_ERR_ARGS;
+    }
+    cursor_t cursor = {line, line + length};
+    bool is_batch = consume(&cursor, '[');
+    if (is_batch && consume(&cursor, ']')) {
+        return SCHED_OK;
+    }
+
+    bool more = true;
+    while (more) {
+        service_request_t *request = (service_request_t *)calloc(1, sizeof(service_request_t));
+        if (!request) {
+            return SCHED_ERR_ALLOC;
+        }
+        request->client = client;
+        request->reply = reply;
+        request->context = context;
+
+        const char *error = NULL;
+        bool parsed = parse_request(&cursor, request, &error);
+        if (parsed) {
+            more = is_batch && consume(&cursor, ',');
+            if (!more) {
+                parsed = (!is_batch || consume(&cursor, ']'));
+                skip_ws(&cursor);
+                parsed = parsed && cursor.p == cursor.end;
+                error = "malformed request";
+            }
+        }
+        if (!parsed) {
+            // The rest of the line cannot be resynchronised.
+            (void)pthread_mutex_lock(&service->lock);
+            service->stats.failed++;
+            (void)pthread_mutex_unlock(&service->lock);
+            reply_status(request, "error", error);
+            free_request(request);
+            break;
+        }
+
+        service_request_t *superseded = NULL;
+        enqueue(service, request, &superseded);
+        while (superseded) {
+            service_request_t *next = superseded->next;
+            reply_status(superseded, "cancelled", NULL);
+            free_request(superseded);
+            superseded = next;
+        }
+    }
+    return SCHED_OK;
+}
+
+void sched_service_forget_client(
+    sched_service_t *service,
+    const void *client,
+    sched_service_release_fn release,
+    void *context
+) {
+    if (!service) {
+        return;
+    }
+    // Without the record (out of memory) this falls back to waiting.
+    service_release_t *pending = release ? (service_release_t *)calloc(1, sizeof(service_release_t)) : NULL;
+    if (pending) {
+        pending->release = release;
+        pending->context = context;
+    }
+
+    service_request_t *dropped = NULL;
+    (void)pthread_mutex_lock(&service->lock);
+    service_request_t *previous = NULL;
+    service_request_t *queued = service->head;
+    while (queued) {
+        service_request_t *next = queued->next;
+        if (queued->client == client) {
+            if (previous) {
+                previous->next = next;
+            } else {
+                service->head = next;
+            }
+            if (service->tail == queued) {
+                service->tail = previous;
+            }
+            queued->next = dropped;
+            dropped = queued;
+        } else {
+            previous = queued;
+        }
+        queued = next;
+    }
+    // Requests forgotten earlier belong to an earlier context at the same address.
+    int running = 0;
+    for (int w = 0; w < service->worker_count; w++) {
+        for (int i = 0; i < service->workers[w].taken_count; i++) {
+            service_request_t *taken = service->workers[w].taken[i];
+            if (taken && taken->client == client && !taken->forgotten) {
+                taken->forgotten = true;
+                taken->release = pending;
+                running++;
+            }
+        }
+    }
+    if (pending) {
+        pending->references = running;
+    } else if (release) {
+        while (is_taken(service, client)) {
+            (void)pthread_cond_wait(&service->released, &service->lock);
+        }
+    }
+    (void)pthread_mutex_unlock(&service->lock);
+
+    while (dropped) {
+        service_request_t *next = dropped->next;
+        free_request(dropped);
+        dropped = next;
+    }
+    if (release && (!pending || running == 0)) {
+        release(context);
+        free(pending);
+    }
+}
+
+int sched_service_stats(sched_service_t *service, sched_service_stats_t *stats) {
+    if (!service || !stats) {
+        return SCHED_ERR_ARGS;
+    }
+    (void)pthread_mutex_lock(&service->lock);
+    *stats = service->stats;
+    (void)pthread_mutex_unlock(&service->lock);
+    return SCHED_OK;
+}
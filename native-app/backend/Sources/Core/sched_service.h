@@ -0,0 +1,95 @@
+#ifndef SCHED_SERVICE_H
+#define SCHED_SERVICE_H
+
+#include "process_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scheduling as a service: requests are queued to a pool of worker threads
+// and answered through a callback. The protocol is one JSON value per line:
+//
+//   {"id": 7, "channel": "gantt", "algorithm": "rr", "quantum": 4,
+//    "switch_cost": 0, "aging": 0, "timeline": true,
+//    "processes": [[id, arrival, burst, priority], ...]}
+//
+// Processes may also be objects with id, arrival (arrivalTime), burst
+// (burstTime), priority and name. A JSON array of requests queues them all
+// at once; a malformed element ends the array with one error reply. Every
+// queued request gets exactly one reply line:
+//
+//   {"id": 7, "status": "ok", "metrics": {...every metrics_t field...},
+//    "processes": [[id, completion, turnaround, waiting, response], ...],
+//    "timeline": [[id, start, end], ...]}
+//   {"id": 7, "status": "cancelled"}
+//   {"id": 7, "status": "error", "error": "..."}
+//
+// Processes are listed in completion order. A request supersedes every
+// earlier one from the same client on the same channel: queued ones are
+// dropped and a running one stops at its next checkpoint, both answered as
+// cancelled. Runs go through the online scheduler, which produces the same
+// schedule as schedule_processes, in chunks of SCHED_SERVICE_CHUNK arrivals
+// or scheduling decisions, whichever comes first.
+// Workers take up to SCHED_SERVICE_BATCH queued requests at a time so small
+// requests do not pay a wake-up each.
+#define SCHED_SERVICE_MAX_WORKERS 64
+#define SCHED_SERVICE_MAX_PROCESSES 10000000
+#define SCHED_SERVICE_CHUNK 4096
+#define SCHED_SERVICE_BATCH 16
+
+// Called from worker threads (or from the submitting thread for requests
+// that fail to parse or are superseded while queued). The response is one
+// line including its '\n' and is only valid during the call.
+typedef void (*sched_service_reply_fn)(void *context, const char *response, size_t length);
+
+typedef struct {
+    long long completed;
+    long long cancelled;
+    long long failed;
+    long long batches;       // worker wake-ups that took queued requests
+} sched_service_stats_t;
+
+typedef struct sched_service sched_service_t;
+
+int sched_service_create(int worker_count, sched_service_t **service);
+
+// Cancels whatever is still queued and waits for running requests.
+void sched_service_destroy(sched_service_t *service);
+
+// Parses one line and queues its request(s). `client` identifies the
+// connection for superseding; replies for it go to reply(context, ...).
+// Malformed requests are answered with an error reply, not a failure code.
+int sched_service_submit(
+    sched_service_t *service,
+    const char *line,
+    size_t length,
+    const void *client,
+    sched_service_reply_fn reply,
+    void *context
+);
+
+// Releases a forgotten client's reply context.
+typedef void (*sched_service_release_fn)(void *context);
+
+// Drops the client's queued requests and stops its running ones, without
+// replying, and returns without waiting for them. release(context), when
+// given, runs once none of them can call reply again: here if none is
+// running, otherwise on the worker that lets go of the last one.
+void sched_service_forget_client(
+    sched_service_t *service,
+    const void *client,
+    sched_service_release_fn release,
+    void *context
+);
+
+int sched_service_stats(sched_service_t *service, sched_service_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_SERVICE_H
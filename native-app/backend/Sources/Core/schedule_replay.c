@@ -0,0 +1,420 @@
+#include "schedule_replay.h"
+
+#include "sched_internal.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checkpoints are immutable once taken, so replays derived through
+// schedule_replay_apply share the prefix they have in common.
+typedef struct {
+    int refs;
+    int time;
+    int submitted;              // feed entries already handed to the simulator
+    int timeline_count;         // recorded segments that were final at this point
+    online_scheduler_t *state;
+} replay_checkpoint_t;
+
+struct schedule_replay {
+    schedule_config_t config;
+    process_t *feed;            // processes in submission order
+    int *feed_source;           // index of each feed entry in the caller's array
+    int feed_count;
+    int interval;
+    replay_checkpoint_t **checkpoints;
+    int checkpoint_count;
+    int checkpoint_capacity;
+    timeline_builder_t timeline;
+    metrics_t metrics;
+    online_scheduler_t *cursor;
+};
+
+typedef struct {
+    int arrival_time;
+    int index;
+} feed_key_t;
+
+static int compare_feed_keys(const void *lhs, const void *rhs) {
+    const feed_key_t *a = (const feed_key_t *)lhs;
+    const feed_key_t *b = (const feed_key_t *)rhs;
+    if (a->arrival_time != b->arrival_time) {
+        return (a->arrival_time > b->arrival_time) - (a->arrival_time < b->arrival_time);
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+// Orders processes by arrival, keeping array order among equal arrivals so
+// the online tie-break by submission order matches the batch one by index.
+static int build_feed(schedule_replay_t *replay, const process_t *processes, int count) {
+    feed_key_t *keys = (feed_key_t *)malloc((size_t)count * sizeof(feed_key_t));
+    replay->feed = (process_t *)malloc((size_t)count * sizeof(process_t));
+    if (!keys || !replay->feed) {
+        free(keys);
+        return SCHED_ERR_ALLOC;
+    }
+
+    for (int i = 0; i < count; i++) {
+        replay->feed[i] = processes[i];
+    }
+    initialize_process_runtime_fields(replay->feed, count);
+    for (int i = 0; i < count; i++) {
+        keys[i].arrival_time = replay->feed[i].arrival_time;
+        keys[i].index = i;
+    }
+    qsort(keys, (size_t)count, sizeof(feed_key_t), compare_feed_keys);
+
+    process_t *sorted = (process_t *)malloc((size_t)count * sizeof(process_t));
+    if (!sorted) {
+        free(keys);
+        return SCHED_ERR_ALLOC;
+    }
+    replay->feed_source = (int *)malloc((size_t)count * sizeof(int));
+    if (!replay->feed_source) {
+        free(sorted);
+        free(keys);
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < count; i++) {
+        sorted[i] = replay->feed[keys[i].index];
+        replay->feed_source[i] = keys[i].index;
+    }
+    free(replay->feed);
+    replay->feed = sorted;
+    replay->feed_count = count;
+    free(keys);
+    return SCHED_OK;
+}
+
+static int submit_until(const schedule_replay_t *replay, online_scheduler_t *sim, int *submitted, int time) {
+    while (*submitted < replay->feed_count && replay->feed[*submitted].arrival_time < time) {
+        if (online_scheduler_submit(sim, &replay->feed[*submitted]) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+        (*submitted)++;
+    }
+    return SCHED_OK;
+}
+
+static int collect_output(schedule_replay_t *replay, online_scheduler_t *sim) {
+    timeline_event_t *events = NULL;
+    process_t *completed = NULL;
+    int count = 0;
+
+    if (online_scheduler_drain_events(sim, &events, &count) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < count; i++) {
+        if (timeline_builder_add(&replay->timeline,
+                                 events[i].process_id,
+                                 events[i].process_name,
+                                 events[i].start_time,
+                                 events[i].end_time) != SCHED_OK) {
+            free(events);
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    free(events);
+
+    if (online_scheduler_drain_completed(sim, &completed, &count) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    free(completed);
+    return SCHED_OK;
+}
+
+static int reserve_checkpoints(schedule_replay_t *replay, int needed) {
+    if (needed <= replay->checkpoint_capacity) {
+        return SCHED_OK;
+    }
+
+    int new_capacity = (replay->checkpoint_capacity == 0) ? 16 : replay->checkpoint_capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    replay_checkpoint_t **resized = (replay_checkpoint_t **)realloc(
+        replay->checkpoints, (size_t)new_capacity * sizeof(replay_checkpoint_t *));
+    if (!resized) {
+        return SCHED_ERR_ALLOC;
+    }
+    replay->checkpoints = resized;
+    replay->checkpoint_capacity = new_capacity;
+    return SCHED_OK;
+}
+
+static int push_checkpoint(schedule_replay_t *replay, const online_scheduler_t *sim, int time, int submitted) {
+    if (reserve_checkpoints(replay, replay->checkpoint_count + 1) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    replay_checkpoint_t *checkpoint = (replay_checkpoint_t *)malloc(sizeof(replay_checkpoint_t));
+    if (!checkpoint) {
+        return SCHED_ERR_ALLOC;
+    }
+    if (online_scheduler_clone(sim, &checkpoint->state) != SCHED_OK) {
+        free(checkpoint);
+        return SCHED_ERR_ALLOC;
+    }
+    checkpoint->refs = 1;
+    checkpoint->time = time;
+    checkpoint->submitted = submitted;
+    checkpoint->timeline_count = replay->timeline.count;
+    replay->checkpoints[replay->checkpoint_count++] = checkpoint;
+    return SCHED_OK;
+}
+
+// Runs sim to completion from `time`, checkpointing every interval. sim is
+// consumed.
+static int record_from(schedule_replay_t *replay, online_scheduler_t *sim, int time, int submitted) {
+    for (;;) {
+        if (submit_until(replay, sim, &submitted, time) != SCHED_OK ||
+            online_scheduler_advance_to(sim, time) != SCHED_OK ||
+            collect_output(replay, sim) != SCHED_OK ||
+            push_checkpoint(replay, sim, time, submitted) != SCHED_OK) {
+            online_scheduler_destroy(sim);
+            return SCHED_ERR_ALLOC;
+        }
+
+        if ((submitted == replay->feed_count && online_scheduler_active_count(sim) == 0) ||
+            time > INT_MAX - replay->interval) {
+            break;
+        }
+        time += replay->interval;
+    }
+
+    int result = online_scheduler_metrics(sim, &replay->metrics);
+    online_scheduler_destroy(sim);
+    return result;
+}
+
+int schedule_replay_create(
+    const process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    int checkpoint_interval,
+    schedule_replay_t **replay
+) {
+    if (!processes || process_count <= 0 || !config || checkpoint_interval <= 0 || !replay ||
+        sched_validate_config(config) != SCHED_OK) {
+        return SCHED_ERR_ARGS;
+    }
+    *replay = NULL;
+
+    schedule_replay_t *out = (schedule_replay_t *)calloc(1, sizeof(schedule_replay_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+    out->config = *config;
+    out->interval = checkpoint_interval;
+
+    online_scheduler_t *sim = NULL;
+    if (timeline_builder_init(&out->timeline) != SCHED_OK ||
+        build_feed(out, processes, process_count) != SCHED_OK ||
+        online_scheduler_create(config, &sim) != SCHED_OK ||
+        record_from(out, sim, 0, 0) != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+
+    *replay = out;
+    return SCHED_OK;
+}
+
+void schedule_replay_destroy(schedule_replay_t *replay) {
+    if (!replay) {
+        return;
+    }
+    for (int i = 0; i < replay->checkpoint_count; i++) {
+        replay_checkpoint_t *checkpoint = replay->checkpoints[i];
+        if (--checkpoint->refs == 0) {
+            online_scheduler_destroy(checkpoint->state);
+            free(checkpoint);
+        }
+    }
+    online_scheduler_destroy(replay->cursor);
+    timeline_builder_free(&replay->timeline);
+    free(replay->checkpoints);
+    free(replay->feed);
+    free(replay->feed_source);
+    free(replay);
+}
+
+int schedule_replay_timeline(const schedule_replay_t *replay, const timeline_event_t **timeline, int *timeline_count) {
+    if (!replay || !timeline || !timeline_count) {
+        return SCHED_ERR_ARGS;
+    }
+    *timeline = replay->timeline.events;
+    *timeline_count = replay->timeline.count;
+    return SCHED_OK;
+}
+
+int schedule_replay_metrics(const schedule_replay_t *replay, metrics_t *metrics) {
+    if (!replay || !metrics) {
+        return SCHED_ERR_ARGS;
+    }
+    *metrics = replay->metrics;
+    return SCHED_OK;
+}
+
+int schedule_replay_checkpoint_count(const schedule_replay_t *replay) {
+    return replay ? replay->checkpoint_count : 0;
+}
+
+int schedule_replay_seek(schedule_replay_t *replay, int time, online_scheduler_t **state) {
+    if (!replay || !state || time < 0) {
+        return SCHED_ERR_ARGS;
+    }
+    *state = NULL;
+
+    int index = time / replay->interval;
+    if (index >= replay->checkpoint_count) {
+        index = replay->checkpoint_count - 1;
+    }
+    const replay_checkpoint_t *checkpoint = replay->checkpoints[index];
+
+    int result = replay->cursor
+        ? online_scheduler_restore(replay->cursor, checkpoint->state)
+        : online_scheduler_clone(checkpoint->state, &replay->cursor);
+    if (result != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    int submitted = checkpoint->submitted;
+    if (submit_until(replay, replay->cursor, &submitted, time) != SCHED_OK ||
+        online_scheduler_advance_to(replay->cursor, time) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    *state = replay->cursor;
+    return SCHED_OK;
+}
+
+// Writes previous' feed with the delta applied into replay and returns the
+// earliest time the change can influence a decision.
+static int build_edited_feed(
+    schedule_replay_t *replay,
+    const schedule_replay_t *previous,
+    const schedule_delta_t *delta,
+    int *affected_time
+) {
+    int old_count = previous->feed_count;
+    int new_count = old_count + (delta->kind == SCHEDULE_DELTA_ADD) - (delta->kind == SCHEDULE_DELTA_REMOVE);
+
+    replay->feed = (process_t *)malloc((size_t)new_count * sizeof(process_t));
+    replay->feed_source = (int *)malloc((size_t)new_count * sizeof(int));
+    if (!replay->feed || !replay->feed_source) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    process_t edited = delta->process;
+    initialize_process_runtime_fields(&edited, 1);
+    int edited_source = (delta->kind == SCHEDULE_DELTA_ADD) ? old_count : delta->index;
+    bool inserting = delta->kind != SCHEDULE_DELTA_REMOVE;
+    *affected_time = inserting ? edited.arrival_time : INT_MAX;
+
+    int out = 0;
+    for (int i = 0; i <= old_count; i++) {
+        // Equal arrivals stay in caller index order, as in build_feed.
+        if (inserting && (i == old_count || previous->feed[i].arrival_time > edited.arrival_time ||
+                          (previous->feed[i].arrival_time == edited.arrival_time &&
+                           previous->feed_source[i] > edited_source))) {
+            replay->feed[out] = edited;
+            replay->feed_source[out] = edited_source;
+            out++;
+            inserting = false;
+        }
+        if (i == old_count) {
+            break;
+        }
+
+        int source = previous->feed_source[i];
+        if (delta->kind != SCHEDULE_DELTA_ADD && source == delta->index) {
+            if (previous->feed[i].arrival_time < *affected_time) {
+                *affected_time = previous->feed[i].arrival_time;
+            }
+            continue;
+        }
+        replay->feed[out] = previous->feed[i];
+        replay->feed_source[out] = (delta->kind == SCHEDULE_DELTA_REMOVE && source > delta->index) ? source - 1 : source;
+        out++;
+    }
+
+    replay->feed_count = new_count;
+    return SCHED_OK;
+}
+
+int schedule_replay_apply(const schedule_replay_t *previous, const schedule_delta_t *delta, schedule_replay_t **updated) {
+    if (!previous || !delta || !updated) {
+        return SCHED_ERR_ARGS;
+    }
+    *updated = NULL;
+
+    if (delta->kind != SCHEDULE_DELTA_ADD && delta->kind != SCHEDULE_DELTA_REMOVE &&
+        delta->kind != SCHEDULE_DELTA_MODIFY) {
+        return SCHED_ERR_ARGS;
+    }
+    if (delta->kind != SCHEDULE_DELTA_ADD && (delta->index < 0 || delta->index >= previous->feed_count)) {
+        return SCHED_ERR_ARGS;
+    }
+    if (delta->kind == SCHEDULE_DELTA_REMOVE && previous->feed_count == 1) {
+        return SCHED_ERR_ARGS;
+    }
+
+    schedule_replay_t *out = (schedule_replay_t *)calloc(1, sizeof(schedule_replay_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+    out->config = previous->config;
+    out->interval = previous->interval;
+
+    int affected_time = 0;
+    if (build_edited_feed(out, previous, delta, &affected_time) != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+
+    // Decisions before the affected time only saw processes that arrived
+    // earlier, so every checkpoint up to it is still valid.
+    int keep = 0;
+    while (keep < previous->checkpoint_count && previous->checkpoints[keep]->time <= affected_time) {
+        keep++;
+    }
+    if (reserve_checkpoints(out, keep) != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < keep; i++) {
+        previous->checkpoints[i]->refs++;
+        out->checkpoints[out->checkpoint_count++] = previous->checkpoints[i];
+    }
+
+    // Segments recorded before the checkpoint are final and already merged.
+    const replay_checkpoint_t *resume = out->checkpoints[keep - 1];
+    if (timeline_builder_copy_prefix(&out->timeline, &previous->timeline, resume->timeline_count) != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+
+    online_scheduler_t *sim = NULL;
+    if (online_scheduler_clone(resume->state, &sim) != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+
+    int result = SCHED_OK;
+    if (resume->time > INT_MAX - out->interval) {
+        result = online_scheduler_metrics(sim, &out->metrics);
+        online_scheduler_destroy(sim);
+    } else {
+        result = record_from(out, sim, resume->time + out->interval, resume->submitted);
+    }
+    if (result != SCHED_OK) {
+        schedule_replay_destroy(out);
+        return SCHED_ERR_ALLOC;
+    }
+
+    *updated = out;
+    return SCHED_OK;
+}
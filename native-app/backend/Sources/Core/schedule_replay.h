@@ -0,0 +1,61 @@
+#ifndef SCHEDULE_REPLAY_H
+#define SCHEDULE_REPLAY_H
+
+#include "online_scheduler.h"
+#include "process_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A recorded schedule with simulator checkpoints every checkpoint_interval
+// time units. Seeking restores the nearest earlier checkpoint and replays
+// only the distance from it, so scrubbing and rewinding never restart at 0.
+// Checkpoint memory is (horizon / interval) snapshots of the active set.
+typedef struct schedule_replay schedule_replay_t;
+
+int schedule_replay_create(
+    const process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    int checkpoint_interval,
+    schedule_replay_t **replay
+);
+void schedule_replay_destroy(schedule_replay_t *replay);
+
+// Full timeline and final metrics of the recorded run.
+int schedule_replay_timeline(const schedule_replay_t *replay, const timeline_event_t **timeline, int *timeline_count);
+int schedule_replay_metrics(const schedule_replay_t *replay, metrics_t *metrics);
+int schedule_replay_checkpoint_count(const schedule_replay_t *replay);
+
+// Positions the replay's simulator at `time` and returns it. The simulator
+// stays owned by the replay and is valid until the next seek. Processes
+// arriving at or after `time` have not been submitted, so callers resuming
+// from that point feed the rest themselves.
+int schedule_replay_seek(schedule_replay_t *replay, int time, online_scheduler_t **state);
+
+typedef enum {
+    SCHEDULE_DELTA_ADD = 0,
+    SCHEDULE_DELTA_REMOVE = 1,
+    SCHEDULE_DELTA_MODIFY = 2
+} schedule_delta_kind_t;
+
+// index names a process by its position in the array the replay was built
+// from (ignored for ADD, which appends). process is ignored for REMOVE.
+typedef struct {
+    schedule_delta_kind_t kind;
+    int index;
+    process_t process;
+} schedule_delta_t;
+
+// What-if edit: builds the replay of the edited workload by reusing the
+// checkpoints, recorded segments and metric accumulators from before the
+// earliest time the edit can affect, then simulating only the rest.
+// previous is left untouched and both replays stay valid independently.
+int schedule_replay_apply(const schedule_replay_t *previous, const schedule_delta_t *delta, schedule_replay_t **updated);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHEDULE_REPLAY_H
@@ -1,247 +1,150 @@
 #include "scheduler.h"
 
 #include "metrics.h"
+#include "ready_queue.h"
+#include "sched_internal.h"
 #include "utils.h"
 
 #include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-enum {
-    SCHED_OK = 0,
-    SCHED_ERR_ARGS = -1,
-    SCHED_ERR_ALLOC = -2
-};
-
-typedef struct {
-    timeline_event_t *events;
-    int count;
-    int capacity;
-} timeline_builder_t;
-
-typedef struct {
-    int *items;
-    int head;
-    int tail;
-    int size;
-    int capacity;
-} int_queue_t;
-
-static int timeline_builder_init(timeline_builder_t *builder) {
-    if (!builder) {
-        return SCHED_ERR_ARGS;
-    }
-    builder->capacity = 64;
-    builder->count = 0;
-    builder->events = (timeline_event_t *)calloc((size_t)builder->capacity, sizeof(timeline_event_t));
-    return builder->events ? SCHED_OK : SCHED_ERR_ALLOC;
-}
-
-static void timeline_builder_free(timeline_builder_t *builder) {
-    if (!builder) {
-        return;
+#ifdef SCHED_ENABLE_STATS
+static double stats_clock(const sched_stats_t *stats) {
+    if (!stats) {
+        return 0.0;
     }
-    free(builder->events);
-    builder->events = NULL;
-    builder->count = 0;
-    builder->capacity = 0;
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
 }
 
-static int timeline_builder_grow(timeline_builder_t *builder) {
-    int new_capacity = builder->capacity * 2;
-    if (new_capacity < 0) {
-        return SCHED_ERR_ALLOC;
-    }
-
-    timeline_event_t *resized = (timeline_event_t *)realloc(builder->events, (size_t)new_capacity * sizeof(timeline_event_t));
-    if (!resized) {
-        return SCHED_ERR_ALLOC;
+// Charges the time since *since to phase and restarts the clock there.
+static void stats_phase(sched_stats_t *stats, sched_phase_t phase, double *since) {
+    if (stats) {
+        double now = stats_clock(stats);
+        stats->phase_seconds[phase] += now - *since;
+        *since = now;
     }
-
-    builder->events = resized;
-    builder->capacity = new_capacity;
-    return SCHED_OK;
 }
-
-static int timeline_builder_add(
-    timeline_builder_t *builder,
-    int process_id,
-    const char *process_name,
-    int start_time,
-    int end_time
-) {
-    if (!builder || !builder->events || !process_name || end_time <= start_time) {
-        return SCHED_ERR_ARGS;
-    }
-
-    // Merge adjacent segments for the same process to avoid fake context switches.
-    if (builder->count > 0) {
-        timeline_event_t *last = &builder->events[builder->count - 1];
-        if (last->process_id == process_id && last->end_time == start_time) {
-            last->end_time = end_time;
-            return SCHED_OK;
-        }
-    }
-
-    if (builder->count == builder->capacity) {
-        int grow_result = timeline_builder_grow(builder);
-        if (grow_result != SCHED_OK) {
-            return grow_result;
-        }
-    }
-
-    timeline_event_t *event = &builder->events[builder->count++];
-    event->process_id = process_id;
-    safe_copy_string(event->process_name, sizeof(event->process_name), process_name);
-    event->start_time = start_time;
-    event->end_time = end_time;
-    return SCHED_OK;
+#else
+static double stats_clock(const sched_stats_t *stats) {
+    (void)stats;
+    return 0.0;
 }
 
-static int int_queue_init(int_queue_t *queue, int initial_capacity) {
-    if (!queue || initial_capacity <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    queue->items = (int *)malloc((size_t)initial_capacity * sizeof(int));
-    if (!queue->items) {
-        return SCHED_ERR_ALLOC;
-    }
-    queue->head = 0;
-    queue->tail = 0;
-    queue->size = 0;
-    queue->capacity = initial_capacity;
-    return SCHED_OK;
+static void stats_phase(sched_stats_t *stats, sched_phase_t phase, double *since) {
+    (void)stats;
+    (void)phase;
+    (void)since;
 }
+#endif
 
-static void int_queue_free(int_queue_t *queue) {
-    if (!queue) {
-        return;
-    }
-    free(queue->items);
-    queue->items = NULL;
-    queue->head = 0;
-    queue->tail = 0;
-    queue->size = 0;
-    queue->capacity = 0;
+static void *run_calloc(sched_run_t *run, size_t count, size_t size) {
+    SCHED_STAT_ADD(run, allocations, 1);
+    return calloc(count, size);
 }
 
-static int int_queue_grow(int_queue_t *queue) {
-    int new_capacity = queue->capacity * 2;
-    int *new_items = (int *)malloc((size_t)new_capacity * sizeof(int));
-    if (!new_items) {
-        return SCHED_ERR_ALLOC;
-    }
-
-    for (int i = 0; i < queue->size; i++) {
-        new_items[i] = queue->items[(queue->head + i) % queue->capacity];
+static int run_queue_push(sched_run_t *run, int_queue_t *queue, int value) {
+#ifdef SCHED_ENABLE_STATS
+    if (!run->stats) {
+        return int_queue_push(queue, value);
     }
-
-    free(queue->items);
-    queue->items = new_items;
-    queue->capacity = new_capacity;
-    queue->head = 0;
-    queue->tail = queue->size;
-    return SCHED_OK;
+    int capacity = queue->capacity;
+    int result = int_queue_push(queue, value);
+    run->stats->queue_pushes++;
+    run->stats->reallocations += (queue->capacity != capacity) ? 1 : 0;
+    return result;
+#else
+    (void)run;
+    return int_queue_push(queue, value);
+#endif
 }
 
-static int int_queue_push(int_queue_t *queue, int value) {
-    if (!queue || !queue->items) {
-        return SCHED_ERR_ARGS;
+// A level's first buffer is allocated by its first push.
+static int run_ready_push(sched_run_t *run, ready_queue_t *ready, int level, ready_entry_t entry) {
+#ifdef SCHED_ENABLE_STATS
+    if (!run->stats) {
+        return ready_queue_push(ready, level, entry);
     }
-    if (queue->size == queue->capacity) {
-        int grow_result = int_queue_grow(queue);
-        if (grow_result != SCHED_OK) {
-            return grow_result;
-        }
+    int capacity = (level >= 0 && level < ready->level_count) ? ready->levels[level].capacity : 0;
+    int result = ready_queue_push(ready, level, entry);
+    if (result == SCHED_OK && ready->levels[level].capacity != capacity) {
+        run->stats->allocations += (capacity == 0) ? 1 : 0;
+        run->stats->reallocations += (capacity == 0) ? 0 : 1;
     }
-
-    queue->items[queue->tail] = value;
-    queue->tail = (queue->tail + 1) % queue->capacity;
-    queue->size++;
-    return SCHED_OK;
+    run->stats->queue_pushes++;
+    return result;
+#else
+    (void)run;
+    return ready_queue_push(ready, level, entry);
+#endif
 }
 
-static int int_queue_pop(int_queue_t *queue, int *value) {
-    if (!queue || !value || queue->size == 0) {
-        return SCHED_ERR_ARGS;
+static int compare_by_arrival_then_id(const sched_run_t *run, int li, int ri) {
+    int left_arrival = sched_arrival(run, li);
+    int right_arrival = sched_arrival(run, ri);
+    if (left_arrival != right_arrival) {
+        return left_arrival - right_arrival;
     }
-
-    *value = queue->items[queue->head];
-    queue->head = (queue->head + 1) % queue->capacity;
-    queue->size--;
-    return SCHED_OK;
-}
-
-static int int_queue_empty(const int_queue_t *queue) {
-    return (!queue || queue->size == 0);
+    return sched_process_id(run, li) - sched_process_id(run, ri);
 }
 
-static int compare_by_arrival_then_id(const void *lhs, const void *rhs, void *ctx) {
-    const process_t *processes = (const process_t *)ctx;
-    int li = *(const int *)lhs;
-    int ri = *(const int *)rhs;
-
-    if (processes[li].arrival_time != processes[ri].arrival_time) {
-        return processes[li].arrival_time - processes[ri].arrival_time;
+// Stable bottom-up merge sort: O(n log n) where the insertion sort it
+// replaces went quadratic on unsorted input, with the same resulting order.
+static int sort_indices_by_arrival_then_id(int *indices, int count, const sched_run_t *run) {
+    if (!indices || count <= 1) {
+        return SCHED_OK;
     }
-    return processes[li].process_id - processes[ri].process_id;
-}
 
-static void sort_indices_by_arrival_then_id(int *indices, int count, const process_t *processes) {
-    if (!indices || !processes || count <= 1) {
-        return;
+    int *scratch = (int *)malloc((size_t)count * sizeof(int));
+    if (!scratch) {
+        return SCHED_ERR_ALLOC;
     }
 
-    for (int i = 1; i < count; i++) {
-        int key = indices[i];
-        int j = i - 1;
-        while (j >= 0) {
-            int cmp = compare_by_arrival_then_id(&key, &indices[j], (void *)processes);
-            if (cmp >= 0) {
-                break;
+    int *src = indices;
+    int *dst = scratch;
+    for (int width = 1; width < count; width *= 2) {
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = (lo + width < count) ? lo + width : count;
+            int hi = (mid + width < count) ? mid + width : count;
+            int left = lo;
+            int right = mid;
+            for (int out = lo; out < hi; out++) {
+                if (right >= hi ||
+                    (left < mid && compare_by_arrival_then_id(run, src[left], src[right]) <= 0)) {
+                    dst[out] = src[left++];
+                } else {
+                    dst[out] = src[right++];
+                }
             }
-            indices[j + 1] = indices[j];
-            j--;
         }
-        indices[j + 1] = key;
+        int *swap = src;
+        src = dst;
+        dst = swap;
     }
+    if (src != indices) {
+        (void)memcpy(indices, src, (size_t)count * sizeof(int));
+    }
+    free(scratch);
+    return SCHED_OK;
 }
 
-static int find_next_arrival(const process_t *processes, const bool *completed, int count, int current_time) {
+static int find_next_arrival(const sched_run_t *run, const bool *completed, int current_time) {
     int next_arrival = INT_MAX;
-    for (int i = 0; i < count; i++) {
-        if (!completed[i] && processes[i].remaining_time > 0 && processes[i].arrival_time > current_time) {
-            if (processes[i].arrival_time < next_arrival) {
-                next_arrival = processes[i].arrival_time;
+    for (int i = 0; i < run->count; i++) {
+        if (!completed[i] && run->tasks[i].remaining_time > 0) {
+            int arrival = sched_arrival(run, i);
+            if (arrival > current_time && arrival < next_arrival) {
+                next_arrival = arrival;
             }
         }
     }
     return next_arrival;
 }
 
-static void finalize_completed_process(process_t *proc, int completion_time) {
-    proc->remaining_time = 0;
-    proc->completion_time = completion_time;
-    proc->turnaround_time = completion_time - proc->arrival_time;
-    proc->waiting_time = proc->turnaround_time - proc->burst_time;
-    if (proc->waiting_time < 0) {
-        proc->waiting_time = 0;
-    }
-    if (proc->response_time < 0) {
-        proc->response_time = 0;
-    }
-}
-
-static int init_timeline_out(timeline_event_t **timeline, int *timeline_count) {
-    if (!timeline || !timeline_count) {
-        return SCHED_ERR_ARGS;
-    }
-    *timeline = NULL;
-    *timeline_count = 0;
-    return SCHED_OK;
-}
-
 static int allocate_index_array(int count, int **indices_out) {
     if (!indices_out || count <= 0) {
         return SCHED_ERR_ARGS;
@@ -258,250 +161,192 @@ static int allocate_index_array(int count, int **indices_out) {
     return SCHED_OK;
 }
 
-static int initial_current_time(const process_t *processes, int count) {
-    int min_arrival = INT_MAX;
-    for (int i = 0; i < count; i++) {
-        if (processes[i].remaining_time > 0 && processes[i].arrival_time < min_arrival) {
-            min_arrival = processes[i].arrival_time;
-        }
+// Indices of the processes sorted by (arrival, id); the sort is timed as its
+// own phase.
+static int run_arrival_order(sched_run_t *run, int **order_out) {
+    double started = stats_clock(run->stats);
+    int *order = NULL;
+    if (allocate_index_array(run->count, &order) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
     }
-    if (min_arrival == INT_MAX) {
-        return 0;
+    SCHED_STAT_ADD(run, allocations, (run->count > 1) ? 2 : 1);  // the indices and the merge scratch
+    if (sort_indices_by_arrival_then_id(order, run->count, run) != SCHED_OK) {
+        free(order);
+        return SCHED_ERR_ALLOC;
     }
-    return (min_arrival < 0) ? 0 : min_arrival;
+    stats_phase(run->stats, SCHED_PHASE_SORT, &started);
+    *order_out = order;
+    return SCHED_OK;
 }
 
-static int count_context_switches(const timeline_event_t *timeline, int timeline_count) {
-    if (!timeline || timeline_count <= 1) {
-        return 0;
-    }
-
-    int switches = 0;
-    for (int i = 1; i < timeline_count; i++) {
-        if (timeline[i].process_id != timeline[i - 1].process_id) {
-            switches++;
+static int initial_current_time(const sched_run_t *run) {
+    int min_arrival = INT_MAX;
+    for (int i = 0; i < run->count; i++) {
+        if (run->tasks[i].remaining_time > 0 && sched_arrival(run, i) < min_arrival) {
+            min_arrival = sched_arrival(run, i);
         }
     }
-    return switches;
+    return (min_arrival == INT_MAX) ? 0 : min_arrival;
 }
 
-static int build_and_return_timeline(
-    timeline_builder_t *builder,
-    timeline_event_t **timeline,
-    int *timeline_count
-) {
-    if (!builder || !timeline || !timeline_count) {
-        return SCHED_ERR_ARGS;
-    }
-
-    if (builder->count == 0) {
-        *timeline = NULL;
-        *timeline_count = 0;
-        return SCHED_OK;
+static void mark_started(sched_run_t *run, int index, int time) {
+    sched_task_t *task = &run->tasks[index];
+    if (task->first_run_time < 0) {
+        task->first_run_time = time;
+        task->response_time = time - sched_arrival(run, index);
     }
+}
 
-    timeline_event_t *out = (timeline_event_t *)malloc((size_t)builder->count * sizeof(timeline_event_t));
-    if (!out) {
-        return SCHED_ERR_ALLOC;
+// Processes with no work complete at their arrival without being dispatched.
+static int finalize_empty(sched_run_t *run, bool *completed) {
+    int finished_count = 0;
+    for (int i = 0; i < run->count; i++) {
+        if (sched_burst(run, i) == 0) {
+            run->tasks[i].first_run_time = sched_arrival(run, i);
+            run->tasks[i].response_time = 0;
+            sched_run_finalize(run, i, sched_arrival(run, i));
+            completed[i] = true;
+            finished_count++;
+        }
     }
-
-    (void)memcpy(out, builder->events, (size_t)builder->count * sizeof(timeline_event_t));
-    *timeline = out;
-    *timeline_count = builder->count;
-    return SCHED_OK;
+    return finished_count;
 }
 
-int fcfs_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
-    }
 
-    initialize_process_runtime_fields(processes, count);
+static int fcfs_run(sched_run_t *run) {
+    int count = run->count;
 
     int *indices = NULL;
-    if (allocate_index_array(count, &indices) != SCHED_OK) {
-        return SCHED_ERR_ALLOC;
-    }
-
-    sort_indices_by_arrival_then_id(indices, count, processes);
-
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
-        free(indices);
+    if (run_arrival_order(run, &indices) != SCHED_OK) {
         return SCHED_ERR_ALLOC;
     }
 
     int current_time = 0;
     for (int n = 0; n < count; n++) {
-        process_t *proc = &processes[indices[n]];
+        int index = indices[n];
+        int arrival = sched_arrival(run, index);
+        int burst = sched_burst(run, index);
 
-        if (current_time < proc->arrival_time) {
-            current_time = proc->arrival_time;
+        if (current_time < arrival) {
+            current_time = arrival;
+            SCHED_STAT_ADD(run, idle_jumps, (n > 0) ? 1 : 0);
         }
 
-        if (proc->first_run_time < 0) {
-            proc->first_run_time = current_time;
-            proc->response_time = current_time - proc->arrival_time;
+        if (burst > 0 && sched_run_charge_switch(run, index, &current_time) != SCHED_OK) {
+            free(indices);
+            return SCHED_ERR_ALLOC;
         }
 
+        mark_started(run, index, current_time);
+
         int start = current_time;
-        int end = current_time + proc->burst_time;
+        int end = current_time + burst;
 
-        if (proc->burst_time > 0) {
-            if (timeline_builder_add(&builder, proc->process_id, proc->name, start, end) != SCHED_OK) {
-                timeline_builder_free(&builder);
+        if (burst > 0) {
+            if (sched_run_add_segment(run, indices[n], start, end) != SCHED_OK) {
                 free(indices);
                 return SCHED_ERR_ALLOC;
             }
         }
 
         current_time = end;
-        finalize_completed_process(proc, current_time);
+        sched_run_finalize(run, indices[n], current_time);
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
     free(indices);
-    return result;
+    return SCHED_OK;
 }
 
-int sjf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
-    }
-
-    initialize_process_runtime_fields(processes, count);
+static int sjf_run(sched_run_t *run) {
+    int count = run->count;
 
-    bool *completed = (bool *)calloc((size_t)count, sizeof(bool));
+    bool *completed = (bool *)run_calloc(run, (size_t)count, sizeof(bool));
     if (!completed) {
         return SCHED_ERR_ALLOC;
     }
 
-    int finished_count = 0;
-    int current_time = initial_current_time(processes, count);
-
-    // Mark zero-burst processes as completed at arrival time.
-    for (int i = 0; i < count; i++) {
-        if (processes[i].burst_time == 0) {
-            processes[i].first_run_time = processes[i].arrival_time;
-            processes[i].response_time = 0;
-            finalize_completed_process(&processes[i], processes[i].arrival_time);
-            completed[i] = true;
-            finished_count++;
-        }
-    }
-
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
-        free(completed);
-        return SCHED_ERR_ALLOC;
-    }
+    int current_time = initial_current_time(run);
+    int finished_count = finalize_empty(run, completed);
 
     while (finished_count < count) {
         int chosen = -1;
         int best_burst = INT_MAX;
+        int best_arrival = 0;
 
+        SCHED_STAT_ADD(run, selection_scans, 1);
+        SCHED_STAT_ADD(run, selection_visits, count);
         for (int i = 0; i < count; i++) {
-            if (completed[i] || processes[i].arrival_time > current_time || processes[i].remaining_time <= 0) {
+            int arrival = sched_arrival(run, i);
+            if (completed[i] || arrival > current_time || run->tasks[i].remaining_time <= 0) {
                 continue;
             }
+            SCHED_STAT_ADD(run, selection_comparisons, 1);
 
+            int burst = sched_burst(run, i);
             bool better = false;
-            if (processes[i].burst_time < best_burst) {
+            if (burst < best_burst) {
                 better = true;
-            } else if (processes[i].burst_time == best_burst && chosen >= 0 &&
-                       processes[i].arrival_time < processes[chosen].arrival_time) {
+            } else if (burst == best_burst && chosen >= 0 && arrival < best_arrival) {
                 better = true;
-            } else if (processes[i].burst_time == best_burst && chosen >= 0 &&
-                       processes[i].arrival_time == processes[chosen].arrival_time &&
-                       processes[i].process_id < processes[chosen].process_id) {
+            } else if (burst == best_burst && chosen >= 0 && arrival == best_arrival &&
+                       sched_process_id(run, i) < sched_process_id(run, chosen)) {
                 better = true;
             }
 
             if (chosen < 0 || better) {
                 chosen = i;
-                best_burst = processes[i].burst_time;
+                best_burst = burst;
+                best_arrival = arrival;
             }
         }
 
         if (chosen < 0) {
-            int next_arrival = find_next_arrival(processes, completed, count, current_time);
+            int next_arrival = find_next_arrival(run, completed, current_time);
+            SCHED_STAT_ADD(run, next_arrival_scans, 1);
             if (next_arrival == INT_MAX) {
                 break;
             }
+            SCHED_STAT_ADD(run, idle_jumps, 1);
             current_time = next_arrival;
             continue;
         }
 
-        process_t *proc = &processes[chosen];
-        if (proc->first_run_time < 0) {
-            proc->first_run_time = current_time;
-            proc->response_time = current_time - proc->arrival_time;
+        if (sched_run_charge_switch(run, chosen, &current_time) != SCHED_OK) {
+            free(completed);
+            return SCHED_ERR_ALLOC;
         }
 
+        mark_started(run, chosen, current_time);
+
         int start = current_time;
-        int end = current_time + proc->burst_time;
+        int end = current_time + best_burst;
 
-        if (timeline_builder_add(&builder, proc->process_id, proc->name, start, end) != SCHED_OK) {
-            timeline_builder_free(&builder);
+        if (sched_run_add_segment(run, chosen, start, end) != SCHED_OK) {
             free(completed);
             return SCHED_ERR_ALLOC;
         }
 
         current_time = end;
-        finalize_completed_process(proc, current_time);
+        sched_run_finalize(run, chosen, current_time);
         completed[chosen] = true;
         finished_count++;
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
     free(completed);
-    return result;
+    return SCHED_OK;
 }
 
-int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
-    }
-
-    initialize_process_runtime_fields(processes, count);
+static int srtf_run(sched_run_t *run) {
+    sched_task_t *tasks = run->tasks;
+    int count = run->count;
 
-    bool *completed = (bool *)calloc((size_t)count, sizeof(bool));
+    bool *completed = (bool *)run_calloc(run, (size_t)count, sizeof(bool));
     if (!completed) {
         return SCHED_ERR_ALLOC;
     }
 
-    int finished_count = 0;
-    int current_time = initial_current_time(processes, count);
-
-    for (int i = 0; i < count; i++) {
-        if (processes[i].burst_time == 0) {
-            processes[i].first_run_time = processes[i].arrival_time;
-            processes[i].response_time = 0;
-            finalize_completed_process(&processes[i], processes[i].arrival_time);
-            completed[i] = true;
-            finished_count++;
-        }
-    }
-
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
-        free(completed);
-        return SCHED_ERR_ALLOC;
-    }
+    int current_time = initial_current_time(run);
+    int finished_count = finalize_empty(run, completed);
 
     int running_index = -1;
     int segment_start = current_time;
@@ -509,48 +354,49 @@ int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline,
     while (finished_count < count) {
         int chosen = -1;
         int best_remaining = INT_MAX;
+        int best_arrival = 0;
 
+        SCHED_STAT_ADD(run, selection_scans, 1);
+        SCHED_STAT_ADD(run, selection_visits, count);
         for (int i = 0; i < count; i++) {
-            if (completed[i] || processes[i].arrival_time > current_time || processes[i].remaining_time <= 0) {
+            int arrival = sched_arrival(run, i);
+            if (completed[i] || arrival > current_time || tasks[i].remaining_time <= 0) {
                 continue;
             }
+            SCHED_STAT_ADD(run, selection_comparisons, 1);
 
             bool better = false;
-            if (processes[i].remaining_time < best_remaining) {
+            if (tasks[i].remaining_time < best_remaining) {
                 better = true;
-            } else if (processes[i].remaining_time == best_remaining && chosen >= 0 &&
-                       processes[i].arrival_time < processes[chosen].arrival_time) {
+            } else if (tasks[i].remaining_time == best_remaining && chosen >= 0 && arrival < best_arrival) {
                 better = true;
-            } else if (processes[i].remaining_time == best_remaining && chosen >= 0 &&
-                       processes[i].arrival_time == processes[chosen].arrival_time &&
-                       processes[i].process_id < processes[chosen].process_id) {
+            } else if (tasks[i].remaining_time == best_remaining && chosen >= 0 && arrival == best_arrival &&
+                       sched_process_id(run, i) < sched_process_id(run, chosen)) {
                 better = true;
             }
 
             if (chosen < 0 || better) {
                 chosen = i;
-                best_remaining = processes[i].remaining_time;
+                best_remaining = tasks[i].remaining_time;
+                best_arrival = arrival;
             }
         }
 
         if (chosen < 0) {
             if (running_index >= 0 && segment_start < current_time) {
-                if (timeline_builder_add(&builder,
-                                         processes[running_index].process_id,
-                                         processes[running_index].name,
-                                         segment_start,
-                                         current_time) != SCHED_OK) {
-                    timeline_builder_free(&builder);
+                if (sched_run_add_segment(run, running_index, segment_start, current_time) != SCHED_OK) {
                     free(completed);
                     return SCHED_ERR_ALLOC;
                 }
                 running_index = -1;
             }
 
-            int next_arrival = find_next_arrival(processes, completed, count, current_time);
+            int next_arrival = find_next_arrival(run, completed, current_time);
+            SCHED_STAT_ADD(run, next_arrival_scans, 1);
             if (next_arrival == INT_MAX) {
                 break;
             }
+            SCHED_STAT_ADD(run, idle_jumps, 1);
             current_time = next_arrival;
             segment_start = current_time;
             continue;
@@ -558,41 +404,32 @@ int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline,
 
         if (running_index != chosen) {
             if (running_index >= 0 && segment_start < current_time) {
-                if (timeline_builder_add(&builder,
-                                         processes[running_index].process_id,
-                                         processes[running_index].name,
-                                         segment_start,
-                                         current_time) != SCHED_OK) {
-                    timeline_builder_free(&builder);
+                if (sched_run_add_segment(run, running_index, segment_start, current_time) != SCHED_OK) {
                     free(completed);
                     return SCHED_ERR_ALLOC;
                 }
             }
 
+            if (sched_run_charge_switch(run, chosen, &current_time) != SCHED_OK) {
+                free(completed);
+                return SCHED_ERR_ALLOC;
+            }
+
             running_index = chosen;
             segment_start = current_time;
-
-            if (processes[chosen].first_run_time < 0) {
-                processes[chosen].first_run_time = current_time;
-                processes[chosen].response_time = current_time - processes[chosen].arrival_time;
-            }
+            mark_started(run, chosen, current_time);
         }
 
-        processes[chosen].remaining_time--;
+        tasks[chosen].remaining_time--;
         current_time++;
 
-        if (processes[chosen].remaining_time == 0) {
-            if (timeline_builder_add(&builder,
-                                     processes[chosen].process_id,
-                                     processes[chosen].name,
-                                     segment_start,
-                                     current_time) != SCHED_OK) {
-                timeline_builder_free(&builder);
+        if (tasks[chosen].remaining_time == 0) {
+            if (sched_run_add_segment(run, chosen, segment_start, current_time) != SCHED_OK) {
                 free(completed);
                 return SCHED_ERR_ALLOC;
             }
 
-            finalize_completed_process(&processes[chosen], current_time);
+            sched_run_finalize(run, chosen, current_time);
             completed[chosen] = true;
             finished_count++;
             running_index = -1;
@@ -600,34 +437,23 @@ int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline,
         }
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
     free(completed);
-    return result;
+    return SCHED_OK;
 }
 
-int round_robin_schedule(process_t *processes, int count, int quantum, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
-    }
-
-    initialize_process_runtime_fields(processes, count);
+static int round_robin_run(sched_run_t *run) {
+    int count = run->count;
+    int quantum = run->config->time_quantum;
 
     int safe_quantum = (quantum <= 0) ? 1 : quantum;
 
     int *arrival_order = NULL;
-    if (allocate_index_array(count, &arrival_order) != SCHED_OK) {
+    if (run_arrival_order(run, &arrival_order) != SCHED_OK) {
         return SCHED_ERR_ALLOC;
     }
 
-    sort_indices_by_arrival_then_id(arrival_order, count, processes);
-
-    bool *completed = (bool *)calloc((size_t)count, sizeof(bool));
-    bool *queued = (bool *)calloc((size_t)count, sizeof(bool));
+    bool *completed = (bool *)run_calloc(run, (size_t)count, sizeof(bool));
+    bool *queued = (bool *)run_calloc(run, (size_t)count, sizeof(bool));
     if (!completed || !queued) {
         free(arrival_order);
         free(completed);
@@ -636,6 +462,7 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
     }
 
     int_queue_t queue;
+    SCHED_STAT_ADD(run, allocations, 1);
     if (int_queue_init(&queue, (count < 16) ? 16 : count * 2) != SCHED_OK) {
         free(arrival_order);
         free(completed);
@@ -643,25 +470,15 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
         return SCHED_ERR_ALLOC;
     }
 
-    int finished_count = 0;
-    for (int i = 0; i < count; i++) {
-        if (processes[i].burst_time == 0) {
-            processes[i].first_run_time = processes[i].arrival_time;
-            processes[i].response_time = 0;
-            finalize_completed_process(&processes[i], processes[i].arrival_time);
-            completed[i] = true;
-            finished_count++;
-        }
-    }
-
-    int current_time = initial_current_time(processes, count);
+    int current_time = initial_current_time(run);
+    int finished_count = finalize_empty(run, completed);
     int next_arrival_idx = 0;
 
     // Prime queue with processes available at current_time.
-    while (next_arrival_idx < count && processes[arrival_order[next_arrival_idx]].arrival_time <= current_time) {
+    while (next_arrival_idx < count && sched_arrival(run, arrival_order[next_arrival_idx]) <= current_time) {
         int proc_index = arrival_order[next_arrival_idx++];
         if (!completed[proc_index] && !queued[proc_index]) {
-            if (int_queue_push(&queue, proc_index) != SCHED_OK) {
+            if (run_queue_push(run, &queue, proc_index) != SCHED_OK) {
                 int_queue_free(&queue);
                 free(arrival_order);
                 free(completed);
@@ -672,26 +489,17 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
         }
     }
 
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
-        int_queue_free(&queue);
-        free(arrival_order);
-        free(completed);
-        free(queued);
-        return SCHED_ERR_ALLOC;
-    }
-
     while (finished_count < count) {
         if (int_queue_empty(&queue)) {
             if (next_arrival_idx >= count) {
                 break;
             }
-            current_time = processes[arrival_order[next_arrival_idx]].arrival_time;
-            while (next_arrival_idx < count && processes[arrival_order[next_arrival_idx]].arrival_time <= current_time) {
+            current_time = sched_arrival(run, arrival_order[next_arrival_idx]);
+            SCHED_STAT_ADD(run, idle_jumps, 1);
+            while (next_arrival_idx < count && sched_arrival(run, arrival_order[next_arrival_idx]) <= current_time) {
                 int proc_index = arrival_order[next_arrival_idx++];
                 if (!completed[proc_index] && !queued[proc_index]) {
-                    if (int_queue_push(&queue, proc_index) != SCHED_OK) {
-                        timeline_builder_free(&builder);
+                    if (run_queue_push(run, &queue, proc_index) != SCHED_OK) {
                         int_queue_free(&queue);
                         free(arrival_order);
                         free(completed);
@@ -708,28 +516,33 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
         if (int_queue_pop(&queue, &proc_index) != SCHED_OK) {
             break;
         }
+        SCHED_STAT_ADD(run, queue_pops, 1);
         queued[proc_index] = false;
 
-        process_t *proc = &processes[proc_index];
-        if (proc->remaining_time <= 0) {
+        sched_task_t *task = &run->tasks[proc_index];
+        if (task->remaining_time <= 0) {
             continue;
         }
 
-        if (current_time < proc->arrival_time) {
-            current_time = proc->arrival_time;
+        if (current_time < sched_arrival(run, proc_index)) {
+            current_time = sched_arrival(run, proc_index);
         }
 
-        if (proc->first_run_time < 0) {
-            proc->first_run_time = current_time;
-            proc->response_time = current_time - proc->arrival_time;
+        if (sched_run_charge_switch(run, proc_index, &current_time) != SCHED_OK) {
+            int_queue_free(&queue);
+            free(arrival_order);
+            free(completed);
+            free(queued);
+            return SCHED_ERR_ALLOC;
         }
 
-        int slice = (proc->remaining_time < safe_quantum) ? proc->remaining_time : safe_quantum;
+        mark_started(run, proc_index, current_time);
+
+        int slice = (task->remaining_time < safe_quantum) ? task->remaining_time : safe_quantum;
         int start = current_time;
         int end = current_time + slice;
 
-        if (timeline_builder_add(&builder, proc->process_id, proc->name, start, end) != SCHED_OK) {
-            timeline_builder_free(&builder);
+        if (sched_run_add_segment(run, proc_index, start, end) != SCHED_OK) {
             int_queue_free(&queue);
             free(arrival_order);
             free(completed);
@@ -738,13 +551,12 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
         }
 
         current_time = end;
-        proc->remaining_time -= slice;
+        task->remaining_time -= slice;
 
-        while (next_arrival_idx < count && processes[arrival_order[next_arrival_idx]].arrival_time <= current_time) {
+        while (next_arrival_idx < count && sched_arrival(run, arrival_order[next_arrival_idx]) <= current_time) {
             int arrived_index = arrival_order[next_arrival_idx++];
-            if (!completed[arrived_index] && !queued[arrived_index] && processes[arrived_index].remaining_time > 0) {
-                if (int_queue_push(&queue, arrived_index) != SCHED_OK) {
-                    timeline_builder_free(&builder);
+            if (!completed[arrived_index] && !queued[arrived_index] && run->tasks[arrived_index].remaining_time > 0) {
+                if (run_queue_push(run, &queue, arrived_index) != SCHED_OK) {
                     int_queue_free(&queue);
                     free(arrival_order);
                     free(completed);
@@ -755,9 +567,8 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
             }
         }
 
-        if (proc->remaining_time > 0) {
-            if (int_queue_push(&queue, proc_index) != SCHED_OK) {
-                timeline_builder_free(&builder);
+        if (task->remaining_time > 0) {
+            if (run_queue_push(run, &queue, proc_index) != SCHED_OK) {
                 int_queue_free(&queue);
                 free(arrival_order);
                 free(completed);
@@ -766,244 +577,293 @@ int round_robin_schedule(process_t *processes, int count, int quantum, timeline_
             }
             queued[proc_index] = true;
         } else {
-            finalize_completed_process(proc, current_time);
+            sched_run_finalize(run, proc_index, current_time);
             completed[proc_index] = true;
             finished_count++;
         }
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
     int_queue_free(&queue);
     free(arrival_order);
     free(completed);
     free(queued);
-    return result;
+    return SCHED_OK;
 }
 
-int priority_np_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
+// Without aging, priorities inside 1..READY_QUEUE_MAX_LEVELS map straight onto
+// ready-queue levels. Aged keys are unbounded, so those runs use one heap.
+static bool priority_fits_buckets(const sched_run_t *run) {
+    if (run->config->aging_interval > 0) {
+        return false;
     }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
+    for (int i = 0; i < run->count; i++) {
+        if (sched_burst(run, i) > 0 && sched_priority(run, i) > READY_QUEUE_MAX_LEVELS) {
+            return false;
+        }
     }
+    return true;
+}
 
-    initialize_process_runtime_fields(processes, count);
+// Encodes the policy's tie-break: (priority, arrival, id) for the
+// non-preemptive policy, (priority, remaining, arrival) for the preemptive
+// one. In bucket mode the level carries the priority; the non-preemptive
+// policy pushes each level in (arrival, id) order, so its levels are FIFO.
+static ready_entry_t priority_entry(const sched_run_t *run, int index, int ready_since, bool bucketed, int *level) {
+    bool preemptive = run->config->algorithm == ALGO_PRIORITY_P;
+    int remaining = run->tasks[index].remaining_time;
+    int arrival = sched_arrival(run, index);
+    ready_entry_t entry;
+
+    if (bucketed) {
+        *level = sched_priority(run, index) - 1;
+        entry.key = preemptive ? remaining : arrival;
+        entry.tie1 = preemptive ? arrival : sched_process_id(run, index);
+        entry.tie2 = 0;
+    } else {
+        *level = 0;
+        entry.key = sched_priority_key(run, index, ready_since);
+        entry.tie1 = preemptive ? remaining : arrival;
+        entry.tie2 = preemptive ? arrival : sched_process_id(run, index);
+    }
+    entry.seq = index;
+    entry.index = index;
+    return entry;
+}
 
-    bool *completed = (bool *)calloc((size_t)count, sizeof(bool));
-    if (!completed) {
-        return SCHED_ERR_ALLOC;
-    }
+static int push_arrivals(
+    sched_run_t *run,
+    ready_queue_t *ready,
+    bool bucketed,
+    const int *arrival_order,
+    int *next_arrival,
+    const bool *completed,
+    int current_time
+) {
+    while (*next_arrival < run->count) {
+        int index = arrival_order[*next_arrival];
+        if (sched_arrival(run, index) > current_time) {
+            break;
+        }
+        (*next_arrival)++;
+        if (completed[index]) {
+            continue;
+        }
 
-    int finished_count = 0;
-    int current_time = initial_current_time(processes, count);
+        int level = 0;
+        ready_entry_t entry = priority_entry(run, index, sched_arrival(run, index), bucketed, &level);
+        if (run_ready_push(run, ready, level, entry) != SCHED_OK) {
+            return SCHED_ERR_ALLOC;
+        }
+    }
+    return SCHED_OK;
+}
 
-    for (int i = 0; i < count; i++) {
-        if (processes[i].burst_time == 0) {
-            processes[i].first_run_time = processes[i].arrival_time;
-            processes[i].response_time = 0;
-            finalize_completed_process(&processes[i], processes[i].arrival_time);
-            completed[i] = true;
-            finished_count++;
+// Returns the arrival time of the next process still to be queued, or INT_MAX.
+static int peek_next_arrival(const sched_run_t *run, const int *arrival_order, int next_arrival, const bool *completed) {
+    for (int i = next_arrival; i < run->count; i++) {
+        if (!completed[arrival_order[i]]) {
+            return sched_arrival(run, arrival_order[i]);
         }
     }
+    return INT_MAX;
+}
+
+static int priority_run_prepare(sched_run_t *run, bool **completed_out, int **arrival_order_out, int *finished_out) {
+    int count = run->count;
+
+    bool *completed = (bool *)run_calloc(run, (size_t)count, sizeof(bool));
+    if (!completed) {
+        return SCHED_ERR_ALLOC;
+    }
 
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
+    int *arrival_order = NULL;
+    if (run_arrival_order(run, &arrival_order) != SCHED_OK) {
         free(completed);
         return SCHED_ERR_ALLOC;
     }
 
-    while (finished_count < count) {
-        int chosen = -1;
-        int best_priority = INT_MAX;
+    *completed_out = completed;
+    *arrival_order_out = arrival_order;
+    *finished_out = finalize_empty(run, completed);
+    return SCHED_OK;
+}
 
-        for (int i = 0; i < count; i++) {
-            if (completed[i] || processes[i].arrival_time > current_time || processes[i].remaining_time <= 0) {
-                continue;
-            }
+static int priority_np_run(sched_run_t *run) {
+    int count = run->count;
 
-            bool better = false;
-            if (processes[i].priority < best_priority) {
-                better = true;
-            } else if (processes[i].priority == best_priority && chosen >= 0 &&
-                       processes[i].arrival_time < processes[chosen].arrival_time) {
-                better = true;
-            } else if (processes[i].priority == best_priority && chosen >= 0 &&
-                       processes[i].arrival_time == processes[chosen].arrival_time &&
-                       processes[i].process_id < processes[chosen].process_id) {
-                better = true;
-            }
+    bool *completed = NULL;
+    int *arrival_order = NULL;
+    int finished_count = 0;
+    if (priority_run_prepare(run, &completed, &arrival_order, &finished_count) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
 
-            if (chosen < 0 || better) {
-                chosen = i;
-                best_priority = processes[i].priority;
-            }
+    bool bucketed = priority_fits_buckets(run);
+    ready_queue_t ready;
+    if (bucketed) {
+        (void)ready_queue_init_fifo(&ready, READY_QUEUE_MAX_LEVELS);
+    } else {
+        (void)ready_queue_init(&ready, 1);
+    }
+
+    int next_arrival = 0;
+    int current_time = initial_current_time(run);
+
+    while (finished_count < count) {
+        if (push_arrivals(run, &ready, bucketed, arrival_order, &next_arrival, completed, current_time) != SCHED_OK) {
+            ready_queue_free(&ready);
+            free(arrival_order);
+            free(completed);
+            return SCHED_ERR_ALLOC;
         }
 
-        if (chosen < 0) {
-            int next_arrival = find_next_arrival(processes, completed, count, current_time);
-            if (next_arrival == INT_MAX) {
+        ready_entry_t entry;
+        if (!ready_queue_pop(&ready, &entry, NULL)) {
+            int next_time = peek_next_arrival(run, arrival_order, next_arrival, completed);
+            if (next_time == INT_MAX) {
                 break;
             }
-            current_time = next_arrival;
+            SCHED_STAT_ADD(run, idle_jumps, 1);
+            current_time = next_time;
             continue;
         }
+        SCHED_STAT_ADD(run, queue_pops, 1);
 
-        process_t *proc = &processes[chosen];
-        if (proc->first_run_time < 0) {
-            proc->first_run_time = current_time;
-            proc->response_time = current_time - proc->arrival_time;
+        int chosen = entry.index;
+        if (sched_run_charge_switch(run, chosen, &current_time) != SCHED_OK) {
+            ready_queue_free(&ready);
+            free(arrival_order);
+            free(completed);
+            return SCHED_ERR_ALLOC;
         }
 
+        mark_started(run, chosen, current_time);
+
         int start = current_time;
-        int end = current_time + proc->burst_time;
+        int end = current_time + sched_burst(run, chosen);
 
-        if (timeline_builder_add(&builder, proc->process_id, proc->name, start, end) != SCHED_OK) {
-            timeline_builder_free(&builder);
+        if (sched_run_add_segment(run, chosen, start, end) != SCHED_OK) {
+            ready_queue_free(&ready);
+            free(arrival_order);
             free(completed);
             return SCHED_ERR_ALLOC;
         }
 
         current_time = end;
-        finalize_completed_process(proc, current_time);
+        sched_run_finalize(run, chosen, current_time);
         completed[chosen] = true;
         finished_count++;
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
+    ready_queue_free(&ready);
+    free(arrival_order);
     free(completed);
-    return result;
+    return SCHED_OK;
 }
 
-int priority_p_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
-    if (!processes || count <= 0) {
-        return SCHED_ERR_ARGS;
-    }
-    int init_result = init_timeline_out(timeline, timeline_count);
-    if (init_result != SCHED_OK) {
-        return init_result;
-    }
-
-    initialize_process_runtime_fields(processes, count);
-
-    bool *completed = (bool *)calloc((size_t)count, sizeof(bool));
-    if (!completed) {
-        return SCHED_ERR_ALLOC;
-    }
+static int priority_p_run(sched_run_t *run) {
+    sched_task_t *tasks = run->tasks;
+    int count = run->count;
 
+    bool *completed = NULL;
+    int *arrival_order = NULL;
     int finished_count = 0;
-    int current_time = initial_current_time(processes, count);
-
-    for (int i = 0; i < count; i++) {
-        if (processes[i].burst_time == 0) {
-            processes[i].first_run_time = processes[i].arrival_time;
-            processes[i].response_time = 0;
-            finalize_completed_process(&processes[i], processes[i].arrival_time);
-            completed[i] = true;
-            finished_count++;
-        }
-    }
-
-    timeline_builder_t builder;
-    if (timeline_builder_init(&builder) != SCHED_OK) {
-        free(completed);
+    if (priority_run_prepare(run, &completed, &arrival_order, &finished_count) != SCHED_OK) {
         return SCHED_ERR_ALLOC;
     }
 
+    bool bucketed = priority_fits_buckets(run);
+    ready_queue_t ready;
+    (void)ready_queue_init(&ready, bucketed ? READY_QUEUE_MAX_LEVELS : 1);
+
+    int next_arrival = 0;
+    int current_time = initial_current_time(run);
     int running_index = -1;
+    long long running_level = 0;  // with aging: level held since dispatch
+    bool aging = run->config->aging_interval > 0;
     int segment_start = current_time;
 
     while (finished_count < count) {
-        int chosen = -1;
-        int best_priority = INT_MAX;
-
-        for (int i = 0; i < count; i++) {
-            if (completed[i] || processes[i].arrival_time > current_time || processes[i].remaining_time <= 0) {
-                continue;
-            }
+        if (push_arrivals(run, &ready, bucketed, arrival_order, &next_arrival, completed, current_time) != SCHED_OK) {
+            ready_queue_free(&ready);
+            free(arrival_order);
+            free(completed);
+            return SCHED_ERR_ALLOC;
+        }
 
-            bool better = false;
-            if (processes[i].priority < best_priority) {
-                better = true;
-            } else if (processes[i].priority == best_priority && chosen >= 0 &&
-                       processes[i].remaining_time < processes[chosen].remaining_time) {
-                better = true;
-            } else if (processes[i].priority == best_priority && chosen >= 0 &&
-                       processes[i].remaining_time == processes[chosen].remaining_time &&
-                       processes[i].arrival_time < processes[chosen].arrival_time) {
-                better = true;
+        int chosen = running_index;
+        ready_entry_t top;
+        int top_level = 0;
+        if (ready_queue_peek(&ready, &top, &top_level)) {
+            bool take_top = running_index < 0;
+            if (!take_top && aging) {
+                // The running process keeps the level it was dispatched at and
+                // only gives way to a strictly better one.
+                take_top = sched_aged_level(run, top.key, current_time) < running_level;
+                SCHED_STAT_ADD(run, selection_comparisons, 1);
+            } else if (!take_top) {
+                int level = 0;
+                ready_entry_t running = priority_entry(run, running_index, current_time, bucketed, &level);
+                take_top = top_level < level || (top_level == level && ready_entry_before(&top, &running));
+                SCHED_STAT_ADD(run, selection_comparisons, 1);
             }
-
-            if (chosen < 0 || better) {
-                chosen = i;
-                best_priority = processes[i].priority;
+            if (take_top) {
+                (void)ready_queue_pop(&ready, &top, NULL);
+                SCHED_STAT_ADD(run, queue_pops, 1);
+                chosen = top.index;
+                running_level = aging ? sched_aged_level(run, top.key, current_time) : 0;
             }
         }
 
         if (chosen < 0) {
-            if (running_index >= 0 && segment_start < current_time) {
-                if (timeline_builder_add(&builder,
-                                         processes[running_index].process_id,
-                                         processes[running_index].name,
-                                         segment_start,
-                                         current_time) != SCHED_OK) {
-                    timeline_builder_free(&builder);
-                    free(completed);
-                    return SCHED_ERR_ALLOC;
-                }
-            }
-            running_index = -1;
-
-            int next_arrival = find_next_arrival(processes, completed, count, current_time);
-            if (next_arrival == INT_MAX) {
+            int next_time = peek_next_arrival(run, arrival_order, next_arrival, completed);
+            if (next_time == INT_MAX) {
                 break;
             }
-            current_time = next_arrival;
+            SCHED_STAT_ADD(run, idle_jumps, 1);
+            current_time = next_time;
             segment_start = current_time;
             continue;
         }
 
         if (running_index != chosen) {
-            if (running_index >= 0 && segment_start < current_time) {
-                if (timeline_builder_add(&builder,
-                                         processes[running_index].process_id,
-                                         processes[running_index].name,
-                                         segment_start,
-                                         current_time) != SCHED_OK) {
-                    timeline_builder_free(&builder);
+            if (running_index >= 0) {
+                int level = 0;
+                ready_entry_t preempted = priority_entry(run, running_index, current_time, bucketed, &level);
+                if ((segment_start < current_time &&
+                     sched_run_add_segment(run, running_index, segment_start, current_time) != SCHED_OK) ||
+                    run_ready_push(run, &ready, level, preempted) != SCHED_OK) {
+                    ready_queue_free(&ready);
+                    free(arrival_order);
                     free(completed);
                     return SCHED_ERR_ALLOC;
                 }
             }
 
+            if (sched_run_charge_switch(run, chosen, &current_time) != SCHED_OK) {
+                ready_queue_free(&ready);
+                free(arrival_order);
+                free(completed);
+                return SCHED_ERR_ALLOC;
+            }
+
             running_index = chosen;
             segment_start = current_time;
-
-            if (processes[chosen].first_run_time < 0) {
-                processes[chosen].first_run_time = current_time;
-                processes[chosen].response_time = current_time - processes[chosen].arrival_time;
-            }
+            mark_started(run, chosen, current_time);
         }
 
-        processes[chosen].remaining_time--;
+        tasks[chosen].remaining_time--;
         current_time++;
 
-        if (processes[chosen].remaining_time == 0) {
-            if (timeline_builder_add(&builder,
-                                     processes[chosen].process_id,
-                                     processes[chosen].name,
-                                     segment_start,
-                                     current_time) != SCHED_OK) {
-                timeline_builder_free(&builder);
+        if (tasks[chosen].remaining_time == 0) {
+            if (sched_run_add_segment(run, chosen, segment_start, current_time) != SCHED_OK) {
+                ready_queue_free(&ready);
+                free(arrival_order);
                 free(completed);
                 return SCHED_ERR_ALLOC;
             }
 
-            finalize_completed_process(&processes[chosen], current_time);
+            sched_run_finalize(run, chosen, current_time);
             completed[chosen] = true;
             finished_count++;
             running_index = -1;
@@ -1011,57 +871,326 @@ int priority_p_schedule(process_t *processes, int count, timeline_event_t **time
         }
     }
 
-    int result = build_and_return_timeline(&builder, timeline, timeline_count);
-    timeline_builder_free(&builder);
+    ready_queue_free(&ready);
+    free(arrival_order);
     free(completed);
-    return result;
+    return SCHED_OK;
 }
 
-int schedule_processes(
+// Outcomes go to results (workload order) and, for the process_t entry
+// points, back into the caller's records as the runtime fields.
+static void store_outcomes(const sched_run_t *run, process_t *processes, process_result_t *results) {
+    for (int i = 0; i < run->count; i++) {
+        process_result_t outcome = sched_run_outcome(run, i);
+        if (results) {
+            results[i] = outcome;
+        }
+        if (processes) {
+            processes[i].remaining_time = run->tasks[i].remaining_time;
+            processes[i].completion_time = outcome.completion_time;
+            processes[i].turnaround_time = outcome.turnaround_time;
+            processes[i].waiting_time = outcome.waiting_time;
+            processes[i].response_time = outcome.response_time;
+            processes[i].first_run_time = outcome.first_run_time;
+        }
+    }
+}
+
+// The workload is only read through inputs; per-run state is one
+// sched_task_t per process.
+static int run_policy(
+    const sched_inputs_t *inputs,
+    int count,
+    const schedule_config_t *config,
     process_t *processes,
-    int process_count,
-    algorithm_type_t algorithm,
-    int time_quantum,
+    process_result_t *results,
     timeline_event_t **timeline,
     int *timeline_count,
-    metrics_t *metrics
+    flat_segment_builder_t *flat,
+    metrics_t *metrics,
+    sched_stats_t *stats
 ) {
-    if (!processes || process_count <= 0 || !timeline || !timeline_count || !metrics) {
+    // Without a timeline out-param only the metrics (and flat segments) are produced.
+    bool metrics_only = !timeline;
+    if (!inputs || count <= 0 || (metrics_only ? (timeline_count || !metrics) : !timeline_count)) {
+        return SCHED_ERR_ARGS;
+    }
+    if (stats) {
+        (void)memset(stats, 0, sizeof(*stats));
+#ifdef SCHED_ENABLE_STATS
+        stats->enabled = true;
+#else
+        stats = NULL;
+#endif
+    }
+    double phase_start = stats_clock(stats);
+    if (!metrics_only) {
+        *timeline = NULL;
+        *timeline_count = 0;
+    }
+
+    if (sched_validate_config(config) != SCHED_OK) {
         return SCHED_ERR_ARGS;
     }
 
-    *timeline = NULL;
-    *timeline_count = 0;
+    sched_run_t run;
+    (void)memset(&run, 0, sizeof(run));
+    run.inputs = *inputs;
+    run.count = count;
+    run.config = config;
+    run.last_index = -1;
+    run.metrics_only = metrics_only;
+    run.flat = flat;
+    run.stats = stats;
+    metrics_accumulator_init(&run.metrics);
+
+    SCHED_STAT_ADD(&run, allocations, 1);
+    run.tasks = (sched_task_t *)malloc((size_t)count * sizeof(sched_task_t));
+    if (!run.tasks) {
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < count; i++) {
+        run.tasks[i].remaining_time = sched_burst(&run, i);
+        run.tasks[i].first_run_time = -1;
+        run.tasks[i].response_time = -1;
+        run.tasks[i].completion_time = 0;
+    }
+
+    if (config->cache_refill_penalty > 0) {
+        SCHED_STAT_ADD(&run, allocations, 1);
+        run.last_run_end = (int *)malloc((size_t)count * sizeof(int));
+        if (!run.last_run_end) {
+            free(run.tasks);
+            return SCHED_ERR_ALLOC;
+        }
+        for (int i = 0; i < count; i++) {
+            run.last_run_end[i] = -1;
+        }
+    }
+
+    if (!metrics_only && timeline_builder_init(&run.builder) != SCHED_OK) {
+        free(run.last_run_end);
+        free(run.tasks);
+        return SCHED_ERR_ALLOC;
+    }
+    SCHED_STAT_ADD(&run, allocations, metrics_only ? 0 : 1);
+    stats_phase(stats, SCHED_PHASE_SETUP, &phase_start);
 
     int result = SCHED_OK;
-    switch (algorithm) {
+    switch (config->algorithm) {
         case ALGO_FCFS:
-            result = fcfs_schedule(processes, process_count, timeline, timeline_count);
+            result = fcfs_run(&run);
             break;
         case ALGO_SJF:
-            result = sjf_schedule(processes, process_count, timeline, timeline_count);
+            result = sjf_run(&run);
             break;
         case ALGO_SRTF:
-            result = srtf_schedule(processes, process_count, timeline, timeline_count);
+            result = srtf_run(&run);
             break;
         case ALGO_RR:
-            result = round_robin_schedule(processes, process_count, time_quantum, timeline, timeline_count);
+            result = round_robin_run(&run);
             break;
         case ALGO_PRIORITY_NP:
-            result = priority_np_schedule(processes, process_count, timeline, timeline_count);
+            result = priority_np_run(&run);
             break;
         case ALGO_PRIORITY_P:
-            result = priority_p_schedule(processes, process_count, timeline, timeline_count);
+            result = priority_p_run(&run);
             break;
-        default:
-            return SCHED_ERR_ARGS;
+    }
+    stats_phase(stats, SCHED_PHASE_SIMULATE, &phase_start);
+    if (stats) {
+        stats->phase_seconds[SCHED_PHASE_SIMULATE] -= stats->phase_seconds[SCHED_PHASE_SORT];
     }
 
-    if (result != SCHED_OK) {
-        return result;
+    if (result == SCHED_OK && !metrics_only) {
+        SCHED_STAT_ADD(&run, allocations, (run.builder.count > 0) ? 1 : 0);
+        result = build_and_return_timeline(&run.builder, timeline, timeline_count);
+        stats_phase(stats, SCHED_PHASE_TIMELINE, &phase_start);
+    }
+    if (result == SCHED_OK && metrics) {
+        metrics_accumulator_finish(&run.metrics, metrics);
+        stats_phase(stats, SCHED_PHASE_METRICS, &phase_start);
+    }
+    if (result == SCHED_OK) {
+        store_outcomes(&run, processes, results);
     }
 
-    int context_switches = count_context_switches(*timeline, *timeline_count);
-    calculate_metrics(processes, process_count, context_switches, metrics);
-    return SCHED_OK;
+    timeline_builder_free(&run.builder);
+    metrics_accumulator_free(&run.metrics);
+    free(run.last_run_end);
+    free(run.tasks);
+    return result;
+}
+
+// The process_t entry points clamp the caller's inputs in place, as they
+// always have, and get the runtime fields back.
+static int run_processes(
+    process_t *processes,
+    int count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics,
+    sched_stats_t *stats
+) {
+    if (!processes || count <= 0) {
+        return SCHED_ERR_ARGS;
+    }
+    initialize_process_runtime_fields(processes, count);
+
+    sched_inputs_t inputs;
+    sched_inputs_from_processes(&inputs, processes);
+    return run_policy(&inputs, count, config, processes, NULL, timeline, timeline_count, NULL, metrics, stats);
+}
+
+static const char *const kAlgorithmNames[] = {"fcfs", "sjf", "srtf", "rr", "priority_np", "priority_p"};
+
+int sched_algorithm_from_name(const char *name, algorithm_type_t *algorithm) {
+    if (!name || !algorithm) {
+        return SCHED_ERR_ARGS;
+    }
+    for (int a = ALGO_FCFS; a <= ALGO_PRIORITY_P; a++) {
+        if (strcmp(name, kAlgorithmNames[a]) == 0) {
+            *algorithm = (algorithm_type_t)a;
+            return SCHED_OK;
+        }
+    }
+    return SCHED_ERR_ARGS;
+}
+
+const char *sched_algorithm_name(algorithm_type_t algorithm) {
+    if (algorithm < ALGO_FCFS || algorithm > ALGO_PRIORITY_P) {
+        return NULL;
+    }
+    return kAlgorithmNames[algorithm];
+}
+
+static int run_default_policy(
+    process_t *processes,
+    int count,
+    algorithm_type_t algorithm,
+    int time_quantum,
+    timeline_event_t **timeline,
+    int *timeline_count
+) {
+    schedule_config_t config;
+    (void)memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = time_quantum;
+    return run_processes(processes, count, &config, timeline, timeline_count, NULL, NULL);
+}
+
+int fcfs_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_FCFS, 0, timeline, timeline_count);
+}
+
+int sjf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_SJF, 0, timeline, timeline_count);
+}
+
+int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_SRTF, 0, timeline, timeline_count);
+}
+
+int round_robin_schedule(process_t *processes, int count, int quantum, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_RR, quantum, timeline, timeline_count);
+}
+
+int priority_np_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_PRIORITY_NP, 0, timeline, timeline_count);
+}
+
+int priority_p_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count) {
+    return run_default_policy(processes, count, ALGO_PRIORITY_P, 0, timeline, timeline_count);
+}
+
+int schedule_processes_with_config(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    if (!processes || process_count <= 0 || !config || !timeline || !timeline_count || !metrics) {
+        return SCHED_ERR_ARGS;
+    }
+
+    return run_processes(processes, process_count, config, timeline, timeline_count, metrics, NULL);
+}
+
+int schedule_processes_with_stats(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics,
+    sched_stats_t *stats
+) {
+    if (!processes || process_count <= 0 || !config || !metrics || !stats) {
+        return SCHED_ERR_ARGS;
+    }
+
+    return run_processes(processes, process_count, config, timeline, timeline_count, metrics, stats);
+}
+
+int schedule_processes_metrics_only(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    metrics_t *metrics
+) {
+    if (!processes || process_count <= 0 || !config || !metrics) {
+        return SCHED_ERR_ARGS;
+    }
+
+    return run_processes(processes, process_count, config, NULL, NULL, metrics, NULL);
+}
+
+int sched_schedule_inputs(
+    const sched_inputs_t *inputs,
+    int count,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    flat_segment_builder_t *flat,
+    metrics_t *metrics
+) {
+    return run_policy(inputs, count, config, NULL, results, timeline, timeline_count, flat, metrics, NULL);
+}
+
+int schedule_workload(
+    const process_t *workload,
+    int process_count,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    if (!workload || process_count <= 0 || !config) {
+        return SCHED_ERR_ARGS;
+    }
+
+    sched_inputs_t inputs;
+    sched_inputs_from_processes(&inputs, workload);
+    return run_policy(&inputs, process_count, config, NULL, results, timeline, timeline_count, NULL, metrics, NULL);
+}
+
+int schedule_processes(
+    process_t *processes,
+    int process_count,
+    algorithm_type_t algorithm,
+    int time_quantum,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    schedule_config_t config;
+    (void)memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = time_quantum;
+    return schedule_processes_with_config(processes, process_count, &config, timeline, timeline_count, metrics);
 }
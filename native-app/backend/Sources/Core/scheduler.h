@@ -17,6 +17,60 @@ int schedule_processes(
     metrics_t *metrics
 );
 
+int schedule_processes_with_config(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+);
+
+// schedule_processes_with_config that also reports where the run's work
+// went (see sched_stats_t). timeline/timeline_count may be NULL for a
+// metrics-only run. Without SCHED_ENABLE_STATS the stats come back zeroed
+// with enabled false.
+int schedule_processes_with_stats(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics,
+    sched_stats_t *stats
+);
+
+// Same schedule and metrics as schedule_processes_with_config, but no
+// timeline is built; for sweeps that only keep the metrics.
+int schedule_processes_metrics_only(
+    process_t *processes,
+    int process_count,
+    const schedule_config_t *config,
+    metrics_t *metrics
+);
+
+// Schedules a workload without writing to it: the policies read it in place,
+// runtime state lives in a private 16-byte-per-process array and per-process
+// outcomes go to results (optional).
+// Since nothing shared is modified, any number of threads may schedule the
+// same workload concurrently. Pass NULL timeline/timeline_count for a
+// metrics-only run.
+int schedule_workload(
+    const process_t *workload,
+    int process_count,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+);
+
+// Policy names as the tools and the service spell them: "fcfs", "sjf",
+// "srtf", "rr", "priority_np", "priority_p". Parsing is exact;
+// sched_algorithm_name returns NULL for an unknown algorithm.
+int sched_algorithm_from_name(const char *name, algorithm_type_t *algorithm);
+const char *sched_algorithm_name(algorithm_type_t algorithm);
+
 int fcfs_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count);
 int sjf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count);
 int srtf_schedule(process_t *processes, int count, timeline_event_t **timeline, int *timeline_count);
@@ -0,0 +1,820 @@
+#include "timeline_codec.h"
+
+#include "sched_internal.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t kStreamMagic[4] = {'T', 'L', 'C', '2'};
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} byte_buffer_t;
+
+typedef struct {
+    int id;
+    char name[MAX_PROCESS_NAME];
+} codec_slot_t;
+
+typedef struct {
+    int slot;
+    int start;
+    int end;
+} codec_segment_t;
+
+typedef struct {
+    int id;
+    int slot;
+    bool used;
+} slot_map_entry_t;
+
+// Every block defines the slots it uses, so the encoder's tables only ever
+// hold the open block's processes.
+#define CODEC_MAP_CAPACITY (TIMELINE_CODEC_BLOCK_SEGMENTS * 2)
+
+struct timeline_encoder {
+    byte_buffer_t output;
+    byte_buffer_t payload;
+    codec_slot_t slots[TIMELINE_CODEC_BLOCK_SEGMENTS];
+    int slot_count;
+    slot_map_entry_t map[CODEC_MAP_CAPACITY];
+    codec_segment_t block[TIMELINE_CODEC_BLOCK_SEGMENTS];
+    int block_count;
+    int last_end;
+    bool has_last;
+};
+
+typedef struct {
+    size_t offset;  // in the stream
+    int block_end;
+} block_ref_t;
+
+// input holds only the fed bytes not yet consumed; input.data[0] is stream
+// offset base. Offsets below are into input unless noted.
+struct timeline_decoder {
+    byte_buffer_t input;
+    size_t base;
+    bool header_checked;
+    size_t next_block;  // the first block not yet entered
+    codec_slot_t *slots;  // the open block's
+    int slot_count;
+    int slot_capacity;
+
+    // Every block seen so far, in stream order, for seek().
+    block_ref_t *index;
+    int index_count;
+    int index_capacity;
+    size_t indexed_end;  // stream offset just past the last indexed block
+
+    // Open block.
+    size_t cursor;
+    size_t payload_end;
+    int records_left;
+    int prev_start;
+    int block_end;
+
+    // Segment decoded ahead of time; its end is settled by the record after it.
+    bool has_record;
+    int record_slot;
+    int record_start;
+    int record_end;  // -1 while implicit
+
+    // After seek(): segments ending by skip_until are dropped.
+    bool skipping;
+    int skip_until;
+};
+
+static int buffer_reserve(byte_buffer_t *buffer, size_t extra) {
+    if (buffer->size + extra <= buffer->capacity) {
+        return SCHED_OK;
+    }
+    size_t new_capacity = (buffer->capacity == 0) ? 256 : buffer->capacity;
+    while (new_capacity < buffer->size + extra) {
+        new_capacity *= 2;
+    }
+    uint8_t *resized = (uint8_t *)realloc(buffer->data, new_capacity);
+    if (!resized) {
+        return SCHED_ERR_ALLOC;
+    }
+    buffer->data = resized;
+    buffer->capacity = new_capacity;
+    return SCHED_OK;
+}
+
+static int buffer_put_bytes(byte_buffer_t *buffer, const void *bytes, size_t size) {
+    if (size == 0) {
+        return SCHED_OK;
+    }
+    if (buffer_reserve(buffer, size) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+    return SCHED_OK;
+}
+
+// LEB128: seven bits per byte, high bit set on all but the last.
+static int buffer_put_varint(byte_buffer_t *buffer, uint64_t value) {
+    if (buffer_reserve(buffer, 10) != SCHED_OK) {
+        return SCHED_ERR_ALLOC;
+    }
+    while (value >= 0x80U) {
+        buffer->data[buffer->size++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    buffer->data[buffer->size++] = (uint8_t)value;
+    return SCHED_OK;
+}
+
+static uint64_t zigzag(long long value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static long long unzigzag(uint64_t value) {
+    return (long long)(value >> 1) ^ -(long long)(value & 1U);
+}
+
+// 1 when a value was read, 0 when the bytes end first, SCHED_ERR_ARGS when
+// the value does not fit in 64 bits.
+static int read_varint(const uint8_t *data, size_t size, size_t *pos, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*pos >= size) {
+            return 0;
+        }
+        uint8_t byte = data[(*pos)++];
+        result |= (uint64_t)(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0) {
+            *value = result;
+            return 1;
+        }
+    }
+    return SCHED_ERR_ARGS;
+}
+
+static int slots_append(codec_slot_t **slots, int *slot_count, int *slot_capacity, int id, const char *name, size_t name_length) {
+    if (*slot_count == *slot_capacity) {
+        int new_capacity = (*slot_capacity == 0) ? 16 : *slot_capacity * 2;
+        codec_slot_t *resized = (codec_slot_t *)realloc(*slots, (size_t)new_capacity * sizeof(codec_slot_t));
+        if (!resized) {
+            return SCHED_ERR_ALLOC;
+        }
+        *slots = resized;
+        *slot_capacity = new_capacity;
+    }
+    codec_slot_t *slot = &(*slots)[(*slot_count)++];
+    slot->id = id;
+    (void)memcpy(slot->name, name, name_length);
+    slot->name[name_length] = '\0';
+    return SCHED_OK;
+}
+
+static size_t map_position(const timeline_encoder_t *encoder, int id) {
+    size_t mask = (size_t)CODEC_MAP_CAPACITY - 1;
+    size_t pos = ((size_t)(unsigned)id * 2654435761U) & mask;
+    while (encoder->map[pos].used && encoder->map[pos].id != id) {
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+// Slot for the event's (id, name), defining a new one when either is new to
+// the open block. A block defines at most one slot per segment, so the map
+// never gets more than half full.
+static int encoder_slot(timeline_encoder_t *encoder, const timeline_event_t *event) {
+    slot_map_entry_t *entry = &encoder->map[map_position(encoder, event->process_id)];
+    if (entry->used && strncmp(encoder->slots[entry->slot].name, event->process_name, MAX_PROCESS_NAME) == 0) {
+        return entry->slot;
+    }
+
+    size_t name_length = 0;
+    while (name_length < MAX_PROCESS_NAME - 1 && event->process_name[name_length] != '\0') {
+        name_length++;
+    }
+    codec_slot_t *slot = &encoder->slots[encoder->slot_count];
+    slot->id = event->process_id;
+    (void)memcpy(slot->name, event->process_name, name_length);
+    slot->name[name_length] = '\0';
+
+    entry->used = true;
+    entry->id = event->process_id;
+    entry->slot = encoder->slot_count++;
+    return entry->slot;
+}
+
+int timeline_encoder_create(timeline_encoder_t **encoder) {
+    if (!encoder) {
+        return SCHED_ERR_ARGS;
+    }
+
+    timeline_encoder_t *created = (timeline_encoder_t *)calloc(1, sizeof(timeline_encoder_t));
+    if (!created) {
+        return SCHED_ERR_ALLOC;
+    }
+    if (buffer_put_bytes(&created->output, kStreamMagic, sizeof(kStreamMagic)) != SCHED_OK) {
+        free(created);
+        return SCHED_ERR_ALLOC;
+    }
+    *encoder = created;
+    return SCHED_OK;
+}
+
+void timeline_encoder_destroy(timeline_encoder_t *encoder) {
+    if (!encoder) {
+        return;
+    }
+    free(encoder->output.data);
+    free(encoder->payload.data);
+    free(encoder);
+}
+
+// Block layout: segment count, the process slots it uses (id, name), first
+// start, span and payload length, then one record per segment:
+// (slot << 1 | explicit end), start delta, and the duration when explicit.
+int timeline_encoder_flush(timeline_encoder_t *encoder) {
+    if (!encoder) {
+        return SCHED_ERR_ARGS;
+    }
+    if (encoder->block_count == 0) {
+        return SCHED_OK;
+    }
+
+    const codec_segment_t *block = encoder->block;
+    int count = encoder->block_count;
+    int status = SCHED_OK;
+
+    encoder->payload.size = 0;
+    for (int i = 0; i < count && status == SCHED_OK; i++) {
+        int prev_start = (i == 0) ? block[0].start : block[i - 1].start;
+        bool explicit_end = (i + 1 < count) && block[i].end != block[i + 1].start;
+
+        status = buffer_put_varint(&encoder->payload, ((uint64_t)block[i].slot << 1) | (explicit_end ? 1U : 0U));
+        if (status == SCHED_OK) {
+            status = buffer_put_varint(&encoder->payload, (uint64_t)((long long)block[i].start - prev_start));
+        }
+        if (status == SCHED_OK && explicit_end) {
+            status = buffer_put_varint(&encoder->payload, (uint64_t)((long long)block[i].end - block[i].start));
+        }
+    }
+
+    byte_buffer_t *out = &encoder->output;
+    size_t rollback = out->size;
+    if (status == SCHED_OK) {
+        status = buffer_put_varint(out, (uint64_t)count);
+    }
+    if (status == SCHED_OK) {
+        status = buffer_put_varint(out, (uint64_t)encoder->slot_count);
+    }
+    for (int s = 0; s < encoder->slot_count && status == SCHED_OK; s++) {
+        size_t name_length = strlen(encoder->slots[s].name);
+        status = buffer_put_varint(out, zigzag(encoder->slots[s].id));
+        if (status == SCHED_OK) {
+            status = buffer_put_varint(out, (uint64_t)name_length);
+        }
+        if (status == SCHED_OK) {
+            status = buffer_put_bytes(out, encoder->slots[s].name, name_length);
+        }
+    }
+    if (status == SCHED_OK) {
+        status = buffer_put_varint(out, zigzag(block[0].start));
+    }
+    if (status == SCHED_OK) {
+        status = buffer_put_varint(out, (uint64_t)((long long)block[count - 1].end - block[0].start));
+    }
+    if (status == SCHED_OK) {
+        status = buffer_put_varint(out, (uint64_t)encoder->payload.size);
+    }
+    if (status == SCHED_OK) {
+        status = buffer_put_bytes(out, encoder->payload.data, encoder->payload.size);
+    }
+    if (status != SCHED_OK) {
+        // Leave the stream ending on a whole block; the segments stay queued.
+        out->size = rollback;
+        return status;
+    }
+
+    encoder->slot_count = 0;
+    (void)memset(encoder->map, 0, sizeof(encoder->map));
+    encoder->block_count = 0;
+    return SCHED_OK;
+}
+
+int timeline_encoder_push(timeline_encoder_t *encoder, const timeline_event_t *events, int event_count) {
+    if (!encoder || event_count < 0 || (event_count > 0 && !events)) {
+        return SCHED_ERR_ARGS;
+    }
+
+    for (int i = 0; i < event_count; i++) {
+        const timeline_event_t *event = &events[i];
+        if (event->end_time < event->start_time || (encoder->has_last && event->start_time < encoder->last_end)) {
+            return SCHED_ERR_ARGS;
+        }
+
+        // A block left full by a failed flush is closed before it takes more.
+        if (encoder->block_count == TIMELINE_CODEC_BLOCK_SEGMENTS) {
+            int status = timeline_encoder_flush(encoder);
+            if (status != SCHED_OK) {
+                return status;
+            }
+        }
+
+        codec_segment_t *segment = &encoder->block[encoder->block_count];
+        segment->slot = encoder_slot(encoder, event);
+        segment->start = event->start_time;
+        segment->end = event->end_time;
+        encoder->block_count++;
+        encoder->last_end = event->end_time;
+        encoder->has_last = true;
+
+        if (encoder->block_count == TIMELINE_CODEC_BLOCK_SEGMENTS) {
+            int status = timeline_encoder_flush(encoder);
+            if (status != SCHED_OK) {
+                return status;
+            }
+        }
+    }
+    return SCHED_OK;
+}
+
+int timeline_encoder_drain(timeline_encoder_t *encoder, uint8_t **bytes, size_t *size) {
+    if (!encoder || !bytes || !size) {
+        return SCHED_ERR_ARGS;
+    }
+
+    *bytes = NULL;
+    *size = encoder->output.size;
+    if (encoder->output.size == 0) {
+        return SCHED_OK;
+    }
+    *bytes = encoder->output.data;
+    (void)memset(&encoder->output, 0, sizeof(encoder->output));
+    return SCHED_OK;
+}
+
+int timeline_decoder_create(timeline_decoder_t **decoder) {
+    if (!decoder) {
+        return SCHED_ERR_ARGS;
+    }
+
+    timeline_decoder_t *created = (timeline_decoder_t *)calloc(1, sizeof(timeline_decoder_t));
+    if (!created) {
+        return SCHED_ERR_ALLOC;
+    }
+    created->next_block = sizeof(kStreamMagic);
+    created->indexed_end = sizeof(kStreamMagic);
+    *decoder = created;
+    return SCHED_OK;
+}
+
+void timeline_decoder_destroy(timeline_decoder_t *decoder) {
+    if (!decoder) {
+        return;
+    }
+    free(decoder->input.data);
+    free(decoder->slots);
+    free(decoder->index);
+    free(decoder);
+}
+
+static bool block_open(const timeline_decoder_t *decoder) {
+    return decoder->has_record || decoder->records_left > 0;
+}
+
+// Drops consumed bytes once they make up half the buffer, so the buffer
+// follows the unconsumed tail rather than the stream.
+static void discard_consumed(timeline_decoder_t *decoder) {
+    if (!decoder->header_checked) {
+        return;
+    }
+    size_t consumed = block_open(decoder) ? decoder->cursor : decoder->next_block;
+    if (consumed == 0 || consumed < decoder->input.size / 2) {
+        return;
+    }
+
+    (void)memmove(decoder->input.data, decoder->input.data + consumed, decoder->input.size - consumed);
+    decoder->input.size -= consumed;
+    decoder->base += consumed;
+    decoder->next_block -= consumed;
+    if (block_open(decoder)) {
+        decoder->cursor -= consumed;
+        decoder->payload_end -= consumed;
+    }
+}
+
+int timeline_decoder_feed(timeline_decoder_t *decoder, const uint8_t *bytes, size_t size) {
+    if (!decoder || (size > 0 && !bytes)) {
+        return SCHED_ERR_ARGS;
+    }
+    discard_consumed(decoder);
+    return buffer_put_bytes(&decoder->input, bytes, size);
+}
+
+size_t timeline_decoder_buffered(const timeline_decoder_t *decoder) {
+    return decoder ? decoder->input.size : 0;
+}
+
+typedef struct {
+    int segment_count;
+    int slot_count;
+    size_t slots_at;
+    int first_start;
+    int block_end;
+    size_t payload_at;
+    size_t payload_end;
+} block_header_t;
+
+static int read_int(const byte_buffer_t *input, size_t *pos, bool signed_value, long long *value) {
+    uint64_t raw = 0;
+    int read = read_varint(input->data, input->size, pos, &raw);
+    if (read <= 0) {
+        return read;
+    }
+    if (signed_value) {
+        *value = unzigzag(raw);
+        return (*value < INT_MIN || *value > INT_MAX) ? SCHED_ERR_ARGS : 1;
+    }
+    if (raw > (uint64_t)INT_MAX) {
+        return SCHED_ERR_ARGS;
+    }
+    *value = (long long)raw;
+    return 1;
+}
+
+// 1 when the whole block at pos is buffered, 0 when more bytes are needed,
+// SCHED_ERR_ARGS on malformed input. Does not touch the slot table.
+static int read_block_header(const timeline_decoder_t *decoder, size_t pos, block_header_t *header) {
+    const byte_buffer_t *input = &decoder->input;
+    long long value = 0;
+    int read = read_int(input, &pos, false, &value);
+    if (read <= 0) {
+        return read;
+    }
+    if (value <= 0 || value > TIMELINE_CODEC_BLOCK_SEGMENTS) {
+        return SCHED_ERR_ARGS;
+    }
+    header->segment_count = (int)value;
+
+    if ((read = read_int(input, &pos, false, &value)) <= 0) {
+        return read;
+    }
+    if (value > header->segment_count) {
+        return SCHED_ERR_ARGS;
+    }
+    header->slot_count = (int)value;
+    header->slots_at = pos;
+    for (int s = 0; s < header->slot_count; s++) {
+        if ((read = read_int(input, &pos, true, &value)) <= 0 || (read = read_int(input, &pos, false, &value)) <= 0) {
+            return read;
+        }
+        if (value >= MAX_PROCESS_NAME) {
+            return SCHED_ERR_ARGS;
+        }
+        if (input->size - pos < (size_t)value) {
+            return 0;
+        }
+        pos += (size_t)value;
+    }
+
+    if ((read = read_int(input, &pos, true, &value)) <= 0) {
+        return read;
+    }
+    header->first_start = (int)value;
+    if ((read = read_int(input, &pos, false, &value)) <= 0) {
+        return read;
+    }
+    if ((long long)header->first_start + value > INT_MAX) {
+        return SCHED_ERR_ARGS;
+    }
+    header->block_end = (int)(header->first_start + value);
+    if ((read = read_int(input, &pos, false, &value)) <= 0) {
+        return read;
+    }
+    if (input->size - pos < (size_t)value) {
+        return 0;
+    }
+    header->payload_at = pos;
+    header->payload_end = pos + (size_t)value;
+    return 1;
+}
+
+static int register_block_slots(timeline_decoder_t *decoder, const block_header_t *header) {
+    size_t pos = header->slots_at;
+    decoder->slot_count = 0;
+    for (int s = 0; s < header->slot_count; s++) {
+        long long id = 0;
+        long long name_length = 0;
+        (void)read_int(&decoder->input, &pos, true, &id);
+        (void)read_int(&decoder->input, &pos, false, &name_length);
+        int status = slots_append(
+            &decoder->slots,
+            &decoder->slot_count,
+            &decoder->slot_capacity,
+            (int)id,
+            (const char *)decoder->input.data + pos,
+            (size_t)name_length
+        );
+        if (status != SCHED_OK) {
+            return status;
+        }
+        pos += (size_t)name_length;
+    }
+    return SCHED_OK;
+}
+
+// Decodes the next record of the open block into the lookahead.
+static int read_record(timeline_decoder_t *decoder) {
+    byte_buffer_t payload = decoder->input;
+    payload.size = decoder->payload_end;
+
+    uint64_t tag = 0;
+    uint64_t delta = 0;
+    uint64_t duration = 0;
+    if (read_varint(payload.data, payload.size, &decoder->cursor, &tag) != 1 ||
+        read_varint(payload.data, payload.size, &decoder->cursor, &delta) != 1) {
+        return SCHED_ERR_ARGS;
+    }
+    if ((tag & 1U) && read_varint(payload.data, payload.size, &decoder->cursor, &duration) != 1) {
+        return SCHED_ERR_ARGS;
+    }
+
+    uint64_t slot = tag >> 1;
+    if (slot >= (uint64_t)decoder->slot_count || delta > (uint64_t)INT_MAX || duration > (uint64_t)INT_MAX) {
+        return SCHED_ERR_ARGS;
+    }
+    long long start = (long long)decoder->prev_start + (long long)delta;
+    long long end = (tag & 1U) ? start + (long long)duration : -1;
+    if (start > decoder->block_end || end > decoder->block_end) {
+        return SCHED_ERR_ARGS;
+    }
+
+    decoder->record_slot = (int)slot;
+    decoder->record_start = (int)start;
+    decoder->record_end = (int)end;
+    decoder->prev_start = (int)start;
+    decoder->records_left--;
+    decoder->has_record = true;
+    return SCHED_OK;
+}
+
+// Records the whole block at pos in the seek index unless it is there already.
+static int index_block(timeline_decoder_t *decoder, size_t pos, const block_header_t *header) {
+    if (decoder->base + pos != decoder->indexed_end) {
+        return SCHED_OK;
+    }
+    if (decoder->index_count == decoder->index_capacity) {
+        int new_capacity = (decoder->index_capacity == 0) ? 64 : decoder->index_capacity * 2;
+        block_ref_t *resized = (block_ref_t *)realloc(decoder->index, (size_t)new_capacity * sizeof(block_ref_t));
+        if (!resized) {
+            return SCHED_ERR_ALLOC;
+        }
+        decoder->index = resized;
+        decoder->index_capacity = new_capacity;
+    }
+    decoder->index[decoder->index_count].offset = decoder->base + pos;
+    decoder->index[decoder->index_count].block_end = header->block_end;
+    decoder->index_count++;
+    decoder->indexed_end = decoder->base + header->payload_end;
+    return SCHED_OK;
+}
+
+// Enters the block at next_block. 1 when entered, 0 when it is not yet whole.
+static int enter_block(timeline_decoder_t *decoder) {
+    block_header_t header;
+    int read = read_block_header(decoder, decoder->next_block, &header);
+    if (read <= 0) {
+        return read;
+    }
+
+    int status = index_block(decoder, decoder->next_block, &header);
+    if (status == SCHED_OK) {
+        status = register_block_slots(decoder, &header);
+    }
+    if (status != SCHED_OK) {
+        return status;
+    }
+    decoder->cursor = header.payload_at;
+    decoder->payload_end = header.payload_end;
+    decoder->records_left = header.segment_count;
+    decoder->prev_start = header.first_start;
+    decoder->block_end = header.block_end;
+    decoder->next_block = header.payload_end;
+
+    status = read_record(decoder);
+    return (status == SCHED_OK) ? 1 : status;
+}
+
+static int check_stream_header(timeline_decoder_t *decoder, bool *ready) {
+    *ready = decoder->header_checked;
+    if (decoder->header_checked) {
+        return SCHED_OK;
+    }
+    size_t available = (decoder->input.size < sizeof(kStreamMagic)) ? decoder->input.size : sizeof(kStreamMagic);
+    if (memcmp(decoder->input.data, kStreamMagic, available) != 0) {
+        return SCHED_ERR_ARGS;
+    }
+    decoder->header_checked = (available == sizeof(kStreamMagic));
+    *ready = decoder->header_checked;
+    return SCHED_OK;
+}
+
+static int decode_next(timeline_decoder_t *decoder, timeline_event_t *event, bool *has_event) {
+    *has_event = false;
+    bool ready = false;
+    int status = check_stream_header(decoder, &ready);
+    if (status != SCHED_OK || !ready) {
+        return status;
+    }
+    if (!decoder->has_record) {
+        if (decoder->next_block == decoder->input.size) {
+            return SCHED_OK;
+        }
+        int entered = enter_block(decoder);
+        if (entered <= 0) {
+            return entered;
+        }
+    }
+
+    const codec_slot_t *slot = &decoder->slots[decoder->record_slot];
+    event->process_id = slot->id;
+    safe_copy_string(event->process_name, sizeof(event->process_name), slot->name);
+    event->start_time = decoder->record_start;
+    event->end_time = decoder->record_end;
+    decoder->has_record = false;
+
+    if (decoder->records_left > 0) {
+        status = read_record(decoder);
+        if (status != SCHED_OK) {
+            return status;
+        }
+        if (event->end_time < 0) {
+            event->end_time = decoder->record_start;
+        }
+    } else {
+        if (decoder->cursor != decoder->payload_end) {
+            return SCHED_ERR_ARGS;
+        }
+        if (event->end_time < 0) {
+            event->end_time = decoder->block_end;
+        }
+    }
+    if (event->end_time < event->start_time) {
+        return SCHED_ERR_ARGS;
+    }
+    *has_event = true;
+    return SCHED_OK;
+}
+
+int timeline_decoder_next(timeline_decoder_t *decoder, timeline_event_t *event, bool *has_event) {
+    if (!decoder || !event || !has_event) {
+        return SCHED_ERR_ARGS;
+    }
+    for (;;) {
+        int status = decode_next(decoder, event, has_event);
+        if (status != SCHED_OK || !*has_event) {
+            return status;
+        }
+        if (!decoder->skipping || event->end_time > decoder->skip_until) {
+            decoder->skipping = false;
+            return SCHED_OK;
+        }
+    }
+}
+
+int timeline_decoder_seek(timeline_decoder_t *decoder, int time, size_t *resume_offset) {
+    if (!decoder || !resume_offset) {
+        return SCHED_ERR_ARGS;
+    }
+    *resume_offset = decoder->base + decoder->input.size;
+
+    bool ready = false;
+    int status = check_stream_header(decoder, &ready);
+    if (status != SCHED_OK || !ready) {
+        return status;
+    }
+
+    // Index the whole blocks buffered past the last one seen.
+    if (decoder->indexed_end >= decoder->base) {
+        size_t pos = decoder->indexed_end - decoder->base;
+        while (pos < decoder->input.size) {
+            block_header_t header;
+            int read = read_block_header(decoder, pos, &header);
+            if (read < 0) {
+                return read;
+            }
+            if (read == 0) {
+                break;
+            }
+            status = index_block(decoder, pos, &header);
+            if (status != SCHED_OK) {
+                return status;
+            }
+            pos = header.payload_end;
+        }
+    }
+
+    // Block ends never decrease, so the first block ending after `time` is
+    // found by bisection; past the indexed blocks, the stream resumes at
+    // their end.
+    int lo = 0;
+    int hi = decoder->index_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (decoder->index[mid].block_end > time) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    size_t target = (lo < decoder->index_count) ? decoder->index[lo].offset : decoder->indexed_end;
+
+    decoder->has_record = false;
+    decoder->records_left = 0;
+    decoder->skipping = true;
+    decoder->skip_until = time;
+    if (target >= decoder->base && target <= decoder->base + decoder->input.size) {
+        decoder->next_block = target - decoder->base;
+    } else {
+        decoder->input.size = 0;
+        decoder->base = target;
+        decoder->next_block = 0;
+        *resume_offset = target;
+    }
+    return SCHED_OK;
+}
+
+int timeline_encode(const timeline_event_t *timeline, int timeline_count, uint8_t **bytes, size_t *size) {
+    if (!bytes || !size) {
+        return SCHED_ERR_ARGS;
+    }
+
+    timeline_encoder_t *encoder = NULL;
+    int status = timeline_encoder_create(&encoder);
+    if (status != SCHED_OK) {
+        return status;
+    }
+    status = timeline_encoder_push(encoder, timeline, timeline_count);
+    if (status == SCHED_OK) {
+        status = timeline_encoder_flush(encoder);
+    }
+    if (status == SCHED_OK) {
+        status = timeline_encoder_drain(encoder, bytes, size);
+    }
+    timeline_encoder_destroy(encoder);
+    return status;
+}
+
+int timeline_decode(const uint8_t *bytes, size_t size, timeline_event_t **timeline, int *timeline_count) {
+    if (!timeline || !timeline_count) {
+        return SCHED_ERR_ARGS;
+    }
+    *timeline = NULL;
+    *timeline_count = 0;
+
+    timeline_decoder_t *decoder = NULL;
+    int status = timeline_decoder_create(&decoder);
+    if (status != SCHED_OK) {
+        return status;
+    }
+    status = timeline_decoder_feed(decoder, bytes, size);
+
+    // Segments are kept as stored; the timeline builder would merge them.
+    timeline_event_t *events = NULL;
+    int count = 0;
+    int capacity = 0;
+    while (status == SCHED_OK) {
+        if (count == capacity) {
+            int new_capacity = (capacity == 0) ? 64 : capacity * 2;
+            timeline_event_t *resized = (timeline_event_t *)realloc(events, (size_t)new_capacity * sizeof(timeline_event_t));
+            if (!resized) {
+                status = SCHED_ERR_ALLOC;
+                break;
+            }
+            events = resized;
+            capacity = new_capacity;
+        }
+
+        bool has_event = false;
+        status = timeline_decoder_next(decoder, &events[count], &has_event);
+        if (status != SCHED_OK || !has_event) {
+            break;
+        }
+        count++;
+    }
+
+    // Bytes that never formed a whole block mean the input was truncated.
+    if (status == SCHED_OK && (!decoder->header_checked || decoder->next_block != decoder->input.size)) {
+        status = SCHED_ERR_ARGS;
+    }
+    timeline_decoder_destroy(decoder);
+    if (status != SCHED_OK || count == 0) {
+        free(events);
+        return status;
+    }
+    *timeline = events;
+    *timeline_count = count;
+    return SCHED_OK;
+}
@@ -0,0 +1,62 @@
+#ifndef TIMELINE_CODEC_H
+#define TIMELINE_CODEC_H
+
+#include "process_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Segments per block. Blocks are self-delimiting, so readers can skip whole
+// blocks by time without decoding their segments.
+#define TIMELINE_CODEC_BLOCK_SEGMENTS 256
+
+// Compact timeline encoding: each block names the processes it uses once,
+// segments carry a varint process slot and a start delta, and a segment's
+// end is only written when an idle gap follows it (otherwise it is the next
+// segment's start). Input must be sorted by start time and non-overlapping.
+// Encoder and decoder memory is bounded by a block, not by the stream.
+typedef struct timeline_encoder timeline_encoder_t;
+typedef struct timeline_decoder timeline_decoder_t;
+
+int timeline_encoder_create(timeline_encoder_t **encoder);
+void timeline_encoder_destroy(timeline_encoder_t *encoder);
+int timeline_encoder_push(timeline_encoder_t *encoder, const timeline_event_t *events, int event_count);
+
+// Closes the partial block; later pushes start a new one.
+int timeline_encoder_flush(timeline_encoder_t *encoder);
+
+// Hands over, and forgets, the bytes of every block closed since the previous
+// drain. The array is malloc'd (NULL when empty); free() it.
+int timeline_encoder_drain(timeline_encoder_t *encoder, uint8_t **bytes, size_t *size);
+
+// Bytes may arrive in arbitrary chunks; a block is decoded once it is whole.
+// Consumed bytes are dropped, so the decoder holds the unconsumed tail plus
+// an offset per block seen.
+int timeline_decoder_create(timeline_decoder_t **decoder);
+void timeline_decoder_destroy(timeline_decoder_t *decoder);
+int timeline_decoder_feed(timeline_decoder_t *decoder, const uint8_t *bytes, size_t size);
+size_t timeline_decoder_buffered(const timeline_decoder_t *decoder);
+
+// *has_event is false when the buffered bytes hold no further complete segment.
+int timeline_decoder_next(timeline_decoder_t *decoder, timeline_event_t *event, bool *has_event);
+
+// Repositions at the first segment ending after `time`, skipping earlier
+// blocks by their headers. *resume_offset is the stream offset the next fed
+// bytes must start at: the end of what was fed when the target block is
+// still buffered, otherwise the start of that block, to be fed again.
+int timeline_decoder_seek(timeline_decoder_t *decoder, int time, size_t *resume_offset);
+
+// One-shot helpers over the streaming API.
+int timeline_encode(const timeline_event_t *timeline, int timeline_count, uint8_t **bytes, size_t *size);
+int timeline_decode(const uint8_t *bytes, size_t size, timeline_event_t **timeline, int *timeline_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMELINE_CODEC_H
@@ -0,0 +1,354 @@
+#include "timeline_index.h"
+
+#include "sched_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int busy;
+    int dominant_id;
+    int dominant_time;
+} lod_bucket_t;
+
+typedef struct {
+    long long width;
+    int bucket_count;
+    lod_bucket_t *buckets;
+} lod_level_t;
+
+struct timeline_index {
+    const timeline_event_t *timeline;
+    int count;
+    int origin;
+    int horizon;
+    lod_level_t *levels;
+    int level_count;
+};
+
+static int compare_ints(const void *lhs, const void *rhs) {
+    int a = *(const int *)lhs;
+    int b = *(const int *)rhs;
+    return (a > b) - (a < b);
+}
+
+// Position of id in the sorted, de-duplicated id table.
+static int dense_id(const int *ids, int id_count, int id) {
+    int lo = 0;
+    int hi = id_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (ids[mid] < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Closes a bucket: picks the process with the most time in it (lowest id on
+// ties) and clears the accumulators it touched. Switch overhead only counts
+// towards busy time, never as the bucket's process.
+static void close_bucket(lod_bucket_t *bucket, const int *ids, int *time_by_id, int *touched, int touched_count) {
+    bucket->dominant_id = TIMELINE_INDEX_IDLE_ID;
+    bucket->dominant_time = 0;
+    for (int i = 0; i < touched_count; i++) {
+        int slot = touched[i];
+        if (ids[slot] == TIMELINE_OVERHEAD_PROCESS_ID) {
+            time_by_id[slot] = 0;
+            continue;
+        }
+        if (time_by_id[slot] > bucket->dominant_time ||
+            (time_by_id[slot] == bucket->dominant_time && ids[slot] < bucket->dominant_id)) {
+            bucket->dominant_id = ids[slot];
+            bucket->dominant_time = time_by_id[slot];
+        }
+        time_by_id[slot] = 0;
+    }
+}
+
+static void fill_level(
+    const timeline_index_t *index,
+    lod_level_t *level,
+    const int *slots,
+    const int *ids,
+    int *time_by_id,
+    int *touched
+) {
+    int touched_count = 0;
+    int current = 0;
+
+    (void)memset(level->buckets, 0, (size_t)level->bucket_count * sizeof(lod_bucket_t));
+    for (int i = 0; i < index->count; i++) {
+        const timeline_event_t *event = &index->timeline[i];
+        long long from = (long long)event->start_time - index->origin;
+        long long to = (long long)event->end_time - index->origin;
+
+        while (from < to) {
+            int bucket = (int)(from / level->width);
+            long long bucket_end = (long long)(bucket + 1) * level->width;
+            long long piece_end = (to < bucket_end) ? to : bucket_end;
+            int piece = (int)(piece_end - from);
+
+            while (current < bucket) {
+                close_bucket(&level->buckets[current], ids, time_by_id, touched, touched_count);
+                touched_count = 0;
+                current++;
+            }
+            if (time_by_id[slots[i]] == 0) {
+                touched[touched_count++] = slots[i];
+            }
+            time_by_id[slots[i]] += piece;
+            level->buckets[bucket].busy += piece;
+            from = piece_end;
+        }
+    }
+    while (current < level->bucket_count) {
+        close_bucket(&level->buckets[current], ids, time_by_id, touched, touched_count);
+        touched_count = 0;
+        current++;
+    }
+}
+
+void timeline_index_destroy(timeline_index_t *index) {
+    if (!index) {
+        return;
+    }
+    for (int i = 0; i < index->level_count; i++) {
+        free(index->levels[i].buckets);
+    }
+    free(index->levels);
+    free(index);
+}
+
+static int build_levels(timeline_index_t *index) {
+    long long span = (long long)index->horizon - index->origin;
+    long long width = span / index->count;
+    if (width < 1) {
+        width = 1;
+    }
+
+    int level_count = 1;
+    for (long long w = width; (span + w - 1) / w > 1; w *= 2) {
+        level_count++;
+    }
+
+    index->levels = (lod_level_t *)calloc((size_t)level_count, sizeof(lod_level_t));
+    if (!index->levels) {
+        return SCHED_ERR_ALLOC;
+    }
+    index->level_count = level_count;
+    for (int l = 0; l < level_count; l++) {
+        lod_level_t *level = &index->levels[l];
+        level->width = width;
+        level->bucket_count = (int)((span + width - 1) / width);
+        level->buckets = (lod_bucket_t *)malloc((size_t)level->bucket_count * sizeof(lod_bucket_t));
+        if (!level->buckets) {
+            return SCHED_ERR_ALLOC;
+        }
+        width *= 2;
+    }
+
+    int *ids = (int *)malloc((size_t)index->count * sizeof(int));
+    int *slots = (int *)malloc((size_t)index->count * sizeof(int));
+    int *time_by_id = (int *)calloc((size_t)index->count, sizeof(int));
+    int *touched = (int *)malloc((size_t)index->count * sizeof(int));
+    if (!ids || !slots || !time_by_id || !touched) {
+        free(ids);
+        free(slots);
+        free(time_by_id);
+        free(touched);
+        return SCHED_ERR_ALLOC;
+    }
+
+    for (int i = 0; i < index->count; i++) {
+        ids[i] = index->timeline[i].process_id;
+    }
+    qsort(ids, (size_t)index->count, sizeof(int), compare_ints);
+    int id_count = 0;
+    for (int i = 0; i < index->count; i++) {
+        if (id_count == 0 || ids[id_count - 1] != ids[i]) {
+            ids[id_count++] = ids[i];
+        }
+    }
+    for (int i = 0; i < index->count; i++) {
+        slots[i] = dense_id(ids, id_count, index->timeline[i].process_id);
+    }
+
+    for (int l = 0; l < level_count; l++) {
+        fill_level(index, &index->levels[l], slots, ids, time_by_id, touched);
+    }
+
+    free(ids);
+    free(slots);
+    free(time_by_id);
+    free(touched);
+    return SCHED_OK;
+}
+
+int timeline_index_build(const timeline_event_t *timeline, int timeline_count, timeline_index_t **index) {
+    if (!index || timeline_count < 0 || (timeline_count > 0 && !timeline)) {
+        return SCHED_ERR_ARGS;
+    }
+    *index = NULL;
+
+    for (int i = 0; i < timeline_count; i++) {
+        if (timeline[i].end_time < timeline[i].start_time ||
+            (i > 0 && timeline[i].start_time < timeline[i - 1].end_time)) {
+            return SCHED_ERR_ARGS;
+        }
+    }
+
+    timeline_index_t *built = (timeline_index_t *)calloc(1, sizeof(timeline_index_t));
+    if (!built) {
+        return SCHED_ERR_ALLOC;
+    }
+    built->timeline = timeline;
+    built->count = timeline_count;
+    if (timeline_count > 0) {
+        built->origin = timeline[0].start_time;
+        built->horizon = timeline[timeline_count - 1].end_time;
+    }
+
+    if (built->horizon > built->origin) {
+        int status = build_levels(built);
+        if (status != SCHED_OK) {
+            timeline_index_destroy(built);
+            return status;
+        }
+    }
+
+    *index = built;
+    return SCHED_OK;
+}
+
+int timeline_index_query(
+    const timeline_index_t *index,
+    int start_time,
+    int end_time,
+    const timeline_event_t **first,
+    int *count
+) {
+    if (!index || !first || !count || end_time < start_time) {
+        return SCHED_ERR_ARGS;
+    }
+
+    // Ends are non-decreasing because segments do not overlap, so both
+    // boundaries are a binary search away.
+    int lo = 0;
+    int hi = index->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (index->timeline[mid].end_time <= start_time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    int begin = lo;
+
+    hi = index->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (index->timeline[mid].start_time < end_time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *first = (index->count > 0) ? &index->timeline[begin] : NULL;
+    *count = (start_time < end_time) ? lo - begin : 0;
+    return SCHED_OK;
+}
+
+typedef struct {
+    int id;
+    double time;
+} candidate_t;
+
+int timeline_index_summarize(
+    const timeline_index_t *index,
+    int start_time,
+    int end_time,
+    int bucket_count,
+    timeline_bucket_t *buckets
+) {
+    if (!index || !buckets || bucket_count <= 0 || end_time <= start_time) {
+        return SCHED_ERR_ARGS;
+    }
+
+    double pixel = ((double)end_time - start_time) / bucket_count;
+
+    // Coarsest level not wider than a pixel, so a pixel touches at most three
+    // of its buckets; below level 0 the level-0 buckets are prorated.
+    const lod_level_t *level = NULL;
+    for (int l = 0; l < index->level_count; l++) {
+        if ((double)index->levels[l].width > pixel && level) {
+            break;
+        }
+        level = &index->levels[l];
+    }
+
+    for (int p = 0; p < bucket_count; p++) {
+        double from = start_time + pixel * p - index->origin;
+        double to = (p + 1 == bucket_count) ? (double)end_time - index->origin : from + pixel;
+        double busy = 0.0;
+        candidate_t candidates[4];
+        int candidate_count = 0;
+
+        buckets[p].process_id = TIMELINE_INDEX_IDLE_ID;
+        buckets[p].busy_fraction = 0.0;
+        if (!level) {
+            continue;
+        }
+
+        long long first = (from > 0.0) ? (long long)(from / (double)level->width) : 0;
+        for (long long b = first; b < level->bucket_count; b++) {
+            double bucket_start = (double)(b * level->width);
+            double bucket_end = bucket_start + (double)level->width;
+            if (bucket_start >= to) {
+                break;
+            }
+            double lo = (from > bucket_start) ? from : bucket_start;
+            double hi = (to < bucket_end) ? to : bucket_end;
+            if (hi <= lo) {
+                continue;
+            }
+
+            // Time inside a bucket is treated as spread evenly across it.
+            const lod_bucket_t *source = &level->buckets[b];
+            double share = (hi - lo) / (double)level->width;
+            busy += source->busy * share;
+            if (source->dominant_time == 0) {
+                continue;
+            }
+
+            int c = 0;
+            while (c < candidate_count && candidates[c].id != source->dominant_id) {
+                c++;
+            }
+            if (c == candidate_count) {
+                if (candidate_count == (int)(sizeof(candidates) / sizeof(candidates[0]))) {
+                    continue;
+                }
+                candidates[candidate_count].id = source->dominant_id;
+                candidates[candidate_count].time = 0.0;
+                candidate_count++;
+            }
+            candidates[c].time += source->dominant_time * share;
+        }
+
+        buckets[p].busy_fraction = busy / (to - from);
+        double best = 0.0;
+        for (int c = 0; c < candidate_count; c++) {
+            if (candidates[c].time > best ||
+                (candidates[c].time == best && candidates[c].id < buckets[p].process_id)) {
+                buckets[p].process_id = candidates[c].id;
+                best = candidates[c].time;
+            }
+        }
+    }
+    return SCHED_OK;
+}
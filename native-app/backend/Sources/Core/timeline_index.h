@@ -0,0 +1,51 @@
+#ifndef TIMELINE_INDEX_H
+#define TIMELINE_INDEX_H
+
+#include "process_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIMELINE_INDEX_IDLE_ID (-2)
+
+typedef struct {
+    int process_id;        // process holding most of the bucket, TIMELINE_INDEX_IDLE_ID if none (overhead never counts)
+    double busy_fraction;  // share of the bucket covered by segments, overhead included
+} timeline_bucket_t;
+
+// Read-only index over a single-CPU timeline: segments sorted by start time
+// and not overlapping, as every scheduler here produces. The index refers to
+// the caller's array, which must outlive it.
+typedef struct timeline_index timeline_index_t;
+
+int timeline_index_build(const timeline_event_t *timeline, int timeline_count, timeline_index_t **index);
+void timeline_index_destroy(timeline_index_t *index);
+
+// Segments overlapping [start_time, end_time) in O(log n): they are the
+// *count entries starting at *first.
+int timeline_index_query(
+    const timeline_index_t *index,
+    int start_time,
+    int end_time,
+    const timeline_event_t **first,
+    int *count
+);
+
+// Fills bucket_count equal-width summaries of [start_time, end_time) from
+// precomputed level-of-detail tables, in time independent of the timeline
+// size. Meant for zoomed-out views; once a bucket is narrower than the
+// average segment, query() is cheaper and exact.
+int timeline_index_summarize(
+    const timeline_index_t *index,
+    int start_time,
+    int end_time,
+    int bucket_count,
+    timeline_bucket_t *buckets
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMELINE_INDEX_H
@@ -0,0 +1,549 @@
+#include "trace_export.h"
+
+#include "sched_internal.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Chrome JSON pids and Perfetto track uuids of the fixed tracks. Process and
+// CPU tracks get uuids derived from their id, so nothing has to remember
+// which tracks were declared beyond the CPUs.
+#define EXPORT_CPUS_PID 1
+#define EXPORT_PROCESSES_PID 2
+#define EXPORT_CPUS_UUID 1u
+#define EXPORT_PROCESSES_UUID 2u
+#define EXPORT_READY_UUID 3u
+#define EXPORT_CPU_UUID_BASE 0x100u
+#define EXPORT_PROCESS_UUID_BASE ((uint64_t)1 << 32)
+#define EXPORT_READY_NAME "Ready queue"
+#define EXPORT_MIN_PENDING 256
+
+// perfetto.protos field numbers and enum values used here.
+#define PB_TRACE_PACKET 1
+#define PB_PACKET_TIMESTAMP 8
+#define PB_PACKET_SEQUENCE_ID 10
+#define PB_PACKET_TRACK_EVENT 11
+#define PB_PACKET_SEQUENCE_FLAGS 13
+#define PB_PACKET_TRACK_DESCRIPTOR 60
+#define PB_DESCRIPTOR_UUID 1
+#define PB_DESCRIPTOR_NAME 2
+#define PB_DESCRIPTOR_PROCESS 3
+#define PB_DESCRIPTOR_PARENT_UUID 5
+#define PB_DESCRIPTOR_COUNTER 8
+#define PB_PROCESS_PID 1
+#define PB_PROCESS_NAME 6
+#define PB_EVENT_TYPE 9
+#define PB_EVENT_TRACK_UUID 11
+#define PB_EVENT_NAME 23
+#define PB_EVENT_COUNTER_VALUE 30
+#define PB_EVENT_SLICE_BEGIN 1
+#define PB_EVENT_SLICE_END 2
+#define PB_EVENT_INSTANT 3
+#define PB_EVENT_COUNTER 4
+#define PB_SEQUENCE_ID 1
+#define PB_INCREMENTAL_STATE_CLEARED 1
+
+typedef struct {
+    int time;
+    int delta;
+} ready_change_t;
+
+struct trace_exporter {
+    trace_export_config_t config;
+    FILE *out;
+    bool has_event;   // JSON: events after the first are preceded by a comma
+    bool cpu_declared[TRACE_EXPORT_MAX_CPUS];
+
+    // Ready-queue changes not yet proven final, and the samples written.
+    ready_change_t *pending;
+    int pending_count;
+    int pending_capacity;
+    int horizon;      // every change before this time has been written
+    int ready;
+    int last_sample;
+    bool has_sample;
+};
+
+typedef struct {
+    uint8_t bytes[1024];
+    size_t size;
+} pb_message_t;
+
+static void pb_varint(pb_message_t *message, uint64_t value) {
+    do {
+        uint8_t byte = (uint8_t)(value & 0x7Fu);
+        value >>= 7;
+        message->bytes[message->size++] = (uint8_t)(byte | (value ? 0x80u : 0u));
+    } while (value);
+}
+
+static void pb_uint(pb_message_t *message, int field, uint64_t value) {
+    pb_varint(message, (uint64_t)field << 3);
+    pb_varint(message, value);
+}
+
+static void pb_bytes(pb_message_t *message, int field, const void *bytes, size_t size) {
+    pb_varint(message, ((uint64_t)field << 3) | 2u);
+    pb_varint(message, size);
+    (void)memcpy(message->bytes + message->size, bytes, size);
+    message->size += size;
+}
+
+static void pb_string(pb_message_t *message, int field, const char *text) {
+    pb_bytes(message, field, text, strlen(text));
+}
+
+static void pb_write_packet(trace_exporter_t *exporter, pb_message_t *packet) {
+    pb_uint(packet, PB_PACKET_SEQUENCE_ID, PB_SEQUENCE_ID);
+    pb_message_t framed;
+    framed.size = 0;
+    pb_bytes(&framed, PB_TRACE_PACKET, packet->bytes, packet->size);
+    (void)fwrite(framed.bytes, 1, framed.size, exporter->out);
+}
+
+static void pb_write_descriptor(trace_exporter_t *exporter, const pb_message_t *descriptor) {
+    pb_message_t packet;
+    packet.size = 0;
+    pb_bytes(&packet, PB_PACKET_TRACK_DESCRIPTOR, descriptor->bytes, descriptor->size);
+    pb_write_packet(exporter, &packet);
+}
+
+static void pb_write_event(trace_exporter_t *exporter, int time, const pb_message_t *event) {
+    pb_message_t packet;
+    packet.size = 0;
+    pb_uint(&packet, PB_PACKET_TIMESTAMP, (uint64_t)time * (uint64_t)exporter->config.time_unit_ns);
+    pb_bytes(&packet, PB_PACKET_TRACK_EVENT, event->bytes, event->size);
+    pb_write_packet(exporter, &packet);
+}
+
+static void pb_track_event(trace_exporter_t *exporter, int time, uint64_t track, int type, const char *name) {
+    pb_message_t event;
+    event.size = 0;
+    pb_uint(&event, PB_EVENT_TYPE, (uint64_t)type);
+    pb_uint(&event, PB_EVENT_TRACK_UUID, track);
+    if (name) {
+        pb_string(&event, PB_EVENT_NAME, name);
+    }
+    pb_write_event(exporter, time, &event);
+}
+
+static void pb_process_track(trace_exporter_t *exporter, uint64_t uuid, int pid, const char *name) {
+    pb_message_t process;
+    process.size = 0;
+    pb_uint(&process, PB_PROCESS_PID, (uint64_t)pid);
+    pb_string(&process, PB_PROCESS_NAME, name);
+    pb_message_t descriptor;
+    descriptor.size = 0;
+    pb_uint(&descriptor, PB_DESCRIPTOR_UUID, uuid);
+    pb_bytes(&descriptor, PB_DESCRIPTOR_PROCESS, process.bytes, process.size);
+    pb_write_descriptor(exporter, &descriptor);
+}
+
+static void pb_child_track(trace_exporter_t *exporter, uint64_t uuid, uint64_t parent, const char *name,
+                           bool counter) {
+    pb_message_t descriptor;
+    descriptor.size = 0;
+    pb_uint(&descriptor, PB_DESCRIPTOR_UUID, uuid);
+    pb_string(&descriptor, PB_DESCRIPTOR_NAME, name);
+    pb_uint(&descriptor, PB_DESCRIPTOR_PARENT_UUID, parent);
+    if (counter) {
+        pb_bytes(&descriptor, PB_DESCRIPTOR_COUNTER, "", 0);
+    }
+    pb_write_descriptor(exporter, &descriptor);
+}
+
+static void json_begin(trace_exporter_t *exporter) {
+    fputs(exporter->has_event ? ",\n" : "\n", exporter->out);
+    exporter->has_event = true;
+}
+
+static void json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', out);
+            fputc(*p, out);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Microseconds with the nanosecond digits, without going through a double.
+static void json_time(trace_exporter_t *exporter, const char *key, int time) {
+    long long ns = (long long)time * exporter->config.time_unit_ns;
+    fprintf(exporter->out, ",\"%s\":%lld.%03lld", key, ns / 1000, ns % 1000);
+}
+
+static void json_track_name(trace_exporter_t *exporter, const char *kind, int pid, int tid, const char *name) {
+    json_begin(exporter);
+    fprintf(exporter->out, "{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":", kind, pid, tid);
+    json_string(exporter->out, name);
+    fputs("}}", exporter->out);
+}
+
+static void json_event(trace_exporter_t *exporter, const char *phase, int pid, int tid, const char *name, int time) {
+    json_begin(exporter);
+    fprintf(exporter->out, "{\"ph\":\"%s\",\"pid\":%d,\"tid\":%d,\"name\":", phase, pid, tid);
+    json_string(exporter->out, name);
+    json_time(exporter, "ts", time);
+}
+
+static uint64_t process_uuid(int process_id) {
+    return EXPORT_PROCESS_UUID_BASE + (uint32_t)process_id;
+}
+
+static const char *display_name(int process_id, const char *name, char *buffer, size_t size) {
+    if (name[0] != '\0') {
+        return name;
+    }
+    (void)snprintf(buffer, size, "P%d", process_id);
+    return buffer;
+}
+
+static void write_header(trace_exporter_t *exporter) {
+    if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+        pb_message_t packet;
+        packet.size = 0;
+        pb_uint(&packet, PB_PACKET_SEQUENCE_FLAGS, PB_INCREMENTAL_STATE_CLEARED);
+        pb_write_packet(exporter, &packet);
+        pb_process_track(exporter, EXPORT_CPUS_UUID, EXPORT_CPUS_PID, "CPUs");
+        pb_process_track(exporter, EXPORT_PROCESSES_UUID, EXPORT_PROCESSES_PID, "Processes");
+        pb_child_track(exporter, EXPORT_READY_UUID, EXPORT_CPUS_UUID, EXPORT_READY_NAME, true);
+        return;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", exporter->out);
+    json_track_name(exporter, "process_name", EXPORT_CPUS_PID, 0, "CPUs");
+    json_track_name(exporter, "process_name", EXPORT_PROCESSES_PID, 0, "Processes");
+}
+
+static void declare_cpu(trace_exporter_t *exporter, int cpu) {
+    if (exporter->cpu_declared[cpu]) {
+        return;
+    }
+    exporter->cpu_declared[cpu] = true;
+    char name[32];
+    (void)snprintf(name, sizeof(name), "CPU %d", cpu);
+    if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+        pb_child_track(exporter, EXPORT_CPU_UUID_BASE + (uint64_t)cpu, EXPORT_CPUS_UUID, name, false);
+    } else {
+        json_track_name(exporter, "thread_name", EXPORT_CPUS_PID, cpu, name);
+    }
+}
+
+static int add_change(trace_exporter_t *exporter, int time, int delta) {
+    if (time < exporter->horizon) {
+        return SCHED_ERR_ARGS;
+    }
+    if (exporter->pending_count == exporter->pending_capacity) {
+        int grown_capacity = (exporter->pending_capacity > 0) ? exporter->pending_capacity * 2 : EXPORT_MIN_PENDING;
+        ready_change_t *grown =
+            (ready_change_t *)realloc(exporter->pending, (size_t)grown_capacity * sizeof(ready_change_t));
+        if (!grown) {
+            return SCHED_ERR_ALLOC;
+        }
+        exporter->pending = grown;
+        exporter->pending_capacity = grown_capacity;
+    }
+    exporter->pending[exporter->pending_count].time = time;
+    exporter->pending[exporter->pending_count].delta = delta;
+    exporter->pending_count++;
+    return SCHED_OK;
+}
+
+static int compare_changes(const void *a, const void *b) {
+    int left = ((const ready_change_t *)a)->time;
+    int right = ((const ready_change_t *)b)->time;
+    return (left > right) - (left < right);
+}
+
+static void write_sample(trace_exporter_t *exporter, int time) {
+    if (exporter->has_sample && exporter->ready == exporter->last_sample) {
+        return;
+    }
+    exporter->has_sample = true;
+    exporter->last_sample = exporter->ready;
+    if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+        pb_message_t event;
+        event.size = 0;
+        pb_uint(&event, PB_EVENT_TYPE, PB_EVENT_COUNTER);
+        pb_uint(&event, PB_EVENT_TRACK_UUID, EXPORT_READY_UUID);
+        pb_uint(&event, PB_EVENT_COUNTER_VALUE, (uint64_t)exporter->ready);
+        pb_write_event(exporter, time, &event);
+        return;
+    }
+    json_begin(exporter);
+    fprintf(exporter->out, "{\"ph\":\"C\",\"pid\":%d,\"name\":\"" EXPORT_READY_NAME "\"", EXPORT_CPUS_PID);
+    json_time(exporter, "ts", time);
+    fprintf(exporter->out, ",\"args\":{\"length\":%d}}", exporter->ready);
+}
+
+// Writes one sample per time before `time` at which the queue changed;
+// changes at one time are summed first, so their push order does not matter.
+static void write_samples_before(trace_exporter_t *exporter, long long time) {
+    qsort(exporter->pending, (size_t)exporter->pending_count, sizeof(ready_change_t), compare_changes);
+    int i = 0;
+    while (i < exporter->pending_count && exporter->pending[i].time < time) {
+        int at = exporter->pending[i].time;
+        for (; i < exporter->pending_count && exporter->pending[i].time == at; i++) {
+            exporter->ready += exporter->pending[i].delta;
+        }
+        write_sample(exporter, at);
+    }
+    exporter->pending_count -= i;
+    (void)memmove(exporter->pending, exporter->pending + i, (size_t)exporter->pending_count * sizeof(ready_change_t));
+}
+
+void trace_export_config_default(trace_export_config_t *config) {
+    if (!config) {
+        return;
+    }
+    (void)memset(config, 0, sizeof(*config));
+    config->format = TRACE_EXPORT_CHROME_JSON;
+    config->time_unit_ns = TRACE_EXPORT_DEFAULT_TIME_UNIT_NS;
+}
+
+int trace_exporter_create(const trace_export_config_t *config, FILE *out, trace_exporter_t **exporter) {
+    if (!out || !exporter) {
+        return SCHED_ERR_ARGS;
+    }
+    *exporter = NULL;
+    trace_export_config_t resolved;
+    trace_export_config_default(&resolved);
+    if (config) {
+        resolved = *config;
+    }
+    if (resolved.time_unit_ns <= 0 || resolved.time_unit_ns > LLONG_MAX / INT_MAX ||
+        (resolved.format != TRACE_EXPORT_CHROME_JSON && resolved.format != TRACE_EXPORT_PERFETTO)) {
+        return SCHED_ERR_ARGS;
+    }
+
+    trace_exporter_t *created = (trace_exporter_t *)calloc(1, sizeof(trace_exporter_t));
+    if (!created) {
+        return SCHED_ERR_ALLOC;
+    }
+    created->config = resolved;
+    created->out = out;
+    created->horizon = 0;
+    write_header(created);
+    *exporter = created;
+    return SCHED_OK;
+}
+
+void trace_exporter_destroy(trace_exporter_t *exporter) {
+    if (!exporter) {
+        return;
+    }
+    free(exporter->pending);
+    free(exporter);
+}
+
+int trace_exporter_arrivals(trace_exporter_t *exporter, const process_t *processes, int process_count) {
+    if (!exporter || process_count < 0 || (!processes && process_count > 0)) {
+        return SCHED_ERR_ARGS;
+    }
+    for (int i = 0; i < process_count; i++) {
+        const process_t *process = &processes[i];
+        int status = add_change(exporter, process->arrival_time, 1);
+        if (status != SCHED_OK) {
+            return status;
+        }
+        char fallback[32];
+        const char *name = display_name(process->process_id, process->name, fallback, sizeof(fallback));
+        if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+            pb_child_track(exporter, process_uuid(process->process_id), EXPORT_PROCESSES_UUID, name, false);
+            pb_track_event(exporter, process->arrival_time, process_uuid(process->process_id), PB_EVENT_INSTANT,
+                           "arrival");
+        } else {
+            json_track_name(exporter, "thread_name", EXPORT_PROCESSES_PID, process->process_id, name);
+            json_event(exporter, "i", EXPORT_PROCESSES_PID, process->process_id, "arrival", process->arrival_time);
+            fputs(",\"s\":\"t\"}", exporter->out);
+        }
+    }
+    return SCHED_OK;
+}
+
+int trace_exporter_completions(trace_exporter_t *exporter, const process_t *processes, int process_count) {
+    if (!exporter || process_count < 0 || (!processes && process_count > 0)) {
+        return SCHED_ERR_ARGS;
+    }
+    for (int i = 0; i < process_count; i++) {
+        const process_t *process = &processes[i];
+        int status = add_change(exporter, process->completion_time, -1);
+        if (status != SCHED_OK) {
+            return status;
+        }
+        if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+            pb_track_event(exporter, process->completion_time, process_uuid(process->process_id), PB_EVENT_INSTANT,
+                           "completion");
+        } else {
+            json_event(exporter, "i", EXPORT_PROCESSES_PID, process->process_id, "completion",
+                       process->completion_time);
+            fputs(",\"s\":\"t\"}", exporter->out);
+        }
+    }
+    return SCHED_OK;
+}
+
+int trace_exporter_segments(trace_exporter_t *exporter, const timeline_event_t *events, int event_count, int cpu) {
+    if (!exporter || event_count < 0 || (!events && event_count > 0) || cpu < 0 || cpu >= TRACE_EXPORT_MAX_CPUS) {
+        return SCHED_ERR_ARGS;
+    }
+    declare_cpu(exporter, cpu);
+    for (int i = 0; i < event_count; i++) {
+        const timeline_event_t *event = &events[i];
+        if (event->end_time < event->start_time) {
+            return SCHED_ERR_ARGS;
+        }
+        bool overhead = event->process_id == TIMELINE_OVERHEAD_PROCESS_ID;
+        // The process leaves the ready queue while it runs.
+        if (!overhead) {
+            int status = add_change(exporter, event->start_time, -1);
+            if (status == SCHED_OK) {
+                status = add_change(exporter, event->end_time, 1);
+            }
+            if (status != SCHED_OK) {
+                return status;
+            }
+        }
+        char fallback[32];
+        const char *name = overhead ? TIMELINE_OVERHEAD_NAME
+                                    : display_name(event->process_id, event->process_name, fallback, sizeof(fallback));
+        if (exporter->config.format == TRACE_EXPORT_PERFETTO) {
+            uint64_t cpu_track = EXPORT_CPU_UUID_BASE + (uint64_t)cpu;
+            pb_track_event(exporter, event->start_time, cpu_track, PB_EVENT_SLICE_BEGIN, name);
+            pb_track_event(exporter, event->end_time, cpu_track, PB_EVENT_SLICE_END, NULL);
+            if (!overhead) {
+                uint64_t track = process_uuid(event->process_id);
+                pb_track_event(exporter, event->start_time, track, PB_EVENT_SLICE_BEGIN, "running");
+                pb_track_event(exporter, event->end_time, track, PB_EVENT_SLICE_END, NULL);
+            }
+            continue;
+        }
+        json_event(exporter, "X", EXPORT_CPUS_PID, cpu, name, event->start_time);
+        json_time(exporter, "dur", event->end_time - event->start_time);
+        fprintf(exporter->out, ",\"args\":{\"process_id\":%d}}", event->process_id);
+        if (!overhead) {
+            json_event(exporter, "X", EXPORT_PROCESSES_PID, event->process_id, "running", event->start_time);
+            json_time(exporter, "dur", event->end_time - event->start_time);
+            fprintf(exporter->out, ",\"args\":{\"cpu\":%d}}", cpu);
+        }
+    }
+    return SCHED_OK;
+}
+
+int trace_exporter_flush(trace_exporter_t *exporter, int time) {
+    if (!exporter) {
+        return SCHED_ERR_ARGS;
+    }
+    if (time <= exporter->horizon) {
+        return SCHED_OK;
+    }
+    write_samples_before(exporter, time);
+    exporter->horizon = time;
+    return SCHED_OK;
+}
+
+int trace_exporter_finish(trace_exporter_t *exporter) {
+    if (!exporter) {
+        return SCHED_ERR_ARGS;
+    }
+    write_samples_before(exporter, (long long)INT_MAX + 1);
+    exporter->horizon = INT_MAX;
+    if (exporter->config.format == TRACE_EXPORT_CHROME_JSON) {
+        fputs("\n]}\n", exporter->out);
+    }
+    return (fflush(exporter->out) != 0 || ferror(exporter->out)) ? SCHED_ERR_ARGS : SCHED_OK;
+}
+
+typedef struct {
+    int time;
+    int index;
+} ordered_process_t;
+
+static int compare_ordered(const void *a, const void *b) {
+    const ordered_process_t *left = (const ordered_process_t *)a;
+    const ordered_process_t *right = (const ordered_process_t *)b;
+    if (left->time != right->time) {
+        return (left->time > right->time) - (left->time < right->time);
+    }
+    return (left->index > right->index) - (left->index < right->index);
+}
+
+static ordered_process_t *order_by(const process_t *processes, int process_count, bool completion) {
+    ordered_process_t *order = (ordered_process_t *)malloc((size_t)(process_count > 0 ? process_count : 1) *
+                                                           sizeof(ordered_process_t));
+    if (!order) {
+        return NULL;
+    }
+    for (int i = 0; i < process_count; i++) {
+        order[i].time = completion ? processes[i].completion_time : processes[i].arrival_time;
+        order[i].index = i;
+    }
+    qsort(order, (size_t)process_count, sizeof(ordered_process_t), compare_ordered);
+    return order;
+}
+
+// Pushes the arrivals and completions at or before `time`, one at a time so
+// the exporter only ever holds what falls between two segment starts.
+static int push_until(trace_exporter_t *exporter, const process_t *processes, int process_count,
+                      const ordered_process_t *arrivals, const ordered_process_t *completions, int *next_arrival,
+                      int *next_completion, long long time) {
+    int status = SCHED_OK;
+    while (status == SCHED_OK && *next_arrival < process_count && arrivals[*next_arrival].time <= time) {
+        status = trace_exporter_arrivals(exporter, &processes[arrivals[(*next_arrival)++].index], 1);
+    }
+    while (status == SCHED_OK && *next_completion < process_count && completions[*next_completion].time <= time) {
+        status = trace_exporter_completions(exporter, &processes[completions[(*next_completion)++].index], 1);
+    }
+    return status;
+}
+
+int trace_export_schedule(
+    const process_t *processes,
+    int process_count,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const trace_export_config_t *config,
+    FILE *out
+) {
+    if (process_count < 0 || timeline_count < 0 || (!processes && process_count > 0) ||
+        (!timeline && timeline_count > 0)) {
+        return SCHED_ERR_ARGS;
+    }
+    ordered_process_t *arrivals = order_by(processes, process_count, false);
+    ordered_process_t *completions = order_by(processes, process_count, true);
+    trace_exporter_t *exporter = NULL;
+    int status = (arrivals && completions) ? trace_exporter_create(config, out, &exporter) : SCHED_ERR_ALLOC;
+
+    int next_arrival = 0;
+    int next_completion = 0;
+    for (int i = 0; i < timeline_count && status == SCHED_OK; i++) {
+        int start = timeline[i].start_time;
+        status = push_until(exporter, processes, process_count, arrivals, completions, &next_arrival,
+                            &next_completion, start);
+        if (status == SCHED_OK) {
+            status = trace_exporter_segments(exporter, &timeline[i], 1, 0);
+        }
+        if (status == SCHED_OK) {
+            status = trace_exporter_flush(exporter, start);
+        }
+    }
+    if (status == SCHED_OK) {
+        status = push_until(exporter, processes, process_count, arrivals, completions, &next_arrival,
+                            &next_completion, INT_MAX);
+    }
+    if (status == SCHED_OK) {
+        status = trace_exporter_finish(exporter);
+    }
+    trace_exporter_destroy(exporter);
+    free(arrivals);
+    free(completions);
+    return status;
+}
@@ -0,0 +1,81 @@
+#ifndef TRACE_EXPORT_H
+#define TRACE_EXPORT_H
+
+#include "process_types.h"
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Streaming export of a simulated schedule for Perfetto (ui.perfetto.dev)
+// or chrome://tracing, so it can be inspected like a recorded kernel trace.
+// The trace has two groups of tracks:
+//   "CPUs"       one track per CPU with every segment, context switches
+//                included, and a "Ready queue" counter track
+//   "Processes"  one track per process id with its running slices and its
+//                arrival and completion instants
+//
+// Events are written as they are pushed; only ready-queue changes wait
+// until a flush proves no earlier event can follow, so memory follows what
+// is pushed between flushes, never the length of the timeline. The ready
+// queue holds processes that have arrived, are not running and have not
+// completed. Times are ticks of time_unit_ns; the default matches
+// FTRACE_DEFAULT_TIME_UNIT_NS, so an imported kernel trace and its
+// simulation line up.
+#define TRACE_EXPORT_DEFAULT_TIME_UNIT_NS 1000
+#define TRACE_EXPORT_MAX_CPUS 256
+
+typedef enum {
+    TRACE_EXPORT_CHROME_JSON = 0,  // {"traceEvents": [...]}
+    TRACE_EXPORT_PERFETTO = 1      // perfetto.protos.Trace of TrackEvent packets
+} trace_export_format_t;
+
+typedef struct {
+    trace_export_format_t format;
+    long long time_unit_ns;
+} trace_export_config_t;
+
+typedef struct trace_exporter trace_exporter_t;
+
+void trace_export_config_default(trace_export_config_t *config);
+
+// Writes the header to `out`, which stays owned by the caller.
+int trace_exporter_create(const trace_export_config_t *config, FILE *out, trace_exporter_t **exporter);
+void trace_exporter_destroy(trace_exporter_t *exporter);
+
+// A process' arrival declares its track, so it must be pushed before the
+// process' segments and completion. Completions use completion_time.
+int trace_exporter_arrivals(trace_exporter_t *exporter, const process_t *processes, int process_count);
+int trace_exporter_completions(trace_exporter_t *exporter, const process_t *processes, int process_count);
+
+// Segments ran on `cpu` [0, TRACE_EXPORT_MAX_CPUS); those of one CPU must not
+// overlap. Overhead segments only appear on the CPU track.
+int trace_exporter_segments(trace_exporter_t *exporter, const timeline_event_t *events, int event_count, int cpu);
+
+// Promises that every event before `time` has been pushed and writes the
+// ready-queue samples up to it. Pushing an earlier event afterwards fails
+// with SCHED_ERR_ARGS.
+int trace_exporter_flush(trace_exporter_t *exporter, int time);
+
+// Writes the remaining samples and the trailer; fails with SCHED_ERR_ARGS
+// if writing to the stream failed at any point.
+int trace_exporter_finish(trace_exporter_t *exporter);
+
+// One-shot export of a finished single-CPU run (the processes and timeline
+// returned by schedule_processes), in any process order.
+int trace_export_schedule(
+    const process_t *processes,
+    int process_count,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const trace_export_config_t *config,
+    FILE *out
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_EXPORT_H
@@ -0,0 +1,792 @@
+#include "trace_ingest.h"
+
+#include "online_scheduler.h"
+#include "sched_internal.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef SCHED_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define TRACE_MAX_COLUMNS 256
+#define TRACE_MIN_BUFFER 64
+#define TRACE_DEFAULT_BUFFER (1024 * 1024)
+
+typedef enum {
+    ROLE_NONE = 0,
+    ROLE_ID,
+    ROLE_ARRIVAL,
+    ROLE_BURST,
+    ROLE_PRIORITY,
+    ROLE_NAME
+} field_role_t;
+
+struct trace_reader {
+    trace_ingest_config_t config;
+    trace_format_t format;
+#ifdef SCHED_HAVE_ZLIB
+    gzFile input;
+#else
+    FILE *input;
+#endif
+    char *buffer;
+    size_t capacity;
+    size_t start;              // first unconsumed byte
+    size_t end;                // one past the last byte read
+    bool eof;
+    unsigned char roles[TRACE_MAX_COLUMNS];  // CSV column -> role
+    int column_count;
+    long long rows;
+    long long skipped;
+    long long bytes;
+    double opened_at;
+};
+
+typedef struct {
+    bool has_id;
+    bool has_arrival;
+    bool has_burst;
+    bool has_priority;
+    bool has_name;
+} row_fields_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+void trace_ingest_config_default(trace_ingest_config_t *config) {
+    if (!config) {
+        return;
+    }
+    (void)memset(config, 0, sizeof(*config));
+    config->format = TRACE_FORMAT_AUTO;
+    config->delimiter = ',';
+    config->buffer_size = TRACE_DEFAULT_BUFFER;
+}
+
+bool trace_ingest_has_gzip(void) {
+#ifdef SCHED_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+static const char *field_spec(const trace_ingest_config_t *config, field_role_t role) {
+    switch (role) {
+        case ROLE_ID:
+            return config->id_field ? config->id_field : "id|process_id|job_id";
+        case ROLE_ARRIVAL:
+            return config->arrival_field ? config->arrival_field : "submit_time|arrival_time|submit";
+        case ROLE_BURST:
+            return config->burst_field ? config->burst_field : "runtime|burst_time|run_time";
+        case ROLE_PRIORITY:
+            return config->priority_field ? config->priority_field : "priority";
+        case ROLE_NAME:
+            return config->name_field ? config->name_field : "name|job_name";
+        case ROLE_NONE:
+            break;
+    }
+    return "";
+}
+
+// Whether `name` equals one of the '|'-separated alternatives in spec.
+static bool spec_matches(const char *spec, const char *name, size_t length) {
+    while (*spec) {
+        const char *bar = strchr(spec, '|');
+        size_t alternative = bar ? (size_t)(bar - spec) : strlen(spec);
+        if (alternative == length && memcmp(spec, name, length) == 0) {
+            return true;
+        }
+        if (!bar) {
+            break;
+        }
+        spec = bar + 1;
+    }
+    return false;
+}
+
+static field_role_t role_for(const trace_reader_t *reader, const char *name, size_t length) {
+    for (int role = ROLE_ID; role <= ROLE_NAME; role++) {
+        if (spec_matches(field_spec(&reader->config, (field_role_t)role), name, length)) {
+            return (field_role_t)role;
+        }
+    }
+    return ROLE_NONE;
+}
+
+static void trim(const char **text, size_t *length) {
+    while (*length > 0 && (**text == ' ' || **text == '\t')) {
+        (*text)++;
+        (*length)--;
+    }
+    while (*length > 0 && ((*text)[*length - 1] == ' ' || (*text)[*length - 1] == '\t')) {
+        (*length)--;
+    }
+}
+
+// Decimal integer with an optional fraction, rounded half away from zero.
+static bool parse_number(const char *text, size_t length, int *value) {
+    trim(&text, &length);
+    if (length >= 2 && text[0] == '"' && text[length - 1] == '"') {
+        text++;
+        length -= 2;
+    }
+    size_t i = 0;
+    bool negative = false;
+    if (i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = (text[i] == '-');
+        i++;
+    }
+    if (i == length) {
+        return false;
+    }
+
+    long long magnitude = 0;
+    size_t digits = 0;
+    while (i < length && text[i] >= '0' && text[i] <= '9') {
+        magnitude = magnitude * 10 + (text[i] - '0');
+        if (magnitude > INT_MAX) {
+            return false;
+        }
+        i++;
+        digits++;
+    }
+    if (i < length && text[i] == '.') {
+        i++;
+        if (i < length && text[i] >= '5' && text[i] <= '9') {
+            magnitude++;
+        }
+        while (i < length && text[i] >= '0' && text[i] <= '9') {
+            i++;
+            digits++;
+        }
+    }
+    if (digits == 0 || i != length || magnitude > INT_MAX) {
+        return false;
+    }
+    *value = negative ? (int)-magnitude : (int)magnitude;
+    return true;
+}
+
+// Copies a raw field into name, dropping CSV quotes ("" -> ") or decoding
+// JSON escapes (\uXXXX becomes '?').
+static void copy_name(char *name, const char *text, size_t length, bool json) {
+    size_t out = 0;
+    for (size_t i = 0; i < length && out < MAX_PROCESS_NAME - 1; i++) {
+        char c = text[i];
+        if (!json && c == '"' && i + 1 < length && text[i + 1] == '"') {
+            i++;
+        } else if (json && c == '\\' && i + 1 < length) {
+            char escaped = text[++i];
+            switch (escaped) {
+                case 'n':
+                    c = '\n';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'u':
+                    c = '?';
+                    i += (i + 4 < length) ? 4 : length - 1 - i;
+                    break;
+                default:
+                    c = escaped;
+                    break;
+            }
+        }
+        name[out++] = c;
+    }
+    name[out] = '\0';
+}
+
+// "job<id>" for rows without a name.
+static void default_name(char *name, int id) {
+    char digits[12];
+    int length = 0;
+    unsigned int value = (id < 0) ? 0U - (unsigned int)id : (unsigned int)id;
+    do {
+        digits[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    int out = 0;
+    name[out++] = 'j';
+    name[out++] = 'o';
+    name[out++] = 'b';
+    if (id < 0) {
+        name[out++] = '-';
+    }
+    while (length > 0) {
+        name[out++] = digits[--length];
+    }
+    name[out] = '\0';
+}
+
+static bool assign_field(process_t *process, row_fields_t *fields, field_role_t role, const char *text, size_t length,
+                         bool json_string) {
+    const char *trimmed = text;
+    size_t trimmed_length = length;
+    trim(&trimmed, &trimmed_length);
+    if (trimmed_length == 0 && (role == ROLE_ID || role == ROLE_PRIORITY)) {
+        return true;  // empty optional field: use the default
+    }
+
+    switch (role) {
+        case ROLE_ID:
+            fields->has_id = parse_number(text, length, &process->process_id);
+            return fields->has_id;
+        case ROLE_ARRIVAL:
+            fields->has_arrival = parse_number(text, length, &process->arrival_time);
+            return fields->has_arrival;
+        case ROLE_BURST:
+            fields->has_burst = parse_number(text, length, &process->burst_time);
+            return fields->has_burst;
+        case ROLE_PRIORITY:
+            fields->has_priority = parse_number(text, length, &process->priority);
+            return fields->has_priority;
+        case ROLE_NAME:
+            if (!json_string) {
+                trim(&text, &length);
+            }
+            copy_name(process->name, text, length, json_string);
+            fields->has_name = true;
+            return true;
+        case ROLE_NONE:
+            break;
+    }
+    return true;
+}
+
+// Splits one CSV field starting at *cursor; quoted fields come back without
+// their outer quotes. *more tells whether a delimiter followed. Returns false
+// on an unterminated quote.
+static bool next_csv_field(const char **cursor, const char *end, char delimiter, const char **field, size_t *length,
+                           bool *more) {
+    const char *p = *cursor;
+    while (p < end && (*p == ' ' || *p == '\t') && *p != delimiter) {
+        p++;
+    }
+    if (p < end && *p == '"') {
+        const char *q = p + 1;
+        for (;;) {
+            q = (const char *)memchr(q, '"', (size_t)(end - q));
+            if (!q) {
+                return false;
+            }
+            if (q + 1 < end && q[1] == '"') {
+                q += 2;
+                continue;
+            }
+            break;
+        }
+        *field = p + 1;
+        *length = (size_t)(q - p - 1);
+        p = q + 1;
+        while (p < end && *p != delimiter) {
+            p++;
+        }
+    } else {
+        const char *stop = (const char *)memchr(p, delimiter, (size_t)(end - p));
+        if (!stop) {
+            stop = end;
+        }
+        *field = p;
+        *length = (size_t)(stop - p);
+        p = stop;
+    }
+    *more = (p < end);
+    *cursor = *more ? p + 1 : end;
+    return true;
+}
+
+static bool parse_csv_header(trace_reader_t *reader, const char *line, size_t length) {
+    const char *cursor = line;
+    const char *end = line + length;
+    bool has_arrival = false;
+    bool has_burst = false;
+    bool more = true;
+    reader->column_count = 0;
+
+    while (more && reader->column_count < TRACE_MAX_COLUMNS) {
+        const char *field = NULL;
+        size_t field_length = 0;
+        if (!next_csv_field(&cursor, end, reader->config.delimiter, &field, &field_length, &more)) {
+            return false;
+        }
+        trim(&field, &field_length);
+        field_role_t role = role_for(reader, field, field_length);
+        has_arrival = has_arrival || role == ROLE_ARRIVAL;
+        has_burst = has_burst || role == ROLE_BURST;
+        reader->roles[reader->column_count++] = (unsigned char)role;
+    }
+    return has_arrival && has_burst;
+}
+
+static bool parse_csv_row(const trace_reader_t *reader, const char *line, size_t length, process_t *process,
+                          row_fields_t *fields) {
+    const char *cursor = line;
+    const char *end = line + length;
+    bool more = true;
+    for (int column = 0; column < reader->column_count && more; column++) {
+        const char *field = NULL;
+        size_t field_length = 0;
+        if (!next_csv_field(&cursor, end, reader->config.delimiter, &field, &field_length, &more)) {
+            return false;
+        }
+        field_role_t role = (field_role_t)reader->roles[column];
+        if (role != ROLE_NONE && !assign_field(process, fields, role, field, field_length, false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const char *skip_space(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+// p is on an opening quote; returns the closing quote, or NULL.
+static const char *json_string_end(const char *p, const char *end) {
+    for (p++; p < end; p++) {
+        if (*p == '\\') {
+            p++;
+        } else if (*p == '"') {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// Skips a nested object or array; returns one past its closing bracket.
+static const char *json_skip_nested(const char *p, const char *end) {
+    int depth = 0;
+    for (; p < end; p++) {
+        if (*p == '"') {
+            p = json_string_end(p, end);
+            if (!p) {
+                return NULL;
+            }
+        } else if (*p == '{' || *p == '[') {
+            depth++;
+        } else if (*p == '}' || *p == ']') {
+            if (--depth == 0) {
+                return p + 1;
+            }
+        }
+    }
+    return NULL;
+}
+
+static bool parse_json_row(const trace_reader_t *reader, const char *line, size_t length, process_t *process,
+                           row_fields_t *fields) {
+    const char *end = line + length;
+    const char *p = skip_space(line, end);
+    if (p == end || *p != '{') {
+        return false;
+    }
+    p = skip_space(p + 1, end);
+    if (p < end && *p == '}') {
+        return true;
+    }
+
+    for (;;) {
+        if (p == end || *p != '"') {
+            return false;
+        }
+        const char *key_end = json_string_end(p, end);
+        if (!key_end) {
+            return false;
+        }
+        field_role_t role = role_for(reader, p + 1, (size_t)(key_end - p - 1));
+        p = skip_space(key_end + 1, end);
+        if (p == end || *p != ':') {
+            return false;
+        }
+        p = skip_space(p + 1, end);
+        if (p == end) {
+            return false;
+        }
+
+        const char *value = p;
+        size_t value_length = 0;
+        bool is_string = false;
+        if (*p == '"') {
+            const char *value_end = json_string_end(p, end);
+            if (!value_end) {
+                return false;
+            }
+            value = p + 1;
+            value_length = (size_t)(value_end - p - 1);
+            is_string = true;
+            p = value_end + 1;
+        } else if (*p == '{' || *p == '[') {
+            p = json_skip_nested(p, end);
+            if (!p) {
+                return false;
+            }
+            role = ROLE_NONE;
+        } else {
+            while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t') {
+                p++;
+            }
+            value_length = (size_t)(p - value);
+        }
+
+        if (role != ROLE_NONE && !(value_length == 4 && memcmp(value, "null", 4) == 0 && !is_string) &&
+            !assign_field(process, fields, role, value, value_length, is_string)) {
+            return false;
+        }
+
+        p = skip_space(p, end);
+        if (p < end && *p == ',') {
+            p = skip_space(p + 1, end);
+            continue;
+        }
+        return p < end && *p == '}';
+    }
+}
+
+// *got is 0 only at a clean end of input; a read error or a corrupt or
+// truncated gzip stream fails instead of passing for the end.
+static int read_input(trace_reader_t *reader, char *into, size_t capacity, size_t *got) {
+#ifdef SCHED_HAVE_ZLIB
+    unsigned int request = (capacity > (size_t)INT_MAX) ? (unsigned int)INT_MAX : (unsigned int)capacity;
+    int read = gzread(reader->input, into, request);
+    int error = Z_OK;
+    if (read <= 0) {
+        (void)gzerror(reader->input, &error);
+    }
+    if (read < 0 || (error != Z_OK && error != Z_STREAM_END)) {
+        *got = 0U;
+        return SCHED_ERR_ARGS;
+    }
+    *got = (size_t)read;
+#else
+    *got = fread(into, 1, capacity, reader->input);
+    if (*got == 0U && ferror(reader->input)) {
+        return SCHED_ERR_ARGS;
+    }
+#endif
+    return SCHED_OK;
+}
+
+// Next line without its terminator. Returns 1 for a line, 0 at the end of
+// input and SCHED_ERR_ARGS for a line that does not fit in the buffer or
+// input that cannot be read.
+static int next_line(trace_reader_t *reader, const char **line, size_t *length) {
+    for (;;) {
+        char *begin = reader->buffer + reader->start;
+        char *newline = (char *)memchr(begin, '\n', reader->end - reader->start);
+        if (newline || (reader->eof && reader->start < reader->end)) {
+            size_t line_length = newline ? (size_t)(newline - begin) : reader->end - reader->start;
+            reader->start += line_length + (newline ? 1U : 0U);
+            reader->bytes += (long long)line_length + (newline ? 1 : 0);
+            if (line_length > 0 && begin[line_length - 1] == '\r') {
+                line_length--;
+            }
+            *line = begin;
+            *length = line_length;
+            return 1;
+        }
+        if (reader->eof) {
+            return 0;
+        }
+
+        if (reader->start > 0) {
+            (void)memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+            reader->end -= reader->start;
+            reader->start = 0;
+        }
+        if (reader->end == reader->capacity) {
+            return SCHED_ERR_ARGS;
+        }
+        size_t got = 0;
+        if (read_input(reader, reader->buffer + reader->end, reader->capacity - reader->end, &got) != SCHED_OK) {
+            return SCHED_ERR_ARGS;
+        }
+        reader->end += got;
+        reader->eof = (got == 0U);
+    }
+}
+
+static bool has_suffix(const char *text, const char *suffix) {
+    size_t text_length = strlen(text);
+    size_t suffix_length = strlen(suffix);
+    return text_length >= suffix_length && strcmp(text + text_length - suffix_length, suffix) == 0;
+}
+
+static trace_format_t format_for_path(const char *path) {
+    const char *json_suffixes[] = {".jsonl", ".ndjson", ".json", ".jsonl.gz", ".ndjson.gz", ".json.gz"};
+    for (size_t i = 0; i < sizeof(json_suffixes) / sizeof(json_suffixes[0]); i++) {
+        if (has_suffix(path, json_suffixes[i])) {
+            return TRACE_FORMAT_JSONL;
+        }
+    }
+    return TRACE_FORMAT_CSV;
+}
+
+static void close_input(trace_reader_t *reader) {
+#ifdef SCHED_HAVE_ZLIB
+    if (reader->input) {
+        (void)gzclose(reader->input);
+    }
+#else
+    if (reader->input && reader->input != stdin) {
+        (void)fclose(reader->input);
+    }
+#endif
+}
+
+void trace_reader_close(trace_reader_t *reader) {
+    if (!reader) {
+        return;
+    }
+    close_input(reader);
+    free(reader->buffer);
+    free(reader);
+}
+
+int trace_reader_open(const char *path, const trace_ingest_config_t *config, trace_reader_t **reader) {
+    if (!path || !reader) {
+        return SCHED_ERR_ARGS;
+    }
+    *reader = NULL;
+
+    trace_reader_t *opened = (trace_reader_t *)calloc(1, sizeof(trace_reader_t));
+    if (!opened) {
+        return SCHED_ERR_ALLOC;
+    }
+    trace_ingest_config_default(&opened->config);
+    if (config) {
+        opened->config = *config;
+    }
+    if (opened->config.buffer_size < TRACE_MIN_BUFFER) {
+        opened->config.buffer_size = TRACE_MIN_BUFFER;
+    }
+    if (opened->config.delimiter == '\0') {
+        opened->config.delimiter = ',';
+    }
+    bool use_stdin = strcmp(path, "-") == 0;
+    opened->format = (opened->config.format != TRACE_FORMAT_AUTO) ? opened->config.format
+                     : use_stdin                                   ? TRACE_FORMAT_CSV
+                                                                   : format_for_path(path);
+    opened->capacity = opened->config.buffer_size;
+    opened->buffer = (char *)malloc(opened->capacity);
+    if (!opened->buffer) {
+        free(opened);
+        return SCHED_ERR_ALLOC;
+    }
+
+#ifdef SCHED_HAVE_ZLIB
+    opened->input = use_stdin ? gzdopen(0, "rb") : gzopen(path, "rb");
+    if (opened->input) {
+        (void)gzbuffer(opened->input, 256U * 1024U);
+    }
+#else
+    opened->input = use_stdin ? stdin : fopen(path, "rb");
+#endif
+    if (!opened->input) {
+        trace_reader_close(opened);
+        return SCHED_ERR_ARGS;
+    }
+    opened->opened_at = now_seconds();
+
+#ifndef SCHED_HAVE_ZLIB
+    // Without zlib a gzip stream would be parsed as garbage; refuse it.
+    size_t got = 0;
+    if (read_input(opened, opened->buffer, opened->capacity, &got) != SCHED_OK) {
+        trace_reader_close(opened);
+        return SCHED_ERR_ARGS;
+    }
+    opened->end = got;
+    opened->eof = (got == 0U);
+    if (got >= 2 && (unsigned char)opened->buffer[0] == 0x1F && (unsigned char)opened->buffer[1] == 0x8B) {
+        trace_reader_close(opened);
+        return SCHED_ERR_ARGS;
+    }
+#endif
+
+    if (opened->format == TRACE_FORMAT_CSV) {
+        const char *line = NULL;
+        size_t length = 0;
+        if (next_line(opened, &line, &length) != 1 || !parse_csv_header(opened, line, length)) {
+            trace_reader_close(opened);
+            return SCHED_ERR_ARGS;
+        }
+    }
+
+    *reader = opened;
+    return SCHED_OK;
+}
+
+int trace_reader_next(trace_reader_t *reader, process_t *processes, int capacity, int *count) {
+    if (!reader || !processes || capacity <= 0 || !count) {
+        return SCHED_ERR_ARGS;
+    }
+    *count = 0;
+
+    while (*count < capacity) {
+        const char *line = NULL;
+        size_t length = 0;
+        int status = next_line(reader, &line, &length);
+        if (status < 0) {
+            return status;
+        }
+        if (status == 0) {
+            break;
+        }
+        if (length == 0) {
+            continue;
+        }
+
+        process_t *process = &processes[*count];
+        row_fields_t fields = {false, false, false, false, false};
+        bool parsed = (reader->format == TRACE_FORMAT_JSONL) ? parse_json_row(reader, line, length, process, &fields)
+                                                              : parse_csv_row(reader, line, length, process, &fields);
+        if (!parsed || !fields.has_arrival || !fields.has_burst) {
+            reader->skipped++;
+            continue;
+        }
+
+        reader->rows++;
+        if (!fields.has_id) {
+            process->process_id = (reader->rows > INT_MAX) ? INT_MAX : (int)reader->rows;
+        }
+        if (!fields.has_priority) {
+            process->priority = 1;
+        }
+        if (!fields.has_name) {
+            default_name(process->name, process->process_id);
+        }
+        process->remaining_time = process->burst_time;
+        process->completion_time = 0;
+        process->turnaround_time = 0;
+        process->waiting_time = 0;
+        process->response_time = -1;
+        process->first_run_time = -1;
+        (*count)++;
+    }
+    return SCHED_OK;
+}
+
+int trace_reader_stats(const trace_reader_t *reader, trace_ingest_stats_t *stats) {
+    if (!reader || !stats) {
+        return SCHED_ERR_ARGS;
+    }
+    stats->rows = reader->rows;
+    stats->skipped = reader->skipped;
+    stats->bytes = reader->bytes;
+    stats->seconds = now_seconds() - reader->opened_at;
+    stats->rows_per_second = (stats->seconds > 0.0) ? (double)reader->rows / stats->seconds : 0.0;
+    return SCHED_OK;
+}
+
+// Hands back and frees whatever the simulator has finished with.
+static int discard_output(online_scheduler_t *sim) {
+    timeline_event_t *events = NULL;
+    int event_count = 0;
+    process_t *completed = NULL;
+    int completed_count = 0;
+    int status = online_scheduler_drain_events(sim, &events, &event_count);
+    free(events);
+    if (status == SCHED_OK) {
+        status = online_scheduler_drain_completed(sim, &completed, &completed_count);
+        free(completed);
+    }
+    return status;
+}
+
+int trace_simulate(
+    trace_reader_t *reader,
+    const schedule_config_t *config,
+    int batch,
+    metrics_t *metrics,
+    trace_ingest_stats_t *stats
+) {
+    if (!reader || !config || batch <= 0 || !metrics) {
+        return SCHED_ERR_ARGS;
+    }
+
+    process_t *rows = (process_t *)malloc((size_t)batch * sizeof(process_t));
+    if (!rows) {
+        return SCHED_ERR_ALLOC;
+    }
+    online_scheduler_t *sim = NULL;
+    int status = online_scheduler_create(config, &sim);
+    if (status != SCHED_OK) {
+        free(rows);
+        return status;
+    }
+
+    long long late = 0;
+    for (;;) {
+        int count = 0;
+        status = trace_reader_next(reader, rows, batch, &count);
+        if (status != SCHED_OK || count == 0) {
+            break;
+        }
+
+        int clock = online_scheduler_time(sim);
+        int last_arrival = -1;
+        for (int i = 0; i < count && status == SCHED_OK; i++) {
+            // Negative arrivals mean "at the start", as in the batch scheduler.
+            if (rows[i].arrival_time < 0) {
+                rows[i].arrival_time = 0;
+            }
+            if (rows[i].arrival_time < clock) {
+                late++;
+                continue;
+            }
+            status = online_scheduler_submit(sim, &rows[i]);
+            last_arrival = rows[i].arrival_time;
+        }
+        if (status == SCHED_OK && last_arrival >= 0) {
+            status = online_scheduler_advance_to(sim, last_arrival);
+        }
+        if (status == SCHED_OK) {
+            status = discard_output(sim);
+        }
+        if (status != SCHED_OK) {
+            break;
+        }
+    }
+
+    if (status == SCHED_OK) {
+        status = online_scheduler_advance_to(sim, INT_MAX);
+    }
+    if (status == SCHED_OK) {
+        status = discard_output(sim);
+    }
+    if (status == SCHED_OK) {
+        status = online_scheduler_metrics(sim, metrics);
+    }
+    if (status == SCHED_OK && stats) {
+        status = trace_reader_stats(reader, stats);
+        stats->rows -= late;
+        stats->skipped += late;
+    }
+
+    online_scheduler_destroy(sim);
+    free(rows);
+    return status;
+}
@@ -0,0 +1,86 @@
+#ifndef TRACE_INGEST_H
+#define TRACE_INGEST_H
+
+#include "process_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Streaming reader for job logs in CSV (with a header row) or JSON Lines
+// (one flat object per line). Input is read through one fixed buffer and
+// tokenised in place, so memory does not grow with the file and no row
+// allocates. gzip input is read transparently when built with zlib.
+//
+// Field names are '|'-separated alternatives matched against the CSV header
+// or the JSON keys. Only the arrival and burst fields are required: ids
+// default to the row number, priorities to 1 and names to "job<id>".
+// Numbers may carry a fraction, which is rounded. CSV fields may be quoted
+// ("" escapes a quote) but may not span lines.
+typedef enum {
+    TRACE_FORMAT_AUTO = 0,  // from the file name: .jsonl/.ndjson/.json (optionally .gz), else CSV
+    TRACE_FORMAT_CSV = 1,
+    TRACE_FORMAT_JSONL = 2
+} trace_format_t;
+
+typedef struct {
+    trace_format_t format;
+    const char *id_field;        // NULL fields use the defaults listed in trace_ingest_config_default
+    const char *arrival_field;
+    const char *burst_field;
+    const char *priority_field;
+    const char *name_field;
+    char delimiter;              // CSV only
+    size_t buffer_size;          // bytes read at a time; also the longest accepted row
+} trace_ingest_config_t;
+
+typedef struct {
+    long long rows;              // rows handed out
+    long long skipped;           // malformed rows, or rows missing a required field
+    long long bytes;             // input bytes consumed (decompressed)
+    double seconds;              // since the reader was opened
+    double rows_per_second;
+} trace_ingest_stats_t;
+
+typedef struct trace_reader trace_reader_t;
+
+// id "id|process_id|job_id", arrival "submit_time|arrival_time|submit",
+// burst "runtime|burst_time|run_time", priority "priority",
+// name "name|job_name"; ',' delimiter and a 1 MiB buffer.
+void trace_ingest_config_default(trace_ingest_config_t *config);
+bool trace_ingest_has_gzip(void);
+
+// path "-" reads stdin. A CSV header is read here, so a file lacking the
+// required columns fails to open.
+int trace_reader_open(const char *path, const trace_ingest_config_t *config, trace_reader_t **reader);
+void trace_reader_close(trace_reader_t *reader);
+
+// Up to `capacity` next rows; *count is 0 once the input is exhausted.
+// Fails with SCHED_ERR_ARGS on a row longer than the buffer and on input
+// that cannot be read, such as a corrupt or truncated .gz file.
+int trace_reader_next(trace_reader_t *reader, process_t *processes, int capacity, int *count);
+int trace_reader_stats(const trace_reader_t *reader, trace_ingest_stats_t *stats);
+
+// Feeds the whole trace, `batch` rows at a time, through the online
+// scheduler and reports the final metrics. Timeline segments and finished
+// processes are discarded as they are produced, so memory follows the
+// active set rather than the trace. Rows should be sorted by arrival; order
+// within a batch does not matter, but a row arriving before the previous
+// batch's last row is past the simulator's clock and counted as skipped
+// rather than as a row.
+int trace_simulate(
+    trace_reader_t *reader,
+    const schedule_config_t *config,
+    int batch,
+    metrics_t *metrics,
+    trace_ingest_stats_t *stats
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_INGEST_H
@@ -1,5 +1,8 @@
 #include "utils.h"
 
+#include "sched_internal.h"
+
+#include <stdlib.h>
 #include <string.h>
 
 int clamp_int(int value, int min_value, int max_value) {
@@ -50,3 +53,51 @@ void initialize_process_runtime_fields(process_t *processes, int count) {
         processes[i].first_run_time = -1;
     }
 }
+
+typedef struct {
+    int arrival;
+    int index;
+} arrival_key_t;
+
+static int compare_arrival_keys(const void *lhs, const void *rhs) {
+    const arrival_key_t *a = (const arrival_key_t *)lhs;
+    const arrival_key_t *b = (const arrival_key_t *)rhs;
+    if (a->arrival != b->arrival) {
+        return (a->arrival > b->arrival) - (a->arrival < b->arrival);
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+int arrival_order(const void *arrivals, size_t stride, int count, int **order) {
+    if (!order || count < 0 || (count > 0 && !arrivals)) {
+        return SCHED_ERR_ARGS;
+    }
+    *order = NULL;
+    const char *base = (const char *)arrivals;
+    bool sorted = true;
+    for (int i = 1; i < count && sorted; i++) {
+        sorted = *(const int *)(base + (size_t)(i - 1) * stride) <= *(const int *)(base + (size_t)i * stride);
+    }
+    if (sorted) {
+        return SCHED_OK;
+    }
+
+    arrival_key_t *keys = (arrival_key_t *)malloc((size_t)count * sizeof(arrival_key_t));
+    int *permutation = (int *)malloc((size_t)count * sizeof(int));
+    if (!keys || !permutation) {
+        free(keys);
+        free(permutation);
+        return SCHED_ERR_ALLOC;
+    }
+    for (int i = 0; i < count; i++) {
+        keys[i].arrival = *(const int *)(base + (size_t)i * stride);
+        keys[i].index = i;
+    }
+    qsort(keys, (size_t)count, sizeof(arrival_key_t), compare_arrival_keys);
+    for (int i = 0; i < count; i++) {
+        permutation[i] = keys[i].index;
+    }
+    free(keys);
+    *order = permutation;
+    return SCHED_OK;
+}
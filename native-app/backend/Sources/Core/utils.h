@@ -12,6 +12,12 @@ int clamp_int(int value, int min_value, int max_value);
 void safe_copy_string(char *dst, size_t dst_size, const char *src);
 void initialize_process_runtime_fields(process_t *processes, int count);
 
+// The order in which the online scheduler must take `count` records whose
+// int arrival times sit `stride` bytes apart: *order is NULL when the
+// records are already sorted, else a malloc'd permutation in which ties
+// keep record order, as in the batch API. free() it.
+int arrival_order(const void *arrivals, size_t stride, int count, int **order);
+
 #ifdef __cplusplus
 }
 #endif
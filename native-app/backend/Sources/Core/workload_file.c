@@ -0,0 +1,372 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "workload_file.h"
+
+#include "sched_internal.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define WORKLOAD_FILE_ALIGNMENT 8
+
+struct workload_file {
+    void *mapping;
+    size_t mapping_size;
+    workload_columns_t columns;
+};
+
+struct workload_file_writer {
+    int32_t *ids;
+    int32_t *arrivals;
+    int32_t *bursts;
+    int32_t *priorities;
+    uint32_t *name_offsets;  // count + 1 entries once anything was added
+    int count;
+    int capacity;
+    char *names;
+    size_t names_size;
+    size_t names_capacity;
+};
+
+static uint64_t align_up(uint64_t value) {
+    return (value + WORKLOAD_FILE_ALIGNMENT - 1) & ~(uint64_t)(WORKLOAD_FILE_ALIGNMENT - 1);
+}
+
+// The section [offset, offset + bytes) lies inside the file and is aligned.
+static bool section_is_valid(const workload_file_header_t *header, uint64_t offset, uint64_t bytes) {
+    return offset % sizeof(int32_t) == 0 && offset >= header->header_size && offset <= header->file_size &&
+           bytes <= header->file_size - offset;
+}
+
+static bool header_is_valid(const workload_file_header_t *header, size_t file_size) {
+    if (memcmp(header->magic, WORKLOAD_FILE_MAGIC, 4) != 0 || header->version != WORKLOAD_FILE_VERSION ||
+        header->byte_order != WORKLOAD_FILE_BYTE_ORDER || header->header_size < sizeof(workload_file_header_t) ||
+        header->file_size != (uint64_t)file_size || header->process_count > (uint64_t)INT_MAX - 1) {
+        return false;
+    }
+    uint64_t column_bytes = header->process_count * sizeof(int32_t);
+    return section_is_valid(header, header->ids_offset, column_bytes) &&
+           section_is_valid(header, header->arrivals_offset, column_bytes) &&
+           section_is_valid(header, header->bursts_offset, column_bytes) &&
+           section_is_valid(header, header->priorities_offset, column_bytes) &&
+           section_is_valid(header, header->name_offsets_offset, column_bytes + sizeof(uint32_t)) &&
+           header->names_offset >= header->header_size && header->names_offset <= header->file_size &&
+           header->names_size <= header->file_size - header->names_offset;
+}
+
+int workload_file_open(const char *path, workload_file_t **file) {
+    if (!path || !file) {
+        return SCHED_ERR_ARGS;
+    }
+    *file = NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return SCHED_ERR_ARGS;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(workload_file_header_t)) {
+        (void)close(fd);
+        return SCHED_ERR_ARGS;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (mapping == MAP_FAILED) {
+        return SCHED_ERR_ALLOC;
+    }
+
+    const workload_file_header_t *header = (const workload_file_header_t *)mapping;
+    if (!header_is_valid(header, size)) {
+        (void)munmap(mapping, size);
+        return SCHED_ERR_ARGS;
+    }
+
+    workload_file_t *opened = (workload_file_t *)calloc(1, sizeof(workload_file_t));
+    if (!opened) {
+        (void)munmap(mapping, size);
+        return SCHED_ERR_ALLOC;
+    }
+    const char *base = (const char *)mapping;
+    opened->mapping = mapping;
+    opened->mapping_size = size;
+    opened->columns.process_count = (int)header->process_count;
+    opened->columns.ids = (const int32_t *)(base + header->ids_offset);
+    opened->columns.arrivals = (const int32_t *)(base + header->arrivals_offset);
+    opened->columns.bursts = (const int32_t *)(base + header->bursts_offset);
+    opened->columns.priorities = (const int32_t *)(base + header->priorities_offset);
+    opened->columns.name_offsets = (const uint32_t *)(base + header->name_offsets_offset);
+    opened->columns.names = base + header->names_offset;
+    opened->columns.names_size = header->names_size;
+
+    *file = opened;
+    return SCHED_OK;
+}
+
+void workload_file_close(workload_file_t *file) {
+    if (!file) {
+        return;
+    }
+    (void)munmap(file->mapping, file->mapping_size);
+    free(file);
+}
+
+const workload_columns_t *workload_file_columns(const workload_file_t *file) {
+    return file ? &file->columns : NULL;
+}
+
+int workload_columns_name(const workload_columns_t *columns, int index, char *name, size_t capacity) {
+    if (!columns || !name || capacity == 0U || index < 0 || index >= columns->process_count) {
+        return SCHED_ERR_ARGS;
+    }
+    uint32_t begin = columns->name_offsets[index];
+    uint32_t end = columns->name_offsets[index + 1];
+    if (begin > end || (uint64_t)end > columns->names_size) {
+        name[0] = '\0';
+        return SCHED_ERR_ARGS;
+    }
+
+    size_t length = end - begin;
+    if (length > capacity - 1U) {
+        length = capacity - 1U;
+    }
+    (void)memcpy(name, columns->names + begin, length);
+    name[length] = '\0';
+    return SCHED_OK;
+}
+
+int schedule_workload_columns(
+    const workload_columns_t *columns,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+) {
+    if (!columns || columns->process_count <= 0 || !config) {
+        return SCHED_ERR_ARGS;
+    }
+
+    // The timeline copies names straight out of the blob, so check every
+    // offset first; a metrics-only run never touches the names.
+    int count = columns->process_count;
+    if (timeline) {
+        for (int i = 0; i < count; i++) {
+            if (columns->name_offsets[i] > columns->name_offsets[i + 1] ||
+                (uint64_t)columns->name_offsets[i + 1] > columns->names_size) {
+                return SCHED_ERR_ARGS;
+            }
+        }
+    }
+
+    sched_inputs_t inputs;
+    (void)memset(&inputs, 0, sizeof(inputs));
+    inputs.ids = (const char *)columns->ids;
+    inputs.arrivals = (const char *)columns->arrivals;
+    inputs.bursts = (const char *)columns->bursts;
+    inputs.priorities = (const char *)columns->priorities;
+    inputs.stride = sizeof(int32_t);
+    inputs.name_offsets = columns->name_offsets;
+    inputs.name_blob = columns->names;
+    return sched_schedule_inputs(&inputs, count, config, results, timeline, timeline_count, NULL, metrics);
+}
+
+int workload_file_writer_create(workload_file_writer_t **writer) {
+    if (!writer) {
+        return SCHED_ERR_ARGS;
+    }
+    *writer = (workload_file_writer_t *)calloc(1, sizeof(workload_file_writer_t));
+    return *writer ? SCHED_OK : SCHED_ERR_ALLOC;
+}
+
+void workload_file_writer_destroy(workload_file_writer_t *writer) {
+    if (!writer) {
+        return;
+    }
+    free(writer->ids);
+    free(writer->arrivals);
+    free(writer->bursts);
+    free(writer->priorities);
+    free(writer->name_offsets);
+    free(writer->names);
+    free(writer);
+}
+
+static int writer_reserve(workload_file_writer_t *writer, int needed) {
+    if (needed <= writer->capacity) {
+        return SCHED_OK;
+    }
+    int capacity = (writer->capacity > 0) ? writer->capacity : 1024;
+    while (capacity < needed) {
+        capacity = (capacity > INT_MAX / 2) ? INT_MAX - 1 : capacity * 2;
+    }
+
+    // Each array is swapped in as soon as it grows, so a failure part-way
+    // leaves every array valid for the old capacity at least.
+    int32_t **columns[4] = {&writer->ids, &writer->arrivals, &writer->bursts, &writer->priorities};
+    for (int c = 0; c < 4; c++) {
+        int32_t *grown = (int32_t *)realloc(*columns[c], (size_t)capacity * sizeof(int32_t));
+        if (!grown) {
+            return SCHED_ERR_ALLOC;
+        }
+        *columns[c] = grown;
+    }
+    uint32_t *offsets = (uint32_t *)realloc(writer->name_offsets, ((size_t)capacity + 1U) * sizeof(uint32_t));
+    if (!offsets) {
+        return SCHED_ERR_ALLOC;
+    }
+    offsets[0] = 0;
+    writer->name_offsets = offsets;
+    writer->capacity = capacity;
+    return SCHED_OK;
+}
+
+static int writer_append_name(workload_file_writer_t *writer, const char *name, size_t length) {
+    if (writer->names_size + length > UINT32_MAX) {
+        return SCHED_ERR_ARGS;  // name offsets are 32-bit
+    }
+    if (writer->names_size + length > writer->names_capacity) {
+        size_t capacity = (writer->names_capacity > 0U) ? writer->names_capacity : 16384U;
+        while (capacity < writer->names_size + length) {
+            capacity *= 2U;
+        }
+        char *grown = (char *)realloc(writer->names, capacity);
+        if (!grown) {
+            return SCHED_ERR_ALLOC;
+        }
+        writer->names = grown;
+        writer->names_capacity = capacity;
+    }
+    (void)memcpy(writer->names + writer->names_size, name, length);
+    writer->names_size += length;
+    return SCHED_OK;
+}
+
+int workload_file_writer_add(workload_file_writer_t *writer, const process_t *processes, int count) {
+    if (!writer || count < 0 || (count > 0 && !processes) || count > INT_MAX - 1 - writer->count) {
+        return SCHED_ERR_ARGS;
+    }
+    int status = writer_reserve(writer, writer->count + count);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const process_t *p = &processes[i];
+        size_t length = 0;
+        while (length < sizeof(p->name) && p->name[length] != '\0') {
+            length++;
+        }
+        status = writer_append_name(writer, p->name, length);
+        if (status != SCHED_OK) {
+            return status;
+        }
+
+        int index = writer->count++;
+        writer->ids[index] = p->process_id;
+        writer->arrivals[index] = p->arrival_time;
+        writer->bursts[index] = p->burst_time;
+        writer->priorities[index] = p->priority;
+        writer->name_offsets[index + 1] = (uint32_t)writer->names_size;
+    }
+    return SCHED_OK;
+}
+
+int workload_file_writer_columns(const workload_file_writer_t *writer, workload_columns_t *columns) {
+    static const uint32_t kEmptyOffsets[1] = {0};
+    if (!writer || !columns) {
+        return SCHED_ERR_ARGS;
+    }
+    columns->process_count = writer->count;
+    columns->ids = writer->ids;
+    columns->arrivals = writer->arrivals;
+    columns->bursts = writer->bursts;
+    columns->priorities = writer->priorities;
+    columns->name_offsets = writer->name_offsets ? writer->name_offsets : kEmptyOffsets;
+    columns->names = writer->names;
+    columns->names_size = writer->names_size;
+    return SCHED_OK;
+}
+
+static bool write_section(FILE *out, uint64_t *position, uint64_t offset, const void *data, size_t bytes) {
+    static const char kPadding[WORKLOAD_FILE_ALIGNMENT] = {0};
+    if (offset > *position && fwrite(kPadding, 1, (size_t)(offset - *position), out) != offset - *position) {
+        return false;
+    }
+    if (bytes > 0U && fwrite(data, 1, bytes, out) != bytes) {
+        return false;
+    }
+    *position = offset + bytes;
+    return true;
+}
+
+int workload_file_writer_finish(workload_file_writer_t *writer, const char *path) {
+    if (!writer || !path) {
+        return SCHED_ERR_ARGS;
+    }
+
+    uint64_t count = (uint64_t)writer->count;
+    uint64_t column_bytes = count * sizeof(int32_t);
+    workload_columns_t columns;
+    (void)workload_file_writer_columns(writer, &columns);
+    const uint32_t *name_offsets = columns.name_offsets;
+
+    workload_file_header_t header;
+    (void)memset(&header, 0, sizeof(header));
+    (void)memcpy(header.magic, WORKLOAD_FILE_MAGIC, 4);
+    header.version = WORKLOAD_FILE_VERSION;
+    header.header_size = (uint32_t)sizeof(header);
+    header.byte_order = WORKLOAD_FILE_BYTE_ORDER;
+    header.process_count = count;
+    header.ids_offset = align_up(sizeof(header));
+    header.arrivals_offset = align_up(header.ids_offset + column_bytes);
+    header.bursts_offset = align_up(header.arrivals_offset + column_bytes);
+    header.priorities_offset = align_up(header.bursts_offset + column_bytes);
+    header.name_offsets_offset = align_up(header.priorities_offset + column_bytes);
+    header.names_offset = align_up(header.name_offsets_offset + column_bytes + sizeof(uint32_t));
+    header.names_size = writer->names_size;
+    header.file_size = header.names_offset + header.names_size;
+
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        return SCHED_ERR_ARGS;
+    }
+    uint64_t position = 0;
+    bool written = write_section(out, &position, 0, &header, sizeof(header)) &&
+                   write_section(out, &position, header.ids_offset, writer->ids, (size_t)column_bytes) &&
+                   write_section(out, &position, header.arrivals_offset, writer->arrivals, (size_t)column_bytes) &&
+                   write_section(out, &position, header.bursts_offset, writer->bursts, (size_t)column_bytes) &&
+                   write_section(out, &position, header.priorities_offset, writer->priorities, (size_t)column_bytes) &&
+                   write_section(out, &position, header.name_offsets_offset, name_offsets,
+                                 (size_t)column_bytes + sizeof(uint32_t)) &&
+                   write_section(out, &position, header.names_offset, writer->names, writer->names_size);
+    if (fclose(out) != 0) {
+        written = false;
+    }
+    if (!written) {
+        (void)remove(path);
+        return SCHED_ERR_ALLOC;
+    }
+    return SCHED_OK;
+}
+
+int workload_file_write(const char *path, const process_t *processes, int count) {
+    workload_file_writer_t *writer = NULL;
+    int status = workload_file_writer_create(&writer);
+    if (status != SCHED_OK) {
+        return status;
+    }
+    status = workload_file_writer_add(writer, processes, count);
+    if (status == SCHED_OK) {
+        status = workload_file_writer_finish(writer, path);
+    }
+    workload_file_writer_destroy(writer);
+    return status;
+}
@@ -0,0 +1,95 @@
+#ifndef WORKLOAD_FILE_H
+#define WORKLOAD_FILE_H
+
+#include "process_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Binary workload file, version 1. A fixed header is followed by one array
+// per field and a blob of names, every section 8-byte aligned and stored in
+// the producer's byte order (readers reject a foreign one):
+//
+//   header | ids | arrivals | bursts | priorities | name offsets | names
+//
+// Files are opened with mmap and only the header is validated, so opening is
+// O(1) whatever the size and pages are read as the columns are touched.
+#define WORKLOAD_FILE_MAGIC "SWKL"
+#define WORKLOAD_FILE_VERSION 1
+#define WORKLOAD_FILE_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t byte_order;
+    uint64_t process_count;
+    uint64_t file_size;
+    uint64_t ids_offset;           // int32_t[process_count]
+    uint64_t arrivals_offset;      // int32_t[process_count]
+    uint64_t bursts_offset;        // int32_t[process_count]
+    uint64_t priorities_offset;    // int32_t[process_count]
+    uint64_t name_offsets_offset;  // uint32_t[process_count + 1], into the name blob
+    uint64_t names_offset;         // names are not NUL-terminated
+    uint64_t names_size;
+} workload_file_header_t;
+
+// A workload in columnar form; the arrays may point into a mapped file.
+typedef struct {
+    int process_count;
+    const int32_t *ids;
+    const int32_t *arrivals;
+    const int32_t *bursts;
+    const int32_t *priorities;
+    const uint32_t *name_offsets;
+    const char *names;
+    uint64_t names_size;
+} workload_columns_t;
+
+typedef struct workload_file workload_file_t;
+
+int workload_file_open(const char *path, workload_file_t **file);
+void workload_file_close(workload_file_t *file);
+const workload_columns_t *workload_file_columns(const workload_file_t *file);
+
+// Copies the NUL-terminated name of process `index`, truncated to capacity.
+// Name offsets are checked here rather than at open time.
+int workload_columns_name(const workload_columns_t *columns, int index, char *name, size_t capacity);
+
+// schedule_workload over columns, typically straight from a mapped file. The
+// policies read the columns in place, so a run costs 16 bytes of state per
+// process on top of its outputs; names are only read for a timeline.
+int schedule_workload_columns(
+    const workload_columns_t *columns,
+    const schedule_config_t *config,
+    process_result_t *results,
+    timeline_event_t **timeline,
+    int *timeline_count,
+    metrics_t *metrics
+);
+
+// Accumulates processes in columnar form (16 bytes plus the name each) until
+// finish writes them out as a workload file.
+typedef struct workload_file_writer workload_file_writer_t;
+
+int workload_file_writer_create(workload_file_writer_t **writer);
+void workload_file_writer_destroy(workload_file_writer_t *writer);
+int workload_file_writer_add(workload_file_writer_t *writer, const process_t *processes, int count);
+int workload_file_writer_finish(workload_file_writer_t *writer, const char *path);
+
+// Views what was added so far as columns, without writing a file; the view
+// stays valid until the next add or destroy.
+int workload_file_writer_columns(const workload_file_writer_t *writer, workload_columns_t *columns);
+
+// One-shot write of an in-memory workload.
+int workload_file_write(const char *path, const process_t *processes, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORKLOAD_FILE_H
@@ -0,0 +1,359 @@
+#include "workload_gen.h"
+
+#include "sched_internal.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_GEN_TWO_PI 6.28318530717958647692
+#define WORKLOAD_GEN_MAX_CHUNK 65536
+
+static uint64_t rotate_left(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256**
+static uint64_t next_u64(workload_gen_t *gen) {
+    uint64_t *s = gen->state;
+    uint64_t result = rotate_left(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], 45);
+    return result;
+}
+
+// Uniform in (0, 1], so log() is always finite.
+static double next_unit(workload_gen_t *gen) {
+    return (double)((next_u64(gen) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+static double next_exponential(workload_gen_t *gen, double mean) {
+    return -log(next_unit(gen)) * mean;
+}
+
+// Box-Muller; the second value of each pair is kept for the next call.
+static double next_normal(workload_gen_t *gen) {
+    if (gen->has_spare_normal) {
+        gen->has_spare_normal = false;
+        return gen->spare_normal;
+    }
+    double radius = sqrt(-2.0 * log(next_unit(gen)));
+    double angle = WORKLOAD_GEN_TWO_PI * next_unit(gen);
+    gen->spare_normal = radius * sin(angle);
+    gen->has_spare_normal = true;
+    return radius * cos(angle);
+}
+
+void workload_gen_config_default(workload_gen_config_t *config) {
+    if (!config) {
+        return;
+    }
+    (void)memset(config, 0, sizeof(*config));
+    config->seed = 1;
+    config->first_process_id = 1;
+    config->arrival = WORKLOAD_ARRIVAL_POISSON;
+    config->arrival_rate = 0.5;
+    config->mmpp_burst_rate = 5.0;
+    config->mmpp_mean_quiet = 200.0;
+    config->mmpp_mean_burst = 20.0;
+    config->burst = WORKLOAD_BURST_EXPONENTIAL;
+    config->burst_mean = 8.0;
+    config->lognormal_sigma = 1.0;
+    config->pareto_alpha = 1.5;
+    config->bimodal_short_mean = 3.0;
+    config->bimodal_long_mean = 50.0;
+    config->bimodal_long_fraction = 0.1;
+    config->burst_min = 1;
+    config->burst_max = 1000000;
+}
+
+static bool config_is_valid(const workload_gen_config_t *config) {
+    if (config->first_process_id < 0 || config->arrival_rate <= 0.0 || config->burst_min < 1 ||
+        config->burst_max < config->burst_min) {
+        return false;
+    }
+    if (config->arrival == WORKLOAD_ARRIVAL_MMPP) {
+        if (config->mmpp_burst_rate <= 0.0 || config->mmpp_mean_quiet <= 0.0 || config->mmpp_mean_burst <= 0.0) {
+            return false;
+        }
+    } else if (config->arrival != WORKLOAD_ARRIVAL_POISSON) {
+        return false;
+    }
+
+    switch (config->burst) {
+        case WORKLOAD_BURST_EXPONENTIAL:
+            return config->burst_mean > 0.0;
+        case WORKLOAD_BURST_LOGNORMAL:
+            return config->burst_mean > 0.0 && config->lognormal_sigma >= 0.0;
+        case WORKLOAD_BURST_PARETO:
+            return config->burst_mean > 0.0 && config->pareto_alpha > 1.0;
+        case WORKLOAD_BURST_BIMODAL:
+            return config->bimodal_short_mean > 0.0 && config->bimodal_long_mean > 0.0 &&
+                   config->bimodal_long_fraction >= 0.0 && config->bimodal_long_fraction <= 1.0;
+    }
+    return false;
+}
+
+// Walker/Vose alias table: one draw picks a column and a coin between the
+// column's level and its alias, so any weighting costs the same per process.
+static void build_priority_alias(workload_gen_t *gen, double total_weight) {
+    double scaled[WORKLOAD_GEN_PRIORITY_LEVELS];
+    int small[WORKLOAD_GEN_PRIORITY_LEVELS];
+    int large[WORKLOAD_GEN_PRIORITY_LEVELS];
+    int small_count = 0;
+    int large_count = 0;
+
+    for (int i = 0; i < WORKLOAD_GEN_PRIORITY_LEVELS; i++) {
+        double weight = (total_weight > 0.0) ? gen->config.priority_weights[i] / total_weight
+                                             : 1.0 / WORKLOAD_GEN_PRIORITY_LEVELS;
+        scaled[i] = weight * WORKLOAD_GEN_PRIORITY_LEVELS;
+        gen->priority_alias[i] = i;
+        if (scaled[i] < 1.0) {
+            small[small_count++] = i;
+        } else {
+            large[large_count++] = i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int under = small[--small_count];
+        int over = large[--large_count];
+        gen->priority_cutoff[under] = (uint64_t)(scaled[under] * 4294967296.0);
+        gen->priority_alias[under] = over;
+        scaled[over] -= 1.0 - scaled[under];
+        if (scaled[over] < 1.0) {
+            small[small_count++] = over;
+        } else {
+            large[large_count++] = over;
+        }
+    }
+    // Whatever is left is 1 up to rounding and always keeps its own level.
+    while (large_count > 0) {
+        gen->priority_cutoff[large[--large_count]] = 4294967296ULL;
+    }
+    while (small_count > 0) {
+        gen->priority_cutoff[small[--small_count]] = 4294967296ULL;
+    }
+}
+
+int workload_gen_init(workload_gen_t *gen, const workload_gen_config_t *config) {
+    if (!gen || !config || !config_is_valid(config)) {
+        return SCHED_ERR_ARGS;
+    }
+
+    double total_weight = 0.0;
+    for (int i = 0; i < WORKLOAD_GEN_PRIORITY_LEVELS; i++) {
+        if (!(config->priority_weights[i] >= 0.0)) {
+            return SCHED_ERR_ARGS;
+        }
+        total_weight += config->priority_weights[i];
+    }
+
+    (void)memset(gen, 0, sizeof(*gen));
+    gen->config = *config;
+
+    uint64_t seed = config->seed;
+    for (int i = 0; i < 4; i++) {
+        gen->state[i] = splitmix64(&seed);
+    }
+    gen->next_id = config->first_process_id;
+
+    // Mean-preserving parameters for the heavy-tailed distributions.
+    gen->lognormal_mu = log(config->burst_mean) - 0.5 * config->lognormal_sigma * config->lognormal_sigma;
+    gen->pareto_scale = config->burst_mean * (config->pareto_alpha - 1.0) / config->pareto_alpha;
+
+    if (config->arrival == WORKLOAD_ARRIVAL_MMPP) {
+        gen->mmpp_state_left = next_exponential(gen, config->mmpp_mean_quiet);
+    }
+
+    build_priority_alias(gen, total_weight);
+    return SCHED_OK;
+}
+
+static double next_interarrival(workload_gen_t *gen) {
+    const workload_gen_config_t *config = &gen->config;
+    if (config->arrival == WORKLOAD_ARRIVAL_POISSON) {
+        return next_exponential(gen, 1.0 / config->arrival_rate);
+    }
+
+    // The exponential is memoryless, so a gap that outlives the current state
+    // can be cut at the switch and redrawn at the new state's rate.
+    double elapsed = 0.0;
+    for (;;) {
+        double rate = gen->mmpp_bursting ? config->mmpp_burst_rate : config->arrival_rate;
+        double gap = next_exponential(gen, 1.0 / rate);
+        if (gap < gen->mmpp_state_left) {
+            gen->mmpp_state_left -= gap;
+            return elapsed + gap;
+        }
+        elapsed += gen->mmpp_state_left;
+        gen->mmpp_bursting = !gen->mmpp_bursting;
+        gen->mmpp_state_left =
+            next_exponential(gen, gen->mmpp_bursting ? config->mmpp_mean_burst : config->mmpp_mean_quiet);
+    }
+}
+
+static int next_burst(workload_gen_t *gen) {
+    const workload_gen_config_t *config = &gen->config;
+    double value = 0.0;
+    switch (config->burst) {
+        case WORKLOAD_BURST_EXPONENTIAL:
+            value = next_exponential(gen, config->burst_mean);
+            break;
+        case WORKLOAD_BURST_LOGNORMAL:
+            value = exp(gen->lognormal_mu + config->lognormal_sigma * next_normal(gen));
+            break;
+        case WORKLOAD_BURST_PARETO:
+            value = gen->pareto_scale * exp(-log(next_unit(gen)) / config->pareto_alpha);
+            break;
+        case WORKLOAD_BURST_BIMODAL: {
+            bool long_job = next_unit(gen) <= config->bimodal_long_fraction;
+            value = next_exponential(gen, long_job ? config->bimodal_long_mean : config->bimodal_short_mean);
+            break;
+        }
+    }
+
+    value = ceil(value);
+    if (!(value >= (double)config->burst_min)) {
+        return config->burst_min;
+    }
+    if (value > (double)config->burst_max) {
+        return config->burst_max;
+    }
+    return (int)value;
+}
+
+static int next_priority(workload_gen_t *gen) {
+    uint64_t draw = next_u64(gen);
+    int column = (int)(((draw & 0xFFFFFFFFULL) * WORKLOAD_GEN_PRIORITY_LEVELS) >> 32);
+    int level = ((draw >> 32) < gen->priority_cutoff[column]) ? column : gen->priority_alias[column];
+    return level + 1;
+}
+
+// "P<id>" without going through snprintf.
+static void write_name(char *name, int id) {
+    char digits[12];
+    int length = 0;
+    unsigned int value = (unsigned int)id;
+    do {
+        digits[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    name[0] = 'P';
+    for (int i = 0; i < length; i++) {
+        name[1 + i] = digits[length - 1 - i];
+    }
+    name[1 + length] = '\0';
+}
+
+int workload_gen_fill(workload_gen_t *gen, process_t *processes, int count) {
+    if (!gen || count < 0 || (count > 0 && !processes) || count > INT_MAX - gen->next_id) {
+        return SCHED_ERR_ARGS;
+    }
+
+    // Work on a local copy: the name bytes written below may alias anything,
+    // which would otherwise force the RNG state through memory every process.
+    workload_gen_t local = *gen;
+    int status = SCHED_OK;
+    for (int i = 0; i < count; i++) {
+        int arrival = (int)local.clock;
+        int burst = next_burst(&local);
+        int priority = next_priority(&local);
+        local.clock += next_interarrival(&local);
+        if (local.clock >= (double)INT_MAX) {
+            status = SCHED_ERR_ARGS;  // arrival times no longer fit in an int
+            break;
+        }
+
+        process_t *p = &processes[i];
+        p->process_id = local.next_id++;
+        write_name(p->name, p->process_id);
+        p->arrival_time = arrival;
+        p->burst_time = burst;
+        p->priority = priority;
+        p->remaining_time = burst;
+        p->completion_time = 0;
+        p->turnaround_time = 0;
+        p->waiting_time = 0;
+        p->response_time = -1;
+        p->first_run_time = -1;
+    }
+
+    *gen = local;
+    return status;
+}
+
+int workload_gen_stream(workload_gen_t *gen, long long total, int chunk, workload_sink_fn sink, void *context) {
+    if (!gen || total < 0 || chunk <= 0 || !sink) {
+        return SCHED_ERR_ARGS;
+    }
+    if (chunk > WORKLOAD_GEN_MAX_CHUNK) {
+        chunk = WORKLOAD_GEN_MAX_CHUNK;
+    }
+    if ((long long)chunk > total) {
+        chunk = (total > 0) ? (int)total : 1;
+    }
+
+    process_t *buffer = (process_t *)malloc((size_t)chunk * sizeof(process_t));
+    if (!buffer) {
+        return SCHED_ERR_ALLOC;
+    }
+    (void)memset(buffer, 0, (size_t)chunk * sizeof(process_t));
+
+    long long produced = 0;
+    while (produced < total) {
+        int count = (total - produced < (long long)chunk) ? (int)(total - produced) : chunk;
+        int status = workload_gen_fill(gen, buffer, count);
+        if (status == SCHED_OK) {
+            status = sink(context, buffer, count);
+        }
+        if (status != SCHED_OK) {
+            free(buffer);
+            return status;
+        }
+        produced += count;
+    }
+
+    free(buffer);
+    return SCHED_OK;
+}
+
+int workload_generate(const workload_gen_config_t *config, int count, process_t **processes) {
+    if (!processes || count <= 0) {
+        return SCHED_ERR_ARGS;
+    }
+    *processes = NULL;
+
+    workload_gen_t gen;
+    int status = workload_gen_init(&gen, config);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    process_t *out = (process_t *)calloc((size_t)count, sizeof(process_t));
+    if (!out) {
+        return SCHED_ERR_ALLOC;
+    }
+    status = workload_gen_fill(&gen, out, count);
+    if (status != SCHED_OK) {
+        free(out);
+        return status;
+    }
+
+    *processes = out;
+    return SCHED_OK;
+}
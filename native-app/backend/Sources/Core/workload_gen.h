@@ -0,0 +1,90 @@
+#ifndef WORKLOAD_GEN_H
+#define WORKLOAD_GEN_H
+
+#include "process_types.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Synthetic workloads for stress runs and demos. A generator is a small value
+// type whose output depends only on its config (including the seed): filling
+// N processes at once or in several calls gives the same sequence.
+#define WORKLOAD_GEN_PRIORITY_LEVELS 10
+
+typedef enum {
+    WORKLOAD_ARRIVAL_POISSON = 0,
+    WORKLOAD_ARRIVAL_MMPP = 1     // two-state Markov-modulated Poisson: quiet / burst
+} workload_arrival_kind_t;
+
+typedef enum {
+    WORKLOAD_BURST_EXPONENTIAL = 0,
+    WORKLOAD_BURST_LOGNORMAL = 1,
+    WORKLOAD_BURST_PARETO = 2,
+    WORKLOAD_BURST_BIMODAL = 3    // exponential mix of short and long jobs
+} workload_burst_kind_t;
+
+typedef struct {
+    uint64_t seed;
+    int first_process_id;
+
+    workload_arrival_kind_t arrival;
+    double arrival_rate;          // arrivals per time unit (MMPP: in the quiet state)
+    double mmpp_burst_rate;       // MMPP: arrivals per time unit while bursting
+    double mmpp_mean_quiet;       // MMPP: mean time spent in each state
+    double mmpp_mean_burst;
+
+    workload_burst_kind_t burst;
+    double burst_mean;            // mean burst time for every distribution but BIMODAL
+    double lognormal_sigma;
+    double pareto_alpha;          // > 1 so the mean exists
+    double bimodal_short_mean;
+    double bimodal_long_mean;
+    double bimodal_long_fraction;
+    int burst_min;                // bursts are rounded up, then clamped to [min, max]
+    int burst_max;
+
+    // Relative weight of priorities 1..10; all zero means uniform.
+    double priority_weights[WORKLOAD_GEN_PRIORITY_LEVELS];
+} workload_gen_config_t;
+
+typedef struct {
+    workload_gen_config_t config;
+    uint64_t state[4];
+    double clock;
+    int next_id;
+    bool mmpp_bursting;
+    double mmpp_state_left;
+    bool has_spare_normal;
+    double spare_normal;
+    double lognormal_mu;
+    double pareto_scale;
+    uint64_t priority_cutoff[WORKLOAD_GEN_PRIORITY_LEVELS];  // alias table over the levels
+    int priority_alias[WORKLOAD_GEN_PRIORITY_LEVELS];
+} workload_gen_t;
+
+// Poisson arrivals at rate 0.5, exponential bursts of mean 8, uniform priorities.
+void workload_gen_config_default(workload_gen_config_t *config);
+
+int workload_gen_init(workload_gen_t *gen, const workload_gen_config_t *config);
+
+// Writes the next `count` processes in arrival order. Runtime fields are
+// reset as a fresh workload's would be; name bytes past the terminator are
+// not touched.
+int workload_gen_fill(workload_gen_t *gen, process_t *processes, int count);
+
+// Generates `total` processes in chunks of `chunk` and hands each chunk to
+// sink, which may return non-zero to stop early (that value is returned).
+typedef int (*workload_sink_fn)(void *context, const process_t *processes, int count);
+int workload_gen_stream(workload_gen_t *gen, long long total, int chunk, workload_sink_fn sink, void *context);
+
+// One-shot: a malloc'd array of `count` processes; free() it.
+int workload_generate(const workload_gen_config_t *config, int count, process_t **processes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORKLOAD_GEN_H
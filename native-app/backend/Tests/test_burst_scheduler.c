@@ -0,0 +1,170 @@
+#include "../Sources/Core/burst_scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static process_t make_process(int id, const char *name, int arrival, int priority) {
+    process_t p = {0};
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "%s", name);
+    p.arrival_time = arrival;
+    p.priority = priority;
+    p.first_run_time = -1;
+    p.response_time = -1;
+    return p;
+}
+
+static schedule_config_t make_config(algorithm_type_t algorithm, int quantum) {
+    schedule_config_t config = {0};
+    config.algorithm = algorithm;
+    config.time_quantum = quantum;
+    return config;
+}
+
+// P1: CPU 2, I/O 3, CPU 1. P2: CPU 4.
+static const burst_t kBursts[] = {
+    {2, BURST_DEVICE_CPU}, {3, 0}, {1, BURST_DEVICE_CPU},
+    {4, BURST_DEVICE_CPU},
+};
+static const int kOffsets[] = {0, 3, 4};
+
+static void test_fcfs_overlaps_io(void) {
+    process_t processes[] = {
+        make_process(1, "P1", 0, 1),
+        make_process(2, "P2", 0, 2),
+    };
+    burst_workload_t workload = {processes, 2, kBursts, kOffsets, 1};
+
+    schedule_config_t config = make_config(ALGO_FCFS, 0);
+    process_result_t results[2];
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_burst_processes(&workload, &config, results, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    assert(results[0].completion_time == 7);
+    assert(results[0].waiting_time == 1);
+    assert(results[1].completion_time == 6);
+    assert(results[1].waiting_time == 2);
+    assert(timeline_count == 3);
+    assert(metrics.total_time == 7);
+    assert(fabs(metrics.cpu_utilization - 100.0) < 1e-9);
+    free(timeline);
+}
+
+static void test_priority_p_wakeup_preempts(void) {
+    process_t processes[] = {
+        make_process(1, "P1", 0, 1),
+        make_process(2, "P2", 0, 2),
+    };
+    burst_workload_t workload = {processes, 2, kBursts, kOffsets, 1};
+
+    schedule_config_t config = make_config(ALGO_PRIORITY_P, 0);
+    process_result_t results[2];
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_burst_processes(&workload, &config, results, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    assert(results[0].completion_time == 6);
+    assert(results[0].waiting_time == 0);
+    assert(results[1].completion_time == 7);
+    assert(results[1].waiting_time == 3);
+    assert(metrics.context_switches == 3);
+    free(timeline);
+}
+
+static void test_shared_device_queues(void) {
+    // Both processes block on device 0 at t=1; the second waits for the first.
+    const burst_t bursts[] = {
+        {1, BURST_DEVICE_CPU}, {4, 0}, {1, BURST_DEVICE_CPU},
+        {1, BURST_DEVICE_CPU}, {4, 0}, {1, BURST_DEVICE_CPU},
+    };
+    const int offsets[] = {0, 3, 6};
+    process_t processes[] = {
+        make_process(1, "P1", 0, 1),
+        make_process(2, "P2", 0, 1),
+    };
+    burst_workload_t workload = {processes, 2, bursts, offsets, 1};
+
+    schedule_config_t config = make_config(ALGO_RR, 2);
+    process_result_t results[2];
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_burst_processes(&workload, &config, results, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    assert(results[0].completion_time == 6);
+    assert(results[1].completion_time == 10);
+    assert(metrics.total_time == 10);
+    free(timeline);
+}
+
+static void test_switch_cost_and_const_input(void) {
+    // P2 arrives before time 0 and runs in the gap while P1 is on I/O; every
+    // hand-over costs one tick.
+    process_t processes[] = {
+        make_process(1, "P1", 0, 1),
+        make_process(2, "P2", -3, 0),
+    };
+    const process_t before[] = {processes[0], processes[1]};
+    burst_workload_t workload = {processes, 2, kBursts, kOffsets, 1};
+
+    schedule_config_t config = make_config(ALGO_FCFS, 0);
+    config.switch_cost = 1;
+    process_result_t results[2];
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_burst_processes(&workload, &config, results, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    // P1 0-2, switch 2-3, P2 3-7, switch 7-8, P1 8-9.
+    assert(results[0].completion_time == 9);
+    assert(results[0].waiting_time == 3);
+    assert(results[1].completion_time == 7);
+    assert(results[1].waiting_time == 3);
+    assert(results[1].turnaround_time == 7);
+    assert(timeline_count == 5);
+    assert(timeline[1].process_id == TIMELINE_OVERHEAD_PROCESS_ID);
+    assert(timeline[1].start_time == 2 && timeline[1].end_time == 3);
+    assert(metrics.context_switches == 2);
+    assert(metrics.total_time == 9);
+    assert(memcmp(processes, before, sizeof(before)) == 0);
+    free(timeline);
+
+    config.aging_interval = 2;
+    assert(schedule_burst_processes(&workload, &config, NULL, &timeline, &timeline_count, &metrics) != 0);
+}
+
+static void test_rejects_unknown_device(void) {
+    const burst_t bursts[] = {{1, BURST_DEVICE_CPU}, {2, 3}};
+    const int offsets[] = {0, 2};
+    process_t processes[] = {make_process(1, "P1", 0, 1)};
+    burst_workload_t workload = {processes, 1, bursts, offsets, 1};
+
+    schedule_config_t config = make_config(ALGO_FCFS, 0);
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    assert(schedule_burst_processes(&workload, &config, NULL, &timeline, &timeline_count, &metrics) != 0);
+    assert(timeline == NULL);
+}
+
+int main(void) {
+    test_fcfs_overlaps_io();
+    test_priority_p_wakeup_preempts();
+    test_shared_device_queues();
+    test_switch_cost_and_const_input();
+    test_rejects_unknown_device();
+
+    printf("All burst scheduler tests passed.\n");
+    return 0;
+}
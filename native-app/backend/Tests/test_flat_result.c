@@ -0,0 +1,117 @@
+#include "../Sources/Core/flat_result.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 40
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "task-%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+static bool inside(const schedule_flat_result_t *result, const void *pointer, size_t bytes) {
+    const uint8_t *begin = (const uint8_t *)result;
+    const uint8_t *at = (const uint8_t *)pointer;
+    return at >= begin && at + bytes <= begin + result->size;
+}
+
+// Every section is read in place through offsets, so a byte-for-byte copy
+// of the block (what NSData or a socket would carry) reads back identically.
+static void check_against_timeline(
+    const schedule_flat_result_t *result,
+    const process_t *workload,
+    const timeline_event_t *timeline,
+    int timeline_count,
+    const process_result_t *results
+) {
+    const flat_segment_t *segments = schedule_flat_segments(result);
+    const flat_process_t *processes = schedule_flat_processes(result);
+    assert(inside(result, segments, (size_t)result->segment_count * sizeof(flat_segment_t)));
+    assert(inside(result, processes, (size_t)result->process_count * sizeof(flat_process_t)));
+    assert((uintptr_t)segments % sizeof(int32_t) == 0);
+
+    assert(result->segment_count == timeline_count);
+    assert(result->process_count == WORKLOAD_SIZE);
+    for (int i = 0; i < timeline_count; i++) {
+        int index = segments[i].process_index;
+        if (index == FLAT_SEGMENT_OVERHEAD) {
+            assert(timeline[i].process_id == TIMELINE_OVERHEAD_PROCESS_ID);
+        } else {
+            assert(processes[index].process_id == timeline[i].process_id);
+            assert(strcmp(schedule_flat_name(result, &processes[index]), timeline[i].process_name) == 0);
+        }
+        assert(segments[i].start_time == timeline[i].start_time);
+        assert(segments[i].end_time == timeline[i].end_time);
+    }
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        const char *name = schedule_flat_name(result, &processes[i]);
+        assert(inside(result, name, strlen(name) + 1));
+        assert(strcmp(name, workload[i].name) == 0);
+        assert(processes[i].arrival_time == workload[i].arrival_time);
+        assert(processes[i].completion_time == results[i].completion_time);
+        assert(processes[i].waiting_time == results[i].waiting_time);
+        assert(processes[i].response_time == results[i].response_time);
+    }
+}
+
+static void test_flat_result_matches_timeline(void) {
+    process_t workload[WORKLOAD_SIZE];
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        workload[i] = make_process(i + 1, (i * 7) % 31, 1 + (i * 5) % 8, 1 + (i * 3) % 10);
+    }
+
+    for (int algorithm = ALGO_FCFS; algorithm <= ALGO_PRIORITY_P; algorithm++) {
+        schedule_config_t config;
+        memset(&config, 0, sizeof(config));
+        config.algorithm = (algorithm_type_t)algorithm;
+        config.time_quantum = 2;
+        config.switch_cost = 1;
+
+        process_result_t results[WORKLOAD_SIZE];
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t metrics;
+        assert(schedule_workload(workload, WORKLOAD_SIZE, &config, results, &timeline, &timeline_count, &metrics) == 0);
+
+        schedule_flat_result_t *result = NULL;
+        assert(schedule_workload_flat(workload, WORKLOAD_SIZE, &config, &result) == 0);
+        assert(memcmp(&result->metrics, &metrics, sizeof(metrics)) == 0);
+        check_against_timeline(result, workload, timeline, timeline_count, results);
+
+        // The compact form is far smaller than the event array.
+        assert((size_t)result->size < (size_t)timeline_count * sizeof(timeline_event_t) / 4);
+
+        schedule_flat_result_t *moved = (schedule_flat_result_t *)malloc(result->size);
+        assert(moved != NULL);
+        memcpy(moved, result, result->size);
+        schedule_flat_result_free(result);
+        check_against_timeline(moved, workload, timeline, timeline_count, results);
+
+        free(moved);
+        free(timeline);
+    }
+
+    schedule_flat_result_t *result = NULL;
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    assert(schedule_workload_flat(workload, 0, &config, &result) != 0);
+    assert(result == NULL);
+}
+
+int main(void) {
+    test_flat_result_matches_timeline();
+
+    printf("Flat result tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../Sources/Core/ftrace_import.h"
+#include "../Sources/Core/metrics.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Both traces describe the same run (times in microseconds from 100 s):
+//   cpu0:  worker 0-5, "my app" 5-9 (preempts worker), worker 9-12 then
+//          blocks, idle, rt 20-30, blip for under a microsecond
+//   cpu1:  worker again from 20 until the trace ends at 40
+//   pid 14 is woken at 40 and never runs.
+static const char *const kRawTrace =
+    "# tracer: nop\n"
+    "#\n"
+    "#           TASK-PID     CPU#  |||||  TIMESTAMP  FUNCTION\n"
+    "          <idle>-0       [000] d..2. 100.000000: sched_wakeup: comm=worker pid=10 prio=120 target_cpu=000\n"
+    "          <idle>-0       [000] d..2. 100.000000: sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 "
+    "prev_state=R ==> next_comm=worker next_pid=10 next_prio=120\n"
+    "          worker-10      [000] d..3. 100.000001: sys_enter: NR 0 (3, 0, 0)\n"
+    "          <idle>-0       [001] dN.3. 100.000002: sched_wakeup: comm=my app pid=11 prio=100 target_cpu=000\n"
+    "          worker-10      [000] d..2. 100.000005: sched_switch: prev_comm=worker prev_pid=10 prev_prio=120 "
+    "prev_state=R+ ==> next_comm=my app next_pid=11 next_prio=100\n"
+    "          my app-11      [000] d..2. 100.000009: sched_switch: prev_comm=my app prev_pid=11 prev_prio=100 "
+    "prev_state=S ==> next_comm=worker next_pid=10 next_prio=120\n"
+    "          worker-10      [000] d..2. 100.000012: sched_switch: prev_comm=worker prev_pid=10 prev_prio=120 "
+    "prev_state=D ==> next_comm=swapper/0 next_pid=0 next_prio=120\n"
+    "          <idle>-0       [001] d..2. 100.000020: sched_wakeup: comm=worker pid=10 prio=120 target_cpu=001\n"
+    "          <idle>-0       [001] d..2. 100.000020: sched_switch: prev_comm=swapper/1 prev_pid=0 prev_prio=120 "
+    "prev_state=R ==> next_comm=worker next_pid=10 next_prio=120\n"
+    "          <idle>-0       [000] d..2. 100.000020: sched_wakeup_new: comm=rt pid=12 prio=50 target_cpu=000\n"
+    "          <idle>-0       [000] d..2. 100.000020: sched_switch: prev_comm=swapper/0 prev_pid=0 prev_prio=120 "
+    "prev_state=R ==> next_comm=rt next_pid=12 next_prio=50\n"
+    "              rt-12      [000] d..2. 100.000030: sched_wakeup: comm=blip pid=13 prio=120 target_cpu=000\n"
+    "              rt-12      [000] d..2. 100.000030: sched_switch: prev_comm=rt prev_pid=12 prev_prio=50 "
+    "prev_state=S ==> next_comm=blip next_pid=13 next_prio=120\n"
+    "            blip-13      [000] d..2. 100.000030900: sched_switch: prev_comm=blip prev_pid=13 prev_prio=120 "
+    "prev_state=S ==> next_comm=swapper/0 next_pid=0 next_prio=120\n"
+    "          worker-10      [001] d..2. 100.000040: sched_wakeup: comm=late pid=14 prio=120 target_cpu=000\n";
+
+static const char *const kTraceCmdTrace =
+    "cpus=2\n"
+    "          <idle>-0     [000]   100.000000: sched_wakeup:         worker:10 [120] success=1 CPU:000\n"
+    "          <idle>-0     [000]   100.000000: sched_switch:         swapper/0:0 [120] R ==> worker:10 [120]\n"
+    "          <idle>-0     [001]   100.000002: sched_wakeup:         my app:11 [100] success=1 CPU:000\n"
+    "          worker-10    [000]   100.000005: sched_switch:         worker:10 [120] R+ ==> my app:11 [100]\n"
+    "          my app-11    [000]   100.000009: sched_switch:         my app:11 [100] S ==> worker:10 [120]\n"
+    "          worker-10    [000]   100.000012: sched_switch:         worker:10 [120] D ==> swapper/0:0 [120]\n"
+    "          <idle>-0     [001]   100.000020: sched_wakeup:         worker:10 [120] success=1 CPU:001\n"
+    "          <idle>-0     [001]   100.000020: sched_switch:         swapper/1:0 [120] R ==> worker:10 [120]\n"
+    "          <idle>-0     [000]   100.000020: sched_wakeup_new:     rt:12 [50] success=1 CPU:000\n"
+    "          <idle>-0     [000]   100.000020: sched_switch:         swapper/0:0 [120] R ==> rt:12 [50]\n"
+    "              rt-12    [000]   100.000030: sched_wakeup:         blip:13 [120] success=1 CPU:000\n"
+    "              rt-12    [000]   100.000030: sched_switch:         rt:12 [50] S ==> blip:13 [120]\n"
+    "            blip-13    [000]   100.000030900: sched_switch:      blip:13 [120] S ==> swapper/0:0 [120]\n"
+    "          worker-10    [001]   100.000040: sched_wakeup:         late:14 [120] success=1 CPU:000\n";
+
+static int feed_all(const char *trace, const ftrace_import_config_t *config, ftrace_import_result_t *result) {
+    ftrace_importer_t *importer = NULL;
+    assert(ftrace_importer_create(config, &importer) == 0);
+    int status = 0;
+    for (const char *line = trace; *line && status == 0;) {
+        const char *end = strchr(line, '\n');
+        size_t length = end ? (size_t)(end - line + 1) : strlen(line);
+        status = ftrace_importer_feed(importer, line, length);
+        line += length;
+    }
+    if (status == 0) {
+        status = ftrace_importer_finish(importer, result);
+    }
+    ftrace_importer_destroy(importer);
+    return status;
+}
+
+static void check_process(const process_t *p, int id, const char *name, int arrival, int burst, int priority,
+                          int first_run, int completion) {
+    assert(p->process_id == id);
+    assert(strcmp(p->name, name) == 0);
+    assert(p->arrival_time == arrival);
+    assert(p->burst_time == burst);
+    assert(p->priority == priority);
+    assert(p->first_run_time == first_run);
+    assert(p->response_time == first_run - arrival);
+    assert(p->completion_time == completion);
+    assert(p->turnaround_time == completion - arrival);
+    assert(p->waiting_time == completion - arrival - burst);
+}
+
+static void check_scenario(const ftrace_import_result_t *result, long long ignored_lines) {
+    assert(result->process_count == 4);
+    assert(result->cpu_count == 2);
+    assert(result->truncated == 1);
+    assert(result->dropped == 2);  // blip ran for 900 ns; late never ran
+    assert(result->records == 14);
+    assert(result->ignored_lines == ignored_lines);
+    // worker -> my app -> worker -> rt -> blip on cpu0; idle does not count.
+    assert(result->context_switches == 4);
+
+    check_process(&result->processes[0], 1, "worker:10", 0, 8, 6, 0, 12);
+    check_process(&result->processes[1], 2, "my app:11", 2, 4, 1, 5, 9);
+    check_process(&result->processes[2], 3, "worker:10", 20, 20, 6, 20, 40);
+    check_process(&result->processes[3], 4, "rt:12", 20, 10, 1, 20, 30);
+
+    static const int kSegments[5][3] = {{1, 0, 5}, {2, 5, 9}, {1, 9, 12}, {4, 20, 30}, {3, 20, 40}};
+    assert(result->timeline_count == 5);
+    for (int i = 0; i < 5; i++) {
+        assert(result->timeline[i].process_id == kSegments[i][0]);
+        assert(result->timeline[i].start_time == kSegments[i][1]);
+        assert(result->timeline[i].end_time == kSegments[i][2]);
+        assert(strcmp(result->timeline[i].process_name, result->processes[kSegments[i][0] - 1].name) == 0);
+    }
+}
+
+static void test_raw_trace(void) {
+    ftrace_import_result_t result;
+    assert(feed_all(kRawTrace, NULL, &result) == 0);
+    check_scenario(&result, 4);
+
+    // The observed outcomes score directly.
+    metrics_t metrics;
+    calculate_metrics(result.processes, result.process_count, result.context_switches, &metrics);
+    assert(fabs(metrics.avg_waiting_time - 7.0 / 4.0) < 1e-9);
+    assert(fabs(metrics.avg_response_time - 3.0 / 4.0) < 1e-9);
+    assert(metrics.context_switches == 4);
+
+    // ...and the workload replays under any policy.
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 4;
+    assert(schedule_workload(result.processes, result.process_count, &config, NULL, NULL, NULL, &metrics) == 0);
+    assert(metrics.total_time == 50);
+    ftrace_import_result_free(&result);
+}
+
+static void test_trace_cmd_report(void) {
+    ftrace_import_result_t result;
+    assert(feed_all(kTraceCmdTrace, NULL, &result) == 0);
+    check_scenario(&result, 1);
+    ftrace_import_result_free(&result);
+
+    // "comm:pid" splits at the last ':' so kernel thread names survive.
+    assert(feed_all("  <idle>-0 [003] 5.000000: sched_switch: swapper/3:0 [120] R ==> kworker/u8:2:7 [120]\n"
+                    "  kworker/u8:2-7 [003] 5.000003: sched_switch: kworker/u8:2:7 [120] S ==> swapper/3:0 [120]\n",
+                    NULL, &result) == 0);
+    assert(result.records == 2 && result.process_count == 1 && result.cpu_count == 1);
+    check_process(&result.processes[0], 1, "kworker/u8:2:7", 0, 3, 6, 0, 3);
+    ftrace_import_result_free(&result);
+}
+
+static void test_time_units(void) {
+    ftrace_import_config_t config;
+    config.time_unit_ns = 2000;
+    ftrace_import_result_t result;
+    assert(feed_all(kRawTrace, &config, &result) == 0);
+    assert(result.processes[0].arrival_time == 0 && result.processes[0].burst_time == 4);  // 0-2.5 -> 0-2, 4.5-6 -> 4-6
+    assert(result.processes[3].arrival_time == 10 && result.processes[3].completion_time == 15);
+    ftrace_import_result_free(&result);
+
+    // Ten seconds in nanosecond ticks does not fit in an int.
+    config.time_unit_ns = 1;
+    assert(feed_all("  a-1 [000] 1.000000: sched_wakeup: comm=a pid=1 prio=120 target_cpu=000\n"
+                    "  a-1 [000] 11.000000: sched_wakeup: comm=b pid=2 prio=120 target_cpu=000\n",
+                    &config, &result) != 0);
+
+    ftrace_importer_t *importer = NULL;
+    config.time_unit_ns = 0;
+    assert(ftrace_importer_create(&config, &importer) != 0);
+}
+
+static void test_import_file(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/ftrace_import_test_XXXXXX");
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    FILE *file = fdopen(fd, "w");
+    assert(file != NULL);
+    // An over-long line is ignored as a whole, not split into records.
+    fputs("#", file);
+    for (int i = 0; i < 3000; i++) {
+        fputs(" sched_switch:", file);
+    }
+    fputs("\n", file);
+    fputs(kRawTrace, file);
+    fclose(file);
+
+    ftrace_import_result_t result;
+    assert(ftrace_import_file(path, NULL, &result) == 0);
+    check_scenario(&result, 5);
+    ftrace_import_result_free(&result);
+    remove(path);
+
+    assert(ftrace_import_file("/nonexistent/trace", NULL, &result) != 0);
+}
+
+int main(void) {
+    test_raw_trace();
+    test_trace_cmd_report();
+    test_time_units();
+    test_import_file();
+
+    printf("Ftrace import tests passed.\n");
+    return 0;
+}
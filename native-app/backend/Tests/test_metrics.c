@@ -34,6 +34,16 @@ int main(void) {
     assert(metrics.total_time == 7);
     assert(metrics.context_switches == 1);
 
+    assert(approx_equal(metrics.waiting_stats.mean, 1.5, 1e-9));
+    assert(approx_equal(metrics.waiting_stats.stddev, 1.5, 1e-9));
+    assert(approx_equal(metrics.waiting_stats.p50, 0.0, 1e-9));
+    assert(approx_equal(metrics.waiting_stats.p99, 3.0, 1e-9));
+    assert(approx_equal(metrics.waiting_stats.max, 3.0, 1e-9));
+    assert(approx_equal(metrics.turnaround_stats.p95, 6.0, 1e-9));
+    assert(approx_equal(metrics.slowdown_stats.max, 1.0, 1e-9));
+    assert(approx_equal(bounded_slowdown(60, 20), 3.0, 1e-9));
+    assert(approx_equal(bounded_slowdown(30, 1), 3.0, 1e-9));
+
     printf("Metrics tests passed.\n");
     return 0;
 }
@@ -0,0 +1,167 @@
+#include "../Sources/Core/monte_carlo.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void make_config(monte_carlo_config_t *config) {
+    monte_carlo_config_default(config);
+    config->workload.seed = 2024;
+    config->workload.burst = WORKLOAD_BURST_PARETO;
+    config->workload_size = 60;
+    config->sample_count = 300;  // not a multiple of the block size
+
+    const algorithm_type_t algorithms[] = {ALGO_FCFS, ALGO_SJF, ALGO_SRTF, ALGO_RR};
+    config->policy_count = 4;
+    for (int p = 0; p < config->policy_count; p++) {
+        memset(&config->policies[p], 0, sizeof(config->policies[p]));
+        config->policies[p].algorithm = algorithms[p];
+        config->policies[p].time_quantum = 4;
+    }
+}
+
+static void test_bitwise_reproducible_across_thread_counts(void) {
+    monte_carlo_config_t config;
+    make_config(&config);
+
+    config.thread_count = 1;
+    monte_carlo_result_t reference;
+    assert(monte_carlo_run(&config, &reference) == 0);
+
+    const int thread_counts[] = {2, 3, 8};
+    for (int i = 0; i < 3; i++) {
+        config.thread_count = thread_counts[i];
+        monte_carlo_result_t result;
+        assert(monte_carlo_run(&config, &result) == 0);
+        assert(memcmp(&result, &reference, sizeof(result)) == 0);
+    }
+
+    config.workload.seed = 2025;
+    monte_carlo_result_t other;
+    assert(monte_carlo_run(&config, &other) == 0);
+    assert(memcmp(&other, &reference, sizeof(other)) != 0);
+}
+
+static void test_matches_sequential_reference(void) {
+    monte_carlo_config_t config;
+    make_config(&config);
+    config.thread_count = 3;
+    monte_carlo_result_t result;
+    assert(monte_carlo_run(&config, &result) == 0);
+    assert(result.sample_count == 300);
+    assert(result.policy_count == 4);
+
+    double sum[4][MONTE_CARLO_FIELD_COUNT];
+    double sum_sq[4][MONTE_CARLO_FIELD_COUNT];
+    double wins[4] = {0.0, 0.0, 0.0, 0.0};
+    memset(sum, 0, sizeof(sum));
+    memset(sum_sq, 0, sizeof(sum_sq));
+
+    process_t *scratch = (process_t *)malloc((size_t)config.workload_size * sizeof(process_t));
+    assert(scratch != NULL);
+    for (int k = 0; k < config.sample_count; k++) {
+        workload_gen_config_t spec = config.workload;
+        spec.seed = monte_carlo_sample_seed(config.workload.seed, k);
+        process_t *workload = NULL;
+        assert(workload_generate(&spec, config.workload_size, &workload) == 0);
+
+        double waiting[4];
+        for (int p = 0; p < 4; p++) {
+            metrics_t metrics;
+            memcpy(scratch, workload, (size_t)config.workload_size * sizeof(process_t));
+            assert(schedule_processes_metrics_only(scratch, config.workload_size, &config.policies[p], &metrics) == 0);
+            for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+                double value = monte_carlo_field_value(&metrics, (monte_carlo_field_t)f);
+                sum[p][f] += value;
+                sum_sq[p][f] += value * value;
+            }
+            waiting[p] = metrics.avg_waiting_time;
+        }
+        double best = fmin(fmin(waiting[0], waiting[1]), fmin(waiting[2], waiting[3]));
+        int ties = 0;
+        for (int p = 0; p < 4; p++) {
+            ties += (waiting[p] == best);
+        }
+        for (int p = 0; p < 4; p++) {
+            wins[p] += (waiting[p] == best) ? 1.0 / ties : 0.0;
+        }
+        free(workload);
+    }
+    free(scratch);
+
+    double total_win_rate = 0.0;
+    for (int p = 0; p < 4; p++) {
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            const monte_carlo_estimate_t *estimate = &result.policies[p].fields[f];
+            double mean = sum[p][f] / config.sample_count;
+            double variance = (sum_sq[p][f] - config.sample_count * mean * mean) / (config.sample_count - 1);
+            assert(fabs(estimate->mean - mean) <= 1e-9 * fmax(1.0, fabs(mean)));
+            assert(fabs(estimate->stddev - sqrt(fmax(variance, 0.0))) <= 1e-6 * fmax(1.0, estimate->stddev));
+            assert(estimate->ci_low <= estimate->mean && estimate->mean <= estimate->ci_high);
+
+            // 95% normal interval: half-width 1.96 standard errors.
+            double half_width = 1.959964 * estimate->stddev / sqrt((double)config.sample_count);
+            assert(fabs((estimate->ci_high - estimate->mean) - half_width) <= 1e-5 * fmax(1.0, half_width));
+        }
+        assert(fabs(result.policies[p].win_rate - wins[p] / config.sample_count) < 1e-12);
+        total_win_rate += result.policies[p].win_rate;
+    }
+    assert(fabs(total_win_rate - 1.0) < 1e-9);
+
+    // SRTF minimises average waiting time, so it never loses outright.
+    assert(result.policies[2].win_rate > result.policies[0].win_rate);
+    assert(result.policies[2].fields[MONTE_CARLO_AVG_WAITING].mean <=
+           result.policies[0].fields[MONTE_CARLO_AVG_WAITING].mean);
+}
+
+static void test_field_table(void) {
+    metrics_t metrics;
+    memset(&metrics, 0, sizeof(metrics));
+    metrics.cpu_utilization = 87.5;
+    metrics.context_switches = 12;
+    metrics.response_stats.p95 = 4.25;
+    metrics.slowdown_stats.max = 9.0;
+
+    assert(monte_carlo_field_value(&metrics, MONTE_CARLO_CPU_UTILIZATION) == 87.5);
+    assert(monte_carlo_field_value(&metrics, MONTE_CARLO_CONTEXT_SWITCHES) == 12.0);
+    assert(monte_carlo_field_value(&metrics, MONTE_CARLO_RESPONSE_STATS + 3) == 4.25);
+    assert(monte_carlo_field_value(&metrics, MONTE_CARLO_SLOWDOWN_STATS + 5) == 9.0);
+    assert(strcmp(monte_carlo_field_name(MONTE_CARLO_RESPONSE_STATS + 3), "response_stats.p95") == 0);
+    assert(strcmp(monte_carlo_field_name(MONTE_CARLO_FIELD_COUNT - 1), "slowdown_stats.max") == 0);
+    assert(monte_carlo_field_higher_is_better(MONTE_CARLO_THROUGHPUT));
+    assert(!monte_carlo_field_higher_is_better(MONTE_CARLO_AVG_WAITING));
+}
+
+static void test_invalid_configs(void) {
+    monte_carlo_config_t config;
+    monte_carlo_result_t result;
+
+    make_config(&config);
+    config.policy_count = 0;
+    assert(monte_carlo_run(&config, &result) != 0);
+
+    make_config(&config);
+    config.confidence = 1.0;
+    assert(monte_carlo_run(&config, &result) != 0);
+
+    make_config(&config);
+    config.workload.arrival_rate = -1.0;
+    assert(monte_carlo_run(&config, &result) != 0);
+
+    make_config(&config);
+    config.sample_count = 0;
+    assert(monte_carlo_run(&config, &result) != 0);
+}
+
+int main(void) {
+    test_bitwise_reproducible_across_thread_counts();
+    test_matches_sequential_reference();
+    test_field_table();
+    test_invalid_configs();
+
+    printf("Monte Carlo tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "../Sources/Core/online_scheduler.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 60
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "P%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+// Arrivals are non-decreasing so they can be fed in array order.
+static void build_workload(process_t *processes) {
+    int arrival = 0;
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        arrival += (i * 7) % 5;
+        int burst = (i % 11 == 0) ? 0 : 1 + (i * 13) % 9;
+        processes[i] = make_process(i + 1, arrival, burst, 1 + (i * 3) % 10);
+    }
+}
+
+static void append_events(online_scheduler_t *sim, timeline_event_t *all, int *all_count) {
+    timeline_event_t *events = NULL;
+    int count = 0;
+    assert(online_scheduler_drain_events(sim, &events, &count) == 0);
+    for (int i = 0; i < count; i++) {
+        all[(*all_count)++] = events[i];
+    }
+    free(events);
+}
+
+static void check_matches_batch(const schedule_config_t *config) {
+    process_t batch[WORKLOAD_SIZE];
+    build_workload(batch);
+
+    timeline_event_t *expected = NULL;
+    int expected_count = 0;
+    metrics_t expected_metrics;
+    assert(schedule_processes_with_config(batch, WORKLOAD_SIZE, config, &expected, &expected_count, &expected_metrics) == 0);
+
+    process_t input[WORKLOAD_SIZE];
+    build_workload(input);
+
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(config, &sim) == 0);
+
+    timeline_event_t *actual = (timeline_event_t *)malloc((size_t)expected_count * sizeof(timeline_event_t));
+    int actual_count = 0;
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        assert(online_scheduler_advance_to(sim, input[i].arrival_time) == 0);
+        assert(online_scheduler_submit(sim, &input[i]) == 0);
+        if (i % 4 == 0) {
+            append_events(sim, actual, &actual_count);
+        }
+    }
+    // The tail in bounded steps of a few decisions, drained in between.
+    bool reached = false;
+    int steps = 0;
+    while (!reached) {
+        assert(online_scheduler_advance_bounded(sim, 1000000, 3, &reached) == 0);
+        append_events(sim, actual, &actual_count);
+        steps++;
+    }
+    assert(steps > 1 && online_scheduler_time(sim) == 1000000);
+    assert(online_scheduler_active_count(sim) == 0);
+
+    assert(actual_count == expected_count);
+    for (int i = 0; i < expected_count; i++) {
+        assert(actual[i].process_id == expected[i].process_id);
+        assert(actual[i].start_time == expected[i].start_time);
+        assert(actual[i].end_time == expected[i].end_time);
+    }
+
+    process_t *completed = NULL;
+    int completed_count = 0;
+    assert(online_scheduler_drain_completed(sim, &completed, &completed_count) == 0);
+    assert(completed_count == WORKLOAD_SIZE);
+    for (int i = 0; i < completed_count; i++) {
+        const process_t *want = &batch[completed[i].process_id - 1];
+        assert(completed[i].completion_time == want->completion_time);
+        assert(completed[i].waiting_time == want->waiting_time);
+        assert(completed[i].response_time == want->response_time);
+    }
+
+    metrics_t metrics;
+    assert(online_scheduler_metrics(sim, &metrics) == 0);
+    assert(metrics.total_time == expected_metrics.total_time);
+    assert(metrics.context_switches == expected_metrics.context_switches);
+    assert(metrics.overhead_time == expected_metrics.overhead_time);
+    assert(fabs(metrics.avg_waiting_time - expected_metrics.avg_waiting_time) < 1e-9);
+    assert(fabs(metrics.waiting_stats.p99 - expected_metrics.waiting_stats.p99) < 1e-9);
+
+    free(completed);
+    free(actual);
+    free(expected);
+    online_scheduler_destroy(sim);
+}
+
+static void test_matches_batch_for_every_policy(void) {
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 3;
+        check_matches_batch(&config);
+
+        config.switch_cost = 1;
+        config.cache_refill_penalty = 4;
+        config.cache_refill_window = 6;
+        config.aging_interval = 3;
+        check_matches_batch(&config);
+    }
+}
+
+static void test_rejects_past_arrivals(void) {
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_SRTF;
+
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(&config, &sim) == 0);
+    assert(online_scheduler_advance_to(sim, 10) == 0);
+
+    process_t late = make_process(1, 5, 3, 1);
+    assert(online_scheduler_submit(sim, &late) != 0);
+    assert(online_scheduler_advance_to(sim, 9) != 0);
+
+    late.arrival_time = 10;
+    assert(online_scheduler_submit(sim, &late) == 0);
+    assert(online_scheduler_time(sim) == 10);
+    online_scheduler_destroy(sim);
+
+    config.algorithm = (algorithm_type_t)42;
+    assert(online_scheduler_create(&config, &sim) != 0);
+}
+
+// A long feed with a bounded backlog keeps only the active set resident.
+static void test_active_set_stays_bounded(void) {
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 2;
+
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(&config, &sim) == 0);
+
+    int peak_active = 0;
+    for (int i = 0; i < 100000; i++) {
+        process_t p = make_process(i + 1, i * 3, 2 + i % 3, 1);
+        assert(online_scheduler_submit(sim, &p) == 0);
+        assert(online_scheduler_advance_to(sim, i * 3 + 3) == 0);
+        if (online_scheduler_active_count(sim) > peak_active) {
+            peak_active = online_scheduler_active_count(sim);
+        }
+
+        timeline_event_t *events = NULL;
+        process_t *completed = NULL;
+        int count = 0;
+        assert(online_scheduler_drain_events(sim, &events, &count) == 0);
+        free(events);
+        assert(online_scheduler_drain_completed(sim, &completed, &count) == 0);
+        free(completed);
+    }
+    assert(peak_active <= 4);
+    online_scheduler_destroy(sim);
+}
+
+int main(void) {
+    test_matches_batch_for_every_policy();
+    test_rejects_past_arrivals();
+    test_active_set_stays_bounded();
+
+    printf("Online scheduler tests passed.\n");
+    return 0;
+}
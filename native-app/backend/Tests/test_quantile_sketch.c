@@ -0,0 +1,115 @@
+#include "../Sources/Core/metrics.h"
+#include "../Sources/Core/quantile_sketch.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+static int approx_equal(double a, double b, double eps) {
+    return fabs(a - b) <= eps;
+}
+
+static void test_exact_for_small_n(void) {
+    quantile_sketch_t sketch;
+    quantile_sketch_init(&sketch);
+    for (int i = 100; i >= 1; i--) {
+        quantile_sketch_add(&sketch, (double)i);
+    }
+
+    assert(quantile_sketch_is_exact(&sketch));
+    assert(approx_equal(quantile_sketch_quantile(&sketch, 0.50), 50.0, 1e-9));
+    assert(approx_equal(quantile_sketch_quantile(&sketch, 0.95), 95.0, 1e-9));
+    assert(approx_equal(quantile_sketch_quantile(&sketch, 0.99), 99.0, 1e-9));
+    assert(approx_equal(quantile_sketch_quantile(&sketch, 1.0), 100.0, 1e-9));
+    quantile_sketch_free(&sketch);
+}
+
+static void test_digest_accuracy(void) {
+    const int n = 200000;
+    quantile_sketch_t sketch;
+    quantile_sketch_init(&sketch);
+
+    // Deterministic permutation of 1..n.
+    for (int i = 0; i < n; i++) {
+        int value = (int)(((long long)i * 7919) % n) + 1;
+        quantile_sketch_add(&sketch, (double)value);
+    }
+
+    assert(!quantile_sketch_is_exact(&sketch));
+    assert(sketch.centroid_count <= QUANTILE_SKETCH_MAX_CENTROIDS);
+    assert(fabs(quantile_sketch_quantile(&sketch, 0.50) - 0.50 * n) < 0.01 * n);
+    assert(fabs(quantile_sketch_quantile(&sketch, 0.99) - 0.99 * n) < 0.002 * n);
+    assert(approx_equal(quantile_sketch_quantile(&sketch, 1.0), (double)n, 1e-9));
+    quantile_sketch_free(&sketch);
+}
+
+static void test_copy_is_independent(void) {
+    quantile_sketch_t empty;
+    quantile_sketch_init(&empty);
+    assert(empty.storage == NULL);
+    assert(sizeof(quantile_sketch_t) < 128);
+
+    quantile_sketch_t sketch;
+    quantile_sketch_init(&sketch);
+    for (int i = 1; i <= 1000; i++) {
+        quantile_sketch_add(&sketch, (double)i);
+    }
+    double p50 = quantile_sketch_quantile(&sketch, 0.50);
+    assert(sketch.buffered > 0);
+
+    quantile_sketch_t copy;
+    assert(quantile_sketch_copy(&copy, &sketch) == 0);
+    assert(copy.storage != sketch.storage);
+    for (int i = 0; i < 5000; i++) {
+        quantile_sketch_add(&sketch, 5000.0);
+    }
+    assert(copy.count == 1000);
+    assert(approx_equal(quantile_sketch_quantile(&copy, 0.50), p50, 1e-9));
+    assert(quantile_sketch_quantile(&sketch, 0.50) == 5000.0);
+
+    quantile_sketch_free(&sketch);
+    quantile_sketch_free(&copy);
+}
+
+static void test_merge_matches_single_stream(void) {
+    const int n = 50000;
+    distribution_accumulator_t left;
+    distribution_accumulator_t right;
+    distribution_accumulator_t whole;
+    distribution_accumulator_init(&left);
+    distribution_accumulator_init(&right);
+    distribution_accumulator_init(&whole);
+
+    for (int i = 0; i < n; i++) {
+        double value = (double)((i * 31) % 1000);
+        distribution_accumulator_add((i % 3 == 0) ? &left : &right, value);
+        distribution_accumulator_add(&whole, value);
+    }
+    distribution_accumulator_merge(&left, &right);
+
+    distribution_stats_t merged;
+    distribution_stats_t single;
+    distribution_accumulator_finish(&left, &merged);
+    distribution_accumulator_finish(&whole, &single);
+
+    assert(left.count == n);
+    assert(approx_equal(merged.mean, single.mean, 1e-9));
+    assert(approx_equal(merged.stddev, single.stddev, 1e-6));
+    assert(approx_equal(merged.max, 999.0, 1e-9));
+    assert(fabs(merged.p99 - single.p99) < 5.0);
+    assert(fabs(merged.p50 - single.p50) < 10.0);
+
+    distribution_accumulator_free(&left);
+    distribution_accumulator_free(&right);
+    distribution_accumulator_free(&whole);
+}
+
+int main(void) {
+    test_exact_for_small_n();
+    test_digest_accuracy();
+    test_copy_is_independent();
+    test_merge_matches_single_stream();
+
+    printf("Quantile sketch tests passed.\n");
+    return 0;
+}
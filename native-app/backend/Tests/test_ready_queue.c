@@ -0,0 +1,118 @@
+#include "../Sources/Core/ready_queue.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+static ready_entry_t make_entry(long long key, int tie1, int tie2, int index) {
+    ready_entry_t entry;
+    entry.key = key;
+    entry.tie1 = tie1;
+    entry.tie2 = tie2;
+    entry.seq = index;
+    entry.index = index;
+    return entry;
+}
+
+static void test_levels_dispatch_lowest_first(void) {
+    ready_queue_t queue;
+    assert(ready_queue_init(&queue, READY_QUEUE_MAX_LEVELS) == 0);
+
+    assert(ready_queue_push(&queue, 6, make_entry(0, 1, 0, 0)) == 0);
+    assert(ready_queue_push(&queue, 2, make_entry(1, 2, 0, 1)) == 0);
+    assert(ready_queue_push(&queue, 2, make_entry(1, 3, 0, 2)) == 0);
+    assert(ready_queue_push(&queue, 9, make_entry(0, 4, 0, 3)) == 0);
+    assert(ready_queue_push(&queue, 2, make_entry(3, 5, 0, 4)) == 0);
+    assert(queue.size == 5);
+
+    // Level 2 drains in FIFO (key, tie) order before level 6 and level 9.
+    const int expected_index[] = {1, 2, 4, 0, 3};
+    const int expected_level[] = {2, 2, 2, 6, 9};
+    for (int i = 0; i < 5; i++) {
+        ready_entry_t entry;
+        int level = -1;
+        assert(ready_queue_pop(&queue, &entry, &level));
+        assert(entry.index == expected_index[i]);
+        assert(level == expected_level[i]);
+    }
+    assert(queue.occupied == 0U);
+    assert(!ready_queue_pop(&queue, NULL, NULL));
+
+    assert(ready_queue_push(&queue, READY_QUEUE_MAX_LEVELS, make_entry(0, 0, 0, 0)) != 0);
+    ready_queue_free(&queue);
+}
+
+static void test_single_level_heap_order(void) {
+    ready_queue_t queue;
+    assert(ready_queue_init(&queue, 1) == 0);
+
+    // Out-of-order keys with growth past the initial capacity.
+    for (int i = 0; i < 100; i++) {
+        int key = (i * 37) % 100;
+        assert(ready_queue_push(&queue, 0, make_entry(key, 0, 0, i)) == 0);
+    }
+    // Full ties fall back to the index.
+    assert(ready_queue_push(&queue, 0, make_entry(5, 0, 0, 200)) == 0);
+
+    long long last_key = -1;
+    int pops = 0;
+    ready_entry_t entry;
+    while (ready_queue_pop(&queue, &entry, NULL)) {
+        assert(entry.key >= last_key);
+        if (entry.key == 5 && entry.index == 200) {
+            assert(last_key == 5);
+        }
+        last_key = entry.key;
+        pops++;
+    }
+    assert(pops == 101);
+    ready_queue_free(&queue);
+}
+
+// FIFO levels pop in push order whatever the keys, including across ring
+// wrap-around, growth and copies.
+static void test_fifo_levels_keep_push_order(void) {
+    ready_queue_t queue;
+    assert(ready_queue_init_fifo(&queue, 3) == 0);
+
+    int next_out = 0;
+    int next_in = 0;
+    for (int round = 0; round < 40; round++) {
+        for (int i = 0; i < 3; i++) {
+            // Keys run backwards so a heap would reverse them.
+            assert(ready_queue_push(&queue, 1, make_entry(1000 - next_in, 0, 0, next_in)) == 0);
+            next_in++;
+        }
+        ready_entry_t entry;
+        int level = -1;
+        assert(ready_queue_pop(&queue, &entry, &level));
+        assert(entry.index == next_out && level == 1);
+        next_out++;
+    }
+    assert(ready_queue_push(&queue, 0, make_entry(5000, 0, 0, -1)) == 0);
+
+    ready_queue_t copy;
+    assert(ready_queue_copy(&copy, &queue) == 0);
+    ready_queue_t *queues[] = {&queue, &copy};
+    for (int q = 0; q < 2; q++) {
+        ready_entry_t entry;
+        int level = -1;
+        assert(ready_queue_pop(queues[q], &entry, &level));
+        assert(entry.index == -1 && level == 0);
+        for (int expected = next_out; expected < next_in; expected++) {
+            assert(ready_queue_pop(queues[q], &entry, &level));
+            assert(entry.index == expected && level == 1);
+        }
+        assert(!ready_queue_pop(queues[q], &entry, NULL));
+    }
+    ready_queue_free(&queue);
+    ready_queue_free(&copy);
+}
+
+int main(void) {
+    test_levels_dispatch_lowest_first();
+    test_single_level_heap_order();
+    test_fifo_levels_keep_push_order();
+
+    printf("Ready queue tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "../Sources/Core/result_cache.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 12
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "P%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+static void build_workload(process_t *processes, int seed) {
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        processes[i] = make_process(i + 1, (i * 5 + seed) % 13, 1 + (i * 7 + seed) % 6, 1 + (i * 3) % 10);
+    }
+}
+
+static schedule_config_t make_config(algorithm_type_t algorithm, int quantum) {
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = quantum;
+    config.switch_cost = 1;
+    return config;
+}
+
+static void run_cached(schedule_cache_t *cache, process_t *processes, const schedule_config_t *config, metrics_t *metrics) {
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    assert(schedule_cache_run(cache, processes, WORKLOAD_SIZE, config, &timeline, &timeline_count, metrics) == 0);
+    free(timeline);
+}
+
+static void test_hit_returns_same_result(void) {
+    schedule_cache_t *cache = NULL;
+    assert(schedule_cache_create(1 << 20, &cache) == 0);
+
+    for (int algorithm = ALGO_FCFS; algorithm <= ALGO_PRIORITY_P; algorithm++) {
+        schedule_config_t config = make_config((algorithm_type_t)algorithm, 2);
+        process_t direct[WORKLOAD_SIZE];
+        build_workload(direct, algorithm);
+        timeline_event_t *expected = NULL;
+        int expected_count = 0;
+        metrics_t expected_metrics;
+        assert(schedule_processes_with_config(direct, WORKLOAD_SIZE, &config, &expected, &expected_count, &expected_metrics) == 0);
+
+        for (int round = 0; round < 2; round++) {
+            process_t processes[WORKLOAD_SIZE];
+            build_workload(processes, algorithm);
+            timeline_event_t *timeline = NULL;
+            int timeline_count = 0;
+            metrics_t metrics;
+            assert(schedule_cache_run(cache, processes, WORKLOAD_SIZE, &config, &timeline, &timeline_count, &metrics) == 0);
+
+            assert(timeline_count == expected_count);
+            assert(memcmp(timeline, expected, (size_t)timeline_count * sizeof(timeline_event_t)) == 0);
+            assert(memcmp(&metrics, &expected_metrics, sizeof(metrics)) == 0);
+            for (int i = 0; i < WORKLOAD_SIZE; i++) {
+                assert(processes[i].completion_time == direct[i].completion_time);
+                assert(processes[i].response_time == direct[i].response_time);
+            }
+            free(timeline);
+        }
+        free(expected);
+    }
+
+    schedule_cache_stats_t stats;
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.misses == 6 && stats.hits == 6 && stats.entries == 6);
+    schedule_cache_destroy(cache);
+}
+
+static void test_canonical_key(void) {
+    schedule_cache_t *cache = NULL;
+    assert(schedule_cache_create(1 << 20, &cache) == 0);
+
+    process_t processes[WORKLOAD_SIZE];
+    metrics_t metrics;
+    schedule_config_t config = make_config(ALGO_FCFS, 2);
+    build_workload(processes, 0);
+    processes[0].arrival_time = 0;
+    run_cached(cache, processes, &config, &metrics);
+
+    // Stale result fields, a clamped arrival and a quantum FCFS never reads
+    // all map to the same key.
+    build_workload(processes, 0);
+    processes[0].arrival_time = -4;
+    processes[3].completion_time = 99;
+    processes[3].remaining_time = 7;
+    config.time_quantum = 9;
+    assert(schedule_workload_hash(processes, WORKLOAD_SIZE, &config) != 0);
+    run_cached(cache, processes, &config, &metrics);
+
+    // Anything the schedule depends on does not.
+    build_workload(processes, 0);
+    processes[5].burst_time++;
+    run_cached(cache, processes, &config, &metrics);
+    build_workload(processes, 0);
+    config.switch_cost = 2;
+    run_cached(cache, processes, &config, &metrics);
+
+    schedule_cache_stats_t stats;
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.hits == 1 && stats.misses == 3);
+
+    schedule_cache_clear(cache);
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.entries == 0 && stats.bytes == 0);
+    schedule_cache_destroy(cache);
+}
+
+static void test_lru_eviction_within_budget(void) {
+    process_t processes[WORKLOAD_SIZE];
+    metrics_t metrics;
+    schedule_config_t config = make_config(ALGO_RR, 2);
+
+    // Measure one entry, then allow room for two.
+    schedule_cache_t *cache = NULL;
+    schedule_cache_stats_t stats;
+    assert(schedule_cache_create(1 << 20, &cache) == 0);
+    build_workload(processes, 0);
+    run_cached(cache, processes, &config, &metrics);
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    size_t entry_bytes = stats.bytes;
+    schedule_cache_destroy(cache);
+
+    assert(schedule_cache_create(entry_bytes * 2 + entry_bytes / 2, &cache) == 0);
+    for (int seed = 0; seed < 2; seed++) {
+        build_workload(processes, seed);
+        run_cached(cache, processes, &config, &metrics);
+    }
+    // Touch workload 0 so workload 1 is the least recently used.
+    build_workload(processes, 0);
+    run_cached(cache, processes, &config, &metrics);
+    build_workload(processes, 6);
+    run_cached(cache, processes, &config, &metrics);
+
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.entries == 2 && stats.evictions == 1 && stats.bytes <= stats.budget);
+
+    build_workload(processes, 0);
+    run_cached(cache, processes, &config, &metrics);
+    build_workload(processes, 1);
+    run_cached(cache, processes, &config, &metrics);
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.hits == 2 && stats.misses == 4);
+    schedule_cache_destroy(cache);
+
+    // A result larger than the whole budget is computed but not kept.
+    assert(schedule_cache_create(64, &cache) == 0);
+    run_cached(cache, processes, &config, &metrics);
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.entries == 0 && stats.misses == 1);
+    schedule_cache_destroy(cache);
+
+    assert(schedule_cache_create(0, &cache) != 0);
+}
+
+// Two callers miss the same key, schedule outside the cache and both insert.
+static void test_split_lookup_and_insert(void) {
+    schedule_cache_t *cache = NULL;
+    assert(schedule_cache_create(1 << 20, &cache) == 0);
+    schedule_config_t config = make_config(ALGO_PRIORITY_P, 1);
+
+    for (int caller = 0; caller < 2; caller++) {
+        process_t processes[WORKLOAD_SIZE];
+        build_workload(processes, 3);
+        timeline_event_t *timeline = NULL;
+        int timeline_count = -1;
+        metrics_t metrics;
+        bool hit = true;
+        assert(schedule_cache_lookup(cache, processes, WORKLOAD_SIZE, &config, &timeline, &timeline_count, &metrics, &hit) == 0);
+        assert(!hit && timeline == NULL && timeline_count == -1);
+    }
+    for (int caller = 0; caller < 2; caller++) {
+        process_t processes[WORKLOAD_SIZE];
+        build_workload(processes, 3);
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t metrics;
+        assert(schedule_processes_with_config(processes, WORKLOAD_SIZE, &config, &timeline, &timeline_count, &metrics) == 0);
+        assert(schedule_cache_insert(cache, processes, WORKLOAD_SIZE, &config, timeline, timeline_count, &metrics) == 0);
+        free(timeline);
+    }
+
+    schedule_cache_stats_t stats;
+    assert(schedule_cache_stats(cache, &stats) == 0);
+    assert(stats.entries == 1 && stats.misses == 2 && stats.hits == 0);
+
+    process_t processes[WORKLOAD_SIZE];
+    build_workload(processes, 3);
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics;
+    bool hit = false;
+    assert(schedule_cache_lookup(cache, processes, WORKLOAD_SIZE, &config, &timeline, &timeline_count, &metrics, &hit) == 0);
+    assert(hit && timeline_count > 0 && processes[0].completion_time > 0);
+    free(timeline);
+    schedule_cache_destroy(cache);
+}
+
+int main(void) {
+    test_hit_returns_same_result();
+    test_split_lookup_and_insert();
+    test_canonical_key();
+    test_lru_eviction_within_budget();
+
+    printf("Result cache tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../Sources/Core/monte_carlo.h"
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/workload_file.h"
+#include "../Sources/Core/workload_gen.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define WORKLOAD_SIZE 1500
+#define POLICY_COUNT 6
+
+// Runs the sched_batch binary given as argv[1] and checks that every metrics
+// row matches schedule_processes on the same workload.
+
+static void temp_path(char *path, size_t size, const char *suffix) {
+    char base[64];
+    snprintf(base, sizeof(base), "/tmp/sched_batch_test_XXXXXX");
+    int fd = mkstemp(base);
+    assert(fd >= 0);
+    close(fd);
+    unlink(base);
+    snprintf(path, size, "%s%s", base, suffix);
+}
+
+static void write_csv(const char *path, const process_t *processes, int count) {
+    FILE *out = fopen(path, "w");
+    assert(out != NULL);
+    fputs("id,name,arrival_time,burst_time,priority\n", out);
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%d,%s,%d,%d,%d\n", processes[i].process_id, processes[i].name, processes[i].arrival_time,
+                processes[i].burst_time, processes[i].priority);
+    }
+    fclose(out);
+}
+
+static int run_batch(const char *binary, const char *arguments) {
+    char command[1024];
+    snprintf(command, sizeof(command), "\"%s\" %s", binary, arguments);
+    int status = system(command);
+    assert(status != -1 && WIFEXITED(status));
+    return WEXITSTATUS(status);
+}
+
+static void expected_metrics(const process_t *workload, algorithm_type_t algorithm, int quantum, metrics_t *metrics) {
+    process_t *copy = (process_t *)malloc(WORKLOAD_SIZE * sizeof(process_t));
+    assert(copy != NULL);
+    memcpy(copy, workload, WORKLOAD_SIZE * sizeof(process_t));
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    assert(schedule_processes(copy, WORKLOAD_SIZE, algorithm, quantum, &timeline, &timeline_count, metrics) == 0);
+    free(timeline);
+    free(copy);
+}
+
+// One CSV row: workload,policy,processes and the monte_carlo fields.
+static void check_row(char *line, const process_t *workload, int *seen) {
+    char *fields[3 + MONTE_CARLO_FIELD_COUNT];
+    int count = 0;
+    for (char *field = strtok(line, ",\n"); field && count < 3 + MONTE_CARLO_FIELD_COUNT;
+         field = strtok(NULL, ",\n")) {
+        fields[count++] = field;
+    }
+    assert(count == 3 + MONTE_CARLO_FIELD_COUNT);
+    assert(atoi(fields[2]) == WORKLOAD_SIZE);
+
+    char *colon = strchr(fields[1], ':');
+    int quantum = colon ? atoi(colon + 1) : 4;
+    if (colon) {
+        *colon = '\0';
+    }
+    algorithm_type_t algorithm = ALGO_FCFS;
+    assert(sched_algorithm_from_name(fields[1], &algorithm) == 0);
+    seen[algorithm]++;
+
+    metrics_t metrics;
+    expected_metrics(workload, algorithm, quantum, &metrics);
+    for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+        double expected = monte_carlo_field_value(&metrics, (monte_carlo_field_t)f);
+        double actual = strtod(fields[3 + f], NULL);
+        if (fabs(actual - expected) > 1e-9 * (1.0 + fabs(expected))) {
+            fprintf(stderr, "%s %s: %.10g, expected %.10g\n", fields[1], monte_carlo_field_name((monte_carlo_field_t)f),
+                    actual, expected);
+            assert(0);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    assert(argc == 2);
+    const char *binary = argv[1];
+
+    workload_gen_config_t spec;
+    workload_gen_config_default(&spec);
+    spec.seed = 23;
+    process_t *workload = NULL;
+    assert(workload_generate(&spec, WORKLOAD_SIZE, &workload) == 0);
+    // A few out-of-order arrivals, which the tool must sort itself.
+    for (int i = 0; i + 40 < WORKLOAD_SIZE; i += 97) {
+        process_t swap = workload[i];
+        workload[i] = workload[i + 40];
+        workload[i + 40] = swap;
+    }
+
+    char binary_path[80];
+    char csv_path[80];
+    char metrics_path[80];
+    temp_path(binary_path, sizeof(binary_path), ".swkl");
+    temp_path(csv_path, sizeof(csv_path), ".csv");
+    temp_path(metrics_path, sizeof(metrics_path), ".csv");
+    assert(workload_file_write(binary_path, workload, WORKLOAD_SIZE) == 0);
+    write_csv(csv_path, workload, WORKLOAD_SIZE);
+
+    char arguments[512];
+    snprintf(arguments, sizeof(arguments),
+             "%s %s --policy fcfs,sjf,srtf,rr:3,priority_np,priority_p --format csv --metrics %s --jobs 2",
+             binary_path, csv_path, metrics_path);
+    assert(run_batch(binary, arguments) == 0);
+
+    // Both inputs, every policy.
+    FILE *in = fopen(metrics_path, "r");
+    assert(in != NULL);
+    char line[4096];
+    assert(fgets(line, sizeof(line), in) != NULL);
+    assert(strncmp(line, "workload,policy,processes,", 26) == 0);
+    int seen[POLICY_COUNT] = {0};
+    int rows = 0;
+    while (fgets(line, sizeof(line), in)) {
+        check_row(line, workload, seen);
+        rows++;
+    }
+    fclose(in);
+    assert(rows == 2 * POLICY_COUNT);
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        assert(seen[p] == 2);
+    }
+
+    snprintf(arguments, sizeof(arguments), "%s --policy fcfs,lottery --metrics %s 2>/dev/null", csv_path,
+             metrics_path);
+    assert(run_batch(binary, arguments) == 2);
+
+    unlink(binary_path);
+    unlink(csv_path);
+    unlink(metrics_path);
+    free(workload);
+    printf("sched_batch smoke tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include "../Sources/Core/sched_service.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_REPLIES 64
+#define HEAVY_PROCESSES 300000
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    char *replies[MAX_REPLIES];
+    int count;
+} collector_t;
+
+static void collector_init(collector_t *collector) {
+    memset(collector, 0, sizeof(*collector));
+    pthread_mutex_init(&collector->lock, NULL);
+    pthread_cond_init(&collector->changed, NULL);
+}
+
+static void collector_free(collector_t *collector) {
+    for (int i = 0; i < collector->count; i++) {
+        free(collector->replies[i]);
+    }
+    pthread_cond_destroy(&collector->changed);
+    pthread_mutex_destroy(&collector->lock);
+}
+
+static void collect(void *context, const char *response, size_t length) {
+    collector_t *collector = (collector_t *)context;
+    assert(length > 0 && response[length - 1] == '\n');
+    char *copy = (char *)malloc(length + 1);
+    assert(copy != NULL);
+    memcpy(copy, response, length);
+    copy[length] = '\0';
+    pthread_mutex_lock(&collector->lock);
+    assert(collector->count < MAX_REPLIES);
+    collector->replies[collector->count++] = copy;
+    pthread_cond_broadcast(&collector->changed);
+    pthread_mutex_unlock(&collector->lock);
+}
+
+static void wait_for(collector_t *collector, int count) {
+    pthread_mutex_lock(&collector->lock);
+    while (collector->count < count) {
+        pthread_cond_wait(&collector->changed, &collector->lock);
+    }
+    pthread_mutex_unlock(&collector->lock);
+}
+
+static const char *reply_for(collector_t *collector, const char *id) {
+    char prefix[48];
+    snprintf(prefix, sizeof(prefix), "{\"id\":%s,", id);
+    for (int i = 0; i < collector->count; i++) {
+        if (strncmp(collector->replies[i], prefix, strlen(prefix)) == 0) {
+            return collector->replies[i];
+        }
+    }
+    return NULL;
+}
+
+static double number_after(const char *text, const char *key) {
+    const char *found = strstr(text, key);
+    assert(found != NULL);
+    return strtod(found + strlen(key), NULL);
+}
+
+static void count_release(void *context) {
+    (*(int *)context)++;
+}
+
+static void submit(sched_service_t *service, const char *line, const void *client, collector_t *collector) {
+    assert(sched_service_submit(service, line, strlen(line), client, collect, collector) == 0);
+}
+
+// Arrivals one tick apart, or all at once with `burst`.
+static char *heavy_request(const char *id, const char *channel, bool burst) {
+    size_t capacity = (size_t)HEAVY_PROCESSES * 32 + 256;
+    char *line = (char *)malloc(capacity);
+    assert(line != NULL);
+    size_t length = (size_t)snprintf(line, capacity, "{\"id\":%s,\"channel\":\"%s\",\"algorithm\":\"rr\",\"processes\":[",
+                                     id, channel);
+    for (int i = 0; i < HEAVY_PROCESSES; i++) {
+        length += (size_t)snprintf(line + length, capacity - length, "%s[%d,%d,7,1]", i ? "," : "", i + 1, burst ? 0 : i);
+    }
+    snprintf(line + length, capacity - length, "]}");
+    return line;
+}
+
+static void test_matches_batch_api(void) {
+    sched_service_t *service = NULL;
+    assert(sched_service_create(2, &service) == 0);
+    collector_t collector;
+    collector_init(&collector);
+
+    // Unsorted arrivals, named and unnamed processes, unknown keys ignored.
+    submit(service,
+           "{\"id\": 1, \"algorithm\": \"rr\", \"quantum\": 2, \"timeline\": true, \"client_hint\": {\"a\": [1, null]},"
+           " \"processes\": [[3, 4, 2, 1], {\"id\": 1, \"arrivalTime\": 0, \"burstTime\": 5, \"name\": \"build \\\"x\\\"\"},"
+           " [2, 1, 3, 2], {\"id\": 4, \"arrival\": 6, \"burst\": 4, \"priority\": 3}]}",
+           NULL, &collector);
+    wait_for(&collector, 1);
+
+    process_t processes[4] = {
+        {.process_id = 1, .arrival_time = 0, .burst_time = 5, .priority = 1},
+        {.process_id = 2, .arrival_time = 1, .burst_time = 3, .priority = 2},
+        {.process_id = 3, .arrival_time = 4, .burst_time = 2, .priority = 1},
+        {.process_id = 4, .arrival_time = 6, .burst_time = 4, .priority = 3},
+    };
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 2;
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t expected;
+    assert(schedule_processes_with_config(processes, 4, &config, &timeline, &timeline_count, &expected) == 0);
+
+    const char *reply = reply_for(&collector, "1");
+    assert(reply != NULL);
+    assert(strstr(reply, "\"status\":\"ok\"") != NULL);
+    assert(fabs(number_after(reply, "\"avg_waiting_time\":") - expected.avg_waiting_time) < 1e-6);
+    assert(fabs(number_after(reply, "\"avg_response_time\":") - expected.avg_response_time) < 1e-6);
+    assert((int)number_after(reply, "\"total_time\":") == expected.total_time);
+    assert((int)number_after(reply, "\"context_switches\":") == expected.context_switches);
+
+    // One [id,start,end] per segment, in order.
+    const char *segment = strstr(reply, "\"timeline\":[") + strlen("\"timeline\":[");
+    for (int i = 0; i < timeline_count; i++) {
+        char expected_segment[48];
+        int length = snprintf(expected_segment, sizeof(expected_segment), "%s[%d,%d,%d]", i ? "," : "",
+                              timeline[i].process_id, timeline[i].start_time, timeline[i].end_time);
+        assert(strncmp(segment, expected_segment, (size_t)length) == 0);
+        segment += length;
+    }
+    assert(strcmp(segment, "]}\n") == 0);
+    free(timeline);
+
+    // Per-process outcomes: [id, completion, turnaround, waiting, response].
+    for (int i = 0; i < 4; i++) {
+        char outcome[64];
+        snprintf(outcome, sizeof(outcome), "[%d,%d,%d,%d,%d]", processes[i].process_id, processes[i].completion_time,
+                 processes[i].turnaround_time, processes[i].waiting_time, processes[i].response_time);
+        assert(strstr(reply, outcome) != NULL);
+    }
+
+    sched_service_destroy(service);
+    collector_free(&collector);
+}
+
+static void test_errors(void) {
+    sched_service_t *service = NULL;
+    assert(sched_service_create(1, &service) == 0);
+    collector_t collector;
+    collector_init(&collector);
+
+    submit(service, "{\"id\": 1, \"processes\": [[1, 0, 5]", NULL, &collector);
+    submit(service, "{\"id\": 2, \"algorithm\": \"lottery\", \"processes\": []}", NULL, &collector);
+    submit(service, "{\"id\": 3, \"algorithm\": \"rr\", \"quantum\": 0, \"processes\": [[1, 0, 5]]}", NULL, &collector);
+    submit(service, "{\"id\": 4, \"processes\": [[1, 0, 0]]}", NULL, &collector);
+    submit(service, "not json", NULL, &collector);
+    submit(service, "{\"id\": 5, \"processes\": []} trailing", NULL, &collector);
+    submit(service, "{\"id\": 6, \"processes\": []}", NULL, &collector);
+    wait_for(&collector, 7);
+
+    assert(strstr(reply_for(&collector, "1"), "\"status\":\"error\"") != NULL);
+    assert(strstr(reply_for(&collector, "2"), "unknown algorithm") != NULL);
+    assert(strstr(reply_for(&collector, "3"), "invalid parameters") != NULL);
+    assert(strstr(reply_for(&collector, "4"), "invalid process") != NULL);
+    assert(strstr(reply_for(&collector, "null"), "malformed request") != NULL);
+    assert(strstr(reply_for(&collector, "5"), "\"status\":\"error\"") != NULL);
+    assert(strstr(reply_for(&collector, "6"), "\"status\":\"ok\"") != NULL);  // empty workloads are fine
+
+    sched_service_stats_t stats;
+    assert(sched_service_stats(service, &stats) == 0);
+    assert(stats.failed == 6 && stats.completed == 1);
+    sched_service_destroy(service);
+    collector_free(&collector);
+}
+
+static void test_superseding_and_batching(void) {
+    sched_service_t *service = NULL;
+    assert(sched_service_create(1, &service) == 0);
+    collector_t collector;
+    collector_init(&collector);
+    int client = 0;
+    int other_client = 0;
+
+    // The single worker is busy with a long run while the rest queue up.
+    char *blocker = heavy_request("100", "blocker", false);
+    submit(service, blocker, &client, &collector);
+    submit(service, "{\"id\": 1, \"channel\": \"gantt\", \"processes\": [[1, 0, 5]]}", &client, &collector);
+    submit(service, "{\"id\": 2, \"channel\": \"gantt\", \"processes\": [[1, 0, 6]]}", &client, &collector);
+    // Same channel, other client: not superseded.
+    submit(service, "{\"id\": 3, \"channel\": \"gantt\", \"processes\": [[1, 0, 7]]}", &other_client, &collector);
+    submit(service,
+           "[{\"id\": 4, \"processes\": [[1, 0, 1]]}, {\"id\": 5, \"algorithm\": \"sjf\", \"processes\": [[1, 0, 2]]},"
+           " {\"id\": 6, \"channel\": \"table\", \"processes\": [[1, 0, 3]]}]",
+           &client, &collector);
+    wait_for(&collector, 7);
+
+    assert(strstr(reply_for(&collector, "1"), "\"status\":\"cancelled\"") != NULL);
+    assert(strstr(reply_for(&collector, "100"), "\"status\":\"ok\"") != NULL);
+    for (int id = 2; id <= 6; id++) {
+        char text[8];
+        snprintf(text, sizeof(text), "%d", id);
+        assert(strstr(reply_for(&collector, text), "\"status\":\"ok\"") != NULL);
+    }
+    assert((int)number_after(reply_for(&collector, "3"), "\"total_time\":") == 7);
+
+    // The queued small requests ran as one batch after the blocker.
+    sched_service_stats_t stats;
+    assert(sched_service_stats(service, &stats) == 0);
+    assert(stats.batches == 2);
+    assert(stats.completed == 6 && stats.cancelled == 1);
+
+    // A running request stops at its next checkpoint once superseded.
+    char *running = heavy_request("200", "gantt", false);
+    submit(service, running, &client, &collector);
+    submit(service, "{\"id\": 201, \"channel\": \"gantt\", \"processes\": [[1, 0, 5]]}", &client, &collector);
+    wait_for(&collector, 9);
+    assert(strstr(reply_for(&collector, "200"), "\"status\":\"cancelled\"") != NULL);
+    assert(strstr(reply_for(&collector, "201"), "\"status\":\"ok\"") != NULL);
+
+    // Once every arrival is in, the remaining run is still checked.
+    char *burst = heavy_request("202", "gantt", true);
+    submit(service, burst, &client, &collector);
+    submit(service, "{\"id\": 203, \"channel\": \"gantt\", \"processes\": [[1, 0, 5]]}", &client, &collector);
+    wait_for(&collector, 11);
+    assert(strstr(reply_for(&collector, "202"), "\"status\":\"cancelled\"") != NULL);
+    assert(strstr(reply_for(&collector, "203"), "\"status\":\"ok\"") != NULL);
+
+    // A forgotten client gets no further replies.
+    submit(service, running, &other_client, &collector);
+    submit(service, "{\"id\": 300, \"processes\": [[1, 0, 5]]}", &other_client, &collector);
+    int released = 0;
+    sched_service_forget_client(service, &other_client, count_release, &released);
+    submit(service, "{\"id\": 301, \"processes\": [[1, 0, 5]]}", &client, &collector);
+    wait_for(&collector, 12);
+    assert(reply_for(&collector, "300") == NULL);
+    assert(reply_for(&collector, "301") != NULL);
+    // The worker let go of the running request before it took 301.
+    assert(released == 1);
+
+    // Nothing running: released straight away.
+    sched_service_forget_client(service, &other_client, count_release, &released);
+    assert(released == 2);
+
+    free(blocker);
+    free(running);
+    free(burst);
+    sched_service_destroy(service);
+    assert(collector.count == 12);
+    collector_free(&collector);
+}
+
+int main(void) {
+    test_matches_batch_api();
+    test_errors();
+    test_superseding_and_batching();
+
+    printf("Scheduling service tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include "../Sources/Core/online_scheduler.h"
+#include "../Sources/Core/schedule_replay.h"
+#include "../Sources/Core/scheduler.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 80
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "P%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+// Deliberately not sorted by arrival.
+static void build_workload(process_t *processes) {
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        processes[i] = make_process(i + 1, (i * 37) % 150, 1 + (i * 11) % 8, 1 + (i * 7) % 10);
+    }
+}
+
+// Reference state at `time`: a fresh online run fed from the start.
+static online_scheduler_t *run_from_scratch(const process_t *sorted, const schedule_config_t *config, int time) {
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(config, &sim) == 0);
+    for (int i = 0; i < WORKLOAD_SIZE && sorted[i].arrival_time < time; i++) {
+        assert(online_scheduler_submit(sim, &sorted[i]) == 0);
+    }
+    assert(online_scheduler_advance_to(sim, time) == 0);
+    return sim;
+}
+
+static int compare_id(const void *lhs, const void *rhs) {
+    return ((const process_t *)lhs)->process_id - ((const process_t *)rhs)->process_id;
+}
+
+// Slot order depends on when processes were submitted, so compare by id.
+static void assert_same_state(online_scheduler_t *lhs, online_scheduler_t *rhs) {
+    metrics_t a;
+    metrics_t b;
+    assert(online_scheduler_metrics(lhs, &a) == 0);
+    assert(online_scheduler_metrics(rhs, &b) == 0);
+    assert(a.total_time == b.total_time);
+    assert(a.context_switches == b.context_switches);
+    assert(fabs(a.avg_waiting_time - b.avg_waiting_time) < 1e-9);
+
+    process_t *active_a = NULL;
+    process_t *active_b = NULL;
+    int count_a = 0;
+    int count_b = 0;
+    assert(online_scheduler_active_processes(lhs, &active_a, &count_a) == 0);
+    assert(online_scheduler_active_processes(rhs, &active_b, &count_b) == 0);
+    assert(count_a == count_b);
+    if (count_a > 0) {
+        qsort(active_a, (size_t)count_a, sizeof(process_t), compare_id);
+        qsort(active_b, (size_t)count_b, sizeof(process_t), compare_id);
+    }
+    for (int i = 0; i < count_a; i++) {
+        assert(active_a[i].process_id == active_b[i].process_id);
+        assert(active_a[i].remaining_time == active_b[i].remaining_time);
+    }
+    free(active_a);
+    free(active_b);
+}
+
+static int compare_arrival(const void *lhs, const void *rhs) {
+    const process_t *a = (const process_t *)lhs;
+    const process_t *b = (const process_t *)rhs;
+    if (a->arrival_time != b->arrival_time) {
+        return a->arrival_time - b->arrival_time;
+    }
+    return a->process_id - b->process_id;
+}
+
+static void test_seek_matches_fresh_run(void) {
+    process_t processes[WORKLOAD_SIZE];
+    process_t sorted[WORKLOAD_SIZE];
+    build_workload(processes);
+    memcpy(sorted, processes, sizeof(processes));
+    qsort(sorted, WORKLOAD_SIZE, sizeof(process_t), compare_arrival);
+
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 3;
+        config.switch_cost = 1;
+
+        schedule_replay_t *replay = NULL;
+        assert(schedule_replay_create(processes, WORKLOAD_SIZE, &config, 25, &replay) == 0);
+
+        // Recorded timeline equals the batch schedule.
+        process_t batch[WORKLOAD_SIZE];
+        memcpy(batch, processes, sizeof(processes));
+        timeline_event_t *expected = NULL;
+        int expected_count = 0;
+        metrics_t expected_metrics;
+        assert(schedule_processes_with_config(batch, WORKLOAD_SIZE, &config, &expected, &expected_count, &expected_metrics) == 0);
+
+        const timeline_event_t *recorded = NULL;
+        int recorded_count = 0;
+        assert(schedule_replay_timeline(replay, &recorded, &recorded_count) == 0);
+        assert(recorded_count == expected_count);
+        for (int i = 0; i < expected_count; i++) {
+            assert(recorded[i].process_id == expected[i].process_id);
+            assert(recorded[i].start_time == expected[i].start_time);
+            assert(recorded[i].end_time == expected[i].end_time);
+        }
+
+        metrics_t replay_metrics;
+        assert(schedule_replay_metrics(replay, &replay_metrics) == 0);
+        assert(replay_metrics.total_time == expected_metrics.total_time);
+        assert(schedule_replay_checkpoint_count(replay) == expected_metrics.total_time / 25 + 2);
+
+        // Scrub forwards and backwards across checkpoint boundaries.
+        const int seeks[] = {137, 3, 250, 50, 49, 0, 400, 75};
+        for (size_t i = 0; i < sizeof(seeks) / sizeof(seeks[0]); i++) {
+            online_scheduler_t *state = NULL;
+            assert(schedule_replay_seek(replay, seeks[i], &state) == 0);
+            assert(online_scheduler_time(state) == seeks[i]);
+
+            online_scheduler_t *reference = run_from_scratch(sorted, &config, seeks[i]);
+            assert_same_state(state, reference);
+            online_scheduler_destroy(reference);
+        }
+
+        free(expected);
+        schedule_replay_destroy(replay);
+    }
+}
+
+static void test_restore_resumes_run(void) {
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_SRTF;
+
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(&config, &sim) == 0);
+    process_t a = make_process(1, 0, 10, 1);
+    process_t b = make_process(2, 4, 2, 1);
+    assert(online_scheduler_submit(sim, &a) == 0);
+    assert(online_scheduler_advance_to(sim, 3) == 0);
+
+    online_scheduler_t *checkpoint = NULL;
+    assert(online_scheduler_clone(sim, &checkpoint) == 0);
+
+    assert(online_scheduler_submit(sim, &b) == 0);
+    assert(online_scheduler_advance_to(sim, 100) == 0);
+    metrics_t first;
+    assert(online_scheduler_metrics(sim, &first) == 0);
+    assert(first.context_switches == 2);
+
+    // Rewind and replay the same future.
+    assert(online_scheduler_restore(sim, checkpoint) == 0);
+    assert(online_scheduler_time(sim) == 3);
+    assert(online_scheduler_active_count(sim) == 1);
+    assert(online_scheduler_submit(sim, &b) == 0);
+    assert(online_scheduler_advance_to(sim, 100) == 0);
+    metrics_t second;
+    assert(online_scheduler_metrics(sim, &second) == 0);
+    assert(second.total_time == first.total_time);
+    assert(second.context_switches == first.context_switches);
+
+    online_scheduler_destroy(checkpoint);
+    online_scheduler_destroy(sim);
+}
+
+static void assert_replay_matches_batch(const schedule_replay_t *replay, const process_t *processes, int count,
+                                       const schedule_config_t *config) {
+    process_t batch[WORKLOAD_SIZE + 1];
+    memcpy(batch, processes, (size_t)count * sizeof(process_t));
+    timeline_event_t *expected = NULL;
+    int expected_count = 0;
+    metrics_t expected_metrics;
+    assert(schedule_processes_with_config(batch, count, config, &expected, &expected_count, &expected_metrics) == 0);
+
+    const timeline_event_t *recorded = NULL;
+    int recorded_count = 0;
+    assert(schedule_replay_timeline(replay, &recorded, &recorded_count) == 0);
+    assert(recorded_count == expected_count);
+    for (int i = 0; i < expected_count; i++) {
+        assert(recorded[i].process_id == expected[i].process_id);
+        assert(recorded[i].start_time == expected[i].start_time);
+        assert(recorded[i].end_time == expected[i].end_time);
+    }
+
+    metrics_t metrics;
+    assert(schedule_replay_metrics(replay, &metrics) == 0);
+    assert(metrics.total_time == expected_metrics.total_time);
+    assert(metrics.context_switches == expected_metrics.context_switches);
+    assert(fabs(metrics.avg_waiting_time - expected_metrics.avg_waiting_time) < 1e-9);
+    assert(fabs(metrics.avg_response_time - expected_metrics.avg_response_time) < 1e-9);
+    free(expected);
+}
+
+static void test_apply_delta_matches_batch(void) {
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 2;
+        config.aging_interval = (algo == ALGO_PRIORITY_P) ? 4 : 0;
+
+        process_t processes[WORKLOAD_SIZE + 1];
+        build_workload(processes);
+        int count = WORKLOAD_SIZE;
+
+        schedule_replay_t *replay = NULL;
+        assert(schedule_replay_create(processes, count, &config, 10, &replay) == 0);
+
+        // Modify a late arrival: the early checkpoints are shared.
+        schedule_delta_t delta;
+        memset(&delta, 0, sizeof(delta));
+        delta.kind = SCHEDULE_DELTA_MODIFY;
+        delta.index = 4;
+        delta.process = processes[4];
+        delta.process.burst_time = 9;
+        delta.process.priority = 1;
+        processes[4] = delta.process;
+
+        schedule_replay_t *edited = NULL;
+        assert(schedule_replay_apply(replay, &delta, &edited) == 0);
+        assert_replay_matches_batch(edited, processes, count, &config);
+        schedule_replay_destroy(replay);
+
+        // Remove an early process, then add one that collides on arrival.
+        delta.kind = SCHEDULE_DELTA_REMOVE;
+        delta.index = 2;
+        memmove(&processes[2], &processes[3], (size_t)(count - 3) * sizeof(process_t));
+        count--;
+        assert(schedule_replay_apply(edited, &delta, &replay) == 0);
+        assert_replay_matches_batch(replay, processes, count, &config);
+        schedule_replay_destroy(edited);
+
+        delta.kind = SCHEDULE_DELTA_ADD;
+        delta.process = make_process(500, processes[10].arrival_time, 3, 2);
+        processes[count++] = delta.process;
+        assert(schedule_replay_apply(replay, &delta, &edited) == 0);
+        assert_replay_matches_batch(edited, processes, count, &config);
+        schedule_replay_destroy(replay);
+
+        schedule_replay_t *rejected = NULL;
+        delta.kind = SCHEDULE_DELTA_REMOVE;
+        delta.index = count;
+        assert(schedule_replay_apply(edited, &delta, &rejected) != 0);
+        assert(rejected == NULL);
+
+        schedule_replay_destroy(edited);
+    }
+}
+
+int main(void) {
+    test_seek_matches_fresh_run();
+    test_restore_resumes_run();
+    test_apply_delta_matches_batch();
+
+    printf("Schedule replay tests passed.\n");
+    return 0;
+}
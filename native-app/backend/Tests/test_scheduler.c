@@ -1,8 +1,11 @@
+#include "../Sources/Core/metrics.h"
 #include "../Sources/Core/scheduler.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 static process_t make_process(int id, const char *name, int arrival, int burst, int priority) {
     process_t p = {0};
@@ -144,6 +147,385 @@ static void test_priority_p(void) {
     free(timeline);
 }
 
+static void test_round_robin_switch_cost(void) {
+    process_t processes[] = {
+        make_process(1, "P1", 0, 5, 1),
+        make_process(2, "P2", 1, 3, 1),
+        make_process(3, "P3", 2, 1, 1),
+    };
+
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 2;
+    config.switch_cost = 1;
+
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_processes_with_config(processes, 3, &config, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    assert(processes[0].completion_time == 14);
+    assert(processes[1].completion_time == 12);
+    assert(processes[2].completion_time == 7);
+    assert(metrics.overhead_time == 5);
+    assert(metrics.context_switches == 5);
+    assert(metrics.total_time == 14);
+    assert(timeline_count == 11);
+    assert(timeline[1].process_id == TIMELINE_OVERHEAD_PROCESS_ID);
+    assert(timeline[1].start_time == 2 && timeline[1].end_time == 3);
+    free(timeline);
+}
+
+static void test_cache_refill_penalty(void) {
+    process_t processes[] = {
+        make_process(1, "P1", 0, 2, 1),
+        make_process(2, "P2", 0, 2, 1),
+    };
+
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 1;
+    config.cache_refill_penalty = 4;
+    config.cache_refill_window = 8;
+
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    int result = schedule_processes_with_config(processes, 2, &config, &timeline, &timeline_count, &metrics);
+    assert(result == 0);
+    assert(processes[0].completion_time == 9);
+    assert(processes[1].completion_time == 11);
+    assert(processes[1].response_time == 5);
+    assert(metrics.overhead_time == 7);
+    free(timeline);
+}
+
+static void test_fused_metrics_match_recomputed(void) {
+    for (int algorithm = ALGO_FCFS; algorithm <= ALGO_PRIORITY_P; algorithm++) {
+        process_t processes[] = {
+            make_process(1, "P1", 0, 7, 4),
+            make_process(2, "P2", 2, 4, 2),
+            make_process(3, "P3", 3, 1, 1),
+            make_process(4, "P4", 5, 4, 3),
+            make_process(5, "P5", 20, 2, 2),
+        };
+
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t fused = {0};
+
+        int result = schedule_processes(processes, 5, (algorithm_type_t)algorithm, 3, &timeline, &timeline_count, &fused);
+        assert(result == 0);
+
+        int switches = 0;
+        for (int i = 1; i < timeline_count; i++) {
+            if (timeline[i].process_id != timeline[i - 1].process_id) {
+                switches++;
+            }
+        }
+
+        metrics_t recomputed;
+        calculate_metrics(processes, 5, switches, &recomputed);
+        assert(fused.context_switches == recomputed.context_switches);
+        assert(fused.total_time == recomputed.total_time);
+        assert(fabs(fused.avg_waiting_time - recomputed.avg_waiting_time) < 1e-9);
+        assert(fabs(fused.avg_turnaround_time - recomputed.avg_turnaround_time) < 1e-9);
+        assert(fabs(fused.avg_response_time - recomputed.avg_response_time) < 1e-9);
+        assert(fabs(fused.cpu_utilization - recomputed.cpu_utilization) < 1e-9);
+        assert(fabs(fused.waiting_stats.p99 - recomputed.waiting_stats.p99) < 1e-9);
+        free(timeline);
+    }
+}
+
+// One low-priority job against a steady stream of priority-1 jobs that would
+// otherwise keep the CPU busy until t=42.
+static int build_starvation_workload(process_t *processes) {
+    int count = 0;
+    processes[count++] = make_process(100, "Batch", 0, 2, 10);
+    for (int t = 0; t <= 40; t += 2) {
+        processes[count] = make_process(count, "Interactive", t, 2, 1);
+        count++;
+    }
+    return count;
+}
+
+static void test_priority_aging(void) {
+    process_t processes[32];
+    int count = build_starvation_workload(processes);
+
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_PRIORITY_NP;
+
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+
+    assert(schedule_processes_with_config(processes, count, &config, &timeline, &timeline_count, &metrics) == 0);
+    assert(processes[0].completion_time == 44);
+    free(timeline);
+
+    config.aging_interval = 2;
+    assert(schedule_processes_with_config(processes, count, &config, &timeline, &timeline_count, &metrics) == 0);
+    assert(processes[0].completion_time == 20);
+    assert(processes[0].waiting_time == 18);
+    free(timeline);
+
+    // Once dispatched the batch job holds its aged level, so the interactive
+    // job arriving at the same level does not take the CPU back.
+    config.algorithm = ALGO_PRIORITY_P;
+    assert(schedule_processes_with_config(processes, count, &config, &timeline, &timeline_count, &metrics) == 0);
+    assert(processes[0].first_run_time == 18);
+    assert(processes[0].completion_time == 20);
+    free(timeline);
+}
+
+// Two equal jobs under preemptive aging hand the CPU over only when the
+// waiting one reaches a strictly better level than the runner was dispatched
+// at, not on every tick.
+static void test_priority_aging_does_not_thrash(void) {
+    process_t processes[2];
+    processes[0] = make_process(1, "A", 0, 1000, 5);
+    processes[1] = make_process(2, "B", 0, 1000, 5);
+
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_PRIORITY_P;
+    config.aging_interval = 100;
+
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics = {0};
+    assert(schedule_processes_with_config(processes, 2, &config, &timeline, &timeline_count, &metrics) == 0);
+    assert(metrics.context_switches == 6);
+    assert(timeline[1].start_time == 100 && timeline[2].start_time == 300 && timeline[3].start_time == 600);
+    assert(processes[1].completion_time == 1900);
+    assert(processes[0].completion_time == 2000);
+    free(timeline);
+}
+
+// Priorities outside 1-10 take the heap fallback; shifting every priority by
+// the same amount must not change the schedule.
+static void test_priority_wide_range_matches_buckets(void) {
+    for (int algo = ALGO_PRIORITY_NP; algo <= ALGO_PRIORITY_P; algo++) {
+        process_t bucketed[24];
+        process_t wide[24];
+        for (int i = 0; i < 24; i++) {
+            bucketed[i] = make_process(i + 1, "P", (i * 5) % 17, 1 + (i * 7) % 6, 1 + (i * 3) % 10);
+            wide[i] = bucketed[i];
+            wide[i].priority += 40;
+        }
+
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+
+        timeline_event_t *bucket_timeline = NULL;
+        timeline_event_t *wide_timeline = NULL;
+        int bucket_count = 0;
+        int wide_count = 0;
+        metrics_t metrics = {0};
+        assert(schedule_processes_with_config(bucketed, 24, &config, &bucket_timeline, &bucket_count, &metrics) == 0);
+        assert(schedule_processes_with_config(wide, 24, &config, &wide_timeline, &wide_count, &metrics) == 0);
+
+        assert(bucket_count == wide_count);
+        for (int i = 0; i < bucket_count; i++) {
+            assert(bucket_timeline[i].process_id == wide_timeline[i].process_id);
+            assert(bucket_timeline[i].start_time == wide_timeline[i].start_time);
+            assert(bucket_timeline[i].end_time == wide_timeline[i].end_time);
+        }
+        for (int i = 0; i < 24; i++) {
+            assert(bucketed[i].completion_time == wide[i].completion_time);
+        }
+        free(bucket_timeline);
+        free(wide_timeline);
+    }
+}
+
+static void test_metrics_only_matches_full_run(void) {
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        process_t full[30];
+        process_t fast[30];
+        for (int i = 0; i < 30; i++) {
+            full[i] = make_process(i + 1, "P", (i * 11) % 40, (i % 9 == 0) ? 0 : 1 + (i * 7) % 8, 1 + (i * 3) % 10);
+            fast[i] = full[i];
+        }
+
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 2;
+        config.switch_cost = 1;
+        config.cache_refill_penalty = 2;
+        config.cache_refill_window = 6;
+
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t expected = {0};
+        metrics_t metrics = {0};
+        assert(schedule_processes_with_config(full, 30, &config, &timeline, &timeline_count, &expected) == 0);
+        assert(schedule_processes_metrics_only(fast, 30, &config, &metrics) == 0);
+
+        assert(metrics.context_switches == expected.context_switches);
+        assert(metrics.overhead_time == expected.overhead_time);
+        assert(metrics.total_time == expected.total_time);
+        assert(metrics.avg_waiting_time == expected.avg_waiting_time);
+        assert(metrics.avg_response_time == expected.avg_response_time);
+        assert(metrics.cpu_utilization == expected.cpu_utilization);
+        assert(metrics.turnaround_stats.p95 == expected.turnaround_stats.p95);
+        for (int i = 0; i < 30; i++) {
+            assert(fast[i].completion_time == full[i].completion_time);
+        }
+        free(timeline);
+    }
+
+    process_t p = make_process(1, "P1", 0, 3, 1);
+    schedule_config_t config = {0};
+    assert(schedule_processes_metrics_only(&p, 1, &config, NULL) != 0);
+}
+
+static void test_const_workload_matches_mutable_api(void) {
+    process_t shared[20];
+    for (int i = 0; i < 20; i++) {
+        shared[i] = make_process(i + 1, "P", (i * 7) % 23, (i % 6 == 0) ? 0 : 1 + (i * 5) % 9, 1 + (i * 3) % 10);
+    }
+    // Inputs the scheduler clamps are read in place, never rewritten.
+    shared[3].arrival_time = -5;
+    shared[8].burst_time = -2;
+    shared[11].priority = 0;
+    const process_t *workload = shared;
+    process_t snapshot[20];
+    memcpy(snapshot, shared, sizeof(shared));
+
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 3;
+        config.switch_cost = 1;
+
+        process_t mutable_copy[20];
+        memcpy(mutable_copy, snapshot, sizeof(snapshot));
+        timeline_event_t *expected = NULL;
+        int expected_count = 0;
+        metrics_t expected_metrics = {0};
+        assert(schedule_processes_with_config(mutable_copy, 20, &config, &expected, &expected_count, &expected_metrics) == 0);
+
+        process_result_t results[20];
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t metrics = {0};
+        assert(schedule_workload(workload, 20, &config, results, &timeline, &timeline_count, &metrics) == 0);
+        assert(memcmp(shared, snapshot, sizeof(shared)) == 0);
+
+        assert(timeline_count == expected_count);
+        assert(memcmp(timeline, expected, (size_t)timeline_count * sizeof(timeline_event_t)) == 0);
+        assert(metrics.avg_waiting_time == expected_metrics.avg_waiting_time);
+        for (int i = 0; i < 20; i++) {
+            assert(results[i].completion_time == mutable_copy[i].completion_time);
+            assert(results[i].waiting_time == mutable_copy[i].waiting_time);
+            assert(results[i].response_time == mutable_copy[i].response_time);
+        }
+
+        metrics_t fast = {0};
+        assert(schedule_workload(workload, 20, &config, NULL, NULL, NULL, &fast) == 0);
+        assert(fast.context_switches == expected_metrics.context_switches);
+        free(timeline);
+        free(expected);
+    }
+}
+
+static void test_stats_counters(void) {
+    for (int algo = ALGO_FCFS; algo <= ALGO_PRIORITY_P; algo++) {
+        process_t plain[30];
+        process_t counted[30];
+        for (int i = 0; i < 30; i++) {
+            // Two busy stretches with an idle gap between them.
+            plain[i] = make_process(i + 1, "P", (i * 11) % 40 + ((i >= 15) ? 300 : 0), 1 + (i * 7) % 8, 1 + (i * 3) % 10);
+            counted[i] = plain[i];
+        }
+
+        schedule_config_t config = {0};
+        config.algorithm = (algorithm_type_t)algo;
+        config.time_quantum = 2;
+        config.switch_cost = 1;
+
+        timeline_event_t *expected = NULL;
+        int expected_count = 0;
+        metrics_t expected_metrics = {0};
+        assert(schedule_processes_with_config(plain, 30, &config, &expected, &expected_count, &expected_metrics) == 0);
+
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t metrics = {0};
+        sched_stats_t stats;
+        assert(schedule_processes_with_stats(counted, 30, &config, &timeline, &timeline_count, &metrics, &stats) == 0);
+        assert(timeline_count == expected_count);
+        assert(memcmp(timeline, expected, (size_t)timeline_count * sizeof(timeline_event_t)) == 0);
+        assert(metrics.avg_waiting_time == expected_metrics.avg_waiting_time);
+
+        if (!stats.enabled) {
+            assert(stats.segments_added == 0 && stats.allocations == 0 && stats.phase_seconds[SCHED_PHASE_SIMULATE] == 0.0);
+            free(timeline);
+            free(expected);
+            continue;
+        }
+
+        // Every timeline entry was a new segment; the rest extended one.
+        assert(stats.segments_added == timeline_count);
+        assert(stats.idle_jumps >= 1);
+        assert(stats.allocations >= 2);
+        assert(stats.queue_pushes == stats.queue_pops);
+        if (algo == ALGO_SJF || algo == ALGO_SRTF) {
+            assert(stats.selection_scans > 0);
+            assert(stats.selection_visits == stats.selection_scans * 30);
+            assert(stats.selection_comparisons >= 30);
+            assert(stats.next_arrival_scans >= stats.idle_jumps);
+            assert(stats.queue_pushes == 0);
+        } else {
+            assert(stats.selection_scans == 0 && stats.next_arrival_scans == 0);
+        }
+        if (algo == ALGO_FCFS || algo == ALGO_SJF) {
+            assert(stats.segments_merged == 0);
+        } else {
+            assert(stats.queue_pushes >= 30 || algo == ALGO_SRTF);
+        }
+        for (int phase = 0; phase < SCHED_PHASE_COUNT; phase++) {
+            assert(stats.phase_seconds[phase] >= 0.0);
+        }
+
+        // Metrics-only runs count too, without the timeline allocations.
+        sched_stats_t fast;
+        assert(schedule_processes_with_stats(counted, 30, &config, NULL, NULL, &metrics, &fast) == 0);
+        assert(fast.segments_added + fast.segments_merged == stats.segments_added + stats.segments_merged);
+        assert(fast.allocations == stats.allocations - 2);
+        assert(fast.reallocations <= stats.reallocations);
+        free(timeline);
+        free(expected);
+    }
+
+    // A lone process keeps the CPU over several quanta: one segment, extended.
+    process_t p = make_process(1, "P1", 0, 7, 1);
+    schedule_config_t config = {0};
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 2;
+    metrics_t metrics = {0};
+    sched_stats_t stats;
+    assert(schedule_processes_with_stats(&p, 1, &config, NULL, NULL, &metrics, &stats) == 0);
+    assert(!stats.enabled || (stats.segments_added == 1 && stats.segments_merged == 3 && stats.queue_pops == 4));
+    assert(schedule_processes_with_stats(&p, 1, &config, NULL, NULL, &metrics, NULL) != 0);
+}
+
+static void test_algorithm_names(void) {
+    for (int a = ALGO_FCFS; a <= ALGO_PRIORITY_P; a++) {
+        algorithm_type_t parsed = ALGO_FCFS;
+        assert(sched_algorithm_from_name(sched_algorithm_name((algorithm_type_t)a), &parsed) == 0);
+        assert(parsed == (algorithm_type_t)a);
+    }
+    algorithm_type_t parsed = ALGO_FCFS;
+    assert(sched_algorithm_from_name("PRIORITY_NP", &parsed) != 0);
+    assert(sched_algorithm_from_name("priority", &parsed) != 0);
+    assert(sched_algorithm_from_name("rrr", &parsed) != 0);
+    assert(sched_algorithm_name((algorithm_type_t)6) == NULL);
+}
+
 int main(void) {
     test_fcfs();
     test_sjf();
@@ -151,6 +533,16 @@ int main(void) {
     test_round_robin();
     test_priority_np();
     test_priority_p();
+    test_round_robin_switch_cost();
+    test_cache_refill_penalty();
+    test_fused_metrics_match_recomputed();
+    test_priority_aging();
+    test_priority_aging_does_not_thrash();
+    test_priority_wide_range_matches_buckets();
+    test_metrics_only_matches_full_run();
+    test_const_workload_matches_mutable_api();
+    test_stats_counters();
+    test_algorithm_names();
 
     printf("All scheduler tests passed.\n");
     return 0;
@@ -0,0 +1,209 @@
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/timeline_codec.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 400
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "worker-%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+// Bursty arrivals leave idle gaps between busy stretches.
+static void build_timeline(algorithm_type_t algorithm, int switch_cost, timeline_event_t **timeline, int *timeline_count) {
+    process_t processes[WORKLOAD_SIZE];
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        processes[i] = make_process(i + 1, (i / 40) * 900 + (i * 17) % 60, 1 + (i * 7) % 23, 1 + (i * 3) % 10);
+    }
+
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = 3;
+    config.switch_cost = switch_cost;
+
+    metrics_t metrics;
+    assert(schedule_processes_with_config(processes, WORKLOAD_SIZE, &config, timeline, timeline_count, &metrics) == 0);
+}
+
+static bool same_event(const timeline_event_t *lhs, const timeline_event_t *rhs) {
+    return lhs->process_id == rhs->process_id && strcmp(lhs->process_name, rhs->process_name) == 0 &&
+           lhs->start_time == rhs->start_time && lhs->end_time == rhs->end_time;
+}
+
+static void test_round_trip_all_policies(void) {
+    for (int algorithm = ALGO_FCFS; algorithm <= ALGO_PRIORITY_P; algorithm++) {
+        for (int switch_cost = 0; switch_cost <= 2; switch_cost += 2) {
+            timeline_event_t *timeline = NULL;
+            int timeline_count = 0;
+            build_timeline((algorithm_type_t)algorithm, switch_cost, &timeline, &timeline_count);
+
+            uint8_t *bytes = NULL;
+            size_t size = 0;
+            assert(timeline_encode(timeline, timeline_count, &bytes, &size) == 0);
+
+            timeline_event_t *decoded = NULL;
+            int decoded_count = 0;
+            assert(timeline_decode(bytes, size, &decoded, &decoded_count) == 0);
+            assert(decoded_count == timeline_count);
+            for (int i = 0; i < timeline_count; i++) {
+                assert(same_event(&decoded[i], &timeline[i]));
+            }
+
+            // Truncation anywhere inside a block is detected.
+            timeline_event_t *partial = NULL;
+            int partial_count = 0;
+            assert(timeline_decode(bytes, size - 1, &partial, &partial_count) != 0);
+            assert(partial == NULL);
+
+            free(decoded);
+            free(bytes);
+            free(timeline);
+        }
+    }
+}
+
+static void test_round_robin_compresses(void) {
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    build_timeline(ALGO_RR, 1, &timeline, &timeline_count);
+
+    uint8_t *bytes = NULL;
+    size_t size = 0;
+    assert(timeline_encode(timeline, timeline_count, &bytes, &size) == 0);
+
+    size_t raw = (size_t)timeline_count * sizeof(timeline_event_t);
+    printf("RR timeline: %d segments, %zu raw bytes, %zu encoded (%.1fx)\n",
+           timeline_count, raw, size, (double)raw / (double)size);
+    assert(raw >= 20 * size);
+
+    free(bytes);
+    free(timeline);
+}
+
+// Encoder pushes one segment at a time and drains as it goes; the decoder is
+// fed the bytes in small uneven chunks and only holds what it has not yet
+// consumed.
+static void test_streaming_and_seek(void) {
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    build_timeline(ALGO_RR, 1, &timeline, &timeline_count);
+
+    timeline_encoder_t *encoder = NULL;
+    timeline_decoder_t *decoder = NULL;
+    assert(timeline_encoder_create(&encoder) == 0);
+    assert(timeline_decoder_create(&decoder) == 0);
+
+    uint8_t *stream = NULL;
+    size_t stream_size = 0;
+    size_t max_buffered = 0;
+    int decoded = 0;
+    for (int i = 0; i <= timeline_count; i++) {
+        if (i < timeline_count) {
+            assert(timeline_encoder_push(encoder, &timeline[i], 1) == 0);
+        } else {
+            assert(timeline_encoder_flush(encoder) == 0);
+        }
+
+        uint8_t *bytes = NULL;
+        size_t size = 0;
+        assert(timeline_encoder_drain(encoder, &bytes, &size) == 0);
+        if (size > 0) {
+            stream = (uint8_t *)realloc(stream, stream_size + size);
+            assert(stream != NULL);
+            memcpy(stream + stream_size, bytes, size);
+            stream_size += size;
+        }
+        for (size_t offset = 0; offset < size; offset += 7) {
+            size_t chunk = (size - offset < 7) ? size - offset : 7;
+            assert(timeline_decoder_feed(decoder, bytes + offset, chunk) == 0);
+            if (timeline_decoder_buffered(decoder) > max_buffered) {
+                max_buffered = timeline_decoder_buffered(decoder);
+            }
+
+            timeline_event_t event;
+            bool has_event = true;
+            while (has_event) {
+                assert(timeline_decoder_next(decoder, &event, &has_event) == 0);
+                if (has_event) {
+                    assert(same_event(&event, &timeline[decoded]));
+                    decoded++;
+                }
+            }
+        }
+        free(bytes);
+    }
+    assert(decoded == timeline_count);
+    assert(stream_size > 8 * max_buffered);
+
+    // Out-of-order input is rejected.
+    timeline_event_t early = timeline[0];
+    assert(timeline_encoder_push(encoder, &early, 1) != 0);
+
+    int horizon = timeline[timeline_count - 1].end_time;
+    for (int time = -10; time <= horizon + 10; time += 97) {
+        // Rewinding past the buffered tail asks for the block to be fed again.
+        size_t resume = 0;
+        assert(timeline_decoder_seek(decoder, time, &resume) == 0);
+        assert(resume <= stream_size);
+        assert(timeline_decoder_feed(decoder, stream + resume, stream_size - resume) == 0);
+
+        int expected = 0;
+        while (expected < timeline_count && timeline[expected].end_time <= time) {
+            expected++;
+        }
+        timeline_event_t event;
+        bool has_event = false;
+        for (int i = 0; i < 3; i++) {
+            assert(timeline_decoder_next(decoder, &event, &has_event) == 0);
+            assert(has_event == (expected < timeline_count));
+            if (has_event) {
+                assert(same_event(&event, &timeline[expected]));
+                expected++;
+            }
+        }
+    }
+
+    timeline_encoder_destroy(encoder);
+    timeline_decoder_destroy(decoder);
+    free(stream);
+    free(timeline);
+}
+
+static void test_rejects_malformed_input(void) {
+    const uint8_t wrong_magic[] = {'T', 'L', 'X', '2', 1, 0, 0, 0, 0};
+    timeline_event_t *decoded = NULL;
+    int decoded_count = 0;
+    assert(timeline_decode(wrong_magic, sizeof(wrong_magic), &decoded, &decoded_count) != 0);
+
+    // One segment whose record names a slot the block never defined.
+    const uint8_t bad_slot[] = {'T', 'L', 'C', '2', 1, 0, 0, 4, 2, 2, 0};
+    assert(timeline_decode(bad_slot, sizeof(bad_slot), &decoded, &decoded_count) != 0);
+
+    uint8_t *bytes = NULL;
+    size_t size = 0;
+    assert(timeline_encode(NULL, 0, &bytes, &size) == 0);
+    assert(timeline_decode(bytes, size, &decoded, &decoded_count) == 0);
+    assert(decoded == NULL && decoded_count == 0);
+    free(bytes);
+}
+
+int main(void) {
+    test_round_trip_all_policies();
+    test_round_robin_compresses();
+    test_streaming_and_seek();
+    test_rejects_malformed_input();
+
+    printf("Timeline codec tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/timeline_index.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 60
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "P%d", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+// RR with switch overhead and idle gaps: many short segments.
+static void build_timeline(timeline_event_t **timeline, int *timeline_count) {
+    process_t processes[WORKLOAD_SIZE];
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        processes[i] = make_process(i + 1, (i * 13) % 200 + (i / 20) * 150, 1 + (i * 7) % 9, 1);
+    }
+
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = ALGO_RR;
+    config.time_quantum = 2;
+    config.switch_cost = 1;
+
+    metrics_t metrics;
+    assert(schedule_processes_with_config(processes, WORKLOAD_SIZE, &config, timeline, timeline_count, &metrics) == 0);
+    assert(*timeline_count > WORKLOAD_SIZE);
+}
+
+static void test_query_matches_scan(void) {
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    build_timeline(&timeline, &timeline_count);
+
+    timeline_index_t *index = NULL;
+    assert(timeline_index_build(timeline, timeline_count, &index) == 0);
+
+    int horizon = timeline[timeline_count - 1].end_time;
+    for (int start = -5; start <= horizon + 5; start += 3) {
+        for (int width = 1; width <= 43; width += 7) {
+            const timeline_event_t *first = NULL;
+            int count = -1;
+            assert(timeline_index_query(index, start, start + width, &first, &count) == 0);
+
+            int expected = 0;
+            for (int i = 0; i < timeline_count; i++) {
+                if (timeline[i].start_time < start + width && timeline[i].end_time > start) {
+                    assert(&first[expected] == &timeline[i]);
+                    expected++;
+                }
+            }
+            assert(count == expected);
+        }
+    }
+
+    const timeline_event_t *first = NULL;
+    int count = 0;
+    assert(timeline_index_query(index, 10, 5, &first, &count) != 0);
+
+    timeline_index_destroy(index);
+    free(timeline);
+}
+
+// Exact summary of [from, to) straight from the segments.
+static timeline_bucket_t scan_bucket(const timeline_event_t *timeline, int timeline_count, int from, int to) {
+    timeline_bucket_t bucket;
+    bucket.process_id = TIMELINE_INDEX_IDLE_ID;
+    bucket.busy_fraction = 0.0;
+
+    int busy = 0;
+    int best_time = 0;
+    for (int i = 0; i < timeline_count; i++) {
+        int id = timeline[i].process_id;
+        int time = 0;
+        for (int j = 0; j < timeline_count && id != TIMELINE_OVERHEAD_PROCESS_ID; j++) {
+            if (timeline[j].process_id != id) {
+                continue;
+            }
+            int lo = (timeline[j].start_time > from) ? timeline[j].start_time : from;
+            int hi = (timeline[j].end_time < to) ? timeline[j].end_time : to;
+            time += (hi > lo) ? hi - lo : 0;
+        }
+        if (time > best_time || (time == best_time && time > 0 && id < bucket.process_id)) {
+            bucket.process_id = id;
+            best_time = time;
+        }
+
+        int lo = (timeline[i].start_time > from) ? timeline[i].start_time : from;
+        int hi = (timeline[i].end_time < to) ? timeline[i].end_time : to;
+        busy += (hi > lo) ? hi - lo : 0;
+    }
+    bucket.busy_fraction = (double)busy / (to - from);
+    return bucket;
+}
+
+static void test_summary_matches_scan(void) {
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    build_timeline(&timeline, &timeline_count);
+
+    timeline_index_t *index = NULL;
+    assert(timeline_index_build(timeline, timeline_count, &index) == 0);
+
+    int origin = timeline[0].start_time;
+    int horizon = timeline[timeline_count - 1].end_time;
+
+    // Pixels that line up with a level's buckets are summarised exactly.
+    // Level 0 buckets are span / segment-count wide and each level doubles.
+    int level_width = (horizon - origin) / timeline_count;
+    if (level_width < 1) {
+        level_width = 1;
+    }
+    for (; level_width < 2 * (horizon - origin); level_width *= 2) {
+        int pixels = (horizon - origin + level_width - 1) / level_width;
+        timeline_bucket_t *buckets = (timeline_bucket_t *)malloc((size_t)pixels * sizeof(timeline_bucket_t));
+        assert(buckets != NULL);
+        assert(timeline_index_summarize(index, origin, origin + pixels * level_width, pixels, buckets) == 0);
+
+        for (int p = 0; p < pixels; p++) {
+            int from = origin + p * level_width;
+            timeline_bucket_t expected = scan_bucket(timeline, timeline_count, from, from + level_width);
+            assert(buckets[p].process_id == expected.process_id);
+            assert(fabs(buckets[p].busy_fraction - expected.busy_fraction) < 1e-9);
+        }
+        free(buckets);
+    }
+
+    // Arbitrary viewports stay close on busy time and never leave [0, 1].
+    timeline_bucket_t buckets[37];
+    assert(timeline_index_summarize(index, origin - 7, horizon + 11, 37, buckets) == 0);
+    double pixel = (double)(horizon + 11 - (origin - 7)) / 37;
+    double total = 0.0;
+    for (int p = 0; p < 37; p++) {
+        assert(buckets[p].busy_fraction >= 0.0 && buckets[p].busy_fraction <= 1.0 + 1e-9);
+        total += buckets[p].busy_fraction * pixel;
+    }
+    timeline_bucket_t whole = scan_bucket(timeline, timeline_count, origin, horizon);
+    assert(fabs(total - whole.busy_fraction * (horizon - origin)) < 1e-6);
+    assert(timeline_index_summarize(index, 5, 5, 4, buckets) != 0);
+
+    timeline_index_destroy(index);
+    free(timeline);
+}
+
+static void test_rejects_unordered_and_handles_empty(void) {
+    timeline_event_t timeline[2];
+    memset(timeline, 0, sizeof(timeline));
+    timeline[0].process_id = 1;
+    timeline[0].start_time = 0;
+    timeline[0].end_time = 5;
+    timeline[1].process_id = 2;
+    timeline[1].start_time = 4;
+    timeline[1].end_time = 8;
+
+    timeline_index_t *index = NULL;
+    assert(timeline_index_build(timeline, 2, &index) != 0);
+    assert(index == NULL);
+
+    assert(timeline_index_build(NULL, 0, &index) == 0);
+    const timeline_event_t *first = NULL;
+    int count = -1;
+    assert(timeline_index_query(index, 0, 100, &first, &count) == 0);
+    assert(count == 0);
+    timeline_bucket_t bucket;
+    assert(timeline_index_summarize(index, 0, 100, 1, &bucket) == 0);
+    assert(bucket.process_id == TIMELINE_INDEX_IDLE_ID);
+    assert(bucket.busy_fraction == 0.0);
+    timeline_index_destroy(index);
+}
+
+// Switches that cost more than the slices around them: the overhead fills
+// most of the bucket but the bucket still reports a process.
+static void test_overhead_is_never_dominant(void) {
+    const int ids[] = {1, TIMELINE_OVERHEAD_PROCESS_ID, 2, TIMELINE_OVERHEAD_PROCESS_ID, 1,
+                       TIMELINE_OVERHEAD_PROCESS_ID, TIMELINE_OVERHEAD_PROCESS_ID};
+    const int starts[] = {0, 1, 4, 5, 8, 10, 13};
+    const int ends[] = {1, 4, 5, 8, 10, 13, 16};
+    timeline_event_t timeline[7];
+    memset(timeline, 0, sizeof(timeline));
+    for (int i = 0; i < 7; i++) {
+        timeline[i].process_id = ids[i];
+        timeline[i].start_time = starts[i];
+        timeline[i].end_time = ends[i];
+    }
+
+    timeline_index_t *index = NULL;
+    assert(timeline_index_build(timeline, 7, &index) == 0);
+    timeline_bucket_t buckets[2];
+    assert(timeline_index_summarize(index, 0, 16, 2, buckets) == 0);
+    // [0, 8): P1 1, P2 1, overhead 6. [8, 16): P1 2, overhead 6.
+    assert(buckets[0].process_id == 1);
+    assert(fabs(buckets[0].busy_fraction - 1.0) < 1e-9);
+    assert(buckets[1].process_id == 1);
+
+    // A bucket with nothing but overhead is busy but has no process.
+    timeline_bucket_t fine[8];
+    assert(timeline_index_summarize(index, 0, 16, 8, fine) == 0);
+    assert(fine[7].process_id == TIMELINE_INDEX_IDLE_ID);
+    assert(fabs(fine[7].busy_fraction - 1.0) < 1e-9);
+    timeline_index_destroy(index);
+}
+
+int main(void) {
+    test_query_matches_scan();
+    test_summary_matches_scan();
+    test_overhead_is_never_dominant();
+    test_rejects_unordered_and_handles_empty();
+
+    printf("Timeline index tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,372 @@
+#include "../Sources/Core/online_scheduler.h"
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/trace_export.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORKLOAD_SIZE 300
+#define MAX_SAMPLES 4096
+
+typedef struct {
+    int time;
+    int length;
+} sample_t;
+
+typedef struct {
+    process_t processes[WORKLOAD_SIZE];
+    timeline_event_t *timeline;
+    int timeline_count;
+} run_t;
+
+static process_t make_process(int id, int arrival, int burst, int priority) {
+    process_t p;
+    memset(&p, 0, sizeof(p));
+    p.process_id = id;
+    snprintf(p.name, sizeof(p.name), "job \"%d\"", id);
+    p.arrival_time = arrival;
+    p.burst_time = burst;
+    p.priority = priority;
+    return p;
+}
+
+static void build_run(algorithm_type_t algorithm, int switch_cost, run_t *run) {
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        run->processes[i] = make_process(i + 1, (i / 30) * 200 + (i * 13) % 40, 1 + (i * 7) % 11, 1 + (i * 3) % 10);
+    }
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = algorithm;
+    config.time_quantum = 3;
+    config.switch_cost = switch_cost;
+    metrics_t metrics;
+    assert(schedule_processes_with_config(run->processes, WORKLOAD_SIZE, &config, &run->timeline, &run->timeline_count,
+                                          &metrics) == 0);
+}
+
+static char *read_all(FILE *file, size_t *size) {
+    assert(fseek(file, 0, SEEK_END) == 0);
+    long length = ftell(file);
+    assert(length > 0);
+    rewind(file);
+    char *bytes = (char *)malloc((size_t)length + 1);
+    assert(bytes != NULL);
+    assert(fread(bytes, 1, (size_t)length, file) == (size_t)length);
+    bytes[length] = '\0';
+    *size = (size_t)length;
+    return bytes;
+}
+
+static int count_of(const char *text, const char *needle) {
+    int count = 0;
+    for (const char *p = strstr(text, needle); p; p = strstr(p + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+// Ready-queue samples of a Chrome JSON trace with 1000 ns ticks (ts is then
+// the tick count).
+static int json_samples(const char *text, sample_t *samples) {
+    int count = 0;
+    for (const char *p = strstr(text, "\"ph\":\"C\""); p; p = strstr(p + 1, "\"ph\":\"C\"")) {
+        assert(count < MAX_SAMPLES);
+        samples[count].time = (int)strtod(strstr(p, "\"ts\":") + 5, NULL);
+        samples[count].length = atoi(strstr(p, "\"length\":") + 9);
+        count++;
+    }
+    return count;
+}
+
+static uint64_t read_varint(const uint8_t **cursor) {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte = *(*cursor)++;
+        value |= (uint64_t)(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0) {
+            return value;
+        }
+    }
+}
+
+// Walks a message, reporting varint fields and length-delimited ones.
+typedef struct {
+    int field;
+    int wire;
+    uint64_t value;
+    const uint8_t *bytes;
+    size_t size;
+} pb_field_t;
+
+static bool next_field(const uint8_t **cursor, const uint8_t *end, pb_field_t *field) {
+    if (*cursor >= end) {
+        return false;
+    }
+    uint64_t key = read_varint(cursor);
+    field->field = (int)(key >> 3);
+    field->wire = (int)(key & 7u);
+    assert(field->wire == 0 || field->wire == 2);
+    field->value = read_varint(cursor);
+    if (field->wire == 2) {
+        field->bytes = *cursor;
+        field->size = (size_t)field->value;
+        *cursor += field->size;
+        assert(*cursor <= end);
+    }
+    return true;
+}
+
+typedef struct {
+    int packets;
+    int descriptors;
+    int slice_begins;
+    int slice_ends;
+    int instants;
+    sample_t samples[MAX_SAMPLES];
+    int sample_count;
+} perfetto_summary_t;
+
+static void summarize_perfetto(const uint8_t *bytes, size_t size, perfetto_summary_t *summary) {
+    memset(summary, 0, sizeof(*summary));
+    const uint8_t *cursor = bytes;
+    pb_field_t packet;
+    while (next_field(&cursor, bytes + size, &packet)) {
+        assert(packet.field == 1 && packet.wire == 2);
+        summary->packets++;
+        uint64_t timestamp = 0;
+        bool has_sequence = false;
+        const uint8_t *inner = packet.bytes;
+        pb_field_t field;
+        while (next_field(&inner, packet.bytes + packet.size, &field)) {
+            if (field.field == 8) {
+                timestamp = field.value;
+            } else if (field.field == 10) {
+                has_sequence = field.value == 1;
+            } else if (field.field == 60) {
+                summary->descriptors++;
+            } else if (field.field == 11) {
+                const uint8_t *event_cursor = field.bytes;
+                pb_field_t event;
+                int type = 0;
+                int64_t counter = -1;
+                while (next_field(&event_cursor, field.bytes + field.size, &event)) {
+                    if (event.field == 9) {
+                        type = (int)event.value;
+                    } else if (event.field == 30) {
+                        counter = (int64_t)event.value;
+                    }
+                }
+                summary->slice_begins += type == 1;
+                summary->slice_ends += type == 2;
+                summary->instants += type == 3;
+                if (type == 4) {
+                    assert(summary->sample_count < MAX_SAMPLES);
+                    summary->samples[summary->sample_count].time = (int)(timestamp / 1000);
+                    summary->samples[summary->sample_count].length = (int)counter;
+                    summary->sample_count++;
+                }
+            }
+        }
+        assert(has_sequence);
+    }
+}
+
+static int ready_at(const run_t *run, int time) {
+    int ready = 0;
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        const process_t *process = &run->processes[i];
+        if (process->arrival_time > time || process->completion_time <= time) {
+            continue;
+        }
+        bool running = false;
+        for (int s = 0; s < run->timeline_count && !running; s++) {
+            const timeline_event_t *segment = &run->timeline[s];
+            running = segment->process_id == process->process_id && segment->start_time <= time &&
+                      time < segment->end_time;
+        }
+        ready += running ? 0 : 1;
+    }
+    return ready;
+}
+
+// Samples mark every change and only changes.
+static void check_samples(const run_t *run, const sample_t *samples, int sample_count) {
+    assert(sample_count > 0);
+    int end = run->timeline[run->timeline_count - 1].end_time;
+    int next = 0;
+    int value = 0;
+    for (int time = 0; time <= end; time++) {
+        while (next < sample_count && samples[next].time <= time) {
+            assert(next == 0 || samples[next].time > samples[next - 1].time);
+            assert(next == 0 || samples[next].length != samples[next - 1].length);
+            value = samples[next++].length;
+        }
+        assert(value == ready_at(run, time));
+    }
+    assert(next == sample_count);
+}
+
+static void test_chrome_json(void) {
+    run_t run;
+    build_run(ALGO_RR, 1, &run);
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(trace_export_schedule(run.processes, WORKLOAD_SIZE, run.timeline, run.timeline_count, NULL, file) == 0);
+    size_t size = 0;
+    char *text = read_all(file, &size);
+    fclose(file);
+
+    assert(strncmp(text, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39) == 0);
+    assert(strcmp(text + size - 4, "\n]}\n") == 0);
+    int overhead = 0;
+    for (int i = 0; i < run.timeline_count; i++) {
+        overhead += run.timeline[i].process_id == TIMELINE_OVERHEAD_PROCESS_ID;
+    }
+    assert(overhead > 0);
+    // Every segment on the CPU track, process segments on their own too.
+    assert(count_of(text, "\"ph\":\"X\"") == 2 * run.timeline_count - overhead);
+    assert(count_of(text, "\"name\":\"" TIMELINE_OVERHEAD_NAME "\"") == overhead);
+    assert(count_of(text, "\"name\":\"arrival\"") == WORKLOAD_SIZE);
+    assert(count_of(text, "\"name\":\"completion\"") == WORKLOAD_SIZE);
+    assert(count_of(text, "\"name\":\"thread_name\"") == WORKLOAD_SIZE + 1);
+    assert(strstr(text, "\"args\":{\"name\":\"job \\\"7\\\"\"}") != NULL);
+
+    sample_t samples[MAX_SAMPLES];
+    check_samples(&run, samples, json_samples(text, samples));
+    free(text);
+    free(run.timeline);
+}
+
+static void test_perfetto(void) {
+    run_t run;
+    build_run(ALGO_SRTF, 0, &run);
+    trace_export_config_t config;
+    trace_export_config_default(&config);
+    config.format = TRACE_EXPORT_PERFETTO;
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(trace_export_schedule(run.processes, WORKLOAD_SIZE, run.timeline, run.timeline_count, &config, file) == 0);
+    size_t size = 0;
+    char *bytes = read_all(file, &size);
+    fclose(file);
+
+    perfetto_summary_t *summary = (perfetto_summary_t *)malloc(sizeof(perfetto_summary_t));
+    assert(summary != NULL);
+    summarize_perfetto((const uint8_t *)bytes, size, summary);
+    // CPUs, Processes, the counter, CPU 0 and one track per process.
+    assert(summary->descriptors == 4 + WORKLOAD_SIZE);
+    assert(summary->slice_begins == 2 * run.timeline_count);
+    assert(summary->slice_ends == summary->slice_begins);
+    assert(summary->instants == 2 * WORKLOAD_SIZE);
+    check_samples(&run, summary->samples, summary->sample_count);
+    free(summary);
+    free(bytes);
+    free(run.timeline);
+}
+
+static int compare_arrival(const void *a, const void *b) {
+    const process_t *left = (const process_t *)a;
+    const process_t *right = (const process_t *)b;
+    if (left->arrival_time != right->arrival_time) {
+        return left->arrival_time - right->arrival_time;
+    }
+    return left->process_id - right->process_id;
+}
+
+// The online scheduler drained in chunks yields the same trace samples as
+// the one-shot export of the finished run.
+static void test_streaming_matches_one_shot(void) {
+    run_t run;
+    build_run(ALGO_PRIORITY_P, 0, &run);
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.algorithm = ALGO_PRIORITY_P;
+    online_scheduler_t *sim = NULL;
+    assert(online_scheduler_create(&config, &sim) == 0);
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    trace_exporter_t *exporter = NULL;
+    assert(trace_exporter_create(NULL, file, &exporter) == 0);
+
+    process_t *sorted = (process_t *)malloc(sizeof(run.processes));
+    assert(sorted != NULL);
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        sorted[i] = make_process(i + 1, run.processes[i].arrival_time, run.processes[i].burst_time,
+                                 run.processes[i].priority);
+    }
+    qsort(sorted, WORKLOAD_SIZE, sizeof(process_t), compare_arrival);
+
+    int drained_end = 0;
+    for (int begin = 0; begin <= WORKLOAD_SIZE; begin += 25) {
+        int clock = INT32_MAX;
+        for (int i = begin; i < begin + 25 && i < WORKLOAD_SIZE; i++) {
+            assert(trace_exporter_arrivals(exporter, &sorted[i], 1) == 0);
+            assert(online_scheduler_submit(sim, &sorted[i]) == 0);
+            clock = sorted[i].arrival_time;
+        }
+        assert(online_scheduler_advance_to(sim, clock) == 0);
+        timeline_event_t *events = NULL;
+        int event_count = 0;
+        process_t *completed = NULL;
+        int completed_count = 0;
+        assert(online_scheduler_drain_events(sim, &events, &event_count) == 0);
+        assert(online_scheduler_drain_completed(sim, &completed, &completed_count) == 0);
+        assert(trace_exporter_segments(exporter, events, event_count, 0) == 0);
+        assert(trace_exporter_completions(exporter, completed, completed_count) == 0);
+        if (event_count > 0) {
+            drained_end = events[event_count - 1].end_time;
+        }
+        assert(trace_exporter_flush(exporter, drained_end < clock ? drained_end : clock) == 0);
+        free(events);
+        free(completed);
+    }
+    assert(trace_exporter_finish(exporter) == 0);
+
+    // Nothing may land before what has been flushed.
+    process_t late = make_process(999, 0, 1, 1);
+    assert(trace_exporter_arrivals(exporter, &late, 1) != 0);
+    trace_exporter_destroy(exporter);
+    online_scheduler_destroy(sim);
+    free(sorted);
+
+    size_t size = 0;
+    char *text = read_all(file, &size);
+    fclose(file);
+    sample_t samples[MAX_SAMPLES];
+    check_samples(&run, samples, json_samples(text, samples));
+    free(text);
+    free(run.timeline);
+}
+
+static void test_invalid_arguments(void) {
+    trace_exporter_t *exporter = NULL;
+    trace_export_config_t config;
+    trace_export_config_default(&config);
+    config.time_unit_ns = 0;
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(trace_exporter_create(&config, file, &exporter) != 0);
+    assert(trace_exporter_create(NULL, NULL, &exporter) != 0);
+    assert(trace_exporter_create(NULL, file, &exporter) == 0);
+    timeline_event_t segment = {.process_id = 1, .start_time = 5, .end_time = 3};
+    assert(trace_exporter_segments(exporter, &segment, 1, 0) != 0);
+    segment.end_time = 8;
+    assert(trace_exporter_segments(exporter, &segment, 1, TRACE_EXPORT_MAX_CPUS) != 0);
+    assert(trace_exporter_segments(exporter, &segment, 1, 3) == 0);
+    assert(trace_exporter_finish(exporter) == 0);
+    trace_exporter_destroy(exporter);
+    fclose(file);
+}
+
+int main(void) {
+    test_chrome_json();
+    test_perfetto();
+    test_streaming_matches_one_shot();
+    test_invalid_arguments();
+
+    printf("Trace export tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,275 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/trace_ingest.h"
+#include "../Sources/Core/workload_gen.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef SCHED_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define WORKLOAD_SIZE 2000
+
+static void temp_path(char *path, size_t size, const char *suffix) {
+    char base[64];
+    snprintf(base, sizeof(base), "/tmp/trace_ingest_test_XXXXXX");
+    int fd = mkstemp(base);
+    assert(fd >= 0);
+    close(fd);
+    unlink(base);
+    snprintf(path, size, "%s%s", base, suffix);
+}
+
+static void write_file(const char *path, const char *contents) {
+    FILE *file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite(contents, 1, strlen(contents), file) == strlen(contents));
+    fclose(file);
+}
+
+static int read_all(const char *path, const trace_ingest_config_t *config, process_t *rows, int capacity,
+                    trace_ingest_stats_t *stats) {
+    trace_reader_t *reader = NULL;
+    assert(trace_reader_open(path, config, &reader) == 0);
+    int total = 0;
+    for (;;) {
+        int count = 0;
+        // Uneven small batches exercise the batch boundaries.
+        int want = (capacity - total < 3) ? capacity - total : 3;
+        if (want == 0) {
+            break;
+        }
+        assert(trace_reader_next(reader, rows + total, want, &count) == 0);
+        if (count == 0) {
+            break;
+        }
+        total += count;
+    }
+    assert(trace_reader_stats(reader, stats) == 0);
+    trace_reader_close(reader);
+    return total;
+}
+
+static void test_csv_fields_quotes_and_defaults(void) {
+    char path[96];
+    temp_path(path, sizeof(path), ".csv");
+    write_file(path,
+               "queue,runtime,name,submit_time,priority\r\n"
+               "a,5,\"build, \"\"fast\"\"\",0,3\r\n"
+               "b,2.5,plain,1.49,\n"
+               "\n"
+               "c,not-a-number,bad,2,1\n"
+               "d,7, spaced ,  4 ,2\n"
+               "e,1,short\n"
+               "f,3,last,9,1");
+
+    trace_ingest_config_t config;
+    trace_ingest_config_default(&config);
+    config.buffer_size = 64;  // rows straddle buffer refills
+
+    process_t rows[8];
+    trace_ingest_stats_t stats;
+    int count = read_all(path, &config, rows, 8, &stats);
+    assert(count == 4);
+    assert(stats.rows == 4);
+    assert(stats.skipped == 2);
+
+    assert(rows[0].process_id == 1 && rows[0].arrival_time == 0 && rows[0].burst_time == 5);
+    assert(rows[0].priority == 3);
+    assert(strcmp(rows[0].name, "build, \"fast\"") == 0);
+
+    assert(rows[1].arrival_time == 1 && rows[1].burst_time == 3);  // 1.49 -> 1, 2.5 -> 3
+    assert(rows[1].priority == 1);                                 // empty -> default
+    assert(strcmp(rows[1].name, "plain") == 0);
+
+    assert(rows[2].process_id == 3 && rows[2].arrival_time == 4 && strcmp(rows[2].name, "spaced") == 0);
+    assert(rows[3].arrival_time == 9 && rows[3].first_run_time == -1);
+
+    // Required columns missing from the header.
+    write_file(path, "queue,runtime,name\nq,1,x\n");
+    trace_reader_t *reader = NULL;
+    assert(trace_reader_open(path, &config, &reader) != 0);
+    assert(reader == NULL);
+
+    // A row that cannot fit in the buffer is an error, not a silent skip.
+    char long_row[512];
+    memset(long_row, 'x', sizeof(long_row));
+    memcpy(long_row, "submit_time,runtime,name\n0,1,", 29);
+    long_row[sizeof(long_row) - 1] = '\0';
+    write_file(path, long_row);
+    assert(trace_reader_open(path, &config, &reader) == 0);
+    int got = 0;
+    assert(trace_reader_next(reader, rows, 8, &got) != 0);
+    trace_reader_close(reader);
+
+    remove(path);
+}
+
+static void test_jsonl_and_custom_fields(void) {
+    char path[96];
+    temp_path(path, sizeof(path), ".jsonl");
+    write_file(path,
+               "{\"job\": 41, \"ts\": 10, \"duration\": 4.4, \"tags\": {\"a\": [1, \"}\"]}, \"label\": \"x\\\"y\\u00e9\"}\n"
+               "{\"ts\": 12, \"duration\": 6, \"job\": 42, \"label\": null, \"priority\": \"5\"}\n"
+               "{\"ts\": 13}\n"
+               "not json\n"
+               "  {\"job\":43,\"ts\":15,\"duration\":1,\"priority\":2}  \n");
+
+    trace_ingest_config_t config;
+    trace_ingest_config_default(&config);
+    config.id_field = "job";
+    config.arrival_field = "ts";
+    config.burst_field = "duration";
+    config.name_field = "label";
+
+    process_t rows[8];
+    trace_ingest_stats_t stats;
+    int count = read_all(path, &config, rows, 8, &stats);
+    assert(count == 3);
+    assert(stats.skipped == 2);
+
+    assert(rows[0].process_id == 41 && rows[0].arrival_time == 10 && rows[0].burst_time == 4);
+    assert(strcmp(rows[0].name, "x\"y?") == 0);
+    assert(rows[1].process_id == 42 && rows[1].priority == 5 && strcmp(rows[1].name, "job42") == 0);
+    assert(rows[2].process_id == 43 && rows[2].arrival_time == 15 && rows[2].priority == 2);
+
+    remove(path);
+}
+
+static void write_workload_csv(FILE *out, const process_t *workload, int count) {
+    fprintf(out, "id,name,submit_time,runtime,priority\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%d,%s,%d,%d,%d\n", workload[i].process_id, workload[i].name,
+                workload[i].arrival_time, workload[i].burst_time, workload[i].priority);
+    }
+}
+
+static void check_simulation_matches_batch(const char *path, const process_t *workload) {
+    const algorithm_type_t algorithms[] = {ALGO_FCFS, ALGO_SRTF, ALGO_RR, ALGO_PRIORITY_NP};
+    for (int a = 0; a < 4; a++) {
+        schedule_config_t config;
+        memset(&config, 0, sizeof(config));
+        config.algorithm = algorithms[a];
+        config.time_quantum = 3;
+
+        process_t *copy = (process_t *)malloc(WORKLOAD_SIZE * sizeof(process_t));
+        assert(copy != NULL);
+        memcpy(copy, workload, WORKLOAD_SIZE * sizeof(process_t));
+        metrics_t expected;
+        assert(schedule_processes_metrics_only(copy, WORKLOAD_SIZE, &config, &expected) == 0);
+        free(copy);
+
+        trace_reader_t *reader = NULL;
+        assert(trace_reader_open(path, NULL, &reader) == 0);
+        metrics_t metrics;
+        trace_ingest_stats_t stats;
+        assert(trace_simulate(reader, &config, 97, &metrics, &stats) == 0);
+        trace_reader_close(reader);
+
+        assert(stats.rows == WORKLOAD_SIZE && stats.skipped == 0);
+        assert(metrics.total_time == expected.total_time);
+        assert(metrics.context_switches == expected.context_switches);
+        assert(fabs(metrics.avg_waiting_time - expected.avg_waiting_time) < 1e-9);
+        assert(fabs(metrics.avg_turnaround_time - expected.avg_turnaround_time) < 1e-9);
+        assert(fabs(metrics.avg_response_time - expected.avg_response_time) < 1e-9);
+        assert(fabs(metrics.waiting_stats.max - expected.waiting_stats.max) < 1e-9);
+    }
+}
+
+static void test_simulation_matches_batch(void) {
+    workload_gen_config_t spec;
+    workload_gen_config_default(&spec);
+    spec.seed = 5;
+    spec.arrival = WORKLOAD_ARRIVAL_MMPP;
+    process_t *workload = NULL;
+    assert(workload_generate(&spec, WORKLOAD_SIZE, &workload) == 0);
+
+    char path[96];
+    temp_path(path, sizeof(path), ".csv");
+    FILE *out = fopen(path, "w");
+    assert(out != NULL);
+    write_workload_csv(out, workload, WORKLOAD_SIZE);
+    fclose(out);
+    check_simulation_matches_batch(path, workload);
+    remove(path);
+
+#ifdef SCHED_HAVE_ZLIB
+    assert(trace_ingest_has_gzip());
+    temp_path(path, sizeof(path), ".csv.gz");
+    gzFile gz = gzopen(path, "wb");
+    assert(gz != NULL);
+    gzprintf(gz, "id,name,submit_time,runtime,priority\n");
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        gzprintf(gz, "%d,%s,%d,%d,%d\n", workload[i].process_id, workload[i].name,
+                 workload[i].arrival_time, workload[i].burst_time, workload[i].priority);
+    }
+    gzclose(gz);
+    check_simulation_matches_batch(path, workload);
+
+    // Cut the compressed file short: reading fails instead of ending early.
+    FILE *whole = fopen(path, "rb");
+    assert(whole != NULL);
+    fseek(whole, 0, SEEK_END);
+    long compressed = ftell(whole);
+    fclose(whole);
+    assert(truncate(path, compressed / 2) == 0);
+
+    trace_reader_t *reader = NULL;
+    assert(trace_reader_open(path, NULL, &reader) == 0);
+    process_t *rows = (process_t *)malloc(WORKLOAD_SIZE * sizeof(process_t));
+    assert(rows != NULL);
+    int status = 0;
+    int count = 0;
+    do {
+        status = trace_reader_next(reader, rows, WORKLOAD_SIZE, &count);
+    } while (status == 0 && count > 0);
+    assert(status != 0);
+    trace_reader_close(reader);
+    free(rows);
+    remove(path);
+#endif
+
+    free(workload);
+}
+
+static void test_late_rows_are_skipped(void) {
+    char path[96];
+    temp_path(path, sizeof(path), ".csv");
+    write_file(path,
+               "submit_time,runtime\n"
+               "-4,2\n"  // runs from 0, not late
+               "5,2\n"
+               "3,1\n"    // same batch as 5: still accepted
+               "6,1\n"
+               "1,1\n");  // behind the previous batch: skipped
+
+    trace_reader_t *reader = NULL;
+    assert(trace_reader_open(path, NULL, &reader) == 0);
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    metrics_t metrics;
+    trace_ingest_stats_t stats;
+    assert(trace_simulate(reader, &config, 3, &metrics, &stats) == 0);
+    trace_reader_close(reader);
+    assert(stats.rows == 4);
+    assert(stats.skipped == 1);
+    assert(metrics.total_time == 8);
+    remove(path);
+}
+
+int main(void) {
+    test_csv_fields_quotes_and_defaults();
+    test_jsonl_and_custom_fields();
+    test_simulation_matches_batch();
+    test_late_rows_are_skipped();
+
+    printf("Trace ingest tests passed.\n");
+    return 0;
+}
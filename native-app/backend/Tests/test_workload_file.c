@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/workload_file.h"
+#include "../Sources/Core/workload_gen.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define WORKLOAD_SIZE 3000
+
+static void temp_path(char *path, size_t size) {
+    snprintf(path, size, "/tmp/workload_file_test_XXXXXX");
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+}
+
+static void overwrite_bytes(const char *path, long offset, const void *bytes, size_t size) {
+    FILE *file = fopen(path, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, offset, SEEK_SET) == 0);
+    assert(fwrite(bytes, 1, size, file) == size);
+    fclose(file);
+}
+
+static void test_round_trip_and_schedule_from_mapping(void) {
+    workload_gen_config_t spec;
+    workload_gen_config_default(&spec);
+    spec.seed = 11;
+    spec.burst = WORKLOAD_BURST_LOGNORMAL;
+    process_t *workload = NULL;
+    assert(workload_generate(&spec, WORKLOAD_SIZE, &workload) == 0);
+    snprintf(workload[7].name, sizeof(workload[7].name), "a rather longer process name");
+    workload[8].name[0] = '\0';
+
+    char path[64];
+    temp_path(path, sizeof(path));
+
+    // Written in uneven pieces through the streaming writer.
+    workload_file_writer_t *writer = NULL;
+    assert(workload_file_writer_create(&writer) == 0);
+    for (int done = 0, step = 1; done < WORKLOAD_SIZE; step *= 3) {
+        int n = (WORKLOAD_SIZE - done < step) ? WORKLOAD_SIZE - done : step;
+        assert(workload_file_writer_add(writer, workload + done, n) == 0);
+        done += n;
+    }
+    // The writer's columns are readable before anything is written.
+    workload_columns_t built;
+    assert(workload_file_writer_columns(writer, &built) == 0);
+    assert(built.process_count == WORKLOAD_SIZE);
+    assert(built.arrivals[WORKLOAD_SIZE - 1] == workload[WORKLOAD_SIZE - 1].arrival_time);
+    char built_name[MAX_PROCESS_NAME];
+    assert(workload_columns_name(&built, 7, built_name, sizeof(built_name)) == 0);
+    assert(strcmp(built_name, workload[7].name) == 0);
+    assert(workload_file_writer_finish(writer, path) == 0);
+    workload_file_writer_destroy(writer);
+
+    workload_file_t *file = NULL;
+    assert(workload_file_open(path, &file) == 0);
+    const workload_columns_t *columns = workload_file_columns(file);
+    assert(columns->process_count == WORKLOAD_SIZE);
+    for (int i = 0; i < WORKLOAD_SIZE; i++) {
+        char name[MAX_PROCESS_NAME];
+        assert(workload_columns_name(columns, i, name, sizeof(name)) == 0);
+        assert(strcmp(name, workload[i].name) == 0);
+        assert(columns->ids[i] == workload[i].process_id);
+        assert(columns->arrivals[i] == workload[i].arrival_time);
+        assert(columns->bursts[i] == workload[i].burst_time);
+        assert(columns->priorities[i] == workload[i].priority);
+    }
+    char short_name[5];
+    assert(workload_columns_name(columns, 7, short_name, sizeof(short_name)) == 0);
+    assert(strcmp(short_name, "a ra") == 0);
+    assert(workload_columns_name(columns, WORKLOAD_SIZE, short_name, sizeof(short_name)) != 0);
+
+    const algorithm_type_t algorithms[] = {ALGO_FCFS, ALGO_RR, ALGO_PRIORITY_P};
+    for (int a = 0; a < 3; a++) {
+        schedule_config_t config;
+        memset(&config, 0, sizeof(config));
+        config.algorithm = algorithms[a];
+        config.time_quantum = 3;
+        config.switch_cost = 1;
+
+        process_result_t expected_results[WORKLOAD_SIZE];
+        timeline_event_t *expected_timeline = NULL;
+        int expected_count = 0;
+        metrics_t expected;
+        assert(schedule_workload(workload, WORKLOAD_SIZE, &config, expected_results,
+                                 &expected_timeline, &expected_count, &expected) == 0);
+
+        process_result_t results[WORKLOAD_SIZE];
+        timeline_event_t *timeline = NULL;
+        int timeline_count = 0;
+        metrics_t metrics;
+        assert(schedule_workload_columns(columns, &config, results, &timeline, &timeline_count, &metrics) == 0);
+        assert(memcmp(&metrics, &expected, sizeof(metrics)) == 0);
+        assert(memcmp(results, expected_results, sizeof(results)) == 0);
+        assert(timeline_count == expected_count);
+        for (int i = 0; i < timeline_count; i++) {
+            assert(timeline[i].process_id == expected_timeline[i].process_id);
+            assert(timeline[i].start_time == expected_timeline[i].start_time);
+            assert(timeline[i].end_time == expected_timeline[i].end_time);
+            assert(strcmp(timeline[i].process_name, expected_timeline[i].process_name) == 0);
+        }
+
+        metrics_t metrics_only;
+        assert(schedule_workload_columns(columns, &config, NULL, NULL, NULL, &metrics_only) == 0);
+        assert(memcmp(&metrics_only, &expected, sizeof(metrics_only)) == 0);
+
+        free(timeline);
+        free(expected_timeline);
+    }
+
+    workload_file_close(file);
+    remove(path);
+    free(workload);
+}
+
+static void test_rejects_damaged_files(void) {
+    process_t processes[3];
+    memset(processes, 0, sizeof(processes));
+    for (int i = 0; i < 3; i++) {
+        processes[i].process_id = i + 1;
+        snprintf(processes[i].name, sizeof(processes[i].name), "P%d", i + 1);
+        processes[i].arrival_time = i;
+        processes[i].burst_time = 2;
+        processes[i].priority = 1;
+    }
+
+    char path[64];
+    temp_path(path, sizeof(path));
+    workload_file_t *file = NULL;
+
+    assert(workload_file_write(path, processes, 3) == 0);
+    overwrite_bytes(path, 0, "XXXX", 4);
+    assert(workload_file_open(path, &file) != 0);
+    assert(file == NULL);
+
+    assert(workload_file_write(path, processes, 3) == 0);
+    uint32_t version = WORKLOAD_FILE_VERSION + 1;
+    overwrite_bytes(path, (long)offsetof(workload_file_header_t, version), &version, sizeof(version));
+    assert(workload_file_open(path, &file) != 0);
+
+    assert(workload_file_write(path, processes, 3) == 0);
+    uint64_t huge = 1ULL << 40;
+    overwrite_bytes(path, (long)offsetof(workload_file_header_t, bursts_offset), &huge, sizeof(huge));
+    assert(workload_file_open(path, &file) != 0);
+
+    // Truncation shows up as a size mismatch with the header.
+    assert(workload_file_write(path, processes, 3) == 0);
+    assert(truncate(path, 100) == 0);
+    assert(workload_file_open(path, &file) != 0);
+
+    // A bad name offset only fails when that name is read.
+    assert(workload_file_write(path, processes, 3) == 0);
+    assert(workload_file_open(path, &file) == 0);
+    long name_offsets = (long)((const char *)workload_file_columns(file)->name_offsets -
+                               (const char *)workload_file_columns(file)->ids) +
+                        (long)sizeof(workload_file_header_t);
+    workload_file_close(file);
+    uint32_t bad_offset = 1000;
+    overwrite_bytes(path, name_offsets + 2 * (long)sizeof(uint32_t), &bad_offset, sizeof(bad_offset));
+    assert(workload_file_open(path, &file) == 0);
+    char name[16];
+    assert(workload_columns_name(workload_file_columns(file), 0, name, sizeof(name)) == 0);
+    assert(workload_columns_name(workload_file_columns(file), 1, name, sizeof(name)) != 0);
+    schedule_config_t config;
+    memset(&config, 0, sizeof(config));
+    timeline_event_t *timeline = NULL;
+    int timeline_count = 0;
+    metrics_t metrics;
+    assert(schedule_workload_columns(workload_file_columns(file), &config, NULL, &timeline, &timeline_count,
+                                     &metrics) != 0);
+    assert(schedule_workload_columns(workload_file_columns(file), &config, NULL, NULL, NULL, &metrics) == 0);
+    workload_file_close(file);
+
+    assert(workload_file_write(path, processes, 0) == 0);
+    assert(workload_file_open(path, &file) == 0);
+    assert(workload_file_columns(file)->process_count == 0);
+    workload_file_close(file);
+
+    assert(workload_file_open("/nonexistent/workload.swkl", &file) != 0);
+    remove(path);
+}
+
+int main(void) {
+    test_round_trip_and_schedule_from_mapping();
+    test_rejects_damaged_files();
+
+    printf("Workload file tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include "../Sources/Core/scheduler.h"
+#include "../Sources/Core/workload_gen.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_COUNT 200000
+
+static double mean_burst(const process_t *processes, int count) {
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        total += processes[i].burst_time;
+    }
+    return total / count;
+}
+
+// Variance / mean of arrivals per window of `width`; 1 for a Poisson process.
+static double dispersion_index(const process_t *processes, int count, int width) {
+    int windows = processes[count - 1].arrival_time / width;
+    assert(windows > 10);
+    int *counts = (int *)calloc((size_t)windows, sizeof(int));
+    assert(counts != NULL);
+    for (int i = 0; i < count; i++) {
+        int w = processes[i].arrival_time / width;
+        if (w < windows) {
+            counts[w]++;
+        }
+    }
+    double mean = 0.0;
+    for (int w = 0; w < windows; w++) {
+        mean += counts[w];
+    }
+    mean /= windows;
+    double variance = 0.0;
+    for (int w = 0; w < windows; w++) {
+        variance += (counts[w] - mean) * (counts[w] - mean);
+    }
+    variance /= windows;
+    free(counts);
+    return variance / mean;
+}
+
+static void test_deterministic_and_chunk_independent(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    config.seed = 42;
+    config.arrival = WORKLOAD_ARRIVAL_MMPP;
+    config.burst = WORKLOAD_BURST_LOGNORMAL;
+
+    process_t *whole = NULL;
+    assert(workload_generate(&config, 5000, &whole) == 0);
+
+    workload_gen_t gen;
+    assert(workload_gen_init(&gen, &config) == 0);
+    process_t *pieces = (process_t *)calloc(5000, sizeof(process_t));
+    assert(pieces != NULL);
+    int filled = 0;
+    for (int step = 1; filled < 5000; step = step * 3 + 1) {
+        int n = (5000 - filled < step) ? 5000 - filled : step;
+        assert(workload_gen_fill(&gen, pieces + filled, n) == 0);
+        filled += n;
+    }
+    assert(memcmp(whole, pieces, 5000 * sizeof(process_t)) == 0);
+
+    for (int i = 0; i < 5000; i++) {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "P%d", i + 1);
+        assert(whole[i].process_id == i + 1);
+        assert(strcmp(whole[i].name, expected) == 0);
+        assert(whole[i].burst_time >= 1);
+        assert(whole[i].priority >= 1 && whole[i].priority <= 10);
+        assert(whole[i].first_run_time == -1 && whole[i].response_time == -1);
+        assert(i == 0 || whole[i].arrival_time >= whole[i - 1].arrival_time);
+    }
+
+    config.seed = 43;
+    process_t *other = NULL;
+    assert(workload_generate(&config, 5000, &other) == 0);
+    assert(memcmp(whole, other, 5000 * sizeof(process_t)) != 0);
+
+    free(other);
+    free(pieces);
+    free(whole);
+}
+
+static void test_distribution_means(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    config.arrival_rate = 0.25;
+    config.burst_mean = 20.0;
+    config.burst_max = 100000000;
+
+    const workload_burst_kind_t kinds[] = {
+        WORKLOAD_BURST_EXPONENTIAL, WORKLOAD_BURST_LOGNORMAL, WORKLOAD_BURST_PARETO};
+    for (int k = 0; k < 3; k++) {
+        config.burst = kinds[k];
+        config.pareto_alpha = 2.5;  // finite variance keeps the sample mean stable
+        process_t *processes = NULL;
+        assert(workload_generate(&config, SAMPLE_COUNT, &processes) == 0);
+
+        // Rounding up adds about half a unit on average.
+        double mean = mean_burst(processes, SAMPLE_COUNT);
+        assert(fabs(mean - 20.5) < 1.0);
+
+        double arrival_rate = (double)(SAMPLE_COUNT - 1) / processes[SAMPLE_COUNT - 1].arrival_time;
+        assert(fabs(arrival_rate - 0.25) < 0.01);
+        free(processes);
+    }
+
+    config.burst = WORKLOAD_BURST_BIMODAL;
+    config.bimodal_short_mean = 2.0;
+    config.bimodal_long_mean = 200.0;
+    config.bimodal_long_fraction = 0.1;
+    process_t *processes = NULL;
+    assert(workload_generate(&config, SAMPLE_COUNT, &processes) == 0);
+    double mean = mean_burst(processes, SAMPLE_COUNT);
+    assert(fabs(mean - (0.9 * 2.0 + 0.1 * 200.0 + 0.5)) < 1.5);
+    free(processes);
+}
+
+static void test_mmpp_is_burstier_than_poisson(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    config.seed = 9;
+
+    process_t *poisson = NULL;
+    assert(workload_generate(&config, SAMPLE_COUNT, &poisson) == 0);
+    double poisson_index = dispersion_index(poisson, SAMPLE_COUNT, 50);
+    assert(poisson_index > 0.8 && poisson_index < 1.2);
+
+    config.arrival = WORKLOAD_ARRIVAL_MMPP;
+    process_t *mmpp = NULL;
+    assert(workload_generate(&config, SAMPLE_COUNT, &mmpp) == 0);
+    assert(dispersion_index(mmpp, SAMPLE_COUNT, 50) > 5.0 * poisson_index);
+
+    free(mmpp);
+    free(poisson);
+}
+
+static void test_priority_mix(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    config.priority_weights[0] = 1.0;  // priority 1
+    config.priority_weights[4] = 3.0;  // priority 5
+
+    process_t *processes = NULL;
+    assert(workload_generate(&config, SAMPLE_COUNT, &processes) == 0);
+    int counts[11] = {0};
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        counts[processes[i].priority]++;
+    }
+    assert(counts[1] + counts[5] == SAMPLE_COUNT);
+    assert(fabs((double)counts[5] / SAMPLE_COUNT - 0.75) < 0.01);
+    free(processes);
+
+    workload_gen_config_default(&config);
+    assert(workload_generate(&config, SAMPLE_COUNT, &processes) == 0);
+    for (int i = 0; i < 11; i++) {
+        counts[i] = 0;
+    }
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        counts[processes[i].priority]++;
+    }
+    for (int level = 1; level <= 10; level++) {
+        assert(fabs((double)counts[level] / SAMPLE_COUNT - 0.1) < 0.01);
+    }
+    free(processes);
+}
+
+typedef struct {
+    long long seen;
+    long long stop_after;
+    int last_id;
+} stream_probe_t;
+
+static int probe_sink(void *context, const process_t *processes, int count) {
+    stream_probe_t *probe = (stream_probe_t *)context;
+    for (int i = 0; i < count; i++) {
+        assert(processes[i].process_id == probe->last_id + 1);
+        probe->last_id = processes[i].process_id;
+    }
+    probe->seen += count;
+    return (probe->stop_after > 0 && probe->seen >= probe->stop_after) ? 7 : 0;
+}
+
+static void test_stream_sink(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    workload_gen_t gen;
+
+    assert(workload_gen_init(&gen, &config) == 0);
+    stream_probe_t probe = {0, 0, 0};
+    assert(workload_gen_stream(&gen, 10007, 1000, probe_sink, &probe) == 0);
+    assert(probe.seen == 10007);
+
+    assert(workload_gen_init(&gen, &config) == 0);
+    stream_probe_t stopping = {0, 3000, 0};
+    assert(workload_gen_stream(&gen, 10007, 1000, probe_sink, &stopping) == 7);
+    assert(stopping.seen == 3000);
+}
+
+static void test_generated_workload_schedules(void) {
+    workload_gen_config_t config;
+    workload_gen_config_default(&config);
+    config.burst = WORKLOAD_BURST_PARETO;
+
+    process_t *processes = NULL;
+    assert(workload_generate(&config, 2000, &processes) == 0);
+    schedule_config_t schedule;
+    memset(&schedule, 0, sizeof(schedule));
+    schedule.algorithm = ALGO_PRIORITY_P;
+    metrics_t metrics;
+    assert(schedule_processes_metrics_only(processes, 2000, &schedule, &metrics) == 0);
+    for (int i = 0; i < 2000; i++) {
+        assert(processes[i].completion_time >= processes[i].arrival_time + processes[i].burst_time);
+    }
+    free(processes);
+}
+
+static void test_invalid_configs(void) {
+    workload_gen_config_t config;
+    workload_gen_t gen;
+
+    workload_gen_config_default(&config);
+    config.arrival_rate = 0.0;
+    assert(workload_gen_init(&gen, &config) != 0);
+
+    workload_gen_config_default(&config);
+    config.burst = WORKLOAD_BURST_PARETO;
+    config.pareto_alpha = 1.0;
+    assert(workload_gen_init(&gen, &config) != 0);
+
+    workload_gen_config_default(&config);
+    config.burst_max = 0;
+    assert(workload_gen_init(&gen, &config) != 0);
+
+    workload_gen_config_default(&config);
+    config.priority_weights[3] = -1.0;
+    assert(workload_gen_init(&gen, &config) != 0);
+
+    workload_gen_config_default(&config);
+    process_t *processes = NULL;
+    assert(workload_generate(&config, 0, &processes) != 0);
+    assert(processes == NULL);
+}
+
+int main(void) {
+    test_deterministic_and_chunk_independent();
+    test_distribution_means();
+    test_mmpp_is_burstier_than_poisson();
+    test_priority_mix();
+    test_stream_sink();
+    test_generated_workload_schedules();
+    test_invalid_configs();
+
+    printf("Workload generator tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Imports a kernel sched_switch/sched_wakeup trace and compares what the
+// kernel did with what each policy would have done on the same workload.
+//
+//   trace-cmd record -e sched_switch -e sched_wakeup -e sched_wakeup_new sleep 5
+//   trace-cmd report | ftrace_import - --unit-ns 1000 --workload trace.swkl
+//   ftrace_import /sys/kernel/tracing/trace --csv trace.csv
+#include "ftrace_import.h"
+#include "metrics.h"
+#include "scheduler.h"
+#include "workload_file.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_row(const char *label, const metrics_t *metrics) {
+    printf("%-12s %12.2f %12.2f %12.2f %12.1f %10d\n", label, metrics->avg_turnaround_time,
+           metrics->avg_waiting_time, metrics->avg_response_time, metrics->waiting_stats.p99,
+           metrics->context_switches);
+}
+
+static int write_csv(const char *path, const process_t *processes, int count) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return 1;
+    }
+    fprintf(out, "process_id,name,arrival_time,burst_time,priority\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%d,%s,%d,%d,%d\n", processes[i].process_id, processes[i].name,
+                processes[i].arrival_time, processes[i].burst_time, processes[i].priority);
+    }
+    return (fclose(out) == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    ftrace_import_config_t config;
+    config.time_unit_ns = FTRACE_DEFAULT_TIME_UNIT_NS;
+    int quantum = 4;
+    const char *path = NULL;
+    const char *workload_path = NULL;
+    const char *csv_path = NULL;
+    bool valid = true;
+
+    for (int i = 1; i < argc && valid; i++) {
+        const char *flag = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (flag[0] != '-' || strcmp(flag, "-") == 0) {
+            valid = (path == NULL);
+            path = flag;
+            continue;
+        }
+        if (!value) {
+            valid = false;
+            break;
+        }
+        i++;
+        if (strcmp(flag, "--unit-ns") == 0) {
+            config.time_unit_ns = atoll(value);
+            valid = config.time_unit_ns > 0;
+        } else if (strcmp(flag, "--quantum") == 0) {
+            quantum = atoi(value);
+        } else if (strcmp(flag, "--workload") == 0) {
+            workload_path = value;
+        } else if (strcmp(flag, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || !path) {
+        fprintf(stderr, "usage: %s TRACE|- [--unit-ns N] [--quantum Q] [--workload OUT.swkl] [--csv OUT.csv]\n",
+                argv[0]);
+        return 2;
+    }
+
+    ftrace_import_result_t result;
+    int status = ftrace_import_file(path, &config, &result);
+    if (status != 0) {
+        fprintf(stderr, "%s: import failed (%d); is --unit-ns too small for the trace length?\n", path, status);
+        return 1;
+    }
+    printf("%lld records (%lld other lines), %d CPUs: %d processes, %d segments, %d truncated, %d dropped\n",
+           result.records, result.ignored_lines, result.cpu_count, result.process_count, result.timeline_count,
+           result.truncated, result.dropped);
+    if (result.process_count == 0) {
+        ftrace_import_result_free(&result);
+        return 0;
+    }
+
+    printf("%-12s %12s %12s %12s %12s %10s\n", "schedule", "turnaround", "waiting", "response", "wait p99",
+           "switches");
+    metrics_t metrics;
+    calculate_metrics(result.processes, result.process_count, result.context_switches, &metrics);
+    print_row("observed", &metrics);
+
+    for (int a = ALGO_FCFS; a <= ALGO_PRIORITY_P && status == 0; a++) {
+        schedule_config_t schedule;
+        (void)memset(&schedule, 0, sizeof(schedule));
+        schedule.algorithm = (algorithm_type_t)a;
+        schedule.time_quantum = quantum;
+        status = schedule_workload(result.processes, result.process_count, &schedule, NULL, NULL, NULL, &metrics);
+        if (status == 0) {
+            print_row(sched_algorithm_name((algorithm_type_t)a), &metrics);
+        }
+    }
+    if (result.cpu_count > 1) {
+        printf("(the policies run on one CPU; the observed schedule used %d)\n", result.cpu_count);
+    }
+
+    if (status == 0 && workload_path) {
+        status = workload_file_write(workload_path, result.processes, result.process_count);
+    }
+    if (status == 0 && csv_path) {
+        status = write_csv(csv_path, result.processes, result.process_count);
+    }
+    ftrace_import_result_free(&result);
+    if (status != 0) {
+        fprintf(stderr, "failed (%d)\n", status);
+        return 1;
+    }
+    return 0;
+}
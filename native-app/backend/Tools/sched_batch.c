@@ -0,0 +1,747 @@
+// Headless batch runner: schedules workload files under one or more policies
+// and writes the metrics and, optionally, the timelines.
+//
+//   sched_batch jobs.swkl --policy fcfs,sjf,rr:2 --format csv
+//   workload_gen --count 100000 | sched_batch - --timeline timeline.jsonl --metrics metrics.jsonl
+//   sched_batch workloads/ --jobs 8 --format binary --metrics metrics.bin --timeline-dir timelines/
+//   sched_batch jobs.csv --policy rr:4 --trace-dir traces/ --trace-format perfetto
+//
+// Inputs are binary workload files (see workload_convert), CSV or JSON Lines
+// job logs, "-" for stdin, or directories, whose files are processed in
+// parallel by --jobs workers. A workload is held as columns (binary files
+// stay mapped) and every run goes through the online scheduler, whose
+// segments are written as they are committed: memory follows the workload's
+// columns and the active set, never the length of the timeline.
+//
+// Formats (--format, for every output):
+//   json    one object per line; metrics rows carry every metrics_t field
+//   csv     a header, then one row per run / per segment
+//   binary  metrics: "SMTB", u32 version, u32 field count, the field names
+//           (u16 length + bytes), then per run the workload and policy
+//           (u16 length + bytes each), i32 process count and f64 fields.
+//           timelines: "STLB", u32 version, then per run the workload and
+//           policy, a sequence of u32-sized chunks that together form one
+//           timeline_codec stream, and a zero size. Integers are in the
+//           producer's byte order.
+//
+// --trace-dir writes every run as a trace for Perfetto or chrome://tracing
+// (see trace_export.h), streamed like the timelines: <input>.<policy>.json,
+// or .perfetto-trace with --trace-format perfetto.
+#define _POSIX_C_SOURCE 200809L
+
+#include "monte_carlo.h"
+#include "online_scheduler.h"
+#include "scheduler.h"
+#include "timeline_codec.h"
+#include "trace_export.h"
+#include "trace_ingest.h"
+#include "utils.h"
+#include "workload_file.h"
+
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BATCH_CHUNK 4096
+#define BATCH_MAX_POLICIES 16
+#define BATCH_MAX_JOBS 256
+#define BATCH_FORMAT_VERSION 1u
+
+typedef enum {
+    OUTPUT_JSON = 0,
+    OUTPUT_CSV = 1,
+    OUTPUT_BINARY = 2
+} output_format_t;
+
+typedef struct {
+    char label[32];  // "rr:4", "fcfs", ...
+    schedule_config_t config;
+} policy_t;
+
+typedef struct {
+    policy_t policies[BATCH_MAX_POLICIES];
+    int policy_count;
+    output_format_t format;
+    trace_format_t input_format;
+
+    FILE *metrics;
+    bool metrics_started;
+    FILE *timeline;             // --timeline: one stream, single worker
+    bool timeline_started;
+    const char *timeline_dir;   // --timeline-dir: one file per run
+    const char *trace_dir;      // --trace-dir: one trace per run
+    trace_export_format_t trace_format;
+
+    char **inputs;
+    int input_count;
+    int next_input;
+    int failures;
+    pthread_mutex_t lock;       // next_input, failures and the metrics stream
+} batch_t;
+
+typedef struct {
+    FILE *out;
+    output_format_t format;
+    const char *workload;
+    const char *policy;
+    timeline_encoder_t *encoder;  // binary: one stream per run
+} timeline_writer_t;
+
+static void write_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', out);
+            fputc(*p, out);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void write_csv_field(FILE *out, const char *text) {
+    if (!strpbrk(text, ",\"\r\n")) {
+        fputs(text, out);
+        return;
+    }
+    fputc('"', out);
+    for (const char *p = text; *p; p++) {
+        if (*p == '"') {
+            fputc('"', out);
+        }
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+static void write_binary_string(FILE *out, const char *text) {
+    size_t length = strlen(text);
+    uint16_t stored = (uint16_t)((length > UINT16_MAX) ? UINT16_MAX : length);
+    (void)fwrite(&stored, sizeof(stored), 1, out);
+    (void)fwrite(text, 1, stored, out);
+}
+
+static void write_binary_magic(FILE *out, const char *magic) {
+    uint32_t version = BATCH_FORMAT_VERSION;
+    (void)fwrite(magic, 1, 4, out);
+    (void)fwrite(&version, sizeof(version), 1, out);
+}
+
+static void write_metrics_header(FILE *out, output_format_t format) {
+    if (format == OUTPUT_CSV) {
+        fputs("workload,policy,processes", out);
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            fprintf(out, ",%s", monte_carlo_field_name((monte_carlo_field_t)f));
+        }
+        fputc('\n', out);
+    } else if (format == OUTPUT_BINARY) {
+        uint32_t field_count = MONTE_CARLO_FIELD_COUNT;
+        write_binary_magic(out, "SMTB");
+        (void)fwrite(&field_count, sizeof(field_count), 1, out);
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            write_binary_string(out, monte_carlo_field_name((monte_carlo_field_t)f));
+        }
+    }
+}
+
+// Called with the batch lock held, so rows of concurrent runs stay whole.
+static void write_metrics_row(batch_t *batch, const char *workload, const char *policy, int process_count,
+                              const metrics_t *metrics) {
+    FILE *out = batch->metrics;
+    if (!batch->metrics_started) {
+        write_metrics_header(out, batch->format);
+        batch->metrics_started = true;
+    }
+
+    if (batch->format == OUTPUT_JSON) {
+        fputs("{\"workload\":", out);
+        write_json_string(out, workload);
+        fprintf(out, ",\"policy\":\"%s\",\"processes\":%d", policy, process_count);
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            fprintf(out, ",\"%s\":%.10g", monte_carlo_field_name((monte_carlo_field_t)f),
+                    monte_carlo_field_value(metrics, (monte_carlo_field_t)f));
+        }
+        fputs("}\n", out);
+    } else if (batch->format == OUTPUT_CSV) {
+        write_csv_field(out, workload);
+        fprintf(out, ",%s,%d", policy, process_count);
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            fprintf(out, ",%.10g", monte_carlo_field_value(metrics, (monte_carlo_field_t)f));
+        }
+        fputc('\n', out);
+    } else {
+        int32_t count = process_count;
+        write_binary_string(out, workload);
+        write_binary_string(out, policy);
+        (void)fwrite(&count, sizeof(count), 1, out);
+        for (int f = 0; f < MONTE_CARLO_FIELD_COUNT; f++) {
+            double value = monte_carlo_field_value(metrics, (monte_carlo_field_t)f);
+            (void)fwrite(&value, sizeof(value), 1, out);
+        }
+    }
+    (void)fflush(out);
+}
+
+static void write_timeline_header(FILE *out, output_format_t format) {
+    if (format == OUTPUT_CSV) {
+        fputs("workload,policy,process_id,name,start,end\n", out);
+    } else if (format == OUTPUT_BINARY) {
+        write_binary_magic(out, "STLB");
+    }
+}
+
+// Writes the blocks the run's encoder has closed as one chunk; the open
+// block waits for more segments unless flush is set.
+static int write_encoded(timeline_writer_t *writer, const timeline_event_t *events, int count, bool flush) {
+    uint8_t *bytes = NULL;
+    size_t size = 0;
+    int status = timeline_encoder_push(writer->encoder, events, count);
+    if (status == 0 && flush) {
+        status = timeline_encoder_flush(writer->encoder);
+    }
+    if (status == 0) {
+        status = timeline_encoder_drain(writer->encoder, &bytes, &size);
+    }
+    if (status == 0 && size > 0) {
+        uint32_t stored = (uint32_t)size;
+        (void)fwrite(&stored, sizeof(stored), 1, writer->out);
+        (void)fwrite(bytes, 1, size, writer->out);
+    }
+    free(bytes);
+    return status;
+}
+
+static int write_segments(timeline_writer_t *writer, const timeline_event_t *events, int count) {
+    FILE *out = writer->out;
+    if (writer->format == OUTPUT_BINARY) {
+        return write_encoded(writer, events, count, false);
+    }
+
+    for (int i = 0; i < count; i++) {
+        const timeline_event_t *event = &events[i];
+        if (writer->format == OUTPUT_JSON) {
+            fputs("{\"workload\":", out);
+            write_json_string(out, writer->workload);
+            fprintf(out, ",\"policy\":\"%s\",\"process_id\":%d,\"name\":", writer->policy, event->process_id);
+            write_json_string(out, event->process_name);
+            fprintf(out, ",\"start\":%d,\"end\":%d}\n", event->start_time, event->end_time);
+        } else {
+            write_csv_field(out, writer->workload);
+            fprintf(out, ",%s,%d,", writer->policy, event->process_id);
+            write_csv_field(out, event->process_name);
+            fprintf(out, ",%d,%d\n", event->start_time, event->end_time);
+        }
+    }
+    return ferror(out) ? 1 : 0;
+}
+
+// The trace is flushed up to the end of the last drained segment (capped by
+// the clock): the segment held back by the scheduler cannot start earlier.
+static int drain_output(online_scheduler_t *sim, timeline_writer_t *writer, trace_exporter_t *trace, int clock,
+                        int *drained_end) {
+    timeline_event_t *events = NULL;
+    int event_count = 0;
+    process_t *completed = NULL;
+    int completed_count = 0;
+    int status = online_scheduler_drain_events(sim, &events, &event_count);
+    if (status == 0 && writer && event_count > 0) {
+        status = write_segments(writer, events, event_count);
+    }
+    if (status == 0 && trace && event_count > 0) {
+        status = trace_exporter_segments(trace, events, event_count, 0);
+        *drained_end = events[event_count - 1].end_time;
+    }
+    free(events);
+    if (status == 0) {
+        status = online_scheduler_drain_completed(sim, &completed, &completed_count);
+    }
+    if (status == 0 && trace) {
+        status = trace_exporter_completions(trace, completed, completed_count);
+    }
+    if (status == 0 && trace) {
+        status = trace_exporter_flush(trace, (*drained_end < clock) ? *drained_end : clock);
+    }
+    free(completed);
+    return status;
+}
+
+// A workload in columnar form: mapped from a binary file, or read from a
+// text log into a workload file writer (a few bytes per process rather than
+// a process_t), so every policy replays it without re-reading the input.
+typedef struct {
+    workload_columns_t columns;
+    workload_file_t *file;
+    workload_file_writer_t *builder;  // columns of a text input
+    int *order;  // arrival order when the input is not sorted, else NULL
+} workload_t;
+
+static void workload_free(workload_t *workload) {
+    workload_file_close(workload->file);
+    workload_file_writer_destroy(workload->builder);
+    free(workload->order);
+    (void)memset(workload, 0, sizeof(*workload));
+}
+
+// The online scheduler takes arrivals in time order.
+static int workload_order(workload_t *workload) {
+    const workload_columns_t *columns = &workload->columns;
+    return arrival_order(columns->arrivals, sizeof(int32_t), columns->process_count, &workload->order);
+}
+
+static int workload_load(const char *path, trace_format_t input_format, workload_t *workload) {
+    (void)memset(workload, 0, sizeof(*workload));
+    if (strcmp(path, "-") != 0 && workload_file_open(path, &workload->file) == 0) {
+        workload->columns = *workload_file_columns(workload->file);
+        return workload_order(workload);
+    }
+
+    trace_ingest_config_t config;
+    trace_ingest_config_default(&config);
+    config.format = input_format;
+    trace_reader_t *reader = NULL;
+    process_t *rows = (process_t *)malloc(BATCH_CHUNK * sizeof(process_t));
+    int status = rows ? workload_file_writer_create(&workload->builder) : 1;
+    if (status == 0) {
+        status = trace_reader_open(path, &config, &reader);
+    }
+    while (status == 0) {
+        int got = 0;
+        status = trace_reader_next(reader, rows, BATCH_CHUNK, &got);
+        if (status != 0 || got == 0) {
+            break;
+        }
+        status = workload_file_writer_add(workload->builder, rows, got);
+    }
+    trace_reader_close(reader);
+    free(rows);
+
+    if (status == 0) {
+        status = workload_file_writer_columns(workload->builder, &workload->columns);
+    }
+    return (status == 0) ? workload_order(workload) : status;
+}
+
+static int submit_process(online_scheduler_t *sim, const workload_t *workload, int position, trace_exporter_t *trace) {
+    const workload_columns_t *columns = &workload->columns;
+    int index = workload->order ? workload->order[position] : position;
+    process_t process;
+    (void)memset(&process, 0, sizeof(process));
+    process.process_id = columns->ids[index];
+    process.arrival_time = columns->arrivals[index];
+    process.burst_time = columns->bursts[index];
+    process.priority = columns->priorities[index];
+    int status = workload_columns_name(columns, index, process.name, sizeof(process.name));
+    if (status == 0 && trace) {
+        status = trace_exporter_arrivals(trace, &process, 1);
+    }
+    return (status == 0) ? online_scheduler_submit(sim, &process) : status;
+}
+
+static int arrival_at(const workload_t *workload, int position) {
+    int index = workload->order ? workload->order[position] : position;
+    return workload->columns.arrivals[index];
+}
+
+// Feeds the workload in arrival order, a chunk at a time, and writes the
+// committed segments after each chunk.
+static int run_policy(const workload_t *workload, const policy_t *policy, timeline_writer_t *writer,
+                      trace_exporter_t *trace, metrics_t *metrics) {
+    online_scheduler_t *sim = NULL;
+    int status = online_scheduler_create(&policy->config, &sim);
+    if (status != 0) {
+        return status;
+    }
+    if (writer && writer->format == OUTPUT_BINARY) {
+        write_binary_string(writer->out, writer->workload);
+        write_binary_string(writer->out, writer->policy);
+        status = timeline_encoder_create(&writer->encoder);
+    }
+
+    int count = workload->columns.process_count;
+    int drained_end = 0;
+    for (int begin = 0; begin < count && status == 0; begin += BATCH_CHUNK) {
+        int end = (count - begin > BATCH_CHUNK) ? begin + BATCH_CHUNK : count;
+        for (int i = begin; i < end && status == 0; i++) {
+            status = submit_process(sim, workload, i, trace);
+        }
+        int clock = arrival_at(workload, end - 1);
+        if (status == 0) {
+            status = online_scheduler_advance_to(sim, clock);
+        }
+        if (status == 0) {
+            status = drain_output(sim, writer, trace, clock, &drained_end);
+        }
+    }
+    if (status == 0) {
+        status = online_scheduler_advance_to(sim, INT_MAX);
+    }
+    if (status == 0) {
+        status = drain_output(sim, writer, trace, INT_MAX, &drained_end);
+    }
+    if (status == 0 && trace) {
+        status = trace_exporter_finish(trace);
+    }
+    if (status == 0 && writer && writer->format == OUTPUT_BINARY) {
+        status = write_encoded(writer, NULL, 0, true);
+    }
+    if (status == 0 && writer && writer->format == OUTPUT_BINARY) {
+        uint32_t terminator = 0;
+        (void)fwrite(&terminator, sizeof(terminator), 1, writer->out);
+    }
+    if (status == 0) {
+        status = online_scheduler_metrics(sim, metrics);
+    }
+    if (writer) {
+        timeline_encoder_destroy(writer->encoder);
+        writer->encoder = NULL;
+    }
+    online_scheduler_destroy(sim);
+    return status;
+}
+
+// Opens <dir>/<input base name>.<policy>.<extension>.
+static FILE *open_run_file(const char *dir, const char *input, const char *policy, const char *extension,
+                           const char *mode) {
+    const char *base = strrchr(input, '/');
+    base = (strcmp(input, "-") == 0) ? "stdin" : (base ? base + 1 : input);
+
+    char path[PATH_MAX];
+    int written = snprintf(path, sizeof(path), "%s/%s.%s.%s", dir, base, policy, extension);
+    if (written < 0 || (size_t)written >= sizeof(path)) {
+        return NULL;
+    }
+    for (char *p = path + strlen(dir) + 1; *p; p++) {
+        if (*p == ':') {
+            *p = '_';
+        }
+    }
+    return fopen(path, mode);
+}
+
+static FILE *open_run_timeline(const batch_t *batch, const char *input, const char *policy) {
+    static const char *const kExtensions[] = {"jsonl", "csv", "bin"};
+    FILE *out = open_run_file(batch->timeline_dir, input, policy, kExtensions[batch->format],
+                              (batch->format == OUTPUT_BINARY) ? "wb" : "w");
+    if (out) {
+        write_timeline_header(out, batch->format);
+    }
+    return out;
+}
+
+static int open_run_trace(const batch_t *batch, const char *input, const char *policy, FILE **out,
+                          trace_exporter_t **trace) {
+    bool perfetto = batch->trace_format == TRACE_EXPORT_PERFETTO;
+    *out = open_run_file(batch->trace_dir, input, policy, perfetto ? "perfetto-trace" : "json", perfetto ? "wb" : "w");
+    if (!*out) {
+        return 1;
+    }
+    trace_export_config_t config;
+    trace_export_config_default(&config);
+    config.format = batch->trace_format;
+    return trace_exporter_create(&config, *out, trace);
+}
+
+static int process_input(batch_t *batch, const char *input) {
+    workload_t workload;
+    int status = workload_load(input, batch->input_format, &workload);
+    int count = workload.columns.process_count;
+    const char *label = (strcmp(input, "-") == 0) ? "stdin" : input;
+
+    for (int p = 0; p < batch->policy_count && status == 0; p++) {
+        const policy_t *policy = &batch->policies[p];
+        timeline_writer_t writer = {NULL, batch->format, label, policy->label, NULL};
+        if (batch->timeline_dir) {
+            writer.out = open_run_timeline(batch, input, policy->label);
+            status = writer.out ? 0 : 1;
+        } else if (batch->timeline) {
+            writer.out = batch->timeline;
+            if (!batch->timeline_started) {
+                write_timeline_header(writer.out, batch->format);
+                batch->timeline_started = true;
+            }
+        }
+
+        FILE *trace_out = NULL;
+        trace_exporter_t *trace = NULL;
+        if (status == 0 && batch->trace_dir) {
+            status = open_run_trace(batch, input, policy->label, &trace_out, &trace);
+        }
+
+        metrics_t metrics;
+        if (status == 0) {
+            status = run_policy(&workload, policy, writer.out ? &writer : NULL, trace, &metrics);
+        }
+        if (writer.out && writer.out != batch->timeline && fclose(writer.out) != 0 && status == 0) {
+            status = 1;
+        }
+        trace_exporter_destroy(trace);
+        if (trace_out && fclose(trace_out) != 0 && status == 0) {
+            status = 1;
+        }
+        if (status == 0) {
+            (void)pthread_mutex_lock(&batch->lock);
+            write_metrics_row(batch, label, policy->label, count, &metrics);
+            (void)pthread_mutex_unlock(&batch->lock);
+        }
+    }
+    workload_free(&workload);
+    return status;
+}
+
+static void *batch_worker(void *arg) {
+    batch_t *batch = (batch_t *)arg;
+    for (;;) {
+        (void)pthread_mutex_lock(&batch->lock);
+        int index = batch->next_input++;
+        (void)pthread_mutex_unlock(&batch->lock);
+        if (index >= batch->input_count) {
+            break;
+        }
+        int status = process_input(batch, batch->inputs[index]);
+        if (status != 0) {
+            (void)pthread_mutex_lock(&batch->lock);
+            batch->failures++;
+            fprintf(stderr, "%s: failed (%d); unreadable workload, unwritable timeline or invalid policy?\n",
+                    batch->inputs[index], status);
+            (void)pthread_mutex_unlock(&batch->lock);
+        }
+    }
+    return NULL;
+}
+
+static int add_input(batch_t *batch, int *capacity, const char *path) {
+    if (batch->input_count == *capacity) {
+        int grown_capacity = (*capacity > 0) ? *capacity * 2 : 16;
+        char **grown = (char **)realloc(batch->inputs, (size_t)grown_capacity * sizeof(char *));
+        if (!grown) {
+            return 1;
+        }
+        batch->inputs = grown;
+        *capacity = grown_capacity;
+    }
+    size_t length = strlen(path) + 1;
+    char *copy = (char *)malloc(length);
+    if (!copy) {
+        return 1;
+    }
+    (void)memcpy(copy, path, length);
+    batch->inputs[batch->input_count++] = copy;
+    return 0;
+}
+
+static int compare_paths(const void *lhs, const void *rhs) {
+    return strcmp(*(char *const *)lhs, *(char *const *)rhs);
+}
+
+// Directories contribute their regular, non-hidden files in name order.
+static int expand_input(batch_t *batch, int *capacity, const char *path) {
+    struct stat info;
+    if (strcmp(path, "-") == 0 || stat(path, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return add_input(batch, capacity, path);
+    }
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return 1;
+    }
+    int first = batch->input_count;
+    int status = 0;
+    char child[PATH_MAX];
+    for (struct dirent *entry = readdir(dir); entry && status == 0; entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        int written = snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (written < 0 || (size_t)written >= sizeof(child)) {
+            continue;
+        }
+        if (stat(child, &info) == 0 && S_ISREG(info.st_mode)) {
+            status = add_input(batch, capacity, child);
+        }
+    }
+    (void)closedir(dir);
+    qsort(batch->inputs + first, (size_t)(batch->input_count - first), sizeof(char *), compare_paths);
+    return status;
+}
+
+// "fcfs,rr:2,priority_p"; a quantum after ':' overrides --quantum for rr.
+static bool parse_policies(const char *list, batch_t *batch) {
+    batch->policy_count = 0;
+    const char *p = list;
+    while (*p) {
+        const char *end = strchr(p, ',');
+        size_t length = end ? (size_t)(end - p) : strlen(p);
+        char name[32];
+        if (length == 0 || length >= sizeof(name) || batch->policy_count == BATCH_MAX_POLICIES) {
+            return false;
+        }
+        (void)memcpy(name, p, length);
+        name[length] = '\0';
+
+        policy_t *policy = &batch->policies[batch->policy_count];
+        char *colon = strchr(name, ':');
+        policy->config.time_quantum = 0;
+        if (colon) {
+            *colon = '\0';
+            policy->config.time_quantum = atoi(colon + 1);
+            if (policy->config.time_quantum <= 0) {
+                return false;
+            }
+        }
+        if (sched_algorithm_from_name(name, &policy->config.algorithm) != 0) {
+            return false;
+        }
+        batch->policy_count++;
+        p += length + (end ? 1 : 0);
+    }
+    return batch->policy_count > 0;
+}
+
+static void finish_policies(batch_t *batch, int quantum, int switch_cost, int aging) {
+    for (int p = 0; p < batch->policy_count; p++) {
+        policy_t *policy = &batch->policies[p];
+        if (policy->config.time_quantum == 0) {
+            policy->config.time_quantum = quantum;
+        }
+        policy->config.switch_cost = switch_cost;
+        policy->config.aging_interval = aging;
+        if (policy->config.algorithm == ALGO_RR) {
+            (void)snprintf(policy->label, sizeof(policy->label), "rr:%d", policy->config.time_quantum);
+        } else {
+            (void)snprintf(policy->label, sizeof(policy->label), "%s", sched_algorithm_name(policy->config.algorithm));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    batch_t batch;
+    (void)memset(&batch, 0, sizeof(batch));
+    (void)parse_policies("fcfs,sjf,srtf,rr,priority_np,priority_p", &batch);
+    batch.format = OUTPUT_JSON;
+    batch.input_format = TRACE_FORMAT_AUTO;
+    batch.trace_format = TRACE_EXPORT_CHROME_JSON;
+    int quantum = 4;
+    int switch_cost = 0;
+    int aging = 0;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = (online > 0) ? (int)online : 1;
+    const char *metrics_path = "-";
+    const char *timeline_path = NULL;
+    int input_capacity = 0;
+    bool valid = true;
+
+    for (int i = 1; i < argc && valid; i++) {
+        const char *flag = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (flag[0] != '-' || strcmp(flag, "-") == 0) {
+            valid = expand_input(&batch, &input_capacity, flag) == 0;
+            continue;
+        }
+        if (!value) {
+            valid = false;
+            break;
+        }
+        i++;
+        if (strcmp(flag, "--policy") == 0) {
+            valid = parse_policies(value, &batch);
+        } else if (strcmp(flag, "--quantum") == 0) {
+            quantum = atoi(value);
+        } else if (strcmp(flag, "--switch-cost") == 0) {
+            switch_cost = atoi(value);
+        } else if (strcmp(flag, "--aging") == 0) {
+            aging = atoi(value);
+        } else if (strcmp(flag, "--format") == 0) {
+            valid = strcmp(value, "json") == 0 || strcmp(value, "csv") == 0 || strcmp(value, "binary") == 0;
+            batch.format = (value[0] == 'j') ? OUTPUT_JSON : (value[0] == 'c') ? OUTPUT_CSV : OUTPUT_BINARY;
+        } else if (strcmp(flag, "--input-format") == 0) {
+            batch.input_format = (strcmp(value, "jsonl") == 0) ? TRACE_FORMAT_JSONL : TRACE_FORMAT_CSV;
+        } else if (strcmp(flag, "--metrics") == 0) {
+            metrics_path = value;
+        } else if (strcmp(flag, "--timeline") == 0) {
+            timeline_path = value;
+        } else if (strcmp(flag, "--timeline-dir") == 0) {
+            batch.timeline_dir = value;
+        } else if (strcmp(flag, "--trace-dir") == 0) {
+            batch.trace_dir = value;
+        } else if (strcmp(flag, "--trace-format") == 0) {
+            valid = strcmp(value, "json") == 0 || strcmp(value, "perfetto") == 0;
+            batch.trace_format = (value[0] == 'p') ? TRACE_EXPORT_PERFETTO : TRACE_EXPORT_CHROME_JSON;
+        } else if (strcmp(flag, "--jobs") == 0) {
+            jobs = atoi(value);
+        } else {
+            valid = false;
+        }
+    }
+    if (valid && batch.input_count == 0) {
+        valid = add_input(&batch, &input_capacity, "-") == 0;
+    }
+    // Both outputs on stdout would interleave.
+    if (!valid || jobs <= 0 || (timeline_path && batch.timeline_dir) ||
+        (timeline_path && strcmp(timeline_path, "-") == 0 && strcmp(metrics_path, "-") == 0)) {
+        fprintf(stderr,
+                "usage: %s [WORKLOAD|DIR|-]... [--policy fcfs,sjf,srtf,rr[:Q],priority_np,priority_p]\n"
+                "          [--quantum Q] [--switch-cost C] [--aging A] [--format json|csv|binary]\n"
+                "          [--input-format csv|jsonl] [--metrics PATH|-] [--timeline PATH|-]\n"
+                "          [--timeline-dir DIR] [--trace-dir DIR] [--trace-format json|perfetto]\n"
+                "          [--jobs N]\n",
+                argv[0]);
+        for (int i = 0; i < batch.input_count; i++) {
+            free(batch.inputs[i]);
+        }
+        free(batch.inputs);
+        return 2;
+    }
+    finish_policies(&batch, quantum, switch_cost, aging);
+
+    const char *mode = (batch.format == OUTPUT_BINARY) ? "wb" : "w";
+    batch.metrics = (strcmp(metrics_path, "-") == 0) ? stdout : fopen(metrics_path, mode);
+    if (timeline_path) {
+        batch.timeline = (strcmp(timeline_path, "-") == 0) ? stdout : fopen(timeline_path, mode);
+        jobs = 1;  // runs share the stream
+    }
+    if (!batch.metrics || (timeline_path && !batch.timeline)) {
+        fprintf(stderr, "cannot open %s\n", batch.metrics ? timeline_path : metrics_path);
+        return 1;
+    }
+
+    if (jobs > batch.input_count) {
+        jobs = batch.input_count;
+    }
+    if (jobs > BATCH_MAX_JOBS) {
+        jobs = BATCH_MAX_JOBS;
+    }
+    (void)pthread_mutex_init(&batch.lock, NULL);
+    pthread_t threads[BATCH_MAX_JOBS];
+    int started = 0;
+    for (int t = 1; t < jobs; t++) {
+        if (pthread_create(&threads[started], NULL, batch_worker, &batch) == 0) {
+            started++;
+        }
+    }
+    (void)batch_worker(&batch);
+    for (int t = 0; t < started; t++) {
+        (void)pthread_join(threads[t], NULL);
+    }
+    (void)pthread_mutex_destroy(&batch.lock);
+
+    if (batch.timeline && batch.timeline != stdout && fclose(batch.timeline) != 0) {
+        batch.failures++;
+    }
+    if (batch.metrics != stdout && fclose(batch.metrics) != 0) {
+        batch.failures++;
+    }
+    for (int i = 0; i < batch.input_count; i++) {
+        free(batch.inputs[i]);
+    }
+    free(batch.inputs);
+    return (batch.failures > 0) ? 1 : 0;
+}
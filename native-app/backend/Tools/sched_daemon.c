@@ -0,0 +1,365 @@
+// Local scheduling daemon: front ends send JSON requests, one per line, over
+// a Unix domain socket (or a loopback TCP port) and a worker pool answers
+// them; see sched_service.h for the protocol.
+//
+//   sched_daemon --socket /tmp/sched.sock --workers 4
+//   echo '{"id":1,"algorithm":"rr","quantum":2,"processes":[[1,0,5,1],[2,1,3,2]]}' | nc -U /tmp/sched.sock
+//   sched_daemon --port 7070
+//
+// Each connection is a client for superseding: a request replaces the same
+// connection's earlier requests on its channel. Replies to one connection may
+// arrive out of request order; match them by id.
+//
+// Sockets are non-blocking: workers queue replies on the connection and write
+// what the socket takes, and the poll loop writes the rest, so a client that
+// stops reading holds memory (up to DAEMON_MAX_OUTPUT) but never a worker.
+#define _POSIX_C_SOURCE 200809L
+
+#include "sched_service.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DAEMON_MAX_CLIENTS 256
+#define DAEMON_READ_SIZE 65536
+#define DAEMON_MAX_LINE ((size_t)512 * 1024 * 1024)
+#define DAEMON_MAX_OUTPUT ((size_t)1024 * 1024 * 1024)
+
+typedef struct {
+    int fd;                      // -1 once closed
+    pthread_mutex_t lock;        // fd and output; replies come from worker threads
+    bool broken;                 // a write failed or output overflowed; later replies are dropped
+    char *output;                // replies the socket has not taken yet
+    size_t output_length;
+    size_t output_capacity;
+    char *buffer;                // bytes of the unfinished line; poll loop only
+    size_t length;
+    size_t capacity;
+} client_t;
+
+static volatile sig_atomic_t g_stop = 0;
+static int g_wake[2] = {-1, -1};  // a worker left output behind, or broke a client
+
+static void wake_poll_loop(void) {
+    static const char kByte = 0;
+    (void)write(g_wake[1], &kByte, 1);  // a full pipe already wakes it
+}
+
+static void on_signal(int signal_number) {
+    (void)signal_number;
+    g_stop = 1;
+}
+
+static bool set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Writes what the socket takes; called with the client lock held.
+static void flush_output(client_t *client) {
+    size_t written_total = 0;
+    while (!client->broken && written_total < client->output_length) {
+        ssize_t written = write(client->fd, client->output + written_total, client->output_length - written_total);
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno != EINTR) {
+                client->broken = true;
+            }
+            continue;
+        }
+        written_total += (size_t)written;
+    }
+    if (client->broken) {
+        written_total = client->output_length;
+    }
+    (void)memmove(client->output, client->output + written_total, client->output_length - written_total);
+    client->output_length -= written_total;
+}
+
+static void reply_to_client(void *context, const char *response, size_t length) {
+    client_t *client = (client_t *)context;
+    (void)pthread_mutex_lock(&client->lock);
+    if (client->fd >= 0 && !client->broken) {
+        if (client->output_length + length > client->output_capacity) {
+            size_t grown_capacity = (client->output_capacity > 0U) ? client->output_capacity : DAEMON_READ_SIZE;
+            while (grown_capacity < client->output_length + length) {
+                grown_capacity *= 2U;
+            }
+            char *grown = (grown_capacity <= DAEMON_MAX_OUTPUT) ? (char *)realloc(client->output, grown_capacity) : NULL;
+            if (grown) {
+                client->output = grown;
+                client->output_capacity = grown_capacity;
+            } else {
+                client->broken = true;
+            }
+        }
+        if (!client->broken) {
+            (void)memcpy(client->output + client->output_length, response, length);
+            client->output_length += length;
+            flush_output(client);
+        }
+        if (client->broken || client->output_length > 0U) {
+            wake_poll_loop();
+        }
+    }
+    (void)pthread_mutex_unlock(&client->lock);
+}
+
+static void release_client(void *context) {
+    client_t *client = (client_t *)context;
+    (void)pthread_mutex_destroy(&client->lock);
+    free(client->output);
+    free(client->buffer);
+    free(client);
+}
+
+// Replies still in flight find the fd closed and are dropped; the client
+// itself is freed once the service lets go of it.
+static void close_client(sched_service_t *service, client_t *client) {
+    (void)pthread_mutex_lock(&client->lock);
+    (void)close(client->fd);
+    client->fd = -1;
+    (void)pthread_mutex_unlock(&client->lock);
+    sched_service_forget_client(service, client, release_client, client);
+}
+
+// Reads what is available and submits every complete line. Returns false
+// when the connection should be closed.
+static bool read_client(sched_service_t *service, client_t *client) {
+    if (client->capacity - client->length < DAEMON_READ_SIZE) {
+        size_t grown_capacity = (client->capacity > 0U) ? client->capacity * 2U : (size_t)DAEMON_READ_SIZE * 2U;
+        char *grown = (char *)realloc(client->buffer, grown_capacity);
+        if (!grown) {
+            return false;
+        }
+        client->buffer = grown;
+        client->capacity = grown_capacity;
+    }
+    ssize_t got = read(client->fd, client->buffer + client->length, DAEMON_READ_SIZE);
+    if (got < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return true;
+    }
+    if (got <= 0) {
+        return false;
+    }
+
+    size_t scanned = client->length;
+    client->length += (size_t)got;
+    size_t line_start = 0;
+    for (size_t i = scanned; i < client->length; i++) {
+        if (client->buffer[i] != '\n') {
+            continue;
+        }
+        size_t line_length = i - line_start;
+        if (line_length > 0U &&
+            sched_service_submit(service, client->buffer + line_start, line_length, client, reply_to_client, client) != 0) {
+            return false;
+        }
+        line_start = i + 1U;
+    }
+    if (line_start > 0U) {
+        (void)memmove(client->buffer, client->buffer + line_start, client->length - line_start);
+        client->length -= line_start;
+    }
+    if (client->length > DAEMON_MAX_LINE) {
+        static const char kTooLarge[] = "{\"id\":null,\"status\":\"error\",\"error\":\"request too large\"}\n";
+        reply_to_client(client, kTooLarge, sizeof(kTooLarge) - 1U);
+        return false;
+    }
+    return true;
+}
+
+static int open_listener(const char *socket_path, int port) {
+    int fd = -1;
+    if (socket_path) {
+        struct sockaddr_un address;
+        (void)memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (strlen(socket_path) >= sizeof(address.sun_path)) {
+            return -1;
+        }
+        (void)memcpy(address.sun_path, socket_path, strlen(socket_path) + 1U);
+        // A stale socket from an earlier run would make bind fail.
+        struct stat info;
+        if (stat(socket_path, &info) == 0 && S_ISSOCK(info.st_mode)) {
+            (void)unlink(socket_path);
+        }
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && bind(fd, (const struct sockaddr *)&address, sizeof(address)) != 0) {
+            (void)close(fd);
+            fd = -1;
+        }
+    } else {
+        struct sockaddr_in address;
+        (void)memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int reuse = 1;
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0) {
+            (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        if (fd >= 0 && bind(fd, (const struct sockaddr *)&address, sizeof(address)) != 0) {
+            (void)close(fd);
+            fd = -1;
+        }
+    }
+    if (fd >= 0 && listen(fd, 64) != 0) {
+        (void)close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = NULL;
+    int port = 0;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = (online > 0) ? (int)online : 1;
+    bool valid = true;
+
+    for (int i = 1; i + 1 < argc && valid; i += 2) {
+        if (strcmp(argv[i], "--socket") == 0) {
+            socket_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--port") == 0) {
+            port = atoi(argv[i + 1]);
+            valid = port > 0 && port < 65536;
+        } else if (strcmp(argv[i], "--workers") == 0) {
+            workers = atoi(argv[i + 1]);
+        } else {
+            valid = false;
+        }
+    }
+    if (workers > SCHED_SERVICE_MAX_WORKERS) {
+        workers = SCHED_SERVICE_MAX_WORKERS;
+    }
+    if (!valid || argc % 2 == 0 || workers <= 0 || (socket_path && port > 0) || (!socket_path && port == 0)) {
+        fprintf(stderr, "usage: %s (--socket PATH | --port N) [--workers N]\n", argv[0]);
+        return 2;
+    }
+
+    struct sigaction action;
+    (void)memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    (void)sigaction(SIGINT, &action, NULL);
+    (void)sigaction(SIGTERM, &action, NULL);
+    action.sa_handler = SIG_IGN;
+    (void)sigaction(SIGPIPE, &action, NULL);
+
+    if (pipe(g_wake) != 0 || !set_non_blocking(g_wake[0]) || !set_non_blocking(g_wake[1])) {
+        fprintf(stderr, "cannot create the wake-up pipe: %s\n", strerror(errno));
+        return 1;
+    }
+    int listener = open_listener(socket_path, port);
+    if (listener < 0) {
+        fprintf(stderr, "cannot listen on %s: %s\n", socket_path ? socket_path : "127.0.0.1", strerror(errno));
+        return 1;
+    }
+    sched_service_t *service = NULL;
+    if (sched_service_create(workers, &service) != 0) {
+        (void)close(listener);
+        return 1;
+    }
+    if (socket_path) {
+        fprintf(stderr, "listening on %s with %d workers\n", socket_path, workers);
+    } else {
+        fprintf(stderr, "listening on 127.0.0.1:%d with %d workers\n", port, workers);
+    }
+
+    struct pollfd fds[DAEMON_MAX_CLIENTS + 2];
+    client_t *clients[DAEMON_MAX_CLIENTS];
+    int client_count = 0;
+    while (!g_stop) {
+        fds[0].fd = listener;
+        fds[0].events = (client_count < DAEMON_MAX_CLIENTS) ? POLLIN : 0;
+        fds[1].fd = g_wake[0];
+        fds[1].events = POLLIN;
+        // Workers mark clients broken; only this loop closes them.
+        for (int c = client_count - 1; c >= 0; c--) {
+            (void)pthread_mutex_lock(&clients[c]->lock);
+            bool broken = clients[c]->broken;
+            (void)pthread_mutex_unlock(&clients[c]->lock);
+            if (broken) {
+                close_client(service, clients[c]);
+                clients[c] = clients[--client_count];
+            }
+        }
+        for (int c = 0; c < client_count; c++) {
+            (void)pthread_mutex_lock(&clients[c]->lock);
+            bool pending = clients[c]->output_length > 0U;
+            (void)pthread_mutex_unlock(&clients[c]->lock);
+            fds[c + 2].fd = clients[c]->fd;
+            fds[c + 2].events = (short)(POLLIN | (pending ? POLLOUT : 0));
+        }
+        if (poll(fds, (nfds_t)client_count + 2U, -1) < 0) {
+            continue;  // EINTR; g_stop is re-checked
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            char drained[64];
+            while (read(g_wake[0], drained, sizeof(drained)) > 0) {
+            }
+        }
+
+        // Back to front, so removing a client leaves unvisited slots in place.
+        for (int c = client_count - 1; c >= 0; c--) {
+            client_t *client = clients[c];
+            bool open = true;
+            if ((fds[c + 2].revents & POLLOUT) != 0) {
+                (void)pthread_mutex_lock(&client->lock);
+                flush_output(client);
+                open = !client->broken;
+                (void)pthread_mutex_unlock(&client->lock);
+            }
+            if (open && (fds[c + 2].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                open = read_client(service, client);
+            }
+            if (!open) {
+                close_client(service, client);
+                clients[c] = clients[--client_count];
+            }
+        }
+        if ((fds[0].revents & POLLIN) != 0) {
+            int fd = accept(listener, NULL, NULL);
+            client_t *client = (fd >= 0 && set_non_blocking(fd)) ? (client_t *)calloc(1, sizeof(client_t)) : NULL;
+            if (client) {
+                client->fd = fd;
+                (void)pthread_mutex_init(&client->lock, NULL);
+                clients[client_count++] = client;
+            } else if (fd >= 0) {
+                (void)close(fd);
+            }
+        }
+    }
+
+    for (int c = 0; c < client_count; c++) {
+        close_client(service, clients[c]);
+    }
+    sched_service_stats_t stats;
+    (void)sched_service_stats(service, &stats);
+    sched_service_destroy(service);
+    (void)close(listener);
+    (void)close(g_wake[0]);
+    (void)close(g_wake[1]);
+    if (socket_path) {
+        (void)unlink(socket_path);
+    }
+    fprintf(stderr, "completed %lld, cancelled %lld, failed %lld in %lld batches\n", stats.completed, stats.cancelled,
+            stats.failed, stats.batches);
+    return 0;
+}
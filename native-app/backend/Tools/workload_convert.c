@@ -0,0 +1,134 @@
+// Converts CSV workloads into the binary workload file format, or describes
+// an existing workload file.
+//
+//   workload_convert workload.csv workload.swkl     ("-" reads stdin)
+//   workload_convert --info workload.swkl
+//
+// CSV rows are "process_id,name,arrival_time,burst_time,priority", as written
+// by workload_gen; a header row is skipped.
+#include "workload_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONVERT_BATCH 4096
+#define CONVERT_LINE_MAX 1024
+
+static bool parse_int_field(char **cursor, int *value) {
+    char *end = NULL;
+    long parsed = strtol(*cursor, &end, 10);
+    if (end == *cursor || parsed < -2147483647L - 1L || parsed > 2147483647L || (*end != ',' && *end != '\0' &&
+                                                                                  *end != '\n' && *end != '\r')) {
+        return false;
+    }
+    *value = (int)parsed;
+    *cursor = (*end == ',') ? end + 1 : end;
+    return true;
+}
+
+static bool parse_row(char *line, process_t *process) {
+    (void)memset(process, 0, sizeof(*process));
+    char *cursor = line;
+    if (!parse_int_field(&cursor, &process->process_id)) {
+        return false;
+    }
+    char *comma = strchr(cursor, ',');
+    if (!comma) {
+        return false;
+    }
+    size_t length = (size_t)(comma - cursor);
+    if (length >= sizeof(process->name)) {
+        length = sizeof(process->name) - 1U;
+    }
+    (void)memcpy(process->name, cursor, length);
+    cursor = comma + 1;
+    return parse_int_field(&cursor, &process->arrival_time) && parse_int_field(&cursor, &process->burst_time) &&
+           parse_int_field(&cursor, &process->priority);
+}
+
+static int convert(const char *input_path, const char *output_path) {
+    FILE *in = (strcmp(input_path, "-") == 0) ? stdin : fopen(input_path, "r");
+    if (!in) {
+        fprintf(stderr, "cannot read %s\n", input_path);
+        return 1;
+    }
+    process_t *batch = (process_t *)malloc(CONVERT_BATCH * sizeof(process_t));
+    workload_file_writer_t *writer = NULL;
+    if (!batch || workload_file_writer_create(&writer) != 0) {
+        free(batch);
+        if (in != stdin) {
+            (void)fclose(in);
+        }
+        return 1;
+    }
+
+    char line[CONVERT_LINE_MAX];
+    long long line_number = 0;
+    int batched = 0;
+    int status = 0;
+    while (status == 0 && fgets(line, sizeof(line), in)) {
+        line_number++;
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '\0') {
+            continue;
+        }
+        if (!parse_row(line, &batch[batched])) {
+            if (line_number == 1) {
+                continue;  // header
+            }
+            fprintf(stderr, "%s:%lld: malformed row\n", input_path, line_number);
+            status = 1;
+            break;
+        }
+        if (++batched == CONVERT_BATCH) {
+            status = workload_file_writer_add(writer, batch, batched) == 0 ? 0 : 1;
+            batched = 0;
+        }
+    }
+    if (status == 0 && batched > 0) {
+        status = workload_file_writer_add(writer, batch, batched) == 0 ? 0 : 1;
+    }
+    if (status == 0 && workload_file_writer_finish(writer, output_path) != 0) {
+        fprintf(stderr, "cannot write %s\n", output_path);
+        status = 1;
+    }
+
+    workload_file_writer_destroy(writer);
+    free(batch);
+    if (in != stdin) {
+        (void)fclose(in);
+    }
+    return status;
+}
+
+static int describe(const char *path) {
+    workload_file_t *file = NULL;
+    if (workload_file_open(path, &file) != 0) {
+        fprintf(stderr, "%s is not a version %d workload file\n", path, WORKLOAD_FILE_VERSION);
+        return 1;
+    }
+    const workload_columns_t *columns = workload_file_columns(file);
+    printf("%s: %d processes, %llu bytes of names\n",
+           path, columns->process_count, (unsigned long long)columns->names_size);
+
+    int shown = (columns->process_count < 5) ? columns->process_count : 5;
+    for (int i = 0; i < shown; i++) {
+        char name[MAX_PROCESS_NAME];
+        (void)workload_columns_name(columns, i, name, sizeof(name));
+        printf("  %d,%s,%d,%d,%d\n",
+               columns->ids[i], name, columns->arrivals[i], columns->bursts[i], columns->priorities[i]);
+    }
+    workload_file_close(file);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--info") == 0) {
+        return describe(argv[2]);
+    }
+    if (argc == 3) {
+        return convert(argv[1], argv[2]);
+    }
+    fprintf(stderr, "usage: %s INPUT.csv OUTPUT.swkl | --info FILE.swkl\n", argv[0]);
+    return 2;
+}